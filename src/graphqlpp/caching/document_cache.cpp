@@ -0,0 +1,180 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "document_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace graphqlpp::caching {
+using language::parsing::ParseError;
+
+/// \brief Estimated bytes used by the bookkeeping of a single entry: its list
+/// node, its index node and its persisted index node.
+constexpr size_t ENTRY_OVERHEAD = 192;
+
+DocumentCache::DocumentCache(const size_t memory_budget,
+                             const size_t shard_count)
+    : shard_count_(std::max<size_t>(shard_count, 1)),
+      shard_budget_(memory_budget / shard_count_),
+      shards_(std::make_unique<Shard[]>(shard_count_)),
+      persisted_shards_(std::make_unique<PersistedShard[]>(shard_count_)) {}
+
+Result<std::shared_ptr<const ParsedDocument>, ParseError>
+DocumentCache::get_or_parse(const std::string_view source) {
+  using DocumentResult =
+      Result<std::shared_ptr<const ParsedDocument>, ParseError>;
+
+  const size_t hash = std::hash<std::string_view>{}(source);
+  std::shared_ptr<const ParsedDocument> document =
+      find(Key{.hash_ = hash, .source_ = source});
+
+  if (document != nullptr) {
+    return DocumentResult::Ok(std::move(document));
+  }
+
+  // Parsing happens outside of any lock, so a slow document does not block
+  // lookups of the other documents within its shard.
+  DocumentResult r = ParsedDocument::create(std::string(source));
+
+  if (!r.IsOk()) {
+    return r;
+  }
+
+  return DocumentResult::Ok(insert(hash, r.Unwrap()));
+}
+
+std::shared_ptr<const ParsedDocument> DocumentCache::find(
+    const std::string_view source) {
+  return find(
+      Key{.hash_ = std::hash<std::string_view>{}(source), .source_ = source});
+}
+
+std::shared_ptr<const ParsedDocument> DocumentCache::find_persisted(
+    const Sha256Digest& digest) {
+  PersistedEntry entry;
+
+  {
+    PersistedShard& persisted_shard = get_persisted_shard(digest);
+    std::lock_guard lock(persisted_shard.mutex_);
+    const auto it = persisted_shard.entries_.find(digest);
+
+    if (it == persisted_shard.entries_.end()) {
+      misses_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    entry = it->second;
+  }
+
+  // Going through the shard keeps the eviction order up to date.
+  return find(Key{.hash_ = entry.source_hash_,
+                  .source_ = entry.document_->get_source()});
+}
+
+std::shared_ptr<const ParsedDocument> DocumentCache::find_persisted(
+    const std::string_view sha256_hex) {
+  const std::optional<Sha256Digest> digest = parse_sha256_hex(sha256_hex);
+
+  if (!digest.has_value()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  return find_persisted(digest.value());
+}
+
+CacheStatistics DocumentCache::get_statistics() const {
+  CacheStatistics statistics = {
+      .hits_ = hits_.load(std::memory_order_relaxed),
+      .misses_ = misses_.load(std::memory_order_relaxed),
+      .evictions_ = evictions_.load(std::memory_order_relaxed),
+      .entries_ = 0,
+      .memory_usage_ = 0};
+
+  for (size_t i = 0; i < shard_count_; i++) {
+    std::lock_guard lock(shards_[i].mutex_);
+    statistics.entries_ += shards_[i].entries_.size();
+    statistics.memory_usage_ += shards_[i].memory_usage_;
+  }
+
+  return statistics;
+}
+
+DocumentCache::Shard& DocumentCache::get_shard(const size_t hash) const {
+  return shards_[hash % shard_count_];
+}
+
+DocumentCache::PersistedShard& DocumentCache::get_persisted_shard(
+    const Sha256Digest& digest) const {
+  return persisted_shards_[Sha256DigestHash{}(digest) % shard_count_];
+}
+
+std::shared_ptr<const ParsedDocument> DocumentCache::find(const Key& key) {
+  Shard& shard = get_shard(key.hash_);
+  std::lock_guard lock(shard.mutex_);
+  const auto it = shard.index_.find(key);
+
+  if (it == shard.index_.end()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  shard.entries_.splice(shard.entries_.begin(), shard.entries_, it->second);
+  hits_.fetch_add(1, std::memory_order_relaxed);
+
+  return it->second->document_;
+}
+
+std::shared_ptr<const ParsedDocument> DocumentCache::insert(
+    const size_t hash, std::shared_ptr<const ParsedDocument> document) {
+  const size_t memory_usage = document->get_memory_usage() + ENTRY_OVERHEAD;
+
+  if (memory_usage > shard_budget_) {
+    return document;
+  }
+
+  const Key key = Key{.hash_ = hash, .source_ = document->get_source()};
+  const Sha256Digest digest = sha256(document->get_source());
+  Shard& shard = get_shard(hash);
+  std::lock_guard lock(shard.mutex_);
+  const auto existing = shard.index_.find(key);
+
+  if (existing != shard.index_.end()) {
+    return existing->second->document_;
+  }
+
+  shard.entries_.push_front(Entry{.document_ = document,
+                                  .hash_ = hash,
+                                  .digest_ = digest,
+                                  .memory_usage_ = memory_usage});
+  shard.index_.emplace(key, shard.entries_.begin());
+  shard.memory_usage_ += memory_usage;
+
+  {
+    PersistedShard& persisted_shard = get_persisted_shard(digest);
+    std::lock_guard persisted_lock(persisted_shard.mutex_);
+    persisted_shard.entries_.insert_or_assign(
+        digest, PersistedEntry{.document_ = document, .source_hash_ = hash});
+  }
+
+  while (shard.memory_usage_ > shard_budget_) {
+    const Entry& evicted = shard.entries_.back();
+    PersistedShard& persisted_shard = get_persisted_shard(evicted.digest_);
+
+    {
+      std::lock_guard persisted_lock(persisted_shard.mutex_);
+      persisted_shard.entries_.erase(evicted.digest_);
+    }
+
+    shard.index_.erase(Key{.hash_ = evicted.hash_,
+                           .source_ = evicted.document_->get_source()});
+    shard.memory_usage_ -= evicted.memory_usage_;
+    shard.entries_.pop_back();
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  return document;
+}
+}  // namespace graphqlpp::caching
@@ -0,0 +1,140 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef DOCUMENT_CACHE_H
+#define DOCUMENT_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include "../language/parsing/parse_error.h"
+#include "../result.h"
+#include "parsed_document.h"
+#include "sha256.h"
+
+namespace graphqlpp::caching {
+struct CacheStatistics {
+  uint64_t hits_;
+  uint64_t misses_;
+  uint64_t evictions_;
+  size_t entries_;
+  /// \brief Amount of bytes held by the cached documents.
+  size_t memory_usage_;
+};
+
+/// \brief Thread-safe cache of parsed documents, keyed by their source text.
+///
+/// Entries are spread across shards by a hash of the source text, each one
+/// with its own lock and least recently used eviction order, so lookups of
+/// different documents rarely contend. Documents are also indexed by the
+/// SHA-256 digest of their source text, which allows lookups by persisted
+/// query hash.
+class DocumentCache {
+ public:
+  static constexpr size_t DEFAULT_SHARD_COUNT = 16;
+
+  /// \param memory_budget Amount of bytes the cached documents may hold. It
+  /// is split evenly between the shards.
+  /// \param shard_count Amount of independently locked shards.
+  explicit DocumentCache(size_t memory_budget,
+                         size_t shard_count = DEFAULT_SHARD_COUNT);
+
+  DocumentCache(const DocumentCache&) = delete;
+  DocumentCache& operator=(const DocumentCache&) = delete;
+
+  /// \brief Looks up the document with the given source text, parsing and
+  /// caching it if it is not cached yet. Documents larger than the budget of
+  /// a shard are returned without being cached.
+  /// \return The shared document or the <i>ParseError</i> of its source.
+  Result<std::shared_ptr<const ParsedDocument>, language::parsing::ParseError>
+  get_or_parse(std::string_view source);
+
+  /// \brief Looks up the document with the given source text.
+  /// \return The shared document, or null if it is not cached.
+  std::shared_ptr<const ParsedDocument> find(std::string_view source);
+
+  /// \brief Looks up a document by the SHA-256 digest of its source text.
+  /// \return The shared document, or null if it is not cached.
+  std::shared_ptr<const ParsedDocument> find_persisted(
+      const Sha256Digest& digest);
+
+  /// \brief Looks up a document by the hexadecimal SHA-256 digest of its
+  /// source text, as sent by Automatic Persisted Queries clients.
+  /// \return The shared document, or null if it is not cached or the digest
+  /// is not valid.
+  std::shared_ptr<const ParsedDocument> find_persisted(
+      std::string_view sha256_hex);
+
+  [[nodiscard]] CacheStatistics get_statistics() const;
+
+ private:
+  struct Key {
+    size_t hash_;
+    /// \brief View of the source text owned by the cached document.
+    std::string_view source_;
+
+    bool operator==(const Key& other) const {
+      return hash_ == other.hash_ && source_ == other.source_;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const { return key.hash_; }
+  };
+
+  struct Entry {
+    std::shared_ptr<const ParsedDocument> document_;
+    size_t hash_;
+    Sha256Digest digest_;
+    size_t memory_usage_;
+  };
+
+  struct Shard {
+    std::mutex mutex_;
+    /// \brief Most recently used entries first.
+    std::list<Entry> entries_;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+    size_t memory_usage_ = 0;
+  };
+
+  struct PersistedEntry {
+    std::shared_ptr<const ParsedDocument> document_;
+    size_t source_hash_;
+  };
+
+  /// \brief Index from digests to documents. Its locks are only ever taken
+  /// alone or while holding a shard's lock, never the other way around.
+  struct PersistedShard {
+    std::mutex mutex_;
+    std::unordered_map<Sha256Digest, PersistedEntry, Sha256DigestHash>
+        entries_;
+  };
+
+  size_t shard_count_;
+  size_t shard_budget_;
+  std::unique_ptr<Shard[]> shards_;
+  std::unique_ptr<PersistedShard[]> persisted_shards_;
+  std::atomic<uint64_t> hits_ = 0;
+  std::atomic<uint64_t> misses_ = 0;
+  std::atomic<uint64_t> evictions_ = 0;
+
+  Shard& get_shard(size_t hash) const;
+  PersistedShard& get_persisted_shard(const Sha256Digest& digest) const;
+
+  /// \brief Looks up an entry, marking it as the most recently used one.
+  std::shared_ptr<const ParsedDocument> find(const Key& key);
+
+  /// \brief Caches a parsed document, evicting the least recently used ones
+  /// until its shard fits within its budget.
+  /// \return The cached document, which is a previously cached one if
+  /// another thread cached the same source text meanwhile.
+  std::shared_ptr<const ParsedDocument> insert(
+      size_t hash, std::shared_ptr<const ParsedDocument> document);
+};
+}  // namespace graphqlpp::caching
+
+#endif  // DOCUMENT_CACHE_H
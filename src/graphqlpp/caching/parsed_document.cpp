@@ -0,0 +1,53 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "parsed_document.h"
+
+#include <utility>
+
+#include "../language/parsing/parser.h"
+#include "../language/tokenization/tokenizer.h"
+
+namespace graphqlpp::caching {
+using language::parsing::Document;
+using language::parsing::ParseError;
+
+/// \brief Cached documents are mostly small queries, so their arenas start
+/// with small blocks.
+constexpr size_t ARENA_BLOCK_SIZE = 1024;
+
+ParsedDocument::ParsedDocument(std::string source)
+    : source_(std::move(source)), arena_(ARENA_BLOCK_SIZE) {}
+
+Result<std::shared_ptr<const ParsedDocument>, ParseError>
+ParsedDocument::create(std::string source) {
+  using ParsedDocumentResult =
+      Result<std::shared_ptr<const ParsedDocument>, ParseError>;
+
+  // The document is placed on the heap before parsing, so the views of its
+  // AST keep pointing to its source text.
+  std::shared_ptr<ParsedDocument> document(
+      new ParsedDocument(std::move(source)));
+  Result<size_t, language::tokenization::TokenizeError> tokenize_result =
+      language::tokenization::tokenize(document->source_, document->tokens_);
+
+  if (!tokenize_result.IsOk()) {
+    return ParsedDocumentResult::Err(ParseError(tokenize_result.UnwrapErr()));
+  }
+
+  Result<const Document*, ParseError> parse_result = language::parsing::parse(
+      document->source_, document->tokens_, document->arena_);
+
+  if (!parse_result.IsOk()) {
+    return ParsedDocumentResult::Err(parse_result.UnwrapErr());
+  }
+
+  document->document_ = parse_result.Unwrap();
+
+  return ParsedDocumentResult::Ok(std::move(document));
+}
+
+size_t ParsedDocument::get_memory_usage() const {
+  return sizeof(ParsedDocument) + source_.capacity() +
+         tokens_.get_memory_usage() + arena_.get_reserved_size();
+}
+}  // namespace graphqlpp::caching
@@ -0,0 +1,54 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef PARSED_DOCUMENT_H
+#define PARSED_DOCUMENT_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "../language/parsing/arena.h"
+#include "../language/parsing/ast.h"
+#include "../language/parsing/parse_error.h"
+#include "../language/tokenization/token_buffer.h"
+#include "../result.h"
+
+namespace graphqlpp::caching {
+/// \brief Immutable document which owns its source text, its tokens and the
+/// arena holding its AST, so it can be shared between threads and requests.
+class ParsedDocument {
+ public:
+  /// \brief Tokenizes and parses a GraphQL executable document.
+  /// \param source UTF-8 source text, which is kept by the document.
+  /// \return The parsed document or a <i>ParseError</i>.
+  static Result<std::shared_ptr<const ParsedDocument>,
+                language::parsing::ParseError>
+  create(std::string source);
+
+  ParsedDocument(const ParsedDocument&) = delete;
+  ParsedDocument& operator=(const ParsedDocument&) = delete;
+
+  [[nodiscard]] std::string_view get_source() const { return source_; }
+
+  [[nodiscard]] const language::tokenization::TokenBuffer& get_tokens() const {
+    return tokens_;
+  }
+
+  [[nodiscard]] const language::parsing::Document& get_document() const {
+    return *document_;
+  }
+
+  /// \brief Amount of bytes held by the document, including its source text.
+  [[nodiscard]] size_t get_memory_usage() const;
+
+ private:
+  std::string source_;
+  language::tokenization::TokenBuffer tokens_;
+  language::parsing::Arena arena_;
+  const language::parsing::Document* document_ = nullptr;
+
+  explicit ParsedDocument(std::string source);
+};
+}  // namespace graphqlpp::caching
+
+#endif  // PARSED_DOCUMENT_H
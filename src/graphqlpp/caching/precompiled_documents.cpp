@@ -0,0 +1,936 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "precompiled_documents.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "../language/normalization/normalizer.h"
+#include "../language/parsing/parser.h"
+#include "../language/tokenization/token_buffer.h"
+#include "../language/tokenization/tokenizer.h"
+
+namespace graphqlpp::caching {
+using language::parsing::Node;
+using language::parsing::NodeKind;
+using precompiled::DocumentRecord;
+using precompiled::FileHeader;
+using precompiled::NodeRecord;
+using precompiled::TokenRecord;
+
+namespace parsing = language::parsing;
+
+namespace {
+constexpr char MAGIC[8] = {'G', 'Q', 'L', 'P', 'P', 'D', 'O', 'C'};
+constexpr uint8_t BLOCK_STRING_FLAG = 1;
+constexpr uint8_t ESCAPED_STRING_FLAG = 2;
+/// \brief Longest chain of nodes within a parsed document. The parser bounds
+/// the nesting of selection sets, values and types, each level of which takes
+/// at most two nodes, such as a selection set and a field. The document, its
+/// definition, a directive and an argument come on top.
+constexpr size_t MAX_NODE_DEPTH = 2 * parsing::MAX_NESTING_DEPTH + 8;
+
+static_assert(std::is_trivially_copyable_v<FileHeader> &&
+              std::is_trivially_copyable_v<DocumentRecord> &&
+              std::is_trivially_copyable_v<TokenRecord> &&
+              std::is_trivially_copyable_v<NodeRecord>);
+static_assert(sizeof(DocumentRecord) % precompiled::SECTION_ALIGNMENT == 0);
+
+size_t align_section(const size_t offset) {
+  return (offset + precompiled::SECTION_ALIGNMENT - 1) &
+         ~(precompiled::SECTION_ALIGNMENT - 1);
+}
+
+/// \brief Appends a section of records, aligned, to the contents of a file.
+/// \return Offset of the section.
+template <typename T>
+uint64_t append_section(const std::vector<T>& records, std::string& output) {
+  output.resize(align_section(output.size()));
+  const uint64_t offset = output.size();
+  output.append(reinterpret_cast<const char*>(records.data()),
+                records.size() * sizeof(T));
+
+  return offset;
+}
+
+/// \brief Lays out the AST of a document as node records, children first
+/// being given higher indices than their parents. Documents come from the
+/// parser, so the recursion is at most <i>MAX_NODE_DEPTH</i> deep.
+class NodeEncoder {
+ public:
+  NodeEncoder(const std::string_view source, std::vector<NodeRecord>& nodes,
+              std::vector<uint32_t>& children)
+      : source_(source), nodes_(nodes), children_(children) {}
+
+  uint32_t encode(const Node& node) {
+    const auto index = static_cast<uint32_t>(nodes_.size());
+    NodeRecord record = NodeRecord();
+    std::vector<uint32_t> groups[3];
+    record.kind_ = static_cast<uint8_t>(node.kind_);
+    record.offset_ = static_cast<uint32_t>(node.offset_);
+    nodes_.emplace_back();
+
+    switch (node.kind_) {
+      case NodeKind::DOCUMENT: {
+        const auto& document = static_cast<const parsing::Document&>(node);
+        add_all(groups[0], document.definitions_);
+        break;
+      }
+      case NodeKind::OPERATION_DEFINITION: {
+        const auto& operation =
+            static_cast<const parsing::OperationDefinition&>(node);
+        record.flags_ = static_cast<uint8_t>(operation.operation_);
+        set_range(record, 0, operation.name_);
+        add_all(groups[0], operation.variable_definitions_);
+        add_all(groups[1], operation.directives_);
+        add(groups[2], operation.selection_set_);
+        break;
+      }
+      case NodeKind::FRAGMENT_DEFINITION: {
+        const auto& fragment =
+            static_cast<const parsing::FragmentDefinition&>(node);
+        set_range(record, 0, fragment.name_);
+        add(groups[0], fragment.type_condition_);
+        add_all(groups[1], fragment.directives_);
+        add(groups[2], fragment.selection_set_);
+        break;
+      }
+      case NodeKind::VARIABLE_DEFINITION: {
+        const auto& definition =
+            static_cast<const parsing::VariableDefinition&>(node);
+        add(groups[0], definition.variable_);
+        add(groups[0], definition.type_);
+        add_all(groups[1], definition.directives_);
+        add(groups[2], definition.default_value_);
+        break;
+      }
+      case NodeKind::SELECTION_SET:
+        add_all(groups[0],
+                static_cast<const parsing::SelectionSet&>(node).selections_);
+        break;
+      case NodeKind::FIELD: {
+        const auto& field = static_cast<const parsing::Field&>(node);
+        set_range(record, 0, field.alias_);
+        set_range(record, 1, field.name_);
+        add_all(groups[0], field.arguments_);
+        add_all(groups[1], field.directives_);
+        add(groups[2], field.selection_set_);
+        break;
+      }
+      case NodeKind::FRAGMENT_SPREAD: {
+        const auto& spread = static_cast<const parsing::FragmentSpread&>(node);
+        set_range(record, 0, spread.name_);
+        add_all(groups[1], spread.directives_);
+        break;
+      }
+      case NodeKind::INLINE_FRAGMENT: {
+        const auto& fragment =
+            static_cast<const parsing::InlineFragment&>(node);
+        add(groups[0], fragment.type_condition_);
+        add_all(groups[1], fragment.directives_);
+        add(groups[2], fragment.selection_set_);
+        break;
+      }
+      case NodeKind::ARGUMENT: {
+        const auto& argument = static_cast<const parsing::Argument&>(node);
+        set_range(record, 0, argument.name_);
+        add(groups[0], argument.value_);
+        break;
+      }
+      case NodeKind::DIRECTIVE: {
+        const auto& directive = static_cast<const parsing::Directive&>(node);
+        set_range(record, 0, directive.name_);
+        add_all(groups[0], directive.arguments_);
+        break;
+      }
+      case NodeKind::VARIABLE:
+        set_range(record, 0, static_cast<const parsing::Variable&>(node).name_);
+        break;
+      case NodeKind::INT_VALUE:
+        set_range(record, 0,
+                  static_cast<const parsing::IntValue&>(node).value_);
+        break;
+      case NodeKind::FLOAT_VALUE:
+        set_range(record, 0,
+                  static_cast<const parsing::FloatValue&>(node).value_);
+        break;
+      case NodeKind::STRING_VALUE: {
+        const auto& string = static_cast<const parsing::StringValue&>(node);
+        record.flags_ = (string.block_ ? BLOCK_STRING_FLAG : 0) |
+                        (string.escaped_ ? ESCAPED_STRING_FLAG : 0);
+        set_range(record, 0, string.raw_value_);
+        break;
+      }
+      case NodeKind::BOOLEAN_VALUE:
+        record.flags_ = static_cast<const parsing::BooleanValue&>(node).value_;
+        break;
+      case NodeKind::NULL_VALUE:
+        break;
+      case NodeKind::ENUM_VALUE:
+        set_range(record, 0,
+                  static_cast<const parsing::EnumValue&>(node).value_);
+        break;
+      case NodeKind::LIST_VALUE:
+        add_all(groups[0],
+                static_cast<const parsing::ListValue&>(node).values_);
+        break;
+      case NodeKind::OBJECT_VALUE:
+        add_all(groups[0],
+                static_cast<const parsing::ObjectValue&>(node).fields_);
+        break;
+      case NodeKind::OBJECT_FIELD: {
+        const auto& field = static_cast<const parsing::ObjectField&>(node);
+        set_range(record, 0, field.name_);
+        add(groups[0], field.value_);
+        break;
+      }
+      case NodeKind::NAMED_TYPE:
+        set_range(record, 0,
+                  static_cast<const parsing::NamedType&>(node).name_);
+        break;
+      case NodeKind::LIST_TYPE:
+        add(groups[0], static_cast<const parsing::ListType&>(node).type_);
+        break;
+      case NodeKind::NON_NULL_TYPE:
+      default:
+        add(groups[0], static_cast<const parsing::NonNullType&>(node).type_);
+        break;
+    }
+
+    // Children are laid out once encoded, since encoding them appends the
+    // children of their own children.
+    record.first_child_ = static_cast<uint32_t>(children_.size());
+
+    for (size_t i = 0; i < 3; i++) {
+      record.group_sizes_[i] = static_cast<uint32_t>(groups[i].size());
+      children_.insert(children_.end(), groups[i].begin(), groups[i].end());
+    }
+
+    nodes_[index] = record;
+
+    return index;
+  }
+
+ private:
+  std::string_view source_;
+  std::vector<NodeRecord>& nodes_;
+  std::vector<uint32_t>& children_;
+
+  void set_range(NodeRecord& record, const size_t i,
+                 const std::string_view value) const {
+    // Views of the AST always point into the source, except empty ones,
+    // which may not point anywhere.
+    record.range_offsets_[i] =
+        value.empty() ? 0
+                      : static_cast<uint32_t>(value.data() - source_.data());
+    record.range_sizes_[i] = static_cast<uint32_t>(value.size());
+  }
+
+  void add(std::vector<uint32_t>& group, const Node* node) {
+    if (node != nullptr) {
+      group.push_back(encode(*node));
+    }
+  }
+
+  template <typename T>
+  void add_all(std::vector<uint32_t>& group,
+               const std::span<const T* const> nodes) {
+    for (const T* node : nodes) {
+      group.push_back(encode(*node));
+    }
+  }
+};
+
+/// \brief Whether a node of the given kind can be viewed as a <i>T</i>.
+template <typename T>
+bool is_kind_of(const NodeKind kind) {
+  if constexpr (std::is_same_v<T, parsing::Definition>) {
+    return kind == NodeKind::OPERATION_DEFINITION ||
+           kind == NodeKind::FRAGMENT_DEFINITION;
+  } else if constexpr (std::is_same_v<T, parsing::Selection>) {
+    return kind == NodeKind::FIELD || kind == NodeKind::FRAGMENT_SPREAD ||
+           kind == NodeKind::INLINE_FRAGMENT;
+  } else if constexpr (std::is_same_v<T, parsing::Value>) {
+    return kind >= NodeKind::VARIABLE && kind <= NodeKind::OBJECT_VALUE;
+  } else if constexpr (std::is_same_v<T, parsing::Type>) {
+    return kind >= NodeKind::NAMED_TYPE && kind <= NodeKind::NON_NULL_TYPE;
+  } else if constexpr (std::is_same_v<T, parsing::Document>) {
+    return kind == NodeKind::DOCUMENT;
+  } else if constexpr (std::is_same_v<T, parsing::VariableDefinition>) {
+    return kind == NodeKind::VARIABLE_DEFINITION;
+  } else if constexpr (std::is_same_v<T, parsing::SelectionSet>) {
+    return kind == NodeKind::SELECTION_SET;
+  } else if constexpr (std::is_same_v<T, parsing::Argument>) {
+    return kind == NodeKind::ARGUMENT;
+  } else if constexpr (std::is_same_v<T, parsing::Directive>) {
+    return kind == NodeKind::DIRECTIVE;
+  } else if constexpr (std::is_same_v<T, parsing::Variable>) {
+    return kind == NodeKind::VARIABLE;
+  } else if constexpr (std::is_same_v<T, parsing::ObjectField>) {
+    return kind == NodeKind::OBJECT_FIELD;
+  } else {
+    static_assert(std::is_same_v<T, parsing::NamedType>);
+    return kind == NodeKind::NAMED_TYPE;
+  }
+}
+
+Result<std::string, std::string> read_file(const std::filesystem::path& path) {
+  std::ifstream stream(path, std::ios::binary);
+  std::string contents;
+
+  if (stream) {
+    contents.assign(std::istreambuf_iterator<char>(stream),
+                    std::istreambuf_iterator<char>());
+  }
+
+  if (!stream && !stream.eof()) {
+    return Result<std::string, std::string>::Err("Could not read '" +
+                                                 path.string() + "'.");
+  }
+
+  return Result<std::string, std::string>::Ok(std::move(contents));
+}
+}  // namespace
+
+/// \brief Builds the AST of a precompiled document within an arena. Every
+/// index and range is checked against the document, and children must come
+/// after their parents, so a corrupt file can neither be read out of bounds
+/// nor make the decoder loop. Nodes are decoded at most
+/// <i>MAX_NODE_DEPTH</i> deep, and no more of them than the document holds,
+/// so neither can a corrupt file exhaust the stack, nor expand children
+/// shared by several parents exponentially.
+class NodeDecoder {
+ public:
+  NodeDecoder(const PrecompiledDocuments& documents,
+              const DocumentRecord& record, parsing::Arena& arena)
+      : documents_(documents),
+        source_(documents.strings_.substr(record.source_offset_,
+                                          record.source_size_)),
+        first_node_(record.first_node_),
+        end_node_(record.first_node_ + record.node_count_),
+        arena_(arena) {}
+
+  template <typename T>
+  const T* decode(const uint32_t index) {
+    if (index < first_node_ || index >= end_node_ ||
+        depth_ == MAX_NODE_DEPTH || decoded_count_ == end_node_ - first_node_) {
+      is_corrupt_ = true;
+      return nullptr;
+    }
+
+    const NodeRecord& record = documents_.nodes_[index];
+    const auto kind = static_cast<NodeKind>(record.kind_);
+
+    if (record.kind_ > static_cast<uint8_t>(NodeKind::NON_NULL_TYPE) ||
+        !is_kind_of<T>(kind) || !has_valid_children(index, record)) {
+      is_corrupt_ = true;
+      return nullptr;
+    }
+
+    decoded_count_++;
+    depth_++;
+    const Node* node = decode_node(record);
+    depth_--;
+
+    return static_cast<const T*>(node);
+  }
+
+  [[nodiscard]] bool is_corrupt() const { return is_corrupt_; }
+
+ private:
+  const PrecompiledDocuments& documents_;
+  std::string_view source_;
+  uint32_t first_node_;
+  uint32_t end_node_;
+  parsing::Arena& arena_;
+  /// \brief Amount of nodes being decoded, from the document down.
+  size_t depth_ = 0;
+  uint32_t decoded_count_ = 0;
+  bool is_corrupt_ = false;
+
+  bool has_valid_children(const uint32_t index,
+                          const NodeRecord& record) const {
+    const uint64_t end_child = static_cast<uint64_t>(record.first_child_) +
+                               record.group_sizes_[0] +
+                               record.group_sizes_[1] + record.group_sizes_[2];
+
+    if (end_child > documents_.children_.size()) {
+      return false;
+    }
+
+    for (uint64_t i = record.first_child_; i < end_child; i++) {
+      if (documents_.children_[i] <= index) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  std::span<const uint32_t> get_group(const NodeRecord& record,
+                                      const size_t group) const {
+    uint32_t first = record.first_child_;
+
+    for (size_t i = 0; i < group; i++) {
+      first += record.group_sizes_[i];
+    }
+
+    return documents_.children_.subspan(first, record.group_sizes_[group]);
+  }
+
+  std::string_view get_range(const NodeRecord& record, const size_t i) {
+    const uint64_t end = static_cast<uint64_t>(record.range_offsets_[i]) +
+                         record.range_sizes_[i];
+
+    if (end > source_.size()) {
+      is_corrupt_ = true;
+      return {};
+    }
+
+    return source_.substr(record.range_offsets_[i], record.range_sizes_[i]);
+  }
+
+  template <typename T>
+  std::span<const T* const> decode_all(const std::span<const uint32_t> group) {
+    const T** nodes = arena_.allocate_array<const T*>(group.size());
+
+    for (size_t i = 0; i < group.size(); i++) {
+      nodes[i] = decode<T>(group[i]);
+    }
+
+    return std::span<const T* const>(nodes, group.size());
+  }
+
+  /// \brief Decodes the node of a group holding at most one.
+  template <typename T>
+  const T* decode_optional(const std::span<const uint32_t> group) {
+    if (group.size() > 1) {
+      is_corrupt_ = true;
+    }
+
+    return group.empty() ? nullptr : decode<T>(group[0]);
+  }
+
+  /// \brief Decodes the node of a group holding exactly one.
+  template <typename T>
+  const T* decode_required(const std::span<const uint32_t> group) {
+    if (group.size() != 1) {
+      is_corrupt_ = true;
+      return nullptr;
+    }
+
+    return decode<T>(group[0]);
+  }
+
+  template <typename T>
+  T* create(const NodeRecord& record) {
+    T* node = arena_.create<T>();
+    node->kind_ = static_cast<NodeKind>(record.kind_);
+    node->offset_ = record.offset_;
+
+    return node;
+  }
+
+  const Node* decode_node(const NodeRecord& record) {
+    switch (static_cast<NodeKind>(record.kind_)) {
+      case NodeKind::DOCUMENT: {
+        auto* document = create<parsing::Document>(record);
+        document->definitions_ =
+            decode_all<parsing::Definition>(get_group(record, 0));
+        return document;
+      }
+      case NodeKind::OPERATION_DEFINITION: {
+        auto* operation = create<parsing::OperationDefinition>(record);
+
+        if (record.flags_ >
+            static_cast<uint8_t>(parsing::OperationType::SUBSCRIPTION)) {
+          is_corrupt_ = true;
+        }
+
+        operation->operation_ =
+            static_cast<parsing::OperationType>(record.flags_);
+        operation->name_ = get_range(record, 0);
+        operation->variable_definitions_ =
+            decode_all<parsing::VariableDefinition>(get_group(record, 0));
+        operation->directives_ =
+            decode_all<parsing::Directive>(get_group(record, 1));
+        operation->selection_set_ =
+            decode_required<parsing::SelectionSet>(get_group(record, 2));
+        return operation;
+      }
+      case NodeKind::FRAGMENT_DEFINITION: {
+        auto* fragment = create<parsing::FragmentDefinition>(record);
+        fragment->name_ = get_range(record, 0);
+        fragment->type_condition_ =
+            decode_required<parsing::NamedType>(get_group(record, 0));
+        fragment->directives_ =
+            decode_all<parsing::Directive>(get_group(record, 1));
+        fragment->selection_set_ =
+            decode_required<parsing::SelectionSet>(get_group(record, 2));
+        return fragment;
+      }
+      case NodeKind::VARIABLE_DEFINITION: {
+        auto* definition = create<parsing::VariableDefinition>(record);
+        const std::span<const uint32_t> group = get_group(record, 0);
+
+        if (group.size() != 2) {
+          is_corrupt_ = true;
+          return definition;
+        }
+
+        definition->variable_ = decode<parsing::Variable>(group[0]);
+        definition->type_ = decode<parsing::Type>(group[1]);
+        definition->directives_ =
+            decode_all<parsing::Directive>(get_group(record, 1));
+        definition->default_value_ =
+            decode_optional<parsing::Value>(get_group(record, 2));
+        return definition;
+      }
+      case NodeKind::SELECTION_SET: {
+        auto* selection_set = create<parsing::SelectionSet>(record);
+        selection_set->selections_ =
+            decode_all<parsing::Selection>(get_group(record, 0));
+        return selection_set;
+      }
+      case NodeKind::FIELD: {
+        auto* field = create<parsing::Field>(record);
+        field->alias_ = get_range(record, 0);
+        field->name_ = get_range(record, 1);
+        field->arguments_ = decode_all<parsing::Argument>(get_group(record, 0));
+        field->directives_ =
+            decode_all<parsing::Directive>(get_group(record, 1));
+        field->selection_set_ =
+            decode_optional<parsing::SelectionSet>(get_group(record, 2));
+        return field;
+      }
+      case NodeKind::FRAGMENT_SPREAD: {
+        auto* spread = create<parsing::FragmentSpread>(record);
+        spread->name_ = get_range(record, 0);
+        spread->directives_ =
+            decode_all<parsing::Directive>(get_group(record, 1));
+        return spread;
+      }
+      case NodeKind::INLINE_FRAGMENT: {
+        auto* fragment = create<parsing::InlineFragment>(record);
+        fragment->type_condition_ =
+            decode_optional<parsing::NamedType>(get_group(record, 0));
+        fragment->directives_ =
+            decode_all<parsing::Directive>(get_group(record, 1));
+        fragment->selection_set_ =
+            decode_required<parsing::SelectionSet>(get_group(record, 2));
+        return fragment;
+      }
+      case NodeKind::ARGUMENT: {
+        auto* argument = create<parsing::Argument>(record);
+        argument->name_ = get_range(record, 0);
+        argument->value_ =
+            decode_required<parsing::Value>(get_group(record, 0));
+        return argument;
+      }
+      case NodeKind::DIRECTIVE: {
+        auto* directive = create<parsing::Directive>(record);
+        directive->name_ = get_range(record, 0);
+        directive->arguments_ =
+            decode_all<parsing::Argument>(get_group(record, 0));
+        return directive;
+      }
+      case NodeKind::VARIABLE: {
+        auto* variable = create<parsing::Variable>(record);
+        variable->name_ = get_range(record, 0);
+        return variable;
+      }
+      case NodeKind::INT_VALUE: {
+        auto* value = create<parsing::IntValue>(record);
+        value->value_ = get_range(record, 0);
+        return value;
+      }
+      case NodeKind::FLOAT_VALUE: {
+        auto* value = create<parsing::FloatValue>(record);
+        value->value_ = get_range(record, 0);
+        return value;
+      }
+      case NodeKind::STRING_VALUE: {
+        auto* value = create<parsing::StringValue>(record);
+        value->raw_value_ = get_range(record, 0);
+        value->block_ = (record.flags_ & BLOCK_STRING_FLAG) != 0;
+        value->escaped_ = (record.flags_ & ESCAPED_STRING_FLAG) != 0;
+        return value;
+      }
+      case NodeKind::BOOLEAN_VALUE: {
+        auto* value = create<parsing::BooleanValue>(record);
+        value->value_ = record.flags_ != 0;
+        return value;
+      }
+      case NodeKind::NULL_VALUE:
+        return create<parsing::NullValue>(record);
+      case NodeKind::ENUM_VALUE: {
+        auto* value = create<parsing::EnumValue>(record);
+        value->value_ = get_range(record, 0);
+        return value;
+      }
+      case NodeKind::LIST_VALUE: {
+        auto* value = create<parsing::ListValue>(record);
+        value->values_ = decode_all<parsing::Value>(get_group(record, 0));
+        return value;
+      }
+      case NodeKind::OBJECT_VALUE: {
+        auto* value = create<parsing::ObjectValue>(record);
+        value->fields_ = decode_all<parsing::ObjectField>(get_group(record, 0));
+        return value;
+      }
+      case NodeKind::OBJECT_FIELD: {
+        auto* field = create<parsing::ObjectField>(record);
+        field->name_ = get_range(record, 0);
+        field->value_ = decode_required<parsing::Value>(get_group(record, 0));
+        return field;
+      }
+      case NodeKind::NAMED_TYPE: {
+        auto* type = create<parsing::NamedType>(record);
+        type->name_ = get_range(record, 0);
+        return type;
+      }
+      case NodeKind::LIST_TYPE: {
+        auto* type = create<parsing::ListType>(record);
+        type->type_ = decode_required<parsing::Type>(get_group(record, 0));
+        return type;
+      }
+      case NodeKind::NON_NULL_TYPE:
+      default: {
+        auto* type = create<parsing::NonNullType>(record);
+        type->type_ = decode_required<parsing::Type>(get_group(record, 0));
+        return type;
+      }
+    }
+  }
+};
+
+std::string_view PrecompiledDocument::get_name() const {
+  return documents_->strings_.substr(record_->name_offset_,
+                                     record_->name_size_);
+}
+
+std::string_view PrecompiledDocument::get_source() const {
+  return documents_->strings_.substr(record_->source_offset_,
+                                     record_->source_size_);
+}
+
+std::span<const TokenRecord> PrecompiledDocument::get_tokens() const {
+  return documents_->tokens_.subspan(record_->first_token_,
+                                     record_->token_count_);
+}
+
+Result<const parsing::Document*, std::string> PrecompiledDocument::materialize(
+    parsing::Arena& arena) const {
+  NodeDecoder decoder = NodeDecoder(*documents_, *record_, arena);
+  const parsing::Document* document =
+      decoder.decode<parsing::Document>(record_->first_node_);
+
+  if (decoder.is_corrupt()) {
+    return Result<const parsing::Document*, std::string>::Err(
+        "Detected a corrupt node within the precompiled document '" +
+        std::string(get_name()) + "'.");
+  }
+
+  return Result<const parsing::Document*, std::string>::Ok(document);
+}
+
+Result<PrecompiledDocuments, std::string> PrecompiledDocuments::open(
+    const std::string& path) {
+  using DocumentsResult = Result<PrecompiledDocuments, std::string>;
+
+  const auto fail = [&](const std::string& reason) {
+    return DocumentsResult::Err("Could not load '" + path + "': " + reason +
+                                ".");
+  };
+
+  if constexpr (std::endian::native != std::endian::little) {
+    return fail("precompiled files are only read on little-endian machines");
+  }
+
+  Result<io::MappedFile, std::string> file_result = io::MappedFile::open(path);
+
+  if (!file_result.IsOk()) {
+    return DocumentsResult::Err(file_result.UnwrapErr());
+  }
+
+  PrecompiledDocuments documents = PrecompiledDocuments(file_result.Unwrap());
+  const std::string_view contents = documents.file_.get_contents();
+
+  if (contents.size() < sizeof(FileHeader) ||
+      std::memcmp(contents.data(), MAGIC, sizeof(MAGIC)) != 0) {
+    return fail("it is not a precompiled file");
+  }
+
+  if (reinterpret_cast<uintptr_t>(contents.data()) %
+          precompiled::SECTION_ALIGNMENT !=
+      0) {
+    return fail("its contents are not aligned");
+  }
+
+  const auto& header = *reinterpret_cast<const FileHeader*>(contents.data());
+
+  if (header.version_ != PRECOMPILED_FORMAT_VERSION) {
+    return fail("its format version is " + std::to_string(header.version_) +
+                " instead of " + std::to_string(PRECOMPILED_FORMAT_VERSION));
+  }
+
+  // Every section has to lie within the file, and start aligned.
+  const auto is_within_file = [&](const uint64_t offset, const uint64_t count,
+                                  const size_t record_size) {
+    return offset % precompiled::SECTION_ALIGNMENT == 0 &&
+           offset <= contents.size() &&
+           count <= (contents.size() - offset) / record_size;
+  };
+
+  if (header.file_size_ != contents.size() ||
+      !is_within_file(header.documents_offset_, header.document_count_,
+                      sizeof(DocumentRecord)) ||
+      !is_within_file(header.strings_offset_, header.strings_size_, 1) ||
+      !is_within_file(header.tokens_offset_, header.token_count_,
+                      sizeof(TokenRecord)) ||
+      !is_within_file(header.nodes_offset_, header.node_count_,
+                      sizeof(NodeRecord)) ||
+      !is_within_file(header.children_offset_, header.child_count_,
+                      sizeof(uint32_t))) {
+    return fail("it is truncated or corrupt");
+  }
+
+  const char* data = contents.data();
+  documents.documents_ = std::span(
+      reinterpret_cast<const DocumentRecord*>(data + header.documents_offset_),
+      header.document_count_);
+  documents.strings_ = contents.substr(header.strings_offset_,
+                                       header.strings_size_);
+  documents.tokens_ = std::span(
+      reinterpret_cast<const TokenRecord*>(data + header.tokens_offset_),
+      header.token_count_);
+  documents.nodes_ = std::span(
+      reinterpret_cast<const NodeRecord*>(data + header.nodes_offset_),
+      header.node_count_);
+  documents.children_ = std::span(
+      reinterpret_cast<const uint32_t*>(data + header.children_offset_),
+      header.child_count_);
+
+  // Records are only checked against the sections, which keeps loading
+  // proportional to the amount of documents. Their nodes are checked as
+  // they are materialized.
+  for (const DocumentRecord& record : documents.documents_) {
+    if (record.source_offset_ > header.strings_size_ ||
+        record.source_size_ > header.strings_size_ - record.source_offset_ ||
+        record.name_offset_ > header.strings_size_ ||
+        record.name_size_ > header.strings_size_ - record.name_offset_ ||
+        static_cast<uint64_t>(record.first_token_) + record.token_count_ >
+            header.token_count_ ||
+        record.node_count_ == 0 ||
+        static_cast<uint64_t>(record.first_node_) + record.node_count_ >
+            header.node_count_) {
+      return fail("it has a document out of bounds");
+    }
+  }
+
+  return DocumentsResult::Ok(std::move(documents));
+}
+
+std::optional<PrecompiledDocument> PrecompiledDocuments::find(
+    const Sha256Digest& digest) const {
+  const auto it = std::lower_bound(
+      documents_.begin(), documents_.end(), digest,
+      [](const DocumentRecord& record, const Sha256Digest& value) {
+        return record.digest_ < value;
+      });
+
+  if (it == documents_.end() || it->digest_ != digest) {
+    return std::nullopt;
+  }
+
+  return PrecompiledDocument(*this, *it);
+}
+
+std::optional<PrecompiledDocument> PrecompiledDocuments::find(
+    const std::string_view sha256_hex) const {
+  const std::optional<Sha256Digest> digest = parse_sha256_hex(sha256_hex);
+
+  return digest.has_value() ? find(*digest) : std::nullopt;
+}
+
+Result<std::string, std::string> precompile_documents(
+    const std::span<const DocumentSource> documents) {
+  using PrecompileResult = Result<std::string, std::string>;
+
+  std::vector<DocumentRecord> records;
+  std::string strings;
+  std::vector<TokenRecord> tokens;
+  std::vector<NodeRecord> nodes;
+  std::vector<uint32_t> children;
+  records.reserve(documents.size());
+
+  for (const DocumentSource& document : documents) {
+    const std::string& source = document.source_;
+    language::tokenization::TokenBuffer buffer;
+    Result<size_t, language::tokenization::TokenizeError> tokenize_result =
+        language::tokenization::tokenize<
+            language::tokenization::SIGNIFICANT_TOKENS_POLICY>(source, buffer);
+
+    if (!tokenize_result.IsOk()) {
+      return PrecompileResult::Err(
+          "Detected an invalid document '" + document.name_ + "': " +
+          parsing::ParseError(tokenize_result.UnwrapErr()).get_message());
+    }
+
+    parsing::Arena arena;
+    Result<const parsing::Document*, parsing::ParseError> parse_result =
+        parsing::parse(source, buffer, arena);
+
+    if (!parse_result.IsOk()) {
+      return PrecompileResult::Err("Detected an invalid document '" +
+                                   document.name_ + "': " +
+                                   parse_result.UnwrapErr().get_message());
+    }
+
+    std::string canonical_text;
+    language::normalization::normalize(
+        source, buffer, language::normalization::NormalizeOptions(),
+        canonical_text);
+    const language::normalization::QuerySignature signature =
+        language::normalization::compute_signature(canonical_text);
+
+    DocumentRecord record = DocumentRecord();
+    record.digest_ = sha256(source);
+    record.signature_low_ = signature.low_;
+    record.signature_high_ = signature.high_;
+    record.source_offset_ = strings.size();
+    record.source_size_ = static_cast<uint32_t>(source.size());
+    strings += source;
+    record.name_offset_ = strings.size();
+    record.name_size_ = static_cast<uint32_t>(document.name_.size());
+    strings += document.name_;
+    record.first_token_ = static_cast<uint32_t>(tokens.size());
+    record.token_count_ = static_cast<uint32_t>(buffer.size());
+
+    for (size_t i = 0; i < buffer.size(); i++) {
+      tokens.push_back(TokenRecord{
+          .offset_ = static_cast<uint32_t>(buffer.get_offset(i)),
+          .length_ = static_cast<uint32_t>(buffer.get_length(i)),
+          .type_ = static_cast<uint8_t>(buffer.get_type(i)),
+          .is_escaped_ = buffer.is_escaped(i),
+          .padding_ = 0});
+    }
+
+    record.first_node_ = static_cast<uint32_t>(nodes.size());
+    NodeEncoder(source, nodes, children).encode(*parse_result.Unwrap());
+    record.node_count_ = static_cast<uint32_t>(nodes.size()) -
+                         record.first_node_;
+    records.push_back(record);
+
+    // Indices are 32 bits wide, which is plenty for persisted queries, but
+    // not for arbitrary input.
+    constexpr uint64_t MAXIMUM_INDEX = std::numeric_limits<uint32_t>::max();
+
+    if (source.size() > MAXIMUM_INDEX ||
+        document.name_.size() > MAXIMUM_INDEX ||
+        tokens.size() > MAXIMUM_INDEX || nodes.size() > MAXIMUM_INDEX ||
+        children.size() > MAXIMUM_INDEX) {
+      return PrecompileResult::Err(
+          "Detected too many documents to be precompiled together, at '" +
+          document.name_ + "'.");
+    }
+  }
+
+  // Records are sorted by digest so they can be searched in place. Documents
+  // with the same source text keep the first record.
+  std::stable_sort(records.begin(), records.end(),
+                   [](const DocumentRecord& a, const DocumentRecord& b) {
+                     return a.digest_ < b.digest_;
+                   });
+  records.erase(std::unique(records.begin(), records.end(),
+                            [](const DocumentRecord& a,
+                               const DocumentRecord& b) {
+                              return a.digest_ == b.digest_;
+                            }),
+                records.end());
+
+  FileHeader header = FileHeader();
+  std::memcpy(header.magic_, MAGIC, sizeof(MAGIC));
+  header.version_ = PRECOMPILED_FORMAT_VERSION;
+  header.document_count_ = static_cast<uint32_t>(records.size());
+  std::string output(sizeof(FileHeader), '\0');
+  header.documents_offset_ = append_section(records, output);
+  output.resize(align_section(output.size()));
+  header.strings_offset_ = output.size();
+  header.strings_size_ = strings.size();
+  output += strings;
+  header.tokens_offset_ = append_section(tokens, output);
+  header.token_count_ = tokens.size();
+  header.nodes_offset_ = append_section(nodes, output);
+  header.node_count_ = nodes.size();
+  header.children_offset_ = append_section(children, output);
+  header.child_count_ = children.size();
+  header.file_size_ = output.size();
+  std::memcpy(output.data(), &header, sizeof(header));
+
+  return PrecompileResult::Ok(std::move(output));
+}
+
+Result<size_t, std::string> precompile_directory(const std::string& directory,
+                                                 const std::string& path) {
+  using DirectoryResult = Result<size_t, std::string>;
+
+  std::vector<std::filesystem::path> paths;
+  std::error_code error;
+
+  for (auto it =
+           std::filesystem::recursive_directory_iterator(directory, error);
+       !error && it != std::filesystem::recursive_directory_iterator();
+       it.increment(error)) {
+    if (it->is_regular_file() && it->path().extension() == ".graphql") {
+      paths.push_back(it->path());
+    }
+  }
+
+  if (error) {
+    return DirectoryResult::Err("Could not list '" + directory +
+                                "': " + error.message() + ".");
+  }
+
+  // Files are sorted so that the same directory always gives the same file.
+  std::sort(paths.begin(), paths.end());
+  std::vector<DocumentSource> documents;
+  documents.reserve(paths.size());
+
+  for (const std::filesystem::path& file_path : paths) {
+    Result<std::string, std::string> r = read_file(file_path);
+
+    if (!r.IsOk()) {
+      return DirectoryResult::Err(r.UnwrapErr());
+    }
+
+    documents.push_back(DocumentSource{
+        .name_ = file_path.lexically_relative(directory).generic_string(),
+        .source_ = r.Unwrap()});
+  }
+
+  Result<std::string, std::string> precompile_result =
+      precompile_documents(documents);
+
+  if (!precompile_result.IsOk()) {
+    return DirectoryResult::Err(precompile_result.UnwrapErr());
+  }
+
+  const std::string contents = precompile_result.Unwrap();
+  std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+  stream.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+  stream.close();
+
+  if (!stream) {
+    return DirectoryResult::Err("Could not write '" + path + "'.");
+  }
+
+  return DirectoryResult::Ok(documents.size());
+}
+}  // namespace graphqlpp::caching
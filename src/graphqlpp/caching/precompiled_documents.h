@@ -0,0 +1,211 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef PRECOMPILED_DOCUMENTS_H
+#define PRECOMPILED_DOCUMENTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "../io/mapped_file.h"
+#include "../language/normalization/signature.h"
+#include "../language/parsing/arena.h"
+#include "../language/parsing/ast.h"
+#include "../result.h"
+#include "sha256.h"
+
+namespace graphqlpp::caching {
+/// \brief Version of the precompiled format written by this library. Files
+/// of any other version are rejected.
+constexpr uint32_t PRECOMPILED_FORMAT_VERSION = 1;
+
+namespace precompiled {
+/// \brief Every section starts at a multiple of this, so records are read in
+/// place.
+constexpr size_t SECTION_ALIGNMENT = 8;
+
+struct FileHeader {
+  char magic_[8];
+  uint32_t version_;
+  uint32_t document_count_;
+  uint64_t file_size_;
+  /// \brief <i>DocumentRecord</i>s, sorted by digest.
+  uint64_t documents_offset_;
+  /// \brief Names and source texts of the documents.
+  uint64_t strings_offset_;
+  uint64_t strings_size_;
+  uint64_t tokens_offset_;
+  uint64_t token_count_;
+  uint64_t nodes_offset_;
+  uint64_t node_count_;
+  /// \brief Indices of the children of every node.
+  uint64_t children_offset_;
+  uint64_t child_count_;
+};
+
+struct DocumentRecord {
+  Sha256Digest digest_;
+  /// \brief Signature of the document's canonical form, without replacing
+  /// its literals.
+  uint64_t signature_low_;
+  uint64_t signature_high_;
+  uint64_t source_offset_;
+  uint64_t name_offset_;
+  uint32_t source_size_;
+  uint32_t name_size_;
+  uint32_t first_token_;
+  uint32_t token_count_;
+  /// \brief Index of the document's root node, which is followed by the rest
+  /// of its nodes.
+  uint32_t first_node_;
+  uint32_t node_count_;
+};
+
+/// \brief Lexical token, whose offset is relative to its document's source.
+struct TokenRecord {
+  uint32_t offset_;
+  uint32_t length_;
+  uint8_t type_;
+  uint8_t is_escaped_;
+  uint16_t padding_;
+};
+
+/// \brief AST node, whose pointers and spans are replaced by groups of
+/// children and whose views are ranges of its document's source.
+///
+/// Each kind of node gives its own meaning to the two ranges and the three
+/// groups, e.g. a field keeps its alias and name in the ranges, and its
+/// arguments, directives and selection set in the groups.
+struct NodeRecord {
+  uint8_t kind_;
+  /// \brief Operation type, boolean value, or whether a string is a block
+  /// string (bit 0) and escaped (bit 1).
+  uint8_t flags_;
+  uint16_t padding_;
+  uint32_t offset_;
+  uint32_t range_offsets_[2];
+  uint32_t range_sizes_[2];
+  /// \brief Index of the first child, within the children section. The
+  /// groups follow each other.
+  uint32_t first_child_;
+  uint32_t group_sizes_[3];
+};
+}  // namespace precompiled
+
+class PrecompiledDocuments;
+
+/// \brief Named source text of a document to be precompiled.
+struct DocumentSource {
+  std::string name_;
+  std::string source_;
+};
+
+/// \brief Document stored within a precompiled file. It is a view over the
+/// <i>PrecompiledDocuments</i>, which must outlive it and stay in place.
+class PrecompiledDocument {
+ public:
+  PrecompiledDocument(const PrecompiledDocuments& documents,
+                      const precompiled::DocumentRecord& record)
+      : documents_(&documents), record_(&record) {}
+
+  /// \brief Name the document was precompiled with, such as its path.
+  [[nodiscard]] std::string_view get_name() const;
+
+  [[nodiscard]] std::string_view get_source() const;
+
+  /// \brief SHA-256 digest of the source text, as used by persisted queries.
+  [[nodiscard]] const Sha256Digest& get_digest() const {
+    return record_->digest_;
+  }
+
+  /// \brief Signature of the document's canonical form.
+  [[nodiscard]] language::normalization::QuerySignature get_signature()
+      const {
+    return {.low_ = record_->signature_low_,
+            .high_ = record_->signature_high_};
+  }
+
+  /// \brief Lexical tokens of the source, read in place.
+  [[nodiscard]] std::span<const precompiled::TokenRecord> get_tokens() const;
+
+  /// \brief Builds the document's AST within an arena, which takes a single
+  /// pass over its nodes, without tokenizing nor parsing the source. The
+  /// nodes refer to the source text within the file.
+  /// \return The document's root node, or a message describing why the file
+  /// is corrupt.
+  [[nodiscard]] Result<const language::parsing::Document*, std::string>
+  materialize(language::parsing::Arena& arena) const;
+
+ private:
+  const PrecompiledDocuments* documents_;
+  const precompiled::DocumentRecord* record_;
+};
+
+/// \brief Read-only file of precompiled documents, as written by
+/// <i>precompile_documents</i>, which is memory-mapped and read in place.
+///
+/// Opening a file only validates its header and the bounds of its document
+/// records: loading tens of thousands of persisted queries costs as much as
+/// mapping the file, however large their source texts are. Lookups by digest
+/// are binary searches over the records, and the AST of a document is only
+/// built once asked for.
+class PrecompiledDocuments {
+ public:
+  static Result<PrecompiledDocuments, std::string> open(
+      const std::string& path);
+
+  [[nodiscard]] size_t size() const { return documents_.size(); }
+
+  [[nodiscard]] PrecompiledDocument operator[](const size_t i) const {
+    return {*this, documents_[i]};
+  }
+
+  /// \brief Looks up a document by the SHA-256 digest of its source text.
+  [[nodiscard]] std::optional<PrecompiledDocument> find(
+      const Sha256Digest& digest) const;
+
+  /// \brief Looks up a document by the hexadecimal SHA-256 digest of its
+  /// source text, as sent by Automatic Persisted Queries clients.
+  [[nodiscard]] std::optional<PrecompiledDocument> find(
+      std::string_view sha256_hex) const;
+
+ private:
+  io::MappedFile file_;
+  std::span<const precompiled::DocumentRecord> documents_;
+  std::string_view strings_;
+  std::span<const precompiled::TokenRecord> tokens_;
+  std::span<const precompiled::NodeRecord> nodes_;
+  std::span<const uint32_t> children_;
+
+  explicit PrecompiledDocuments(io::MappedFile file)
+      : file_(std::move(file)) {}
+
+  friend class PrecompiledDocument;
+  friend class NodeDecoder;
+};
+
+/// \brief Tokenizes and parses documents, and lays them out in the
+/// precompiled format.
+/// \param documents Documents to be precompiled. Documents with the same
+/// source text are stored once.
+/// \return Contents of the precompiled file, or a message naming the first
+/// document which could not be parsed.
+Result<std::string, std::string> precompile_documents(
+    std::span<const DocumentSource> documents);
+
+/// \brief Precompiles every ".graphql" file found within a directory and its
+/// subdirectories into a single file.
+/// \param directory Directory to be searched. Documents are named after
+/// their path relative to it.
+/// \param path Path of the precompiled file to be written.
+/// \return Amount of files precompiled, or a message describing why they
+/// could not be.
+Result<size_t, std::string> precompile_directory(const std::string& directory,
+                                                 const std::string& path);
+}  // namespace graphqlpp::caching
+
+#endif  // PRECOMPILED_DOCUMENTS_H
@@ -0,0 +1,192 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "sha256.h"
+
+#include <cstring>
+
+namespace graphqlpp::caching {
+namespace {
+constexpr size_t BLOCK_SIZE = 64;
+constexpr size_t LENGTH_SIZE = 8;
+
+constexpr std::array<uint32_t, 64> ROUND_CONSTANTS = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+constexpr std::array<uint32_t, 8> INITIAL_STATE = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+uint32_t rotate_right(const uint32_t value, const int bits) {
+  return (value >> bits) | (value << (32 - bits));
+}
+
+void compress(std::array<uint32_t, 8>& state, const uint8_t* block) {
+  std::array<uint32_t, 64> w{};
+
+  for (size_t i = 0; i < 16; i++) {
+    w[i] = static_cast<uint32_t>(block[4 * i]) << 24 |
+           static_cast<uint32_t>(block[4 * i + 1]) << 16 |
+           static_cast<uint32_t>(block[4 * i + 2]) << 8 |
+           static_cast<uint32_t>(block[4 * i + 3]);
+  }
+
+  for (size_t i = 16; i < 64; i++) {
+    const uint32_t s0 = rotate_right(w[i - 15], 7) ^
+                        rotate_right(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    const uint32_t s1 = rotate_right(w[i - 2], 17) ^
+                        rotate_right(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = state[0];
+  uint32_t b = state[1];
+  uint32_t c = state[2];
+  uint32_t d = state[3];
+  uint32_t e = state[4];
+  uint32_t f = state[5];
+  uint32_t g = state[6];
+  uint32_t h = state[7];
+
+  for (size_t i = 0; i < 64; i++) {
+    const uint32_t s1 =
+        rotate_right(e, 6) ^ rotate_right(e, 11) ^ rotate_right(e, 25);
+    const uint32_t choice = (e & f) ^ (~e & g);
+    const uint32_t t1 = h + s1 + choice + ROUND_CONSTANTS[i] + w[i];
+    const uint32_t s0 =
+        rotate_right(a, 2) ^ rotate_right(a, 13) ^ rotate_right(a, 22);
+    const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+    const uint32_t t2 = s0 + majority;
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+int parse_hex_digit(const char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+
+  return -1;
+}
+}  // namespace
+
+Sha256Digest sha256(const std::string_view data) {
+  std::array<uint32_t, 8> state = INITIAL_STATE;
+  const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+  const size_t full_blocks = data.size() / BLOCK_SIZE;
+
+  for (size_t i = 0; i < full_blocks; i++) {
+    compress(state, bytes + i * BLOCK_SIZE);
+  }
+
+  // The remaining bytes are padded with a single set bit, zeroes and the
+  // message's length in bits, which may take one or two more blocks.
+  std::array<uint8_t, 2 * BLOCK_SIZE> tail{};
+  const size_t remaining = data.size() - full_blocks * BLOCK_SIZE;
+
+  if (remaining > 0) {
+    std::memcpy(tail.data(), bytes + full_blocks * BLOCK_SIZE, remaining);
+  }
+
+  tail[remaining] = 0x80;
+
+  const size_t tail_size =
+      remaining + 1 + LENGTH_SIZE <= BLOCK_SIZE ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+  const uint64_t bit_length = static_cast<uint64_t>(data.size()) * 8;
+
+  for (size_t i = 0; i < LENGTH_SIZE; i++) {
+    tail[tail_size - 1 - i] = static_cast<uint8_t>(bit_length >> (8 * i));
+  }
+
+  for (size_t i = 0; i < tail_size; i += BLOCK_SIZE) {
+    compress(state, tail.data() + i);
+  }
+
+  Sha256Digest digest{};
+
+  for (size_t i = 0; i < state.size(); i++) {
+    digest[4 * i] = static_cast<uint8_t>(state[i] >> 24);
+    digest[4 * i + 1] = static_cast<uint8_t>(state[i] >> 16);
+    digest[4 * i + 2] = static_cast<uint8_t>(state[i] >> 8);
+    digest[4 * i + 3] = static_cast<uint8_t>(state[i]);
+  }
+
+  return digest;
+}
+
+std::string to_hex(const Sha256Digest& digest) {
+  constexpr char HEX_DIGITS[] = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(2 * digest.size());
+
+  for (const uint8_t byte : digest) {
+    hex.push_back(HEX_DIGITS[byte >> 4]);
+    hex.push_back(HEX_DIGITS[byte & 0x0F]);
+  }
+
+  return hex;
+}
+
+std::optional<Sha256Digest> parse_sha256_hex(const std::string_view hex) {
+  if (hex.size() != 2 * SHA256_DIGEST_SIZE) {
+    return std::nullopt;
+  }
+
+  Sha256Digest digest{};
+
+  for (size_t i = 0; i < digest.size(); i++) {
+    const int high = parse_hex_digit(hex[2 * i]);
+    const int low = parse_hex_digit(hex[2 * i + 1]);
+
+    if (high < 0 || low < 0) {
+      return std::nullopt;
+    }
+
+    digest[i] = static_cast<uint8_t>(high << 4 | low);
+  }
+
+  return digest;
+}
+
+size_t Sha256DigestHash::operator()(const Sha256Digest& digest) const {
+  // The digest is already uniformly distributed, so any of its words works.
+  size_t hash = 0;
+  std::memcpy(&hash, digest.data(), sizeof(hash));
+
+  return hash;
+}
+}  // namespace graphqlpp::caching
@@ -0,0 +1,35 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace graphqlpp::caching {
+constexpr size_t SHA256_DIGEST_SIZE = 32;
+
+using Sha256Digest = std::array<std::uint8_t, SHA256_DIGEST_SIZE>;
+
+/// \brief SHA-256 digest of the given bytes, as used by Automatic Persisted
+/// Queries to identify a query.
+Sha256Digest sha256(std::string_view data);
+
+/// \brief Lowercase hexadecimal representation of a digest.
+std::string to_hex(const Sha256Digest& digest);
+
+/// \brief Parses the hexadecimal representation of a digest, in either case.
+/// \return The digest, or <i>std::nullopt</i> if the text is not a valid
+/// representation.
+std::optional<Sha256Digest> parse_sha256_hex(std::string_view hex);
+
+struct Sha256DigestHash {
+  size_t operator()(const Sha256Digest& digest) const;
+};
+}  // namespace graphqlpp::caching
+
+#endif  // SHA256_H
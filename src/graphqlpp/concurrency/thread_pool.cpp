@@ -0,0 +1,125 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace graphqlpp::concurrency {
+namespace {
+/// \brief Pool whose worker is running on this thread, if any.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+}  // namespace
+
+ThreadPool::ThreadPool(const size_t thread_count) {
+  const size_t worker_count = std::max<size_t>(thread_count, 1);
+  threads_.reserve(worker_count);
+  queues_.reserve(worker_count);
+
+  for (size_t i = 0; i < worker_count; i++) {
+    queues_.push_back(std::make_unique<TaskQueue>());
+  }
+
+  for (size_t i = 0; i < worker_count; i++) {
+    threads_.emplace_back([this, i]() { run_worker(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(mutex_);
+    is_stopping_ = true;
+  }
+
+  condition_.notify_all();
+
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+void ThreadPool::post(std::function<void()> task) {
+  if (current_pool == this) {
+    push(*queues_[current_worker], std::move(task));
+  } else {
+    push(shared_queue_, std::move(task));
+  }
+}
+
+void ThreadPool::push(TaskQueue& queue, std::function<void()> task) {
+  {
+    std::lock_guard lock(queue.mutex_);
+    queue.tasks_.push_back(std::move(task));
+    pending_count_++;
+  }
+
+  // A worker counts itself as sleeping before checking the pending count,
+  // and both counters are sequentially consistent, so either the worker
+  // sees the task or the task sees the worker.
+  if (sleeping_count_ > 0) {
+    { std::lock_guard lock(mutex_); }
+
+    condition_.notify_one();
+  }
+}
+
+bool ThreadPool::pop(const size_t worker, std::function<void()>& task) {
+  {
+    TaskQueue& own_queue = *queues_[worker];
+    std::lock_guard lock(own_queue.mutex_);
+
+    if (!own_queue.tasks_.empty()) {
+      task = std::move(own_queue.tasks_.back());
+      own_queue.tasks_.pop_back();
+      pending_count_--;
+
+      return true;
+    }
+  }
+
+  const size_t queue_count = queues_.size();
+
+  for (size_t i = 0; i < queue_count; i++) {
+    TaskQueue& queue =
+        i == 0 ? shared_queue_ : *queues_[(worker + i) % queue_count];
+    std::lock_guard lock(queue.mutex_);
+
+    if (!queue.tasks_.empty()) {
+      task = std::move(queue.tasks_.front());
+      queue.tasks_.pop_front();
+      pending_count_--;
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ThreadPool::run_worker(const size_t worker) {
+  current_pool = this;
+  current_worker = worker;
+
+  std::function<void()> task;
+
+  while (true) {
+    if (pop(worker, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock lock(mutex_);
+    sleeping_count_++;
+    condition_.wait(
+        lock, [this]() { return is_stopping_ || pending_count_ > 0; });
+    sleeping_count_--;
+
+    // Workers only queue tasks on their own queue, so once nothing is
+    // pending, a stopping pool has nothing left to run.
+    if (is_stopping_ && pending_count_ == 0) {
+      return;
+    }
+  }
+}
+}  // namespace graphqlpp::concurrency
@@ -0,0 +1,92 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace graphqlpp::concurrency {
+/// \brief Fixed set of worker threads with a queue each, which steal tasks
+/// from one another when their own queue runs dry.
+///
+/// Tasks queued from outside the pool go to a shared queue and are run in
+/// submission order. Tasks queued by a worker go to its own queue and are
+/// run most recent first, while their data is still cached, unless another
+/// worker steals them, oldest first. Pending tasks are still run when the
+/// pool is destroyed.
+class ThreadPool {
+ public:
+  /// \param thread_count Amount of worker threads, at least one.
+  explicit ThreadPool(
+      size_t thread_count = std::thread::hardware_concurrency());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// \brief Queues a task to be run by a worker thread.
+  /// \param task Callable without parameters.
+  /// \return Future which receives the task's value, or its exception.
+  template <typename Task>
+  std::future<std::invoke_result_t<Task>> submit(Task task) {
+    using ValueType = std::invoke_result_t<Task>;
+
+    // std::function requires copyable callables, so the packaged task is
+    // shared with the queued closure.
+    auto packaged_task =
+        std::make_shared<std::packaged_task<ValueType()>>(std::move(task));
+    std::future<ValueType> future = packaged_task->get_future();
+
+    post([packaged_task]() { (*packaged_task)(); });
+
+    return future;
+  }
+
+  /// \brief Queues a task whose completion nobody waits for, without the
+  /// shared state of a future.
+  /// \param task Callable without parameters. It must not throw.
+  void post(std::function<void()> task);
+
+  [[nodiscard]] size_t get_thread_count() const { return threads_.size(); }
+
+ private:
+  struct TaskQueue {
+    std::mutex mutex_;
+    std::deque<std::function<void()>> tasks_;
+  };
+
+  std::vector<std::thread> threads_;
+  /// \brief Queue of every worker, indexed like <i>threads_</i>.
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  /// \brief Tasks queued from outside the pool.
+  TaskQueue shared_queue_;
+  /// \brief Tasks queued and not taken yet. It only changes while the queue
+  /// holding the task is locked, so it never underflows.
+  std::atomic<size_t> pending_count_ = 0;
+  /// \brief Workers waiting for tasks, which are only woken up when there
+  /// is any.
+  std::atomic<size_t> sleeping_count_ = 0;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool is_stopping_ = false;
+
+  void push(TaskQueue& queue, std::function<void()> task);
+
+  /// \brief Takes a task from the worker's own queue, then from the shared
+  /// queue and then from the queues of the other workers.
+  bool pop(size_t worker, std::function<void()>& task);
+
+  void run_worker(size_t worker);
+};
+}  // namespace graphqlpp::concurrency
+
+#endif  // THREAD_POOL_H
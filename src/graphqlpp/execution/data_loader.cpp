@@ -0,0 +1,102 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "data_loader.h"
+
+#include <exception>
+#include <string>
+
+namespace graphqlpp::execution {
+std::vector<FieldResult> DataLoader::LoadManyAwaiter::await_resume() const {
+  std::vector<FieldResult> results;
+  results.reserve(entries_.size());
+
+  for (const Entry* entry : entries_) {
+    results.push_back(*entry->result_);
+  }
+
+  return results;
+}
+
+Task<void> DataLoader::dispatch() {
+  std::vector<Value> keys;
+  std::vector<Entry*> entries;
+
+  {
+    std::lock_guard lock(mutex_);
+    keys.reserve(pending_.size());
+    entries.reserve(pending_.size());
+
+    for (const auto& [key, entry] : pending_) {
+      keys.push_back(*key);
+      entries.push_back(entry);
+    }
+
+    pending_.clear();
+  }
+
+  std::optional<std::string> error;
+  std::vector<FieldResult> results;
+
+  try {
+    results = co_await batch_function_(keys);
+  } catch (const std::exception& e) {
+    error = e.what();
+  }
+
+  if (!error.has_value() && results.size() != keys.size()) {
+    error = "Detected a batch function which returned " +
+            std::to_string(results.size()) + " values for " +
+            std::to_string(keys.size()) + " keys.";
+  }
+
+  std::vector<std::coroutine_handle<>> ready_coroutines;
+
+  {
+    std::lock_guard lock(mutex_);
+
+    for (size_t i = 0; i < entries.size(); i++) {
+      entries[i]->result_ = error.has_value() ? FieldResult::Err(*error)
+                                              : std::move(results[i]);
+
+      for (Waiter* waiter : entries[i]->waiters_) {
+        if (--waiter->remaining_count_ == 0) {
+          ready_coroutines.push_back(waiter->coroutine_);
+        }
+      }
+
+      entries[i]->waiters_ = std::vector<Waiter*>();
+    }
+  }
+
+  for (const std::coroutine_handle<> coroutine : ready_coroutines) {
+    scheduler_.schedule(coroutine);
+  }
+}
+
+bool DataLoader::wait(const std::span<Value> keys,
+                      const std::span<const Entry*> entries, Waiter& waiter) {
+  std::lock_guard lock(mutex_);
+
+  for (size_t i = 0; i < keys.size(); i++) {
+    auto [it, is_new] = entries_.try_emplace(std::move(keys[i]));
+    entries[i] = &it->second;
+
+    if (it->second.result_.has_value()) {
+      continue;
+    }
+
+    waiter.remaining_count_++;
+    it->second.waiters_.push_back(&waiter);
+
+    if (is_new) {
+      if (pending_.empty()) {
+        scheduler_.add_pending_loader(*this);
+      }
+
+      pending_.emplace_back(&it->first, &it->second);
+    }
+  }
+
+  return waiter.remaining_count_ > 0;
+}
+}  // namespace graphqlpp::execution
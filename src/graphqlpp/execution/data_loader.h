@@ -0,0 +1,142 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef DATA_LOADER_H
+#define DATA_LOADER_H
+
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "scheduler.h"
+#include "task.h"
+#include "value.h"
+
+namespace graphqlpp::execution {
+/// \brief Loads a batch of keys from a backend through a single call.
+/// \return One result per key, in the order of the keys.
+using BatchFunction =
+    std::function<Task<std::vector<FieldResult>>(std::span<const Value>)>;
+
+/// \brief Batches and caches the loads of an execution, following the
+/// semantics of DataLoader: resolvers ask for keys, and the keys asked for
+/// while the execution is busy are loaded by a single call of the batch
+/// function once every coroutine is suspended. Each key is loaded once per
+/// execution, and later loads of it are answered from the cache.
+class DataLoader {
+ public:
+  /// \brief Coroutine waiting for the results of some keys.
+  struct Waiter {
+    std::coroutine_handle<> coroutine_;
+    /// \brief Keys whose result is still unknown.
+    size_t remaining_count_ = 0;
+  };
+
+  struct Entry {
+    std::optional<FieldResult> result_;
+    std::vector<Waiter*> waiters_;
+  };
+
+  /// \brief Awaitable returned by <i>load</i>, whose value is the key's
+  /// <i>FieldResult</i>. Cached keys are answered without suspending.
+  class LoadAwaiter {
+   public:
+    LoadAwaiter(DataLoader& loader, Value key)
+        : loader_(loader), key_(std::move(key)) {}
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(const std::coroutine_handle<> awaiter) {
+      waiter_.coroutine_ = awaiter;
+
+      return loader_.wait(std::span<Value>(&key_, 1),
+                          std::span<const Entry*>(&entry_, 1), waiter_);
+    }
+
+    /// \brief Results are never written again once set, so they are read
+    /// without locking.
+    [[nodiscard]] FieldResult await_resume() const {
+      return *entry_->result_;
+    }
+
+   private:
+    DataLoader& loader_;
+    Value key_;
+    const Entry* entry_ = nullptr;
+    Waiter waiter_;
+  };
+
+  /// \brief Awaitable returned by <i>load_many</i>, whose value holds the
+  /// <i>FieldResult</i> of each key.
+  class LoadManyAwaiter {
+   public:
+    LoadManyAwaiter(DataLoader& loader, std::vector<Value> keys)
+        : loader_(loader), keys_(std::move(keys)), entries_(keys_.size()) {}
+
+    [[nodiscard]] bool await_ready() const noexcept { return keys_.empty(); }
+
+    bool await_suspend(const std::coroutine_handle<> awaiter) {
+      waiter_.coroutine_ = awaiter;
+
+      return loader_.wait(keys_, entries_, waiter_);
+    }
+
+    [[nodiscard]] std::vector<FieldResult> await_resume() const;
+
+   private:
+    DataLoader& loader_;
+    std::vector<Value> keys_;
+    std::vector<const Entry*> entries_;
+    Waiter waiter_;
+  };
+
+  /// \param batch_function Function loading the batches, which must outlive
+  /// the loader.
+  /// \param scheduler Scheduler of the execution the loader belongs to.
+  DataLoader(const BatchFunction& batch_function, Scheduler& scheduler)
+      : batch_function_(batch_function), scheduler_(scheduler) {}
+
+  DataLoader(const DataLoader&) = delete;
+  DataLoader& operator=(const DataLoader&) = delete;
+
+  /// \brief Loads a key. It may only be awaited by coroutines run by the
+  /// loader's scheduler.
+  [[nodiscard]] LoadAwaiter load(Value key) { return {*this, std::move(key)}; }
+
+  /// \brief Loads several keys at once, so that they go into the same batch
+  /// instead of one batch each, as awaiting their loads one after another
+  /// would cause.
+  [[nodiscard]] LoadManyAwaiter load_many(std::vector<Value> keys) {
+    return {*this, std::move(keys)};
+  }
+
+  /// \brief Calls the batch function with the keys requested since the last
+  /// batch, and resumes the coroutines waiting for them. Errors of the batch
+  /// function become errors of each of its keys.
+  Task<void> dispatch();
+
+ private:
+  const BatchFunction& batch_function_;
+  Scheduler& scheduler_;
+  std::mutex mutex_;
+  /// \brief Entries are never moved by rehashing, so they are referred to by
+  /// address.
+  std::unordered_map<Value, Entry, ValueHash> entries_;
+  /// \brief Keys requested since the last batch.
+  std::vector<std::pair<const Value*, Entry*>> pending_;
+
+  /// \brief Registers a coroutine waiting for some keys, unless all of their
+  /// results are already known.
+  /// \param entries Receives the entry of each key.
+  /// \return Whether the coroutine has to suspend.
+  bool wait(std::span<Value> keys, std::span<const Entry*> entries,
+            Waiter& waiter);
+};
+}  // namespace graphqlpp::execution
+
+#endif  // DATA_LOADER_H
@@ -0,0 +1,74 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "execution_error.h"
+
+#include "json_writer.h"
+
+namespace graphqlpp::execution {
+std::string_view get_error_code_name(const ExecutionErrorCode code) {
+  switch (code) {
+    case OPERATION_NOT_FOUND:
+      return "OPERATION_NOT_FOUND";
+    case AMBIGUOUS_OPERATION:
+      return "AMBIGUOUS_OPERATION";
+    case UNSUPPORTED_OPERATION:
+      return "UNSUPPORTED_OPERATION";
+    case UNDEFINED_FIELD:
+      return "UNDEFINED_FIELD";
+    case RESOLVER_FAILED:
+      return "RESOLVER_FAILED";
+    case NULL_NON_NULL_FIELD:
+      return "NULL_NON_NULL_FIELD";
+    case INVALID_LIST_VALUE:
+      return "INVALID_LIST_VALUE";
+    case UNRESOLVED_ABSTRACT_TYPE:
+      return "UNRESOLVED_ABSTRACT_TYPE";
+    case RESOLVER_SUSPENDED:
+    default:
+      return "RESOLVER_SUSPENDED";
+  }
+}
+
+std::optional<std::vector<language::tokenization::Location>>
+ExecutionError::get_locations() const {
+  if (!location_.has_value()) {
+    return std::nullopt;
+  }
+
+  return std::vector<language::tokenization::Location>{*location_};
+}
+
+std::string ExecutionError::get_message() const {
+  switch (code_) {
+    case OPERATION_NOT_FOUND:
+      return text_.empty() ? "Detected a document without operations."
+                           : "Detected no operation named '" + text_ + "'.";
+    case AMBIGUOUS_OPERATION:
+      return "Detected several operations, but no operation name.";
+    case UNSUPPORTED_OPERATION:
+      return "Detected a " + text_ +
+             " operation, which cannot be executed against the schema.";
+    case UNDEFINED_FIELD:
+      return "Detected a query of undefined field '" + text_ + "'.";
+    case RESOLVER_FAILED:
+      return text_;
+    case NULL_NON_NULL_FIELD:
+      return "Detected a null value for non-null field '" + text_ + "'.";
+    case INVALID_LIST_VALUE:
+      return "Detected a value which is not a list for list field '" + text_ +
+             "'.";
+    case UNRESOLVED_ABSTRACT_TYPE:
+      return "Detected a value of field '" + text_ +
+             "' whose object type could not be resolved.";
+    case RESOLVER_SUSPENDED:
+    default:
+      return "Detected a resolver which suspended outside of the executor.";
+  }
+}
+
+void ExecutionError::write_json(std::string& output) const {
+  JsonWriter writer = JsonWriter(JsonWriter::ERROR_CHUNK_SIZE);
+  writer.write_error(*this);
+  output += writer.to_string();
+}
+}  // namespace graphqlpp::execution
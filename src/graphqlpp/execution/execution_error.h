@@ -0,0 +1,117 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef EXECUTION_ERROR_H
+#define EXECUTION_ERROR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "../language/tokenization/location.h"
+
+namespace graphqlpp::execution {
+enum ExecutionErrorCode : std::uint8_t {
+  /// \brief The document has no operation with the requested name.
+  OPERATION_NOT_FOUND,
+  /// \brief The document has several operations, and none was requested.
+  AMBIGUOUS_OPERATION,
+  /// \brief The operation is a subscription, or the schema has no root type
+  /// for it.
+  UNSUPPORTED_OPERATION,
+  UNDEFINED_FIELD,
+  /// \brief A resolver returned an error or threw.
+  RESOLVER_FAILED,
+  NULL_NON_NULL_FIELD,
+  /// \brief A list field was resolved to a value which is not a list.
+  INVALID_LIST_VALUE,
+  /// \brief The object type of an interface or union value is unknown.
+  UNRESOLVED_ABSTRACT_TYPE,
+  /// \brief A resolver suspended on something other than a loader or a
+  /// task, so the execution could not finish.
+  RESOLVER_SUSPENDED
+};
+
+/// \brief Name of an error code, as reported within the error's extensions.
+/// \param code Error code.
+/// \return Statically allocated name.
+std::string_view get_error_code_name(ExecutionErrorCode code);
+
+/// \brief Key of a field or index of a list item within a response.
+using PathSegment = std::variant<std::string, size_t>;
+
+/// \brief Error raised while executing an operation. Errors of a field keep
+/// the path of the field within the response besides its location, as the
+/// GraphQL specification asks for.
+class ExecutionError {
+ public:
+  /// \brief Error of the whole request, before any field was executed.
+  /// \param code What went wrong.
+  /// \param name Name of the offending operation, if any.
+  ExecutionError(const ExecutionErrorCode code, const std::string_view name)
+      : code_(code), text_(name) {}
+
+  /// \param code What went wrong.
+  /// \param text Message of the resolver if the code is
+  /// <i>RESOLVER_FAILED</i>, or the name of the offending field.
+  /// \param path Path of the field within the response.
+  /// \param offset Byte of the document where the field starts.
+  /// \param location Line and column of the offset, unless the source text
+  /// is unknown.
+  ExecutionError(
+      const ExecutionErrorCode code, const std::string_view text,
+      std::vector<PathSegment> path, const size_t offset,
+      const std::optional<language::tokenization::Location> location)
+      : code_(code),
+        text_(text),
+        path_(std::move(path)),
+        offset_(offset),
+        location_(location) {}
+
+  [[nodiscard]] ExecutionErrorCode get_code() const { return code_; }
+
+  /// \brief Path of the field within the response, which is empty for
+  /// errors of the whole request.
+  [[nodiscard]] const std::vector<PathSegment>& get_path() const {
+    return path_;
+  }
+
+  /// \brief Byte of the document where the field starts.
+  [[nodiscard]] size_t get_offset() const { return offset_; }
+
+  /// \brief Line and column where the field starts. Errors of the whole
+  /// request have none, nor do errors of fields if the source text was
+  /// unknown.
+  [[nodiscard]] const std::optional<language::tokenization::Location>&
+  get_location() const {
+    return location_;
+  }
+
+  /// \brief Locations of the error, as reported within a GraphQL response.
+  /// Errors of the whole request have none, nor do errors of fields if the
+  /// source text was unknown.
+  [[nodiscard]] std::optional<std::vector<language::tokenization::Location>>
+  get_locations() const;
+
+  /// \brief Formats the human-readable message of the error.
+  [[nodiscard]] std::string get_message() const;
+
+  /// \brief Appends the error as an entry of a GraphQL response's "errors"
+  /// list: its message, locations, path and extensions with the error code.
+  /// \param output String where the JSON object is appended.
+  void write_json(std::string& output) const;
+
+ private:
+  ExecutionErrorCode code_;
+  std::string text_;
+  std::vector<PathSegment> path_;
+  size_t offset_ = 0;
+  std::optional<language::tokenization::Location> location_;
+};
+}  // namespace graphqlpp::execution
+
+#endif  // EXECUTION_ERROR_H
@@ -0,0 +1,954 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <utility>
+
+#include "../instrumentation/metrics.h"
+#include "../language/parsing/arena.h"
+#include "../language/parsing/parser.h"
+#include "../language/tokenization/line_index.h"
+#include "../language/tokenization/string_value.h"
+#include "scheduler.h"
+
+namespace graphqlpp::execution {
+namespace parsing = language::parsing;
+
+namespace {
+/// \brief Converts a literal of the document into a value.
+/// \param variables Object holding the values of the variables, or null
+/// where variables are not allowed.
+Value to_value(const parsing::Value* node, const Value* variables) {
+  switch (node->kind_) {
+    case parsing::NodeKind::VARIABLE: {
+      const auto* variable = static_cast<const parsing::Variable*>(node);
+      const Value* value =
+          variables != nullptr ? variables->find(variable->name_) : nullptr;
+
+      return value != nullptr ? *value : Value();
+    }
+    case parsing::NodeKind::INT_VALUE: {
+      const std::string_view digits =
+          static_cast<const parsing::IntValue*>(node)->value_;
+      int64_t value = 0;
+      const auto r =
+          std::from_chars(digits.data(), digits.data() + digits.size(), value);
+
+      if (r.ec == std::errc()) {
+        return Value(value);
+      }
+
+      // Integers beyond 64 bits are kept as floats.
+      double float_value = 0;
+      std::from_chars(digits.data(), digits.data() + digits.size(),
+                      float_value);
+
+      return Value(float_value);
+    }
+    case parsing::NodeKind::FLOAT_VALUE: {
+      const std::string_view digits =
+          static_cast<const parsing::FloatValue*>(node)->value_;
+      double value = 0;
+      std::from_chars(digits.data(), digits.data() + digits.size(), value);
+
+      return Value(value);
+    }
+    case parsing::NodeKind::STRING_VALUE: {
+      const auto* string = static_cast<const parsing::StringValue*>(node);
+
+      if (!string->escaped_) {
+        return Value(string->raw_value_);
+      }
+
+      std::string value;
+
+      if (string->block_) {
+        language::tokenization::decode_block_string(string->raw_value_, value);
+      } else {
+        language::tokenization::decode_string(string->raw_value_, value);
+      }
+
+      return Value(std::move(value));
+    }
+    case parsing::NodeKind::BOOLEAN_VALUE:
+      return Value(static_cast<const parsing::BooleanValue*>(node)->value_);
+    case parsing::NodeKind::ENUM_VALUE:
+      return Value(static_cast<const parsing::EnumValue*>(node)->value_);
+    case parsing::NodeKind::LIST_VALUE: {
+      Value::List items;
+
+      for (const parsing::Value* item :
+           static_cast<const parsing::ListValue*>(node)->values_) {
+        items.push_back(to_value(item, variables));
+      }
+
+      return Value(std::move(items));
+    }
+    case parsing::NodeKind::OBJECT_VALUE: {
+      Value::Object members;
+
+      for (const parsing::ObjectField* field :
+           static_cast<const parsing::ObjectValue*>(node)->fields_) {
+        members.emplace_back(std::string(field->name_),
+                             to_value(field->value_, variables));
+      }
+
+      return Value(std::move(members));
+    }
+    case parsing::NodeKind::NULL_VALUE:
+    default:
+      return Value();
+  }
+}
+
+/// \brief Parses the default value of an argument, which the schema keeps as
+/// source text, as the argument of a field of a synthetic query.
+Value parse_default_value(const std::string_view text) {
+  const std::string source = "{f(a:" + std::string(text) + ")}";
+  parsing::Arena arena = parsing::Arena();
+  Result<const parsing::Document*, parsing::ParseError> r =
+      parsing::parse(source, arena);
+
+  if (!r.IsOk()) {
+    return Value();
+  }
+
+  const auto* operation = static_cast<const parsing::OperationDefinition*>(
+      r.Unwrap()->definitions_[0]);
+  const auto* field = static_cast<const parsing::Field*>(
+      operation->selection_set_->selections_[0]);
+
+  return to_value(field->arguments_[0]->value_, nullptr);
+}
+
+std::string_view get_operation_type_name(const parsing::OperationType type) {
+  switch (type) {
+    case parsing::OperationType::QUERY:
+      return "query";
+    case parsing::OperationType::MUTATION:
+      return "mutation";
+    case parsing::OperationType::SUBSCRIPTION:
+    default:
+      return "subscription";
+  }
+}
+}  // namespace
+
+const Value* ResolveInfo::get_argument(const std::string_view name) const {
+  for (const auto& [argument_name, argument_value] : arguments_) {
+    if (argument_name == name) {
+      return &argument_value;
+    }
+  }
+
+  return nullptr;
+}
+
+void ExecutionResult::write_json(std::string& output) const {
+  output += '{';
+
+  if (!errors_.empty()) {
+    output += "\"errors\":[";
+
+    for (size_t i = 0; i < errors_.size(); i++) {
+      if (i > 0) {
+        output += ',';
+      }
+
+      errors_[i].write_json(output);
+    }
+
+    output += ']';
+  }
+
+  if (data_.has_value()) {
+    if (!errors_.empty()) {
+      output += ',';
+    }
+
+    output += "\"data\":";
+    data_->write_json(output);
+  }
+
+  output += '}';
+}
+
+/// \brief State of a single execution of an operation.
+class Execution {
+ public:
+  Execution(const Executor& executor, const ExecutionRequest& request)
+      : executor_(executor),
+        schema_(executor.schema_),
+        request_(request),
+        scheduler_(executor.pool_) {
+    loaders_.reserve(executor.batch_functions_.size());
+
+    for (const BatchFunction& batch_function : executor.batch_functions_) {
+      loaders_.push_back(
+          std::make_unique<DataLoader>(batch_function, scheduler_));
+    }
+  }
+
+  ExecutionResult run();
+
+ private:
+  /// \brief Fields of a selection set sharing a response key, whose own
+  /// selection sets are merged.
+  struct CollectedField {
+    std::string_view response_key_;
+    std::vector<const parsing::Field*> fields_;
+  };
+
+  /// \brief Element of the path of a field within the response, linked to
+  /// its parent, so that paths are only copied when an error is reported.
+  struct PathNode {
+    const PathNode* parent_ = nullptr;
+    /// \brief Empty for list items.
+    std::string_view key_;
+    size_t index_ = 0;
+  };
+
+  const Executor& executor_;
+  const schema::Schema& schema_;
+  const ExecutionRequest& request_;
+  Scheduler scheduler_;
+  std::vector<std::unique_ptr<DataLoader>> loaders_;
+  std::unordered_map<std::string_view, const parsing::FragmentDefinition*>
+      fragments_;
+  Value variables_ = Value(Value::Object());
+  std::mutex errors_mutex_;
+  std::vector<ExecutionError> errors_;
+
+  /// \brief Finds the requested operation and indexes the fragments.
+  /// \return The operation, or null once the error has been added.
+  const parsing::OperationDefinition* find_operation();
+
+  /// \brief Takes the value of every variable from the request, or from its
+  /// default value.
+  void set_variables(const parsing::OperationDefinition& operation);
+
+  Task<void> execute_root(const parsing::OperationDefinition& operation,
+                          schema::TypeId type, Value& data,
+                          bool& is_finished);
+
+  /// \brief Executes the fields of an object.
+  /// \param is_serial Whether fields run one after another instead of
+  /// concurrently, as the root fields of mutations do.
+  /// \param output Value where the object is written.
+  /// \return False if a non-null field is null, which makes the object null.
+  Task<bool> execute_selection_sets(
+      std::span<const parsing::SelectionSet* const> selection_sets,
+      schema::TypeId type, const Value& source, const PathNode* path,
+      bool is_serial, Value& output);
+
+  /// \brief Resolves and completes a field.
+  /// \param is_complete Cleared if a non-null field is null.
+  Task<void> execute_field(Value& output, const CollectedField& field,
+                           schema::FieldId field_id, schema::TypeId type,
+                           const Value& source, const PathNode* path,
+                           std::atomic<bool>& is_complete);
+
+  /// \brief Completes the value of a field, or of one of its list items,
+  /// against its type.
+  /// \param depth Amount of lists the value is nested within.
+  /// \return False if the value is null where its type is non-null.
+  Task<bool> complete_value(Value& output, schema::TypeReference type,
+                            uint8_t depth, const CollectedField& field,
+                            Value value, const PathNode* path);
+
+  Task<void> complete_item(Value& output, schema::TypeReference type,
+                           uint8_t depth, const CollectedField& field,
+                           Value value, const PathNode* path,
+                           std::atomic<bool>& is_complete);
+
+  /// \brief Completes the value of a field whose named type is a leaf,
+  /// without suspending.
+  bool complete_leaf(Value& output, schema::TypeReference type, uint8_t depth,
+                     const CollectedField& field, Value value,
+                     const PathNode* path);
+
+  /// \brief Object type of a value of an abstract type.
+  /// \return The object type, or <i>INVALID_ID</i> if it is unknown.
+  [[nodiscard]] schema::TypeId resolve_object_type(schema::TypeId type,
+                                                   const Value& value) const;
+
+  void collect_fields(const parsing::SelectionSet& selection_set,
+                      schema::TypeId type,
+                      std::vector<CollectedField>& fields,
+                      std::vector<std::string_view>& spread_fragments) const;
+
+  /// \brief Evaluates the @skip and @include directives of a selection.
+  [[nodiscard]] bool is_included(
+      std::span<const parsing::Directive* const> directives) const;
+
+  [[nodiscard]] bool does_fragment_apply(
+      const parsing::NamedType* type_condition, schema::TypeId type) const;
+
+  [[nodiscard]] Value::Object get_arguments(schema::FieldId field_id,
+                                            const parsing::Field& field) const;
+
+  [[nodiscard]] bool is_leaf(const schema::TypeId type) const {
+    const schema::TypeKind kind = schema_.get_type(type).kind_;
+
+    return kind == schema::TypeKind::SCALAR || kind == schema::TypeKind::ENUM;
+  }
+
+  void add_error(ExecutionErrorCode code, std::string_view text,
+                 const CollectedField& field, const PathNode* path);
+};
+
+ExecutionResult Execution::run() {
+  ExecutionResult result;
+  const parsing::OperationDefinition* operation = find_operation();
+
+  if (operation == nullptr) {
+    result.errors_ = std::move(errors_);
+    return result;
+  }
+
+  schema::TypeId root_type = schema::INVALID_ID;
+
+  if (operation->operation_ == parsing::OperationType::QUERY) {
+    root_type = schema_.get_query_type();
+  } else if (operation->operation_ == parsing::OperationType::MUTATION) {
+    root_type = schema_.get_mutation_type();
+  }
+
+  if (root_type == schema::INVALID_ID) {
+    result.errors_.emplace_back(
+        UNSUPPORTED_OPERATION, get_operation_type_name(operation->operation_));
+    return result;
+  }
+
+  set_variables(*operation);
+
+  Value data;
+  bool is_finished = false;
+  scheduler_.spawn(execute_root(*operation, root_type, data, is_finished));
+  scheduler_.wait();
+
+  if (!is_finished) {
+    // The suspended coroutines still refer to the execution, so they are
+    // leaked rather than destroyed.
+    errors_.emplace_back(RESOLVER_SUSPENDED, std::string_view());
+    data = Value();
+  }
+
+  std::stable_sort(errors_.begin(), errors_.end(),
+                   [](const ExecutionError& a, const ExecutionError& b) {
+                     return a.get_path() < b.get_path();
+                   });
+
+  result.data_ = std::move(data);
+  result.errors_ = std::move(errors_);
+
+  return result;
+}
+
+const parsing::OperationDefinition* Execution::find_operation() {
+  const parsing::OperationDefinition* operation = nullptr;
+  size_t operation_count = 0;
+
+  for (const parsing::Definition* definition :
+       request_.document_->definitions_) {
+    if (definition->kind_ == parsing::NodeKind::FRAGMENT_DEFINITION) {
+      const auto* fragment =
+          static_cast<const parsing::FragmentDefinition*>(definition);
+      fragments_.emplace(fragment->name_, fragment);
+      continue;
+    }
+
+    const auto* candidate =
+        static_cast<const parsing::OperationDefinition*>(definition);
+
+    if (request_.operation_name_.empty() ||
+        candidate->name_ == request_.operation_name_) {
+      operation_count++;
+      operation = operation == nullptr ? candidate : operation;
+    }
+  }
+
+  if (operation == nullptr) {
+    errors_.emplace_back(OPERATION_NOT_FOUND, request_.operation_name_);
+  } else if (operation_count > 1) {
+    errors_.emplace_back(AMBIGUOUS_OPERATION, std::string_view());
+    operation = nullptr;
+  }
+
+  return operation;
+}
+
+void Execution::set_variables(const parsing::OperationDefinition& operation) {
+  Value::Object& variables = variables_.get_object();
+
+  for (const parsing::VariableDefinition* definition :
+       operation.variable_definitions_) {
+    const std::string_view name = definition->variable_->name_;
+
+    if (const Value* value = request_.variables_.find(name)) {
+      variables.emplace_back(std::string(name), *value);
+    } else if (definition->default_value_ != nullptr) {
+      variables.emplace_back(std::string(name),
+                             to_value(definition->default_value_, nullptr));
+    }
+  }
+}
+
+Task<void> Execution::execute_root(
+    const parsing::OperationDefinition& operation, const schema::TypeId type,
+    Value& data, bool& is_finished) {
+  const parsing::SelectionSet* selection_set = operation.selection_set_;
+  const bool is_serial =
+      operation.operation_ == parsing::OperationType::MUTATION;
+
+  // Awaited results are stored before being tested, since GCC 12 fails to
+  // start coroutines awaited within a negated condition.
+  const bool is_data_complete = co_await execute_selection_sets(
+      std::span<const parsing::SelectionSet* const>(&selection_set, 1), type,
+      request_.root_value_, nullptr, is_serial, data);
+
+  if (!is_data_complete) {
+    data = Value();
+  }
+
+  is_finished = true;
+}
+
+Task<bool> Execution::execute_selection_sets(
+    const std::span<const parsing::SelectionSet* const> selection_sets,
+    const schema::TypeId type, const Value& source, const PathNode* path,
+    const bool is_serial, Value& output) {
+  std::vector<CollectedField> fields;
+  std::vector<std::string_view> spread_fragments;
+
+  for (const parsing::SelectionSet* selection_set : selection_sets) {
+    collect_fields(*selection_set, type, fields, spread_fragments);
+  }
+
+  Value::Object members(fields.size());
+  std::vector<PathNode> nodes(fields.size());
+  std::vector<Task<void>> tasks;
+  std::atomic<bool> is_complete = true;
+
+  for (size_t i = 0; i < fields.size(); i++) {
+    const std::string_view name = fields[i].fields_[0]->name_;
+    members[i].first = fields[i].response_key_;
+    nodes[i] = PathNode{
+        .parent_ = path, .key_ = fields[i].response_key_, .index_ = 0};
+
+    if (name == "__typename") {
+      members[i].second =
+          Value(schema_.get_string(schema_.get_type(type).name_));
+      continue;
+    }
+
+    const schema::FieldId field_id = schema_.find_field(type, name);
+
+    if (field_id == schema::INVALID_ID) {
+      add_error(UNDEFINED_FIELD, name, fields[i], &nodes[i]);
+      continue;
+    }
+
+    const schema::TypeReference field_type = schema_.get_field(field_id).type_;
+
+    // Leaves without a resolver take a member of the source, which needs no
+    // coroutine.
+    if (!executor_.resolvers_[field_id] && is_leaf(field_type.type_)) {
+      const Value* value = source.find(name);
+
+      if (!complete_leaf(members[i].second, field_type, 0, fields[i],
+                         value != nullptr ? *value : Value(), &nodes[i])) {
+        is_complete = false;
+      }
+
+      continue;
+    }
+
+    tasks.push_back(execute_field(members[i].second, fields[i], field_id, type,
+                                  source, &nodes[i], is_complete));
+  }
+
+  if (is_serial) {
+    for (Task<void>& task : tasks) {
+      co_await std::move(task);
+    }
+  } else {
+    co_await scheduler_.when_all(tasks);
+  }
+
+  if (!is_complete) {
+    co_return false;
+  }
+
+  output = Value(std::move(members));
+
+  co_return true;
+}
+
+Task<void> Execution::execute_field(Value& output, const CollectedField& field,
+                                    const schema::FieldId field_id,
+                                    const schema::TypeId type,
+                                    const Value& source, const PathNode* path,
+                                    std::atomic<bool>& is_complete) {
+  const schema::TypeReference field_type = schema_.get_field(field_id).type_;
+  const Resolver& resolver = executor_.resolvers_[field_id];
+  const std::string_view name = field.fields_[0]->name_;
+  std::optional<FieldResult> result;
+
+  if (resolver) {
+    const Value::Object arguments = get_arguments(field_id, *field.fields_[0]);
+    const ResolveInfo info =
+        ResolveInfo(source, arguments, field_id, type, loaders_);
+
+    try {
+      result = co_await resolver(info);
+    } catch (const std::exception& e) {
+      result = FieldResult::Err(e.what());
+    } catch (...) {
+      result = FieldResult::Err("Detected a resolver throwing an unknown "
+                                "exception.");
+    }
+  } else {
+    const Value* value = source.find(name);
+    result = FieldResult::Ok(value != nullptr ? *value : Value());
+  }
+
+  // A failed field is null, and its parent too if the field is non-null,
+  // without another error.
+  if (!result->IsOk()) {
+    add_error(RESOLVER_FAILED, result->UnwrapErr(), field, path);
+
+    if (field_type.is_non_null()) {
+      is_complete = false;
+    }
+
+    co_return;
+  }
+
+  const bool is_value_complete = co_await complete_value(
+      output, field_type, 0, field, result->Unwrap(), path);
+
+  if (!is_value_complete) {
+    is_complete = false;
+  }
+}
+
+Task<bool> Execution::complete_value(Value& output,
+                                     const schema::TypeReference type,
+                                     const uint8_t depth,
+                                     const CollectedField& field, Value value,
+                                     const PathNode* path) {
+  if (is_leaf(type.type_)) {
+    co_return complete_leaf(output, type, depth, field, std::move(value),
+                            path);
+  }
+
+  const bool is_non_null = (type.non_null_mask_ >> depth & 1) != 0;
+
+  if (value.is_null()) {
+    if (is_non_null) {
+      add_error(NULL_NON_NULL_FIELD, field.fields_[0]->name_, field, path);
+      co_return false;
+    }
+
+    output = Value();
+    co_return true;
+  }
+
+  if (depth < type.list_depth_) {
+    if (value.get_kind() != ValueKind::LIST) {
+      add_error(INVALID_LIST_VALUE, field.fields_[0]->name_, field, path);
+      output = Value();
+      co_return !is_non_null;
+    }
+
+    Value::List& items = value.get_list();
+    Value::List completed_items(items.size());
+    std::vector<PathNode> nodes(items.size());
+    std::vector<Task<void>> tasks;
+    std::atomic<bool> is_complete = true;
+    tasks.reserve(items.size());
+
+    for (size_t i = 0; i < items.size(); i++) {
+      nodes[i] =
+          PathNode{.parent_ = path, .key_ = std::string_view(), .index_ = i};
+      tasks.push_back(complete_item(completed_items[i], type, depth + 1, field,
+                                    std::move(items[i]), &nodes[i],
+                                    is_complete));
+    }
+
+    co_await scheduler_.when_all(tasks);
+
+    // A null item of a non-null item type makes the whole list null.
+    if (!is_complete) {
+      output = Value();
+      co_return !is_non_null;
+    }
+
+    output = Value(std::move(completed_items));
+    co_return true;
+  }
+
+  const schema::TypeId object_type = resolve_object_type(type.type_, value);
+
+  if (object_type == schema::INVALID_ID) {
+    add_error(UNRESOLVED_ABSTRACT_TYPE, field.fields_[0]->name_, field, path);
+    output = Value();
+    co_return !is_non_null;
+  }
+
+  std::vector<const parsing::SelectionSet*> selection_sets;
+
+  for (const parsing::Field* node : field.fields_) {
+    if (node->selection_set_ != nullptr) {
+      selection_sets.push_back(node->selection_set_);
+    }
+  }
+
+  const bool is_object_complete = co_await execute_selection_sets(
+      selection_sets, object_type, value, path, false, output);
+
+  if (!is_object_complete) {
+    output = Value();
+    co_return !is_non_null;
+  }
+
+  co_return true;
+}
+
+Task<void> Execution::complete_item(Value& output,
+                                    const schema::TypeReference type,
+                                    const uint8_t depth,
+                                    const CollectedField& field, Value value,
+                                    const PathNode* path,
+                                    std::atomic<bool>& is_complete) {
+  const bool is_item_complete = co_await complete_value(
+      output, type, depth, field, std::move(value), path);
+
+  if (!is_item_complete) {
+    is_complete = false;
+  }
+}
+
+bool Execution::complete_leaf(Value& output, const schema::TypeReference type,
+                              const uint8_t depth, const CollectedField& field,
+                              Value value, const PathNode* path) {
+  const bool is_non_null = (type.non_null_mask_ >> depth & 1) != 0;
+
+  if (value.is_null()) {
+    if (is_non_null) {
+      add_error(NULL_NON_NULL_FIELD, field.fields_[0]->name_, field, path);
+      return false;
+    }
+
+    output = Value();
+    return true;
+  }
+
+  if (depth < type.list_depth_) {
+    if (value.get_kind() != ValueKind::LIST) {
+      add_error(INVALID_LIST_VALUE, field.fields_[0]->name_, field, path);
+      output = Value();
+      return !is_non_null;
+    }
+
+    Value::List& items = value.get_list();
+
+    for (size_t i = 0; i < items.size(); i++) {
+      const PathNode node =
+          PathNode{.parent_ = path, .key_ = std::string_view(), .index_ = i};
+
+      if (!complete_leaf(items[i], type, depth + 1, field, std::move(items[i]),
+                         &node)) {
+        output = Value();
+        return !is_non_null;
+      }
+    }
+  }
+
+  // Scalars and enum values are passed through as the resolver returned
+  // them.
+  output = std::move(value);
+
+  return true;
+}
+
+schema::TypeId Execution::resolve_object_type(const schema::TypeId type,
+                                              const Value& value) const {
+  if (schema_.get_type(type).kind_ == schema::TypeKind::OBJECT) {
+    return type;
+  }
+
+  schema::TypeId object_type = schema::INVALID_ID;
+
+  if (const TypeResolver& type_resolver = executor_.type_resolvers_[type]) {
+    object_type = schema_.find_type(type_resolver(value));
+  } else if (const Value* name = value.find("__typename");
+             name != nullptr && name->get_kind() == ValueKind::STRING) {
+    object_type = schema_.find_type(name->get_string());
+  }
+
+  if (object_type == schema::INVALID_ID ||
+      schema_.get_type(object_type).kind_ != schema::TypeKind::OBJECT ||
+      !schema_.is_possible_type(type, object_type)) {
+    return schema::INVALID_ID;
+  }
+
+  return object_type;
+}
+
+void Execution::collect_fields(
+    const parsing::SelectionSet& selection_set, const schema::TypeId type,
+    std::vector<CollectedField>& fields,
+    std::vector<std::string_view>& spread_fragments) const {
+  for (const parsing::Selection* selection : selection_set.selections_) {
+    switch (selection->kind_) {
+      case parsing::NodeKind::FIELD: {
+        const auto* field = static_cast<const parsing::Field*>(selection);
+
+        if (!is_included(field->directives_)) {
+          break;
+        }
+
+        const std::string_view response_key =
+            field->alias_.empty() ? field->name_ : field->alias_;
+        const auto it = std::find_if(
+            fields.begin(), fields.end(), [&](const CollectedField& other) {
+              return other.response_key_ == response_key;
+            });
+
+        if (it != fields.end()) {
+          it->fields_.push_back(field);
+        } else {
+          fields.push_back(CollectedField{.response_key_ = response_key,
+                                          .fields_ = {field}});
+        }
+
+        break;
+      }
+      case parsing::NodeKind::FRAGMENT_SPREAD: {
+        const auto* spread =
+            static_cast<const parsing::FragmentSpread*>(selection);
+        const auto fragment = fragments_.find(spread->name_);
+
+        if (!is_included(spread->directives_) ||
+            fragment == fragments_.end() ||
+            std::find(spread_fragments.begin(), spread_fragments.end(),
+                      spread->name_) != spread_fragments.end() ||
+            !does_fragment_apply(fragment->second->type_condition_, type)) {
+          break;
+        }
+
+        spread_fragments.push_back(spread->name_);
+        collect_fields(*fragment->second->selection_set_, type, fields,
+                       spread_fragments);
+        break;
+      }
+      case parsing::NodeKind::INLINE_FRAGMENT: {
+        const auto* fragment =
+            static_cast<const parsing::InlineFragment*>(selection);
+
+        if (is_included(fragment->directives_) &&
+            does_fragment_apply(fragment->type_condition_, type)) {
+          collect_fields(*fragment->selection_set_, type, fields,
+                         spread_fragments);
+        }
+
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+bool Execution::is_included(
+    const std::span<const parsing::Directive* const> directives) const {
+  for (const parsing::Directive* directive : directives) {
+    const bool is_skip = directive->name_ == "skip";
+
+    if (!is_skip && directive->name_ != "include") {
+      continue;
+    }
+
+    for (const parsing::Argument* argument : directive->arguments_) {
+      if (argument->name_ != "if") {
+        continue;
+      }
+
+      const Value condition = to_value(argument->value_, &variables_);
+
+      if (condition.get_kind() == ValueKind::BOOLEAN &&
+          condition.get_bool() == is_skip) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool Execution::does_fragment_apply(
+    const parsing::NamedType* type_condition,
+    const schema::TypeId type) const {
+  if (type_condition == nullptr) {
+    return true;
+  }
+
+  const schema::TypeId condition_type =
+      schema_.find_type(type_condition->name_);
+
+  return condition_type != schema::INVALID_ID &&
+         schema_.is_possible_type(condition_type, type);
+}
+
+Value::Object Execution::get_arguments(const schema::FieldId field_id,
+                                       const parsing::Field& field) const {
+  const schema::IdRange range = schema_.get_field(field_id).arguments_;
+  Value::Object arguments;
+
+  for (uint32_t i = 0; i < range.count_; i++) {
+    const schema::InputValueId id = range.first_ + i;
+    const std::string_view name =
+        schema_.get_string(schema_.get_input_value(id).name_);
+    const auto argument = std::find_if(
+        field.arguments_.begin(), field.arguments_.end(),
+        [&](const parsing::Argument* other) { return other->name_ == name; });
+
+    // Variables without a value leave the argument to its default value.
+    if (argument != field.arguments_.end() &&
+        ((*argument)->value_->kind_ != parsing::NodeKind::VARIABLE ||
+         variables_.find(
+             static_cast<const parsing::Variable*>((*argument)->value_)
+                 ->name_) != nullptr)) {
+      arguments.emplace_back(std::string(name),
+                             to_value((*argument)->value_, &variables_));
+    } else if (const auto default_value =
+                   executor_.default_values_.find(id);
+               default_value != executor_.default_values_.end()) {
+      arguments.emplace_back(std::string(name), default_value->second);
+    }
+  }
+
+  return arguments;
+}
+
+void Execution::add_error(const ExecutionErrorCode code,
+                          const std::string_view text,
+                          const CollectedField& field, const PathNode* path) {
+  std::vector<PathSegment> segments;
+
+  for (const PathNode* node = path; node != nullptr; node = node->parent_) {
+    if (node->key_.empty()) {
+      segments.emplace_back(node->index_);
+    } else {
+      segments.emplace_back(std::string(node->key_));
+    }
+  }
+
+  std::reverse(segments.begin(), segments.end());
+
+  const size_t offset = field.fields_[0]->offset_;
+  std::optional<language::tokenization::Location> location;
+
+  if (!request_.source_.empty()) {
+    location = language::tokenization::locate(request_.source_, offset);
+  }
+
+  std::lock_guard lock(errors_mutex_);
+  errors_.emplace_back(code, text, std::move(segments), offset, location);
+}
+
+Executor::Executor(const schema::Schema& schema,
+                   concurrency::ThreadPool& pool)
+    : schema_(schema), pool_(pool) {
+  size_t field_count = 0;
+
+  for (const schema::TypeDefinition& type : schema.get_types()) {
+    if (type.kind_ == schema::TypeKind::OBJECT ||
+        type.kind_ == schema::TypeKind::INTERFACE) {
+      field_count = std::max<size_t>(
+          field_count, type.members_.first_ + type.members_.count_);
+    }
+  }
+
+  resolvers_.resize(field_count);
+  type_resolvers_.resize(schema.get_types().size());
+
+  for (schema::FieldId field = 0; field < field_count; field++) {
+    const schema::IdRange arguments = schema.get_field(field).arguments_;
+
+    for (uint32_t i = 0; i < arguments.count_; i++) {
+      const schema::InputValueDefinition& argument =
+          schema.get_input_value(arguments.first_ + i);
+
+      if (argument.has_default_value_) {
+        default_values_.emplace(
+            arguments.first_ + i,
+            parse_default_value(schema.get_string(argument.default_value_)));
+      }
+    }
+  }
+}
+
+bool Executor::set_resolver(const std::string_view type,
+                            const std::string_view field, Resolver resolver) {
+  const schema::TypeId type_id = schema_.find_type(type);
+
+  if (type_id == schema::INVALID_ID ||
+      schema_.get_type(type_id).kind_ != schema::TypeKind::OBJECT) {
+    return false;
+  }
+
+  const schema::FieldId field_id = schema_.find_field(type_id, field);
+
+  if (field_id == schema::INVALID_ID) {
+    return false;
+  }
+
+  resolvers_[field_id] = std::move(resolver);
+
+  return true;
+}
+
+bool Executor::set_type_resolver(const std::string_view type,
+                                 TypeResolver resolver) {
+  const schema::TypeId type_id = schema_.find_type(type);
+
+  if (type_id == schema::INVALID_ID) {
+    return false;
+  }
+
+  type_resolvers_[type_id] = std::move(resolver);
+
+  return true;
+}
+
+LoaderId Executor::add_loader(BatchFunction batch_function) {
+  batch_functions_.push_back(std::move(batch_function));
+
+  return static_cast<LoaderId>(batch_functions_.size() - 1);
+}
+
+ExecutionResult Executor::execute(const ExecutionRequest& request) const {
+  [[maybe_unused]] const instrumentation::PhaseTimer<> timer(
+      instrumentation::Phase::EXECUTE);
+  Execution execution = Execution(*this, request);
+  ExecutionResult result = execution.run();
+
+  if constexpr (instrumentation::INSTRUMENTATION_ENABLED) {
+    for (const ExecutionError& error : result.errors_) {
+      instrumentation::record_error(instrumentation::Phase::EXECUTE,
+                                    error.get_code());
+    }
+  }
+
+  return result;
+}
+}  // namespace graphqlpp::execution
@@ -0,0 +1,186 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../concurrency/thread_pool.h"
+#include "../language/parsing/ast.h"
+#include "../schema/schema.h"
+#include "data_loader.h"
+#include "execution_error.h"
+#include "task.h"
+#include "value.h"
+
+namespace graphqlpp::execution {
+/// \brief Identifier of a loader added to an <i>Executor</i>.
+using LoaderId = uint32_t;
+
+/// \brief What a resolver is told about the field it resolves.
+class ResolveInfo {
+ public:
+  /// \param source Value of the object the field belongs to.
+  /// \param arguments Arguments given to the field, or defaulted.
+  /// \param field Field being resolved.
+  /// \param parent_type Object type the field belongs to.
+  /// \param loaders Loaders of the execution, indexed by <i>LoaderId</i>.
+  ResolveInfo(const Value& source, const Value::Object& arguments,
+              const schema::FieldId field, const schema::TypeId parent_type,
+              const std::vector<std::unique_ptr<DataLoader>>& loaders)
+      : source_(source),
+        arguments_(arguments),
+        field_(field),
+        parent_type_(parent_type),
+        loaders_(loaders) {}
+
+  [[nodiscard]] const Value& get_source() const { return source_; }
+
+  [[nodiscard]] const Value::Object& get_arguments() const {
+    return arguments_;
+  }
+
+  /// \brief Finds an argument which was given or has a default value.
+  /// \return The argument's value, or null if it is absent.
+  [[nodiscard]] const Value* get_argument(std::string_view name) const;
+
+  [[nodiscard]] schema::FieldId get_field() const { return field_; }
+
+  [[nodiscard]] schema::TypeId get_parent_type() const {
+    return parent_type_;
+  }
+
+  /// \brief Loads a key through a loader of the execution. The resolver
+  /// suspends until the batch holding the key is loaded.
+  /// \param loader Loader returned by <i>Executor::add_loader</i>.
+  /// \param key Key to be loaded.
+  /// \return Awaitable whose value is the key's <i>FieldResult</i>.
+  [[nodiscard]] DataLoader::LoadAwaiter load(const LoaderId loader,
+                                             Value key) const {
+    return loaders_[loader]->load(std::move(key));
+  }
+
+  /// \brief Loads several keys at once through a loader of the execution,
+  /// so that they go into the same batch.
+  /// \return Awaitable whose value holds the <i>FieldResult</i> of each key.
+  [[nodiscard]] DataLoader::LoadManyAwaiter load_many(
+      const LoaderId loader, std::vector<Value> keys) const {
+    return loaders_[loader]->load_many(std::move(keys));
+  }
+
+ private:
+  const Value& source_;
+  const Value::Object& arguments_;
+  schema::FieldId field_;
+  schema::TypeId parent_type_;
+  const std::vector<std::unique_ptr<DataLoader>>& loaders_;
+};
+
+/// \brief Resolves a field. Resolvers are coroutines which may only suspend
+/// by awaiting loads or other tasks.
+using Resolver = std::function<Task<FieldResult>(const ResolveInfo& info)>;
+
+/// \brief Tells the name of the object type of a value returned for an
+/// interface or a union.
+using TypeResolver = std::function<std::string_view(const Value& value)>;
+
+struct ExecutionRequest {
+  /// \brief Parsed document, which should have been validated.
+  const language::parsing::Document* document_;
+  /// \brief Source text of the document, used to locate errors. Errors have
+  /// no locations if it is empty.
+  std::string_view source_;
+  /// \brief Operation to be executed, which may be empty if the document
+  /// has a single one.
+  std::string_view operation_name_;
+  /// \brief Object holding the values of the operation's variables.
+  Value variables_ = Value(Value::Object());
+  /// \brief Source value given to the resolvers of the root fields.
+  Value root_value_;
+};
+
+struct ExecutionResult {
+  /// \brief Empty if the request failed before any field was executed.
+  std::optional<Value> data_;
+  /// \brief Errors sorted by path.
+  std::vector<ExecutionError> errors_;
+
+  /// \brief Appends the GraphQL response: its errors, if any, followed by
+  /// its data.
+  /// \param output String where the JSON object is appended.
+  void write_json(std::string& output) const;
+};
+
+class Execution;
+
+/// \brief Executes operations against a schema, running resolvers on a
+/// thread pool.
+///
+/// Each execution walks the operation's selection sets recursively. Fields
+/// with a resolver become coroutines: sibling fields, and the items of a
+/// list of objects, run concurrently, the first on the current worker and
+/// the rest queued for idle workers to steal. Fields without a resolver take
+/// the member of the source object with their name, and leaves among them
+/// are completed inline, without a coroutine.
+///
+/// Loads are batched per level: once every coroutine of the execution is
+/// suspended, each loader calls its batch function once with every key asked
+/// for, so resolving a field of N list items costs a single call instead of
+/// N. Errors are collected per field along with their path, and null values
+/// of non-null fields make their parent null, as the GraphQL specification
+/// asks for.
+///
+/// Arguments and variables are passed as written: coercing them against
+/// their types, like validating the document, is left to the caller.
+class Executor {
+ public:
+  /// \param schema Schema the operations are executed against, which must
+  /// outlive the executor.
+  /// \param pool Pool running the resolvers, which must outlive the executor.
+  Executor(const schema::Schema& schema, concurrency::ThreadPool& pool);
+
+  /// \brief Sets the resolver of a field of an object type.
+  /// \return Whether the field exists.
+  bool set_resolver(std::string_view type, std::string_view field,
+                    Resolver resolver);
+
+  /// \brief Sets the type resolver of an interface or a union. Without one,
+  /// the object type is taken from the value's "__typename" member.
+  /// \return Whether the type exists.
+  bool set_type_resolver(std::string_view type, TypeResolver resolver);
+
+  /// \brief Adds a loader, which every execution instantiates with its own
+  /// cache.
+  /// \return Identifier of the loader, to be passed to
+  /// <i>ResolveInfo::load</i>.
+  LoaderId add_loader(BatchFunction batch_function);
+
+  /// \brief Executes a query or a mutation, blocking until it finishes. The
+  /// root fields of mutations run one after another. It must not be called
+  /// from a worker of the pool.
+  [[nodiscard]] ExecutionResult execute(const ExecutionRequest& request) const;
+
+ private:
+  friend class Execution;
+
+  const schema::Schema& schema_;
+  concurrency::ThreadPool& pool_;
+  /// \brief Resolver of every field, indexed by <i>FieldId</i>.
+  std::vector<Resolver> resolvers_;
+  /// \brief Type resolver of every type, indexed by <i>TypeId</i>.
+  std::vector<TypeResolver> type_resolvers_;
+  std::vector<BatchFunction> batch_functions_;
+  /// \brief Default values of the field arguments, which the schema keeps as
+  /// source text, parsed once.
+  std::unordered_map<schema::InputValueId, Value> default_values_;
+};
+}  // namespace graphqlpp::execution
+
+#endif  // EXECUTOR_H
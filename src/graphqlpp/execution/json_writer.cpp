@@ -0,0 +1,344 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "json_writer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <variant>
+
+#include "../instrumentation/metrics.h"
+#include "../language/tokenization/source_scan.h"
+
+namespace graphqlpp::execution {
+namespace {
+/// \brief Records how long writing a response took and how many bytes it
+/// has, if instrumentation is enabled.
+class ResponseMeter {
+ public:
+  explicit ResponseMeter(const JsonWriter& writer)
+      : writer_(writer), timer_(instrumentation::Phase::SERIALIZE) {
+    if constexpr (instrumentation::INSTRUMENTATION_ENABLED) {
+      initial_size_ = writer_.get_size();
+    }
+  }
+
+  ~ResponseMeter() {
+    if constexpr (instrumentation::INSTRUMENTATION_ENABLED) {
+      instrumentation::add_to_counter(
+          instrumentation::Counter::SERIALIZED_BYTES,
+          writer_.get_size() - initial_size_);
+    }
+  }
+
+  ResponseMeter(const ResponseMeter&) = delete;
+  ResponseMeter& operator=(const ResponseMeter&) = delete;
+
+ private:
+  [[maybe_unused]] const JsonWriter& writer_;
+  [[maybe_unused]] const instrumentation::PhaseTimer<> timer_;
+  size_t initial_size_ = 0;
+};
+}  // namespace
+
+JsonWriter::JsonWriter(const size_t chunk_size)
+    : chunk_size_(std::max(chunk_size, MINIMUM_CHUNK_SIZE)) {}
+
+void JsonWriter::write_response(const ExecutionResult& result) {
+  [[maybe_unused]] const ResponseMeter meter = ResponseMeter(*this);
+  append('{');
+
+  if (!result.errors_.empty()) {
+    append("\"errors\":[");
+
+    for (size_t i = 0; i < result.errors_.size(); i++) {
+      if (i > 0) {
+        append(',');
+      }
+
+      write_error(result.errors_[i]);
+    }
+
+    append(']');
+  }
+
+  if (result.data_.has_value()) {
+    if (!result.errors_.empty()) {
+      append(',');
+    }
+
+    append("\"data\":");
+    write_value(*result.data_);
+  }
+
+  append('}');
+}
+
+void JsonWriter::write_response(
+    const std::span<const language::tokenization::TokenizeError> errors) {
+  [[maybe_unused]] const ResponseMeter meter = ResponseMeter(*this);
+  append("{\"errors\":[");
+
+  for (size_t i = 0; i < errors.size(); i++) {
+    if (i > 0) {
+      append(',');
+    }
+
+    write_error(errors[i]);
+  }
+
+  append("]}");
+}
+
+void JsonWriter::write_value(const Value& value) {
+  switch (value.get_kind()) {
+    case ValueKind::NULL_VALUE:
+      append("null");
+      break;
+    case ValueKind::BOOLEAN:
+      append(value.get_bool() ? "true" : "false");
+      break;
+    case ValueKind::INT:
+      write_int(value.get_int());
+      break;
+    case ValueKind::FLOAT:
+      write_float(value.get_float());
+      break;
+    case ValueKind::STRING:
+      write_string(value.get_string());
+      break;
+    case ValueKind::LIST: {
+      const Value::List& items = value.get_list();
+      append('[');
+
+      for (size_t i = 0; i < items.size(); i++) {
+        if (i > 0) {
+          append(',');
+        }
+
+        write_value(items[i]);
+      }
+
+      append(']');
+      break;
+    }
+    case ValueKind::OBJECT:
+    default: {
+      const Value::Object& members = value.get_object();
+      append('{');
+
+      for (size_t i = 0; i < members.size(); i++) {
+        if (i > 0) {
+          append(',');
+        }
+
+        write_string(members[i].first);
+        append(':');
+        write_value(members[i].second);
+      }
+
+      append('}');
+      break;
+    }
+  }
+}
+
+void JsonWriter::write_string(const std::string_view value) {
+  write_string(value, true);
+}
+
+void JsonWriter::write_string(std::string_view value, const bool may_refer) {
+  append('"');
+  size_t i = language::tokenization::find_json_escape_byte(value);
+
+  if (may_refer && i == value.size() &&
+      value.size() >= MINIMUM_REFERENCED_SIZE) {
+    close_segment();
+    segments_.emplace_back(value.data(), value.size());
+    append('"');
+
+    return;
+  }
+
+  for (; i < value.size();
+       i = language::tokenization::find_json_escape_byte(value)) {
+    char buffer[6];
+    append(value.substr(0, i));
+    append(language::tokenization::get_json_escape_sequence(value[i], buffer));
+    value.remove_prefix(i + 1);
+  }
+
+  append(value);
+  append('"');
+}
+
+void JsonWriter::write_error(
+    const language::tokenization::TokenizeError& error) {
+  const language::tokenization::Location location = error.get_location();
+
+  write_error(error.get_message(), std::span(&location, 1), {},
+              language::tokenization::get_error_code_name(error.get_code()));
+}
+
+void JsonWriter::write_error(const ExecutionError& error) {
+  const std::optional<language::tokenization::Location>& location =
+      error.get_location();
+
+  write_error(error.get_message(),
+              location.has_value()
+                  ? std::span(&*location, 1)
+                  : std::span<const language::tokenization::Location>(),
+              error.get_path(), get_error_code_name(error.get_code()));
+}
+
+void JsonWriter::write_error(
+    const std::string_view message,
+    const std::span<const language::tokenization::Location> locations,
+    const std::span<const PathSegment> path, const std::string_view code) {
+  append("{\"message\":");
+  // Messages may be formatted on the fly, so they are always copied.
+  write_string(message, false);
+
+  if (!locations.empty()) {
+    append(",\"locations\":[");
+
+    for (size_t i = 0; i < locations.size(); i++) {
+      append(i > 0 ? ",{\"line\":" : "{\"line\":");
+      write_int(static_cast<int64_t>(locations[i].line_));
+      append(",\"column\":");
+      write_int(static_cast<int64_t>(locations[i].column_));
+      append('}');
+    }
+
+    append(']');
+  }
+
+  if (!path.empty()) {
+    append(",\"path\":[");
+
+    for (size_t i = 0; i < path.size(); i++) {
+      if (i > 0) {
+        append(',');
+      }
+
+      if (const auto* key = std::get_if<std::string>(&path[i])) {
+        write_string(*key);
+      } else {
+        write_int(static_cast<int64_t>(std::get<size_t>(path[i])));
+      }
+    }
+
+    append(']');
+  }
+
+  append(",\"extensions\":{\"code\":");
+  write_string(code);
+  append("}}");
+}
+
+std::span<const std::span<const char>> JsonWriter::get_segments() {
+  close_segment();
+
+  return segments_;
+}
+
+size_t JsonWriter::get_size() const {
+  size_t size = static_cast<size_t>(cursor_ - segment_start_);
+
+  for (const std::span<const char> segment : segments_) {
+    size += segment.size();
+  }
+
+  return size;
+}
+
+std::string JsonWriter::to_string() const {
+  std::string output;
+  output.reserve(get_size());
+
+  for (const std::span<const char> segment : segments_) {
+    output.append(segment.data(), segment.size());
+  }
+
+  output.append(segment_start_, cursor_);
+
+  return output;
+}
+
+void JsonWriter::clear() {
+  segments_.clear();
+  used_chunk_count_ = 0;
+  cursor_ = nullptr;
+  end_ = nullptr;
+  segment_start_ = nullptr;
+}
+
+void JsonWriter::next_chunk() {
+  close_segment();
+
+  if (used_chunk_count_ == chunks_.size()) {
+    chunks_.push_back(std::make_unique_for_overwrite<char[]>(chunk_size_));
+  }
+
+  cursor_ = chunks_[used_chunk_count_].get();
+  end_ = cursor_ + chunk_size_;
+  segment_start_ = cursor_;
+  used_chunk_count_++;
+}
+
+void JsonWriter::close_segment() {
+  if (cursor_ != segment_start_) {
+    segments_.emplace_back(segment_start_, cursor_);
+    segment_start_ = cursor_;
+  }
+}
+
+char* JsonWriter::reserve(const size_t size) {
+  // The tail of the chunk is left unused, as splitting a number between
+  // chunks would cost more than the few bytes lost.
+  if (static_cast<size_t>(end_ - cursor_) < size) {
+    next_chunk();
+  }
+
+  return cursor_;
+}
+
+void JsonWriter::append(const char c) {
+  if (cursor_ == end_) {
+    next_chunk();
+  }
+
+  *cursor_++ = c;
+}
+
+void JsonWriter::append(std::string_view bytes) {
+  while (!bytes.empty()) {
+    if (cursor_ == end_) {
+      next_chunk();
+    }
+
+    const size_t size =
+        std::min(bytes.size(), static_cast<size_t>(end_ - cursor_));
+    std::memcpy(cursor_, bytes.data(), size);
+    cursor_ += size;
+    bytes.remove_prefix(size);
+  }
+}
+
+void JsonWriter::write_int(const int64_t value) {
+  char* output = reserve(MINIMUM_CHUNK_SIZE);
+  cursor_ = std::to_chars(output, output + MINIMUM_CHUNK_SIZE, value).ptr;
+}
+
+void JsonWriter::write_float(const double value) {
+  // JSON has no representation of infinities nor NaN.
+  if (!std::isfinite(value)) {
+    append("null");
+    return;
+  }
+
+  char* output = reserve(MINIMUM_CHUNK_SIZE);
+  cursor_ = std::to_chars(output, output + MINIMUM_CHUNK_SIZE, value).ptr;
+}
+}  // namespace graphqlpp::execution
@@ -0,0 +1,132 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../language/tokenization/location.h"
+#include "../language/tokenization/tokenize_error.h"
+#include "execution_error.h"
+#include "executor.h"
+#include "value.h"
+
+namespace graphqlpp::execution {
+/// \brief Serializes GraphQL responses into a list of byte segments, ready
+/// to be sent with a single gathering write such as <i>writev</i>.
+///
+/// Bytes are written into fixed-size chunks, which never move nor get
+/// copied as the response grows, unlike a string which reallocates. Long
+/// strings without anything to escape are not copied at all: the segments
+/// refer to them in place, so the values written must outlive the segments.
+/// Chunks are kept by <i>clear</i>, so a writer reused for many responses
+/// stops allocating once it grew as large as the largest one.
+class JsonWriter {
+ public:
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 16 * 1024;
+  /// \brief Smallest chunk size, which fits any number.
+  static constexpr size_t MINIMUM_CHUNK_SIZE = 32;
+  /// \brief Strings at least this long, which have nothing to escape, are
+  /// referred to instead of copied.
+  static constexpr size_t MINIMUM_REFERENCED_SIZE = 256;
+  /// \brief Chunk size fitting most errors, for writers which serialize a
+  /// single one.
+  static constexpr size_t ERROR_CHUNK_SIZE = 256;
+
+  /// \param chunk_size Size of the chunks, which is raised to
+  /// <i>MINIMUM_CHUNK_SIZE</i> if it is smaller.
+  explicit JsonWriter(size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+  JsonWriter(const JsonWriter&) = delete;
+  JsonWriter& operator=(const JsonWriter&) = delete;
+
+  /// \brief Writes a GraphQL response: its errors, if any, followed by its
+  /// data.
+  void write_response(const ExecutionResult& result);
+
+  /// \brief Writes a GraphQL response holding only errors, as returned when
+  /// a request could not be tokenized.
+  void write_response(std::span<const language::tokenization::TokenizeError>
+                          errors);
+
+  void write_value(const Value& value);
+
+  /// \brief Writes a string literal, escaping it as needed.
+  void write_string(std::string_view value);
+
+  /// \brief Writes an entry of a response's "errors" list: its message,
+  /// locations and extensions with the error code.
+  void write_error(const language::tokenization::TokenizeError& error);
+
+  /// \brief Writes an entry of a response's "errors" list: its message,
+  /// locations, path and extensions with the error code.
+  void write_error(const ExecutionError& error);
+
+  /// \brief Writes an entry of a response's "errors" list. Every error of
+  /// the library is serialized through it.
+  /// \param message Human-readable message, which is always copied.
+  /// \param locations Locations of the error, left out if there are none.
+  /// \param path Path of the field within the response, left out if empty.
+  /// \param code Name of the error code, written within the extensions.
+  void write_error(std::string_view message,
+                   std::span<const language::tokenization::Location> locations,
+                   std::span<const PathSegment> path, std::string_view code);
+
+  /// \brief Segments holding every byte written so far, in order. They are
+  /// invalidated by the next write.
+  [[nodiscard]] std::span<const std::span<const char>> get_segments();
+
+  /// \brief Amount of bytes written so far.
+  [[nodiscard]] size_t get_size() const;
+
+  /// \brief Concatenates the segments, for callers which need a single
+  /// buffer.
+  [[nodiscard]] std::string to_string() const;
+
+  /// \brief Discards every byte written, keeping the chunks to be reused.
+  void clear();
+
+ private:
+  size_t chunk_size_;
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  /// \brief Chunks in use, which are the first ones of <i>chunks_</i>.
+  size_t used_chunk_count_ = 0;
+  char* cursor_ = nullptr;
+  char* end_ = nullptr;
+  /// \brief Start of the bytes of the current chunk which no segment holds
+  /// yet.
+  char* segment_start_ = nullptr;
+  std::vector<std::span<const char>> segments_;
+
+  /// \brief Closes the open segment and moves on to the next chunk.
+  void next_chunk();
+
+  /// \brief Ends the open segment, if it holds any byte.
+  void close_segment();
+
+  /// \brief Makes room for a few contiguous bytes.
+  /// \param size Amount of bytes, at most <i>MINIMUM_CHUNK_SIZE</i>.
+  /// \return Where the bytes are to be written.
+  char* reserve(size_t size);
+
+  void append(char c);
+
+  void append(std::string_view bytes);
+
+  void write_int(int64_t value);
+
+  void write_float(double value);
+
+  /// \param may_refer Whether the string outlives the segments, so that it
+  /// may be referred to instead of copied.
+  void write_string(std::string_view value, bool may_refer);
+};
+}  // namespace graphqlpp::execution
+
+#endif  // JSON_WRITER_H
@@ -0,0 +1,107 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "scheduler.h"
+
+#include "data_loader.h"
+
+namespace graphqlpp::execution {
+std::coroutine_handle<> SpawnedTask::promise_type::FinalAwaiter::await_suspend(
+    const std::coroutine_handle<promise_type> coroutine) const noexcept {
+  WhenAll* group = coroutine.promise().group_;
+
+  // Nothing touches the frame once it is suspended, so it can be destroyed
+  // before resuming the next coroutine.
+  coroutine.destroy();
+
+  return group != nullptr ? group->finish_task() : std::noop_coroutine();
+}
+
+void Scheduler::schedule(const std::coroutine_handle<> coroutine) {
+  active_count_++;
+
+  pool_.post([this, coroutine]() {
+    coroutine.resume();
+    finish_slice();
+  });
+}
+
+void Scheduler::spawn(Task<void> task) {
+  schedule(start(std::move(task), nullptr));
+}
+
+WhenAll Scheduler::when_all(const std::span<Task<void>> tasks) {
+  return WhenAll(*this, tasks);
+}
+
+void Scheduler::add_pending_loader(DataLoader& loader) {
+  std::lock_guard lock(mutex_);
+  pending_loaders_.push_back(&loader);
+}
+
+void Scheduler::wait() {
+  std::unique_lock lock(mutex_);
+  idle_condition_.wait(lock, [this]() { return is_idle_; });
+}
+
+SpawnedTask Scheduler::run(Task<void> task) { co_await std::move(task); }
+
+std::coroutine_handle<> Scheduler::start(Task<void> task, WhenAll* group) {
+  const SpawnedTask spawned_task = run(std::move(task));
+  spawned_task.get_coroutine().promise().set_group(group);
+
+  return spawned_task.get_coroutine();
+}
+
+void Scheduler::finish_slice() {
+  if (active_count_.fetch_sub(1) != 1) {
+    return;
+  }
+
+  // Nothing runs anymore, so no coroutine can add a pending loader
+  // meanwhile.
+  std::vector<DataLoader*> loaders;
+
+  {
+    std::lock_guard lock(mutex_);
+    loaders.swap(pending_loaders_);
+
+    if (loaders.empty()) {
+      // The waiting thread may destroy the scheduler as soon as the lock is
+      // released, so it is notified while holding it.
+      is_idle_ = true;
+      idle_condition_.notify_all();
+
+      return;
+    }
+  }
+
+  for (DataLoader* loader : loaders) {
+    spawn(loader->dispatch());
+  }
+}
+
+std::coroutine_handle<> WhenAll::await_suspend(
+    const std::coroutine_handle<> awaiter) {
+  awaiter_ = awaiter;
+  remaining_count_ = tasks_.size();
+
+  // The first task holds the group until it finishes, so none of the queued
+  // tasks can resume the awaiter before it runs.
+  const std::coroutine_handle<> first = Scheduler::start(
+      std::move(tasks_[0]), this);
+
+  for (size_t i = 1; i < tasks_.size(); i++) {
+    scheduler_.schedule(Scheduler::start(std::move(tasks_[i]), this));
+  }
+
+  return first;
+}
+
+std::coroutine_handle<> WhenAll::finish_task() {
+  if (remaining_count_.fetch_sub(1) == 1) {
+    return awaiter_;
+  }
+
+  return std::noop_coroutine();
+}
+}  // namespace graphqlpp::execution
@@ -0,0 +1,160 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "../concurrency/thread_pool.h"
+#include "task.h"
+
+namespace graphqlpp::execution {
+class DataLoader;
+class WhenAll;
+
+/// \brief Coroutine started by a <i>Scheduler</i>, which awaits a task and
+/// then destroys itself, telling its <i>WhenAll</i>, if any, that it
+/// finished.
+class SpawnedTask {
+ public:
+  class promise_type {
+   public:
+    struct FinalAwaiter {
+      [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+      std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<promise_type> coroutine) const noexcept;
+
+      void await_resume() const noexcept {}
+    };
+
+    SpawnedTask get_return_object() {
+      return SpawnedTask(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    void return_void() const {}
+
+    /// \brief Spawned tasks are the executor's own, which report their
+    /// failures as field errors instead of throwing.
+    void unhandled_exception() const { std::terminate(); }
+
+    void set_group(WhenAll* group) { group_ = group; }
+
+   private:
+    WhenAll* group_ = nullptr;
+  };
+
+  [[nodiscard]] std::coroutine_handle<promise_type> get_coroutine() const {
+    return coroutine_;
+  }
+
+ private:
+  std::coroutine_handle<promise_type> coroutine_;
+
+  explicit SpawnedTask(const std::coroutine_handle<promise_type> coroutine)
+      : coroutine_(coroutine) {}
+};
+
+/// \brief Runs the coroutines of an execution on a thread pool, and tells
+/// when every one of them is suspended.
+///
+/// Every time a coroutine is resumed on a worker, it runs until it either
+/// finishes or suspends, and the scheduler counts the coroutines which are
+/// running or queued. Once none is left, the coroutines still suspended are
+/// waiting for the keys of a loader, so the pending batch of every loader is
+/// dispatched at once: every key requested at that level of the query goes
+/// into a single batch, which is how loads from sibling fields, or from the
+/// items of a list, collapse into one call.
+class Scheduler {
+ public:
+  /// \param pool Pool running the coroutines, which must outlive the
+  /// scheduler.
+  explicit Scheduler(concurrency::ThreadPool& pool) : pool_(pool) {}
+
+  Scheduler(const Scheduler&) = delete;
+  Scheduler& operator=(const Scheduler&) = delete;
+
+  /// \brief Queues a suspended coroutine to be resumed on a worker.
+  void schedule(std::coroutine_handle<> coroutine);
+
+  /// \brief Starts a task on a worker, without waiting for it.
+  void spawn(Task<void> task);
+
+  /// \brief Awaitable which runs tasks concurrently and resumes the awaiting
+  /// coroutine once all of them finished. The first task runs right away on
+  /// the awaiting thread, while the rest are queued for idle workers to
+  /// steal.
+  /// \param tasks Tasks, which must outlive the awaitable.
+  [[nodiscard]] WhenAll when_all(std::span<Task<void>> tasks);
+
+  /// \brief Registers a loader whose batch has to be dispatched once every
+  /// coroutine is suspended.
+  void add_pending_loader(DataLoader& loader);
+
+  /// \brief Blocks until every coroutine either finished or is suspended
+  /// without a pending loader to resume it. It must not be called from a
+  /// worker of the pool.
+  void wait();
+
+ private:
+  concurrency::ThreadPool& pool_;
+  /// \brief Coroutines running or queued.
+  std::atomic<size_t> active_count_ = 0;
+  std::mutex mutex_;
+  std::condition_variable idle_condition_;
+  std::vector<DataLoader*> pending_loaders_;
+  bool is_idle_ = false;
+
+  friend class WhenAll;
+
+  static SpawnedTask run(Task<void> task);
+
+  /// \brief Creates the coroutine running a task, suspended.
+  /// \param group Group the task belongs to, if any.
+  static std::coroutine_handle<> start(Task<void> task, WhenAll* group);
+
+  /// \brief Called once a resumed coroutine finished or suspended again.
+  void finish_slice();
+};
+
+/// \brief Awaitable returned by <i>Scheduler::when_all</i>.
+class WhenAll {
+ public:
+  WhenAll(Scheduler& scheduler, const std::span<Task<void>> tasks)
+      : scheduler_(scheduler), tasks_(tasks) {}
+
+  WhenAll(const WhenAll&) = delete;
+  WhenAll& operator=(const WhenAll&) = delete;
+
+  [[nodiscard]] bool await_ready() const noexcept { return tasks_.empty(); }
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter);
+
+  void await_resume() const noexcept {}
+
+  /// \brief Called by each task once it finished.
+  /// \return The awaiting coroutine, if every task finished, or a no-op
+  /// coroutine.
+  std::coroutine_handle<> finish_task();
+
+ private:
+  Scheduler& scheduler_;
+  std::span<Task<void>> tasks_;
+  std::coroutine_handle<> awaiter_;
+  std::atomic<size_t> remaining_count_ = 0;
+};
+}  // namespace graphqlpp::execution
+
+#endif  // SCHEDULER_H
@@ -0,0 +1,154 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef TASK_H
+#define TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace graphqlpp::execution {
+template <typename T>
+class Task;
+
+/// \brief Part of a task's promise which does not depend on its value.
+class TaskPromiseBase {
+ public:
+  /// \brief Resumes the awaiting coroutine once the task finishes, without
+  /// growing the stack.
+  struct FinalAwaiter {
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(
+        const std::coroutine_handle<Promise> coroutine) const noexcept {
+      return coroutine.promise().continuation_;
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+
+  void unhandled_exception() { exception_ = std::current_exception(); }
+
+  void set_continuation(const std::coroutine_handle<> continuation) {
+    continuation_ = continuation;
+  }
+
+  void rethrow_exception() const {
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+  }
+
+ private:
+  std::coroutine_handle<> continuation_ = std::noop_coroutine();
+  std::exception_ptr exception_;
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+ public:
+  Task<T> get_return_object();
+
+  void return_value(T value) { value_.emplace(std::move(value)); }
+
+  T take_value() {
+    rethrow_exception();
+
+    return std::move(*value_);
+  }
+
+ private:
+  std::optional<T> value_;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+ public:
+  Task<void> get_return_object();
+
+  void return_void() const {}
+
+  void take_value() const { rethrow_exception(); }
+};
+
+/// \brief Lazy coroutine, which only starts once awaited and resumes its
+/// awaiter when it finishes. Exceptions are rethrown to the awaiter.
+///
+/// Tasks never switch threads on their own: a task runs on the thread which
+/// awaits it, and goes on running on the thread which resumes it, such as a
+/// worker running the batch a <i>DataLoader</i> was waiting for.
+/// \tparam T Type of the task's value.
+template <typename T>
+class [[nodiscard]] Task {
+ public:
+  using promise_type = TaskPromise<T>;
+
+  Task() = default;
+
+  explicit Task(const std::coroutine_handle<promise_type> coroutine)
+      : coroutine_(coroutine) {}
+
+  Task(Task&& other) noexcept
+      : coroutine_(std::exchange(other.coroutine_, nullptr)) {}
+
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      destroy();
+      coroutine_ = std::exchange(other.coroutine_, nullptr);
+    }
+
+    return *this;
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() { destroy(); }
+
+  auto operator co_await() && noexcept {
+    struct Awaiter {
+      std::coroutine_handle<promise_type> coroutine_;
+
+      [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+      std::coroutine_handle<> await_suspend(
+          const std::coroutine_handle<> awaiter) const noexcept {
+        coroutine_.promise().set_continuation(awaiter);
+
+        return coroutine_;
+      }
+
+      T await_resume() const { return coroutine_.promise().take_value(); }
+    };
+
+    return Awaiter{coroutine_};
+  }
+
+ private:
+  std::coroutine_handle<promise_type> coroutine_;
+
+  void destroy() {
+    if (coroutine_) {
+      coroutine_.destroy();
+    }
+  }
+};
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+  return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+  return Task<void>(
+      std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+}  // namespace graphqlpp::execution
+
+#endif  // TASK_H
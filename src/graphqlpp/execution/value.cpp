@@ -0,0 +1,132 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "value.h"
+
+#include <charconv>
+#include <cmath>
+#include <functional>
+
+#include "../language/tokenization/tokenize_error.h"
+
+namespace graphqlpp::execution {
+namespace {
+size_t combine(const size_t seed, const size_t h) {
+  return seed ^ (h + 0x9E3779B97F4A7C15 + (seed << 6) + (seed >> 2));
+}
+}  // namespace
+
+const Value* Value::find(const std::string_view name) const {
+  if (get_kind() != ValueKind::OBJECT) {
+    return nullptr;
+  }
+
+  for (const auto& [member_name, member_value] : get_object()) {
+    if (member_name == name) {
+      return &member_value;
+    }
+  }
+
+  return nullptr;
+}
+
+void Value::write_json(std::string& output) const {
+  switch (get_kind()) {
+    case ValueKind::NULL_VALUE:
+      output += "null";
+      break;
+    case ValueKind::BOOLEAN:
+      output += get_bool() ? "true" : "false";
+      break;
+    case ValueKind::INT: {
+      char digits[24];
+      const auto r = std::to_chars(digits, digits + sizeof(digits), get_int());
+      output.append(digits, r.ptr);
+      break;
+    }
+    case ValueKind::FLOAT: {
+      if (!std::isfinite(get_float())) {
+        output += "null";
+        break;
+      }
+
+      char digits[32];
+      const auto r =
+          std::to_chars(digits, digits + sizeof(digits), get_float());
+      output.append(digits, r.ptr);
+      break;
+    }
+    case ValueKind::STRING:
+      language::tokenization::append_json_string(get_string(), output);
+      break;
+    case ValueKind::LIST: {
+      output += '[';
+
+      for (size_t i = 0; i < get_list().size(); i++) {
+        if (i > 0) {
+          output += ',';
+        }
+
+        get_list()[i].write_json(output);
+      }
+
+      output += ']';
+      break;
+    }
+    case ValueKind::OBJECT:
+    default: {
+      output += '{';
+
+      for (size_t i = 0; i < get_object().size(); i++) {
+        if (i > 0) {
+          output += ',';
+        }
+
+        language::tokenization::append_json_string(get_object()[i].first,
+                                                   output);
+        output += ':';
+        get_object()[i].second.write_json(output);
+      }
+
+      output += '}';
+      break;
+    }
+  }
+}
+
+size_t ValueHash::operator()(const Value& value) const {
+  const auto kind = static_cast<size_t>(value.get_kind());
+
+  switch (value.get_kind()) {
+    case ValueKind::NULL_VALUE:
+      return kind;
+    case ValueKind::BOOLEAN:
+      return combine(kind, value.get_bool());
+    case ValueKind::INT:
+      return combine(kind, std::hash<int64_t>()(value.get_int()));
+    case ValueKind::FLOAT:
+      return combine(kind, std::hash<double>()(value.get_float()));
+    case ValueKind::STRING:
+      return combine(kind, std::hash<std::string>()(value.get_string()));
+    case ValueKind::LIST: {
+      size_t h = kind;
+
+      for (const Value& item : value.get_list()) {
+        h = combine(h, (*this)(item));
+      }
+
+      return h;
+    }
+    case ValueKind::OBJECT:
+    default: {
+      size_t h = kind;
+
+      for (const auto& [name, member] : value.get_object()) {
+        h = combine(combine(h, std::hash<std::string>()(name)),
+                    (*this)(member));
+      }
+
+      return h;
+    }
+  }
+}
+}  // namespace graphqlpp::execution
@@ -0,0 +1,112 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef VALUE_H
+#define VALUE_H
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "../result.h"
+
+namespace graphqlpp::execution {
+enum class ValueKind : uint8_t {
+  NULL_VALUE,
+  BOOLEAN,
+  INT,
+  FLOAT,
+  STRING,
+  LIST,
+  OBJECT
+};
+
+/// \brief Value exchanged with resolvers: the source objects they receive,
+/// the values they return, their arguments and the response's data.
+///
+/// Objects are lists of members which keep their order, as the fields of a
+/// response must follow the order of the query, and are small enough for a
+/// linear search to beat a hash map.
+class Value {
+ public:
+  using List = std::vector<Value>;
+  using Object = std::vector<std::pair<std::string, Value>>;
+
+  Value() = default;
+  Value(const bool value) : value_(value) {}
+
+  template <std::integral Integer>
+    requires(!std::same_as<Integer, bool>)
+  Value(const Integer value) : value_(static_cast<int64_t>(value)) {}
+
+  Value(const double value) : value_(value) {}
+  Value(std::string value) : value_(std::move(value)) {}
+  Value(const std::string_view value) : value_(std::string(value)) {}
+  Value(const char* value) : value_(std::string(value)) {}
+  Value(List value) : value_(std::move(value)) {}
+  Value(Object value) : value_(std::move(value)) {}
+
+  [[nodiscard]] ValueKind get_kind() const {
+    return static_cast<ValueKind>(value_.index());
+  }
+
+  [[nodiscard]] bool is_null() const {
+    return get_kind() == ValueKind::NULL_VALUE;
+  }
+
+  [[nodiscard]] bool get_bool() const { return std::get<bool>(value_); }
+
+  [[nodiscard]] int64_t get_int() const { return std::get<int64_t>(value_); }
+
+  [[nodiscard]] double get_float() const { return std::get<double>(value_); }
+
+  [[nodiscard]] const std::string& get_string() const {
+    return std::get<std::string>(value_);
+  }
+
+  [[nodiscard]] const List& get_list() const {
+    return std::get<List>(value_);
+  }
+
+  [[nodiscard]] List& get_list() { return std::get<List>(value_); }
+
+  [[nodiscard]] const Object& get_object() const {
+    return std::get<Object>(value_);
+  }
+
+  [[nodiscard]] Object& get_object() { return std::get<Object>(value_); }
+
+  /// \brief Finds a member of an object.
+  /// \return The member's value, or null if the value is not an object or
+  /// has no such member.
+  [[nodiscard]] const Value* find(std::string_view name) const;
+
+  /// \brief Appends the value as JSON. Enum values are strings, and floats
+  /// which JSON cannot represent become null.
+  /// \param output String where the JSON value is appended.
+  void write_json(std::string& output) const;
+
+  bool operator==(const Value& other) const = default;
+
+ private:
+  std::variant<std::monostate, bool, int64_t, double, std::string, List,
+               Object>
+      value_;
+};
+
+/// \brief Hash of values used as keys, such as those of a
+/// <i>DataLoader</i>.
+struct ValueHash {
+  size_t operator()(const Value& value) const;
+};
+
+/// \brief Value of a field or of a loaded key, or the message of the error
+/// which prevented it.
+using FieldResult = Result<Value, std::string>;
+}  // namespace graphqlpp::execution
+
+#endif  // VALUE_H
@@ -0,0 +1,160 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "metrics.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace graphqlpp::instrumentation {
+namespace {
+using Cell = std::atomic<uint64_t>;
+
+/// \brief Metrics recorded by one thread at a time. Only the thread which
+/// claimed the buffer writes to it, so its cells are updated with plain
+/// loads and stores instead of read-modify-write operations, and snapshots
+/// read them concurrently.
+struct ThreadMetrics {
+  std::array<Cell, COUNTER_COUNT> counters_{};
+  std::array<std::array<Cell, DURATION_BUCKET_COUNT>, PHASE_COUNT>
+      bucket_counts_{};
+  std::array<Cell, PHASE_COUNT> duration_counts_{};
+  std::array<Cell, PHASE_COUNT> duration_sums_{};
+  std::array<std::array<Cell, MAX_ERROR_CODE_COUNT>, PHASE_COUNT> errors_{};
+  std::atomic<bool> is_claimed_ = true;
+  /// \brief Buffer created before this one.
+  ThreadMetrics* next_ = nullptr;
+};
+
+/// \brief Every buffer ever created. Buffers are never freed: the metrics of
+/// exited threads are kept, and their buffers are claimed by new threads.
+std::atomic<ThreadMetrics*> thread_metrics_head = nullptr;
+
+ThreadMetrics* claim_thread_metrics() {
+  ThreadMetrics* head = thread_metrics_head.load(std::memory_order_acquire);
+
+  for (ThreadMetrics* metrics = head; metrics != nullptr;
+       metrics = metrics->next_) {
+    bool is_claimed = false;
+
+    if (!metrics->is_claimed_.load(std::memory_order_relaxed) &&
+        metrics->is_claimed_.compare_exchange_strong(
+            is_claimed, true, std::memory_order_acquire)) {
+      return metrics;
+    }
+  }
+
+  auto* metrics = new ThreadMetrics();
+  metrics->next_ = head;
+
+  while (!thread_metrics_head.compare_exchange_weak(
+      metrics->next_, metrics, std::memory_order_release,
+      std::memory_order_acquire)) {
+  }
+
+  return metrics;
+}
+
+/// \brief Claims a buffer for the thread's lifetime, and hands it over to
+/// the next thread once it exits.
+class ThreadMetricsOwner {
+ public:
+  ThreadMetricsOwner() : metrics_(claim_thread_metrics()) {}
+
+  ~ThreadMetricsOwner() {
+    metrics_->is_claimed_.store(false, std::memory_order_release);
+  }
+
+  ThreadMetricsOwner(const ThreadMetricsOwner&) = delete;
+  ThreadMetricsOwner& operator=(const ThreadMetricsOwner&) = delete;
+
+  [[nodiscard]] ThreadMetrics& get() const { return *metrics_; }
+
+ private:
+  ThreadMetrics* metrics_;
+};
+
+ThreadMetrics& get_thread_metrics() {
+  thread_local const ThreadMetricsOwner owner;
+
+  return owner.get();
+}
+
+void add(Cell& cell, const uint64_t amount) {
+  cell.store(cell.load(std::memory_order_relaxed) + amount,
+             std::memory_order_relaxed);
+}
+}  // namespace
+
+std::string_view get_phase_name(const Phase phase) {
+  switch (phase) {
+    case Phase::TOKENIZE:
+      return "tokenize";
+    case Phase::PARSE:
+      return "parse";
+    case Phase::NORMALIZE:
+      return "normalize";
+    case Phase::EXECUTE:
+      return "execute";
+    case Phase::SERIALIZE:
+    default:
+      return "serialize";
+  }
+}
+
+void add_to_counter(const Counter counter, const uint64_t amount) {
+  add(get_thread_metrics().counters_[static_cast<size_t>(counter)], amount);
+}
+
+void record_duration(const Phase phase, const uint64_t nanoseconds) {
+  ThreadMetrics& metrics = get_thread_metrics();
+  const auto i = static_cast<size_t>(phase);
+  const size_t bucket = static_cast<size_t>(
+      std::lower_bound(DURATION_BUCKET_BOUNDS.begin(),
+                       DURATION_BUCKET_BOUNDS.end(), nanoseconds) -
+      DURATION_BUCKET_BOUNDS.begin());
+
+  add(metrics.bucket_counts_[i][bucket], 1);
+  add(metrics.duration_counts_[i], 1);
+  add(metrics.duration_sums_[i], nanoseconds);
+}
+
+void record_error(const Phase phase, const std::uint8_t code) {
+  add(get_thread_metrics().errors_[static_cast<size_t>(phase)]
+                                  [std::min(code, OTHER_ERROR_CODE)],
+      1);
+}
+
+MetricsSnapshot take_snapshot() {
+  MetricsSnapshot snapshot = MetricsSnapshot();
+
+  for (const ThreadMetrics* metrics =
+           thread_metrics_head.load(std::memory_order_acquire);
+       metrics != nullptr; metrics = metrics->next_) {
+    for (size_t i = 0; i < COUNTER_COUNT; i++) {
+      snapshot.counters_[i] +=
+          metrics->counters_[i].load(std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < PHASE_COUNT; i++) {
+      DurationHistogram& histogram = snapshot.durations_[i];
+
+      for (size_t j = 0; j < DURATION_BUCKET_COUNT; j++) {
+        histogram.bucket_counts_[j] +=
+            metrics->bucket_counts_[i][j].load(std::memory_order_relaxed);
+      }
+
+      histogram.count_ +=
+          metrics->duration_counts_[i].load(std::memory_order_relaxed);
+      histogram.sum_nanoseconds_ +=
+          metrics->duration_sums_[i].load(std::memory_order_relaxed);
+
+      for (size_t j = 0; j < MAX_ERROR_CODE_COUNT; j++) {
+        snapshot.errors_[i][j] +=
+            metrics->errors_[i][j].load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  return snapshot;
+}
+}  // namespace graphqlpp::instrumentation
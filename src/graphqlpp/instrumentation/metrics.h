@@ -0,0 +1,162 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace graphqlpp::instrumentation {
+/// \brief Whether the library records metrics from every phase, which is
+/// chosen when building it by defining <i>GRAPHQLPP_INSTRUMENTATION</i>.
+/// Without it, the hooks are compiled away.
+#ifdef GRAPHQLPP_INSTRUMENTATION
+constexpr bool INSTRUMENTATION_ENABLED = true;
+#else
+constexpr bool INSTRUMENTATION_ENABLED = false;
+#endif
+
+/// \brief Stage of the handling of a request.
+enum class Phase : std::uint8_t {
+  TOKENIZE,
+  PARSE,
+  NORMALIZE,
+  EXECUTE,
+  /// \brief Writing a response as JSON.
+  SERIALIZE
+};
+
+constexpr size_t PHASE_COUNT = 5;
+
+enum class Counter : std::uint8_t {
+  /// \brief Code units tokenized: bytes, or code points of UTF-32 sources.
+  LEXED_BYTES,
+  /// \brief Tokens scanned, whether they were kept or skipped.
+  TOKENS,
+  /// \brief Ignored tokens scanned, such as whitespace and comments.
+  IGNORED_TOKENS,
+  /// \brief Bytes of the responses written.
+  SERIALIZED_BYTES
+};
+
+constexpr size_t COUNTER_COUNT = 4;
+
+/// \brief Error codes tracked per phase. The last one is
+/// <i>OTHER_ERROR_CODE</i>.
+constexpr size_t MAX_ERROR_CODE_COUNT = 16;
+
+/// \brief Slot counting together the errors whose codes do not fit below
+/// it, which is exported as "OTHER" rather than as the code of a phase.
+constexpr std::uint8_t OTHER_ERROR_CODE = MAX_ERROR_CODE_COUNT - 1;
+
+/// \brief Inclusive upper bounds of the duration histogram buckets, in
+/// nanoseconds: from a microsecond to a second, each four times the former.
+/// Longer durations fall in a last, unbounded bucket.
+constexpr std::array<uint64_t, 11> DURATION_BUCKET_BOUNDS = {
+    1'000,      4'000,      16'000,     64'000,      256'000,      1'024'000,
+    4'096'000,  16'384'000, 65'536'000, 262'144'000, 1'048'576'000};
+
+constexpr size_t DURATION_BUCKET_COUNT = DURATION_BUCKET_BOUNDS.size() + 1;
+
+/// \brief Name of a phase, as exported.
+std::string_view get_phase_name(Phase phase);
+
+struct DurationHistogram {
+  /// \brief Amount of durations within each bucket, not cumulative.
+  std::array<uint64_t, DURATION_BUCKET_COUNT> bucket_counts_;
+  uint64_t count_;
+  uint64_t sum_nanoseconds_;
+};
+
+/// \brief Metrics of every thread added up.
+struct MetricsSnapshot {
+  std::array<uint64_t, COUNTER_COUNT> counters_;
+  std::array<DurationHistogram, PHASE_COUNT> durations_;
+  /// \brief Errors of each phase, indexed by their code.
+  std::array<std::array<uint64_t, MAX_ERROR_CODE_COUNT>, PHASE_COUNT> errors_;
+
+  [[nodiscard]] uint64_t get_counter(const Counter counter) const {
+    return counters_[static_cast<size_t>(counter)];
+  }
+
+  [[nodiscard]] const DurationHistogram& get_durations(
+      const Phase phase) const {
+    return durations_[static_cast<size_t>(phase)];
+  }
+
+  [[nodiscard]] uint64_t get_errors(const Phase phase,
+                                    const std::uint8_t code) const {
+    return errors_[static_cast<size_t>(phase)][code];
+  }
+};
+
+/// \brief Adds to a counter of the calling thread. Every thread records into
+/// its own buffer, so recording never locks nor contends with other threads.
+void add_to_counter(Counter counter, uint64_t amount);
+
+/// \brief Records how long a phase took within the calling thread.
+void record_duration(Phase phase, uint64_t nanoseconds);
+
+/// \brief Records an error of a phase within the calling thread.
+/// \param code Code of the error, as defined by the phase. Codes from
+/// <i>OTHER_ERROR_CODE</i> up are all counted as that one.
+void record_error(Phase phase, std::uint8_t code);
+
+/// \brief Adds up the metrics of every thread, including the ones which
+/// already exited, without stopping them from recording.
+MetricsSnapshot take_snapshot();
+
+/// \brief Records how long the scope it lives in took, as the duration of a
+/// phase.
+/// \tparam Enabled Whether it records anything, which is the build's
+/// instrumentation setting unless given.
+template <bool Enabled = INSTRUMENTATION_ENABLED>
+class PhaseTimer {
+ public:
+  explicit PhaseTimer(const Phase phase)
+      : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+
+  ~PhaseTimer() {
+    const auto duration = std::chrono::steady_clock::now() - start_;
+    record_duration(
+        phase_,
+        static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+                .count()));
+  }
+
+  PhaseTimer(const PhaseTimer&) = delete;
+  PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+ private:
+  Phase phase_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+template <>
+class PhaseTimer<false> {
+ public:
+  constexpr explicit PhaseTimer(Phase) {}
+};
+
+/// \brief Adds to a counter, if enabled.
+template <bool Enabled = INSTRUMENTATION_ENABLED>
+constexpr void count(const Counter counter, const uint64_t amount) {
+  if constexpr (Enabled) {
+    add_to_counter(counter, amount);
+  }
+}
+
+/// \brief Records an error of a phase, if enabled.
+template <bool Enabled = INSTRUMENTATION_ENABLED>
+constexpr void count_error(const Phase phase, const std::uint8_t code) {
+  if constexpr (Enabled) {
+    record_error(phase, code);
+  }
+}
+}  // namespace graphqlpp::instrumentation
+
+#endif  // METRICS_H
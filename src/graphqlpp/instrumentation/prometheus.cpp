@@ -0,0 +1,174 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "prometheus.h"
+
+#include <charconv>
+#include <string_view>
+
+#include "../execution/execution_error.h"
+#include "../language/parsing/parse_error.h"
+#include "../language/tokenization/tokenize_error.h"
+
+namespace graphqlpp::instrumentation {
+namespace {
+struct CounterMetric {
+  Counter counter_;
+  std::string_view name_;
+  std::string_view help_;
+};
+
+constexpr std::array<CounterMetric, COUNTER_COUNT> COUNTER_METRICS = {{
+    {Counter::LEXED_BYTES, "graphqlpp_lexed_bytes_total",
+     "Code units of the sources tokenized."},
+    {Counter::TOKENS, "graphqlpp_tokens_total", "Tokens scanned."},
+    {Counter::IGNORED_TOKENS, "graphqlpp_ignored_tokens_total",
+     "Ignored tokens scanned, such as whitespace and comments."},
+    {Counter::SERIALIZED_BYTES, "graphqlpp_serialized_bytes_total",
+     "Bytes of the responses written."},
+}};
+
+constexpr double NANOSECONDS_PER_SECOND = 1e9;
+
+/// \brief Name of an error code of a phase. Phases without error codes of
+/// their own never record errors.
+std::string_view get_error_code_name(const Phase phase,
+                                     const std::uint8_t code) {
+  if (code == OTHER_ERROR_CODE) {
+    return "OTHER";
+  }
+
+  switch (phase) {
+    case Phase::TOKENIZE:
+      return language::tokenization::get_error_code_name(
+          static_cast<language::tokenization::TokenizeErrorCode>(code));
+    case Phase::PARSE:
+      return language::parsing::get_error_code_name(
+          static_cast<language::parsing::ParseErrorCode>(code));
+    case Phase::EXECUTE:
+      return execution::get_error_code_name(
+          static_cast<execution::ExecutionErrorCode>(code));
+    default:
+      return "UNKNOWN";
+  }
+}
+
+void append_number(const uint64_t value, std::string& output) {
+  char buffer[24];
+  const std::to_chars_result r =
+      std::to_chars(buffer, buffer + sizeof(buffer), value);
+  output.append(buffer, r.ptr);
+}
+
+void append_number(const double value, std::string& output) {
+  char buffer[32];
+  const std::to_chars_result r =
+      std::to_chars(buffer, buffer + sizeof(buffer), value);
+  output.append(buffer, r.ptr);
+}
+
+void append_header(const std::string_view name, const std::string_view type,
+                   const std::string_view help, std::string& output) {
+  output += "# HELP ";
+  output += name;
+  output += ' ';
+  output += help;
+  output += "\n# TYPE ";
+  output += name;
+  output += ' ';
+  output += type;
+  output += '\n';
+}
+
+void append_phase_label(const Phase phase, std::string& output) {
+  output += "{phase=\"";
+  output += get_phase_name(phase);
+  output += '"';
+}
+
+void write_durations(const MetricsSnapshot& snapshot, std::string& output) {
+  constexpr std::string_view NAME = "graphqlpp_phase_duration_seconds";
+  append_header(NAME, "histogram", "Duration of each phase.", output);
+
+  for (size_t i = 0; i < PHASE_COUNT; i++) {
+    const auto phase = static_cast<Phase>(i);
+    const DurationHistogram& histogram = snapshot.get_durations(phase);
+    uint64_t cumulative_count = 0;
+
+    for (size_t j = 0; j < DURATION_BUCKET_COUNT; j++) {
+      cumulative_count += histogram.bucket_counts_[j];
+      output += NAME;
+      output += "_bucket";
+      append_phase_label(phase, output);
+      output += ",le=\"";
+
+      if (j < DURATION_BUCKET_BOUNDS.size()) {
+        append_number(static_cast<double>(DURATION_BUCKET_BOUNDS[j]) /
+                          NANOSECONDS_PER_SECOND,
+                      output);
+      } else {
+        output += "+Inf";
+      }
+
+      output += "\"} ";
+      append_number(cumulative_count, output);
+      output += '\n';
+    }
+
+    output += NAME;
+    output += "_sum";
+    append_phase_label(phase, output);
+    output += "} ";
+    append_number(static_cast<double>(histogram.sum_nanoseconds_) /
+                      NANOSECONDS_PER_SECOND,
+                  output);
+    output += '\n';
+
+    output += NAME;
+    output += "_count";
+    append_phase_label(phase, output);
+    output += "} ";
+    append_number(histogram.count_, output);
+    output += '\n';
+  }
+}
+
+void write_errors(const MetricsSnapshot& snapshot, std::string& output) {
+  constexpr std::string_view NAME = "graphqlpp_errors_total";
+  append_header(NAME, "counter", "Errors of each phase, by code.", output);
+
+  for (size_t i = 0; i < PHASE_COUNT; i++) {
+    const auto phase = static_cast<Phase>(i);
+
+    for (size_t j = 0; j < MAX_ERROR_CODE_COUNT; j++) {
+      const auto code = static_cast<std::uint8_t>(j);
+      const uint64_t count = snapshot.get_errors(phase, code);
+
+      if (count == 0) {
+        continue;
+      }
+
+      output += NAME;
+      append_phase_label(phase, output);
+      output += ",code=\"";
+      output += get_error_code_name(phase, code);
+      output += "\"} ";
+      append_number(count, output);
+      output += '\n';
+    }
+  }
+}
+}  // namespace
+
+void write_prometheus(const MetricsSnapshot& snapshot, std::string& output) {
+  for (const CounterMetric& metric : COUNTER_METRICS) {
+    append_header(metric.name_, "counter", metric.help_, output);
+    output += metric.name_;
+    output += ' ';
+    append_number(snapshot.get_counter(metric.counter_), output);
+    output += '\n';
+  }
+
+  write_durations(snapshot, output);
+  write_errors(snapshot, output);
+}
+}  // namespace graphqlpp::instrumentation
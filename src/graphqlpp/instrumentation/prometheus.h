@@ -0,0 +1,20 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef PROMETHEUS_H
+#define PROMETHEUS_H
+
+#include <string>
+
+#include "metrics.h"
+
+namespace graphqlpp::instrumentation {
+/// \brief Appends a snapshot in the Prometheus text exposition format, such
+/// as to be served on a metrics endpoint. Durations are exported in seconds,
+/// as one histogram labeled by phase, and errors as one counter labeled by
+/// phase and code. Codes which never occurred are left out.
+/// \param snapshot Metrics to export.
+/// \param output String where the metrics are appended.
+void write_prometheus(const MetricsSnapshot& snapshot, std::string& output);
+}  // namespace graphqlpp::instrumentation
+
+#endif  // PROMETHEUS_H
@@ -0,0 +1,116 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GRAPHQLPP_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace graphqlpp::io {
+Result<MappedFile, std::string> MappedFile::open(const std::string& path) {
+  MappedFile file = MappedFile();
+
+#ifdef GRAPHQLPP_HAS_MMAP
+  const int descriptor = ::open(path.c_str(), O_RDONLY);
+
+  if (descriptor < 0) {
+    return Result<MappedFile, std::string>::Err(
+        "Could not open '" + path + "': " + std::strerror(errno) + ".");
+  }
+
+  struct stat status {};
+
+  if (fstat(descriptor, &status) != 0) {
+    const int error = errno;
+    close(descriptor);
+
+    return Result<MappedFile, std::string>::Err(
+        "Could not read the size of '" + path + "': " + std::strerror(error) +
+        ".");
+  }
+
+  // Empty files cannot be mapped, and have no contents to map anyway.
+  if (status.st_size > 0) {
+    void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ,
+                      MAP_PRIVATE, descriptor, 0);
+
+    if (data == MAP_FAILED) {
+      const int error = errno;
+      close(descriptor);
+
+      return Result<MappedFile, std::string>::Err(
+          "Could not map '" + path + "': " + std::strerror(error) + ".");
+    }
+
+    // Documents are read front to back, mostly once.
+    madvise(data, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+
+    file.data_ = static_cast<const char*>(data);
+    file.size_ = static_cast<size_t>(status.st_size);
+    file.is_mapped_ = true;
+  }
+
+  close(descriptor);
+#else
+  std::ifstream stream(path, std::ios::binary);
+
+  if (!stream) {
+    return Result<MappedFile, std::string>::Err("Could not open '" + path +
+                                                "'.");
+  }
+
+  std::stringstream contents;
+  contents << stream.rdbuf();
+  file.fallback_ = contents.str();
+  file.data_ = file.fallback_.data();
+  file.size_ = file.fallback_.size();
+#endif
+
+  return Result<MappedFile, std::string>::Ok(std::move(file));
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  release();
+  is_mapped_ = std::exchange(other.is_mapped_, false);
+  size_ = std::exchange(other.size_, 0);
+  fallback_ = std::move(other.fallback_);
+  // A moved string may relocate its characters, so the view is rebuilt.
+  data_ = is_mapped_ ? other.data_ : fallback_.data();
+  other.data_ = nullptr;
+
+  return *this;
+}
+
+MappedFile::~MappedFile() { release(); }
+
+void MappedFile::release() {
+#ifdef GRAPHQLPP_HAS_MMAP
+  if (is_mapped_) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+
+  data_ = nullptr;
+  size_ = 0;
+  is_mapped_ = false;
+}
+}  // namespace graphqlpp::io
@@ -0,0 +1,47 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+
+#include "../result.h"
+
+namespace graphqlpp::io {
+/// \brief Read-only view of a whole file. On POSIX systems the file is mapped
+/// into memory, so its contents are paged in on demand instead of being
+/// copied; elsewhere it is read into memory.
+class MappedFile {
+ public:
+  /// \brief Maps the file at the given path.
+  /// \return The mapped file, or a message describing why it could not be
+  /// mapped.
+  static Result<MappedFile, std::string> open(const std::string& path);
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  /// \brief Contents of the file, valid as long as the mapped file.
+  [[nodiscard]] std::string_view get_contents() const {
+    return std::string_view(data_, size_);
+  }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  /// \brief Whether <i>data_</i> was mapped, as opposed to being owned by
+  /// <i>fallback_</i>.
+  bool is_mapped_ = false;
+  std::string fallback_;
+
+  MappedFile() = default;
+
+  void release();
+};
+}  // namespace graphqlpp::io
+
+#endif  // MAPPED_FILE_H
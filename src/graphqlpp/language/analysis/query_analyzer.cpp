@@ -0,0 +1,575 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "query_analyzer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "../../execution/json_writer.h"
+
+namespace graphqlpp::language::analysis {
+using tokenization::NAME;
+using tokenization::PUNCTUATOR;
+using tokenization::Token;
+
+/// \brief Size of the chunks <i>analyze_query</i> lexes at a time, which
+/// bounds how much of a rejected document is read past the limit.
+constexpr size_t ANALYSIS_CHUNK_SIZE = 16 * 1024;
+
+namespace {
+/// \brief Statically allocated name of an error code, as reported within the
+/// extensions of a GraphQL response.
+std::string_view get_code_name(const QueryAnalysisErrorCode code) {
+  switch (code) {
+    case ANALYSIS_TOKENIZE_FAILED:
+      return "ANALYSIS_TOKENIZE_FAILED";
+    case DEPTH_LIMIT_EXCEEDED:
+      return "DEPTH_LIMIT_EXCEEDED";
+    case FIELD_LIMIT_EXCEEDED:
+      return "FIELD_LIMIT_EXCEEDED";
+    case ALIAS_LIMIT_EXCEEDED:
+      return "ALIAS_LIMIT_EXCEEDED";
+    case COST_LIMIT_EXCEEDED:
+      return "COST_LIMIT_EXCEEDED";
+    case VALUE_NESTING_TOO_DEEP:
+      return "VALUE_NESTING_TOO_DEEP";
+    case UNBALANCED_BRACKETS:
+    default:
+      return "UNBALANCED_BRACKETS";
+  }
+}
+
+// Costs of hostile documents easily overflow, so they saturate instead.
+uint64_t add_saturated(const uint64_t a, const uint64_t b) {
+  return a > std::numeric_limits<uint64_t>::max() - b
+             ? std::numeric_limits<uint64_t>::max()
+             : a + b;
+}
+
+uint64_t multiply_saturated(const uint64_t a, const uint64_t b) {
+  return a != 0 && b > std::numeric_limits<uint64_t>::max() / a
+             ? std::numeric_limits<uint64_t>::max()
+             : a * b;
+}
+
+/// \brief List size given by an IntValue. Lists are assumed to hold at least
+/// one element, so the cost of a spread fragment is never lower than its
+/// own cost.
+uint64_t parse_list_size(const std::string_view digits) {
+  if (digits.empty() || digits[0] == '-') {
+    return 1;
+  }
+
+  uint64_t size = 0;
+
+  for (const char digit : digits) {
+    size = add_saturated(multiply_saturated(size, 10),
+                         static_cast<uint64_t>(digit - '0'));
+  }
+
+  return std::max<uint64_t>(size, 1);
+}
+
+/// \brief Adds the metrics of a spread fragment to those of its container.
+void add_spread_metrics(QueryMetrics& metrics, const QueryMetrics& fragment,
+                        const size_t depth, const uint64_t multiplier) {
+  if (fragment.depth_ > 0) {
+    metrics.depth_ = std::max(metrics.depth_, depth - 1 + fragment.depth_);
+  }
+
+  metrics.field_count_ = add_saturated(metrics.field_count_,
+                                       fragment.field_count_);
+  metrics.alias_count_ = add_saturated(metrics.alias_count_,
+                                       fragment.alias_count_);
+  metrics.cost_ =
+      add_saturated(metrics.cost_, multiply_saturated(multiplier,
+                                                      fragment.cost_));
+}
+
+void add_metrics(QueryMetrics& metrics, const QueryMetrics& other) {
+  add_spread_metrics(metrics, other, 1, 1);
+}
+}  // namespace
+
+std::string QueryAnalysisError::get_message() const {
+  switch (code_) {
+    case ANALYSIS_TOKENIZE_FAILED:
+      return std::string(tokenize_error_->get_message());
+    case DEPTH_LIMIT_EXCEEDED:
+      return "Detected a query deeper than the limit of " +
+             std::to_string(limit_) + ".";
+    case FIELD_LIMIT_EXCEEDED:
+      return "Detected a query with more fields than the limit of " +
+             std::to_string(limit_) + ".";
+    case ALIAS_LIMIT_EXCEEDED:
+      return "Detected a query with more aliases than the limit of " +
+             std::to_string(limit_) + ".";
+    case COST_LIMIT_EXCEEDED:
+      return "Detected a query costlier than the limit of " +
+             std::to_string(limit_) + ".";
+    case VALUE_NESTING_TOO_DEEP:
+      return "Detected argument values nested deeper than the limit of " +
+             std::to_string(limit_) + ".";
+    case UNBALANCED_BRACKETS:
+    default:
+      return "Detected an unbalanced bracket within arguments.";
+  }
+}
+
+void QueryAnalysisError::write_json(std::string& output) const {
+  if (tokenize_error_.has_value()) {
+    tokenize_error_->write_json(output);
+    return;
+  }
+
+  execution::JsonWriter writer =
+      execution::JsonWriter(execution::JsonWriter::ERROR_CHUNK_SIZE);
+  writer.write_error(get_message(), {}, {}, get_code_name(code_));
+  output += writer.to_string();
+}
+
+QueryAnalyzer::QueryAnalyzer(const QueryAnalysisOptions& options)
+    : options_(options) {}
+
+Result<QueryMetrics, QueryAnalysisError> QueryAnalyzer::feed(
+    const std::string_view chunk) {
+  if (error_.has_value()) {
+    return Result<QueryMetrics, QueryAnalysisError>::Err(*error_);
+  }
+
+  lexer_.feed(chunk);
+
+  return drain();
+}
+
+Result<QueryMetrics, QueryAnalysisError> QueryAnalyzer::finish() {
+  lexer_.finish();
+  Result<QueryMetrics, QueryAnalysisError> r = drain();
+
+  if (!r.IsOk()) {
+    return r;
+  }
+
+  const std::vector<QueryMetrics> expanded = expand_fragment_spreads();
+  std::vector<bool> is_spread(definitions_.size(), false);
+  std::unordered_map<std::string_view, size_t> fragments;
+
+  for (size_t i = 0; i < definitions_.size(); i++) {
+    if (!definitions_[i].fragment_name_.empty()) {
+      fragments.emplace(definitions_[i].fragment_name_, i);
+    }
+  }
+
+  for (const Definition& definition : definitions_) {
+    for (const FragmentSpread& spread : definition.spreads_) {
+      const auto fragment = fragments.find(spread.name_);
+
+      if (fragment != fragments.end()) {
+        is_spread[fragment->second] = true;
+      }
+    }
+  }
+
+  // Spread fragments are counted within the definitions spreading them.
+  // Unused fragments are counted once, as the early checks did.
+  totals_ = QueryMetrics{};
+
+  for (size_t i = 0; i < definitions_.size(); i++) {
+    if (is_spread[i]) {
+      continue;
+    }
+
+    add_metrics(totals_, expanded[i]);
+    check_limits(definitions_[i].offset_);
+
+    if (error_.has_value()) {
+      return Result<QueryMetrics, QueryAnalysisError>::Err(*error_);
+    }
+  }
+
+  return Result<QueryMetrics, QueryAnalysisError>::Ok(totals_);
+}
+
+Result<QueryMetrics, QueryAnalysisError> QueryAnalyzer::drain() {
+  while (!error_.has_value()) {
+    Result<std::optional<Token>, tokenization::TokenizeError> r =
+        lexer_.next();
+
+    if (!r.IsOk()) {
+      error_ = QueryAnalysisError(r.UnwrapErr());
+      break;
+    }
+
+    const std::optional<Token> token = r.Unwrap();
+
+    if (!token.has_value()) {
+      break;
+    }
+
+    if (!token->ignored_) {
+      analyze_token(*token, lexer_.get_value(*token));
+    }
+  }
+
+  if (error_.has_value()) {
+    return Result<QueryMetrics, QueryAnalysisError>::Err(*error_);
+  }
+
+  return Result<QueryMetrics, QueryAnalysisError>::Ok(totals_);
+}
+
+void QueryAnalyzer::analyze_token(const Token& token,
+                                  const std::string_view value) {
+  if (parenthesis_depth_ > 0) {
+    analyze_argument_token(token, value);
+  } else if (multipliers_.empty()) {
+    analyze_definition_token(token, value);
+  } else {
+    analyze_selection_token(token, value);
+  }
+}
+
+void QueryAnalyzer::analyze_definition_token(const Token& token,
+                                             const std::string_view value) {
+  if (is_definition_start_) {
+    is_definition_start_ = false;
+    definitions_.push_back(Definition{.fragment_name_ = std::string(),
+                                      .offset_ = token.offset_,
+                                      .metrics_ = QueryMetrics{},
+                                      .spreads_ = {}});
+
+    if (token.type_ == NAME) {
+      expects_fragment_name_ = value == "fragment";
+      return;
+    }
+  }
+
+  if (token.type_ == NAME) {
+    if (expects_fragment_name_) {
+      definitions_.back().fragment_name_ = std::string(value);
+      expects_fragment_name_ = false;
+    }
+
+    return;
+  }
+
+  if (token.type_ != PUNCTUATOR) {
+    return;
+  }
+
+  if (value[0] == '(') {
+    parenthesis_depth_ = 1;
+    value_closers_.clear();
+    are_field_arguments_ = false;
+    expects_argument_value_ = false;
+  } else if (value[0] == '{') {
+    multipliers_.push_back(1);
+    inline_fragments_.push_back(false);
+    expectation_ = EXPECT_FIELD;
+  }
+}
+
+size_t QueryAnalyzer::selection_depth() const {
+  return multipliers_.size() - inline_fragment_count_;
+}
+
+void QueryAnalyzer::analyze_selection_token(const Token& token,
+                                            const std::string_view value) {
+  Definition& definition = definitions_.back();
+
+  if (token.type_ == PUNCTUATOR && value[0] == ':' &&
+      expectation_ == AFTER_FIELD_NAME) {
+    // The name which was just read is an alias, so the field's weight is
+    // looked up from the name which follows.
+    pending_cost_ = 0;
+    definition.metrics_.alias_count_++;
+    totals_.alias_count_++;
+    expectation_ = EXPECT_ALIASED_FIELD;
+    check_limits(token.offset_);
+    return;
+  }
+
+  const bool follows_field_name = expectation_ == AFTER_FIELD_NAME;
+  commit_field(token.offset_);
+
+  if (follows_field_name) {
+    expectation_ = EXPECT_FIELD;
+  }
+
+  if (token.type_ == PUNCTUATOR) {
+    switch (value[0]) {
+      case '.':
+        expectation_ = EXPECT_SPREAD_TARGET;
+        pending_list_size_ = 1;
+        is_inline_fragment_ = true;
+        break;
+      case '@':
+        expectation_ = EXPECT_DIRECTIVE_NAME;
+        break;
+      case '(':
+        parenthesis_depth_ = 1;
+        value_closers_.clear();
+        are_field_arguments_ = follows_field_name;
+        expects_argument_value_ = false;
+        break;
+      case '{':
+        multipliers_.push_back(
+            multiply_saturated(multipliers_.back(), pending_list_size_));
+        inline_fragments_.push_back(is_inline_fragment_);
+        inline_fragment_count_ += is_inline_fragment_ ? 1 : 0;
+        is_inline_fragment_ = false;
+        pending_list_size_ = 1;
+        expectation_ = EXPECT_FIELD;
+        break;
+      case '}':
+        multipliers_.pop_back();
+        inline_fragment_count_ -= inline_fragments_.back() ? 1 : 0;
+        inline_fragments_.pop_back();
+        expectation_ = EXPECT_FIELD;
+        is_definition_start_ = multipliers_.empty();
+        break;
+      default:
+        break;
+    }
+
+    return;
+  }
+
+  if (token.type_ != NAME) {
+    return;
+  }
+
+  switch (expectation_) {
+    case EXPECT_SPREAD_TARGET:
+      if (value == "on") {
+        expectation_ = EXPECT_TYPE_CONDITION;
+        return;
+      }
+
+      definition.spreads_.push_back(
+          FragmentSpread{.name_ = std::string(value),
+                         .depth_ = selection_depth(),
+                         .multiplier_ = multipliers_.back()});
+      is_inline_fragment_ = false;
+      expectation_ = EXPECT_FIELD;
+      return;
+    case EXPECT_TYPE_CONDITION:
+    case EXPECT_DIRECTIVE_NAME:
+      expectation_ = EXPECT_FIELD;
+      return;
+    case EXPECT_ALIASED_FIELD:
+      break;
+    default:
+      definition.metrics_.field_count_++;
+      definition.metrics_.depth_ =
+          std::max(definition.metrics_.depth_, selection_depth());
+      totals_.field_count_++;
+      totals_.depth_ = std::max(totals_.depth_, selection_depth());
+      is_inline_fragment_ = false;
+      pending_list_size_ = 1;
+      break;
+  }
+
+  const auto weight = options_.field_weights_.find(value);
+
+  pending_cost_ = multiply_saturated(
+      weight == options_.field_weights_.end() ? options_.default_field_weight_
+                                              : weight->second,
+      multipliers_.back());
+  expectation_ = AFTER_FIELD_NAME;
+  check_limits(token.offset_);
+}
+
+void QueryAnalyzer::analyze_argument_token(const Token& token,
+                                           const std::string_view value) {
+  if (token.type_ == PUNCTUATOR) {
+    switch (value[0]) {
+      case '(':
+        parenthesis_depth_++;
+        break;
+      case ')':
+        if (!value_closers_.empty()) {
+          error_ = QueryAnalysisError(UNBALANCED_BRACKETS, token.offset_, 0);
+          break;
+        }
+
+        parenthesis_depth_--;
+        break;
+      case '[':
+      case '{':
+        if (value_closers_.size() == MAX_VALUE_DEPTH) {
+          error_ = QueryAnalysisError(VALUE_NESTING_TOO_DEEP, token.offset_,
+                                      MAX_VALUE_DEPTH);
+          break;
+        }
+
+        value_closers_.push_back(value[0] == '[' ? ']' : '}');
+        break;
+      case ']':
+      case '}':
+        if (value_closers_.empty() || value_closers_.back() != value[0]) {
+          error_ = QueryAnalysisError(UNBALANCED_BRACKETS, token.offset_, 0);
+          break;
+        }
+
+        value_closers_.pop_back();
+        expects_argument_value_ =
+            expects_argument_value_ && !value_closers_.empty();
+        break;
+      case ':':
+        expects_argument_value_ =
+            expects_argument_value_ || value_closers_.empty();
+        break;
+      case '$':
+        if (value_closers_.empty() && expects_argument_value_ &&
+            is_list_size_argument_) {
+          pending_list_size_ =
+              std::max(pending_list_size_, options_.variable_list_size_);
+        }
+        break;
+      default:
+        break;
+    }
+
+    return;
+  }
+
+  // Only the top level of the arguments holds argument names.
+  if (!value_closers_.empty()) {
+    return;
+  }
+
+  if (!expects_argument_value_) {
+    is_list_size_argument_ = are_field_arguments_ &&
+                             parenthesis_depth_ == 1 &&
+                             (value == "first" || value == "last");
+    return;
+  }
+
+  if (token.type_ == tokenization::INT_VALUE && is_list_size_argument_) {
+    pending_list_size_ = std::max(pending_list_size_, parse_list_size(value));
+  }
+
+  expects_argument_value_ = false;
+}
+
+void QueryAnalyzer::commit_field(const size_t offset) {
+  if (pending_cost_ == 0) {
+    return;
+  }
+
+  definitions_.back().metrics_.cost_ =
+      add_saturated(definitions_.back().metrics_.cost_, pending_cost_);
+  totals_.cost_ = add_saturated(totals_.cost_, pending_cost_);
+  pending_cost_ = 0;
+  check_limits(offset);
+}
+
+void QueryAnalyzer::check_limits(const size_t offset) {
+  if (error_.has_value()) {
+    return;
+  }
+
+  const QueryLimits& limits = options_.limits_;
+
+  if (totals_.depth_ > limits.max_depth_) {
+    error_ = QueryAnalysisError(DEPTH_LIMIT_EXCEEDED, offset,
+                                limits.max_depth_);
+  } else if (totals_.field_count_ > limits.max_fields_) {
+    error_ = QueryAnalysisError(FIELD_LIMIT_EXCEEDED, offset,
+                                limits.max_fields_);
+  } else if (totals_.alias_count_ > limits.max_aliases_) {
+    error_ = QueryAnalysisError(ALIAS_LIMIT_EXCEEDED, offset,
+                                limits.max_aliases_);
+  } else if (totals_.cost_ > limits.max_cost_) {
+    error_ = QueryAnalysisError(COST_LIMIT_EXCEEDED, offset,
+                                limits.max_cost_);
+  }
+}
+
+std::vector<QueryMetrics> QueryAnalyzer::expand_fragment_spreads() const {
+  enum ExpansionState : std::uint8_t { UNEXPANDED, EXPANDING, EXPANDED };
+
+  std::unordered_map<std::string_view, size_t> fragments;
+
+  for (size_t i = 0; i < definitions_.size(); i++) {
+    if (!definitions_[i].fragment_name_.empty()) {
+      fragments.emplace(definitions_[i].fragment_name_, i);
+    }
+  }
+
+  std::vector<QueryMetrics> expanded(definitions_.size());
+  std::vector<ExpansionState> states(definitions_.size(), UNEXPANDED);
+  // Fragments may spread each other in long chains, so they are expanded
+  // with an explicit stack of definitions and their next spread.
+  std::vector<std::pair<size_t, size_t>> stack;
+
+  for (size_t root = 0; root < definitions_.size(); root++) {
+    if (states[root] != UNEXPANDED) {
+      continue;
+    }
+
+    states[root] = EXPANDING;
+    expanded[root] = definitions_[root].metrics_;
+    stack.emplace_back(root, 0);
+
+    while (!stack.empty()) {
+      const size_t i = stack.back().first;
+      const std::vector<FragmentSpread>& spreads = definitions_[i].spreads_;
+
+      if (stack.back().second == spreads.size()) {
+        states[i] = EXPANDED;
+        stack.pop_back();
+
+        if (!stack.empty()) {
+          const size_t parent = stack.back().first;
+          const FragmentSpread& spread =
+              definitions_[parent].spreads_[stack.back().second - 1];
+
+          add_spread_metrics(expanded[parent], expanded[i], spread.depth_,
+                             spread.multiplier_);
+        }
+
+        continue;
+      }
+
+      const FragmentSpread& spread = spreads[stack.back().second++];
+      const auto fragment = fragments.find(spread.name_);
+
+      // Unknown fragments and cycles are left for validation to report.
+      if (fragment == fragments.end()) {
+        continue;
+      }
+
+      const size_t f = fragment->second;
+
+      if (states[f] == EXPANDED) {
+        add_spread_metrics(expanded[i], expanded[f], spread.depth_,
+                           spread.multiplier_);
+      } else if (states[f] == UNEXPANDED) {
+        states[f] = EXPANDING;
+        expanded[f] = definitions_[f].metrics_;
+        stack.emplace_back(f, 0);
+      }
+    }
+  }
+
+  return expanded;
+}
+
+Result<QueryMetrics, QueryAnalysisError> analyze_query(
+    const std::string_view source, const QueryAnalysisOptions& options) {
+  QueryAnalyzer analyzer = QueryAnalyzer(options);
+
+  for (size_t i = 0; i < source.size(); i += ANALYSIS_CHUNK_SIZE) {
+    Result<QueryMetrics, QueryAnalysisError> r =
+        analyzer.feed(source.substr(i, ANALYSIS_CHUNK_SIZE));
+
+    if (!r.IsOk()) {
+      return r;
+    }
+  }
+
+  return analyzer.finish();
+}
+}  // namespace graphqlpp::language::analysis
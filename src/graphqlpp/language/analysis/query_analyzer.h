@@ -0,0 +1,264 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef QUERY_ANALYZER_H
+#define QUERY_ANALYZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../../result.h"
+#include "../parsing/parser.h"
+#include "../tokenization/lexer.h"
+#include "../tokenization/tokenize_error.h"
+
+namespace graphqlpp::language::analysis {
+/// \brief Hash which looks up field names without copying them.
+struct FieldNameHash {
+  using is_transparent = void;
+
+  size_t operator()(const std::string_view name) const {
+    return std::hash<std::string_view>()(name);
+  }
+};
+
+/// \brief Weight of the fields which are more expensive to resolve than the
+/// rest, keyed by field name.
+using FieldWeights =
+    std::unordered_map<std::string, uint64_t, FieldNameHash, std::equal_to<>>;
+
+/// \brief Most lists and objects which may be nested within an argument. It
+/// is the parser's own limit, so no document the analysis lets through can
+/// exhaust the parser's stack.
+constexpr size_t MAX_VALUE_DEPTH = parsing::MAX_NESTING_DEPTH;
+
+/// \brief Limits a document must stay within. Every limit is unbounded by
+/// default.
+struct QueryLimits {
+  size_t max_depth_ = std::numeric_limits<size_t>::max();
+  size_t max_fields_ = std::numeric_limits<size_t>::max();
+  size_t max_aliases_ = std::numeric_limits<size_t>::max();
+  uint64_t max_cost_ = std::numeric_limits<uint64_t>::max();
+};
+
+struct QueryAnalysisOptions {
+  QueryLimits limits_;
+  /// \brief Weight of the fields which are not within <i>field_weights_</i>.
+  uint64_t default_field_weight_ = 1;
+  FieldWeights field_weights_;
+  /// \brief List size assumed when a field's <i>first</i> or <i>last</i>
+  /// argument is a variable, whose value is not known yet.
+  uint64_t variable_list_size_ = 100;
+};
+
+/// \brief Amount of work a document may request. Fragment spreads are
+/// expanded, and counts are summed over every operation of the document.
+struct QueryMetrics {
+  /// \brief Amount of nested selection sets of the deepest field.
+  size_t depth_;
+  size_t field_count_;
+  size_t alias_count_;
+  /// \brief Sum of every field's weight, multiplied by the sizes of the lists
+  /// it is nested within. The size of a list is taken from the <i>first</i>
+  /// or <i>last</i> argument of its field.
+  uint64_t cost_;
+
+  bool operator==(const QueryMetrics& other) const = default;
+};
+
+enum QueryAnalysisErrorCode : std::uint8_t {
+  /// \brief The document could not be tokenized.
+  ANALYSIS_TOKENIZE_FAILED,
+  DEPTH_LIMIT_EXCEEDED,
+  FIELD_LIMIT_EXCEEDED,
+  ALIAS_LIMIT_EXCEEDED,
+  COST_LIMIT_EXCEEDED,
+  /// \brief Lists and objects within an argument are nested deeper than
+  /// <i>MAX_VALUE_DEPTH</i>.
+  VALUE_NESTING_TOO_DEEP,
+  /// \brief A list or an object within an argument is closed by the wrong
+  /// bracket, or was never opened.
+  UNBALANCED_BRACKETS
+};
+
+/// \brief Compact analysis error, whose message is only built when asked for.
+class QueryAnalysisError {
+ public:
+  /// \param code Exceeded limit.
+  /// \param offset Byte of the document where the limit was exceeded.
+  /// \param limit Value of the exceeded limit.
+  QueryAnalysisError(const QueryAnalysisErrorCode code, const size_t offset,
+                     const uint64_t limit)
+      : code_(code), offset_(offset), limit_(limit) {}
+
+  /// \brief Wraps the error of the document's tokenization.
+  explicit QueryAnalysisError(const tokenization::TokenizeError& error)
+      : code_(ANALYSIS_TOKENIZE_FAILED),
+        offset_(error.get_offset()),
+        limit_(0),
+        tokenize_error_(error) {}
+
+  [[nodiscard]] QueryAnalysisErrorCode get_code() const { return code_; }
+
+  /// \brief Byte of the document where the error was detected.
+  [[nodiscard]] size_t get_offset() const { return offset_; }
+
+  /// \brief Error of the document's tokenization, if the code is
+  /// <i>ANALYSIS_TOKENIZE_FAILED</i>.
+  [[nodiscard]] const std::optional<tokenization::TokenizeError>&
+  get_tokenize_error() const {
+    return tokenize_error_;
+  }
+
+  /// \brief Formats the human-readable message of the error.
+  [[nodiscard]] std::string get_message() const;
+
+  /// \brief Appends the error as an entry of a GraphQL response's "errors"
+  /// list. Exceeded limits are not tied to a location of the document, so
+  /// only tokenization errors have locations.
+  /// \param output String where the JSON object is appended.
+  void write_json(std::string& output) const;
+
+ private:
+  QueryAnalysisErrorCode code_;
+  size_t offset_;
+  uint64_t limit_;
+  std::optional<tokenization::TokenizeError> tokenize_error_;
+};
+
+/// \brief Single-pass analysis of an executable document, which runs over its
+/// tokens as they are lexed, without building an AST.
+///
+/// Limits are checked against the counts of the definitions read so far,
+/// which never exceed those of the whole document, so an abusive document is
+/// rejected as soon as one of its chunks proves it. Fragment spreads can only
+/// be expanded once every fragment is known, so they are checked when the
+/// analysis finishes, in time linear to the amount of spreads.
+///
+/// The analysis only follows the structure of the document, and otherwise
+/// assumes it is well-formed: syntax errors are left to the parser. Brackets
+/// within arguments are the exception, as they are checked to be balanced
+/// and nested within <i>MAX_VALUE_DEPTH</i>, so a hostile document cannot
+/// get past the analysis and then exhaust the parser's stack. Valid
+/// documents use every fragment, which is assumed by the early checks.
+class QueryAnalyzer {
+ public:
+  /// \param options Weights and limits, which must outlive the analyzer.
+  explicit QueryAnalyzer(const QueryAnalysisOptions& options);
+
+  /// \brief Analyzes the next chunk of the document.
+  /// \param chunk Next bytes of the document.
+  /// \return The metrics of the definitions read so far, without expanding
+  /// fragment spreads, or the first limit they exceed.
+  Result<QueryMetrics, QueryAnalysisError> feed(std::string_view chunk);
+
+  /// \brief Analyzes the rest of the document and expands its fragment
+  /// spreads.
+  /// \return The metrics of the document or the first limit it exceeds.
+  Result<QueryMetrics, QueryAnalysisError> finish();
+
+ private:
+  /// \brief Expected meaning of the next name within a selection set.
+  enum Expectation : std::uint8_t {
+    EXPECT_FIELD,
+    EXPECT_ALIASED_FIELD,
+    EXPECT_SPREAD_TARGET,
+    EXPECT_TYPE_CONDITION,
+    EXPECT_DIRECTIVE_NAME,
+    /// \brief A field name was just read, so a ':' makes it an alias.
+    AFTER_FIELD_NAME
+  };
+
+  struct FragmentSpread {
+    std::string name_;
+    /// \brief Depth of the selection set containing the spread.
+    size_t depth_;
+    /// \brief Product of the list sizes the spread is nested within.
+    uint64_t multiplier_;
+  };
+
+  struct Definition {
+    /// \brief Empty for operations.
+    std::string fragment_name_;
+    size_t offset_;
+    /// \brief Metrics of the definition's own fields.
+    QueryMetrics metrics_;
+    std::vector<FragmentSpread> spreads_;
+  };
+
+  const QueryAnalysisOptions& options_;
+  tokenization::Lexer lexer_;
+  std::vector<Definition> definitions_;
+  /// \brief Metrics of every definition read so far, without expanding
+  /// fragment spreads.
+  QueryMetrics totals_ = QueryMetrics{};
+  /// \brief List size multiplier of each open selection set.
+  std::vector<uint64_t> multipliers_;
+  /// \brief Whether each open selection set is that of an inline fragment,
+  /// which adds no depth to the fields it selects.
+  std::vector<bool> inline_fragments_;
+  size_t inline_fragment_count_ = 0;
+  /// \brief A spread was read which has not been followed by a fragment name,
+  /// so the next selection set is that of an inline fragment.
+  bool is_inline_fragment_ = false;
+  Expectation expectation_ = EXPECT_FIELD;
+  bool is_definition_start_ = true;
+  bool expects_fragment_name_ = false;
+  /// \brief Weight of the field being read, which is only added once its
+  /// alias, if any, has been told apart from its name.
+  uint64_t pending_cost_ = 0;
+  /// \brief Largest list size given to the field being read.
+  uint64_t pending_list_size_ = 1;
+  size_t parenthesis_depth_ = 0;
+  /// \brief Closing bracket of each open list and object within the current
+  /// arguments, innermost last.
+  std::string value_closers_;
+  bool are_field_arguments_ = false;
+  bool expects_argument_value_ = false;
+  bool is_list_size_argument_ = false;
+  std::optional<QueryAnalysisError> error_;
+
+  /// \brief Number of open selection sets, not counting those of inline
+  /// fragments.
+  size_t selection_depth() const;
+
+  /// \brief Analyzes the tokens of the fed chunks.
+  Result<QueryMetrics, QueryAnalysisError> drain();
+
+  void analyze_token(const tokenization::Token& token, std::string_view value);
+
+  void analyze_definition_token(const tokenization::Token& token,
+                                std::string_view value);
+
+  void analyze_selection_token(const tokenization::Token& token,
+                               std::string_view value);
+
+  void analyze_argument_token(const tokenization::Token& token,
+                              std::string_view value);
+
+  /// \brief Adds the cost of the field being read, if any.
+  void commit_field(size_t offset);
+
+  void check_limits(size_t offset);
+
+  /// \brief Expands the fragment spreads of every definition.
+  /// \return Metrics of each definition, indexed like <i>definitions_</i>.
+  [[nodiscard]] std::vector<QueryMetrics> expand_fragment_spreads() const;
+};
+
+/// \brief Analyzes a whole document. It is lexed in chunks, so a document
+/// exceeding a limit is rejected without lexing the rest of it.
+/// \param source Executable document encoded as UTF-8.
+/// \param options Weights and limits.
+/// \return The metrics of the document or the first limit it exceeds.
+Result<QueryMetrics, QueryAnalysisError> analyze_query(
+    std::string_view source, const QueryAnalysisOptions& options);
+}  // namespace graphqlpp::language::analysis
+
+#endif  // QUERY_ANALYZER_H
@@ -0,0 +1,150 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "normalizer.h"
+
+#include <cstring>
+#include <utility>
+
+#include "../../instrumentation/metrics.h"
+#include "../tokenization/tokenizer.h"
+
+namespace graphqlpp::language::normalization {
+using tokenization::TokenType;
+
+namespace {
+constexpr size_t SHORT_COPY_SIZE = 16;
+
+/// \brief Whether two tokens of these types must be separated so they are
+/// not read back as a single token.
+bool is_word(const TokenType type) {
+  return type == tokenization::NAME || type == tokenization::INT_VALUE ||
+         type == tokenization::FLOAT_VALUE;
+}
+
+/// \brief Whether a token of the given type must be separated from the one
+/// before it. Besides words, strings must be separated from one another: an
+/// empty string followed by another string would be read back as a block
+/// string.
+bool needs_separator(const TokenType previous, const TokenType type) {
+  return (is_word(previous) && is_word(type)) ||
+         (previous == tokenization::STRING_VALUE &&
+          type == tokenization::STRING_VALUE);
+}
+
+/// \brief Placeholder of a literal, or an empty view if it is kept.
+std::string_view get_placeholder(const TokenType type) {
+  switch (type) {
+    case tokenization::INT_VALUE:
+    case tokenization::FLOAT_VALUE:
+      return "0";
+    case tokenization::STRING_VALUE:
+      return "\"\"";
+    default:
+      return std::string_view();
+  }
+}
+}  // namespace
+
+void normalize(const std::string_view source,
+               const tokenization::TokenBuffer& tokens,
+               const NormalizeOptions& options, std::string& output) {
+  [[maybe_unused]] const instrumentation::PhaseTimer<> timer(
+      instrumentation::Phase::NORMALIZE);
+
+  // Every space and placeholder replaces at least as many source bytes, so
+  // the canonical form is never longer than the source. Writing through a
+  // pointer avoids a capacity check for each token.
+  const size_t initial_size = output.size();
+  output.resize(initial_size + source.size() + SHORT_COPY_SIZE);
+  char* const begin = output.data() + initial_size;
+  char* out = begin;
+
+  // Most runs are short, so they are copied as a fixed-size block, which
+  // compiles to two moves instead of a call, whenever the source has enough
+  // bytes left. The output is padded for the bytes written past the run.
+  const auto copy = [&out, source](const size_t start, const size_t end) {
+    if (end - start <= SHORT_COPY_SIZE &&
+        source.size() - start >= SHORT_COPY_SIZE) {
+      std::memcpy(out, source.data() + start, SHORT_COPY_SIZE);
+    } else {
+      std::memcpy(out, source.data() + start, end - start);
+    }
+
+    out += end - start;
+  };
+
+  // Source bytes [run_start, run_end) are pending to be copied.
+  size_t run_start = 0;
+  size_t run_end = 0;
+  // Punctuators never need a separator, so they stand for no token.
+  TokenType previous_type = tokenization::PUNCTUATOR;
+
+  for (size_t i = 0; i < tokens.size(); i++) {
+    if (tokens.is_ignored(i)) {
+      continue;
+    }
+
+    const TokenType type = tokens.get_type(i);
+    const size_t offset = tokens.get_offset(i);
+    const size_t end = offset + tokens.get_length(i);
+    const bool needs_space = needs_separator(previous_type, type);
+    previous_type = type;
+
+    const std::string_view placeholder =
+        options.replace_literals_ ? get_placeholder(type) : std::string_view();
+
+    if (!placeholder.empty()) {
+      copy(run_start, run_end);
+
+      if (needs_space) {
+        *out++ = ' ';
+      }
+
+      std::memcpy(out, placeholder.data(), placeholder.size());
+      out += placeholder.size();
+      run_start = end;
+      run_end = end;
+      continue;
+    }
+
+    // Words which need a space between them are never adjacent, as they
+    // would have been scanned as a single token. Adjacent strings are read
+    // back as they were scanned, so they are kept as they are.
+    if (offset != run_end) {
+      copy(run_start, run_end);
+
+      if (needs_space) {
+        *out++ = ' ';
+      }
+
+      run_start = offset;
+    }
+
+    run_end = end;
+  }
+
+  copy(run_start, run_end);
+  output.resize(initial_size + static_cast<size_t>(out - begin));
+}
+
+Result<NormalizedDocument, tokenization::TokenizeError> normalize(
+    const std::string_view source, const NormalizeOptions& options) {
+  tokenization::TokenBuffer tokens = tokenization::TokenBuffer();
+  Result<size_t, tokenization::TokenizeError> r =
+      tokenization::tokenize<tokenization::SIGNIFICANT_TOKENS_POLICY>(source,
+                                                                      tokens);
+
+  if (!r.IsOk()) {
+    return Result<NormalizedDocument, tokenization::TokenizeError>::Err(
+        r.UnwrapErr());
+  }
+
+  NormalizedDocument document =
+      NormalizedDocument{.text_ = std::string(), .signature_ = {}};
+  normalize(source, tokens, options, document.text_);
+  document.signature_ = compute_signature(document.text_);
+
+  return Result<NormalizedDocument, tokenization::TokenizeError>::Ok(
+      std::move(document));
+}
+}  // namespace graphqlpp::language::normalization
@@ -0,0 +1,50 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef NORMALIZER_H
+#define NORMALIZER_H
+
+#include <string>
+#include <string_view>
+
+#include "../../result.h"
+#include "../tokenization/token_buffer.h"
+#include "../tokenization/tokenize_error.h"
+#include "signature.h"
+
+namespace graphqlpp::language::normalization {
+struct NormalizeOptions {
+  /// \brief Whether IntValue and FloatValue literals are replaced by 0, and
+  /// StringValue literals by "", so operations which only differ in their
+  /// inlined arguments share a signature. Names, including enum values and
+  /// booleans, are kept.
+  bool replace_literals_ = false;
+};
+
+/// \brief Canonical form of a document and its signature.
+struct NormalizedDocument {
+  std::string text_;
+  QuerySignature signature_;
+};
+
+/// \brief Appends the canonical form of a document: its lexical tokens with
+/// a single space only between those which would otherwise merge, such as
+/// two names. Runs of tokens which are already adjacent within the source
+/// are copied at once.
+/// \param source UTF-8 source text the tokens were tokenized from.
+/// \param tokens Tokens of the source. Ignored tokens are skipped, so they
+/// may or may not be present.
+/// \param options Normalization options.
+/// \param output String where the canonical form is appended.
+void normalize(std::string_view source, const tokenization::TokenBuffer& tokens,
+               const NormalizeOptions& options, std::string& output);
+
+/// \brief Tokenizes a document and computes its canonical form and signature.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \param options Normalization options.
+/// \return The normalized document or an <i>TokenizeError</i>.
+Result<NormalizedDocument, tokenization::TokenizeError> normalize(
+    std::string_view source,
+    const NormalizeOptions& options = NormalizeOptions());
+}  // namespace graphqlpp::language::normalization
+
+#endif  // NORMALIZER_H
@@ -0,0 +1,113 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "signature.h"
+
+namespace graphqlpp::language::normalization {
+namespace {
+constexpr size_t BLOCK_SIZE = 16;
+constexpr uint64_t C1 = 0x87c37b91114253d5;
+constexpr uint64_t C2 = 0x4cf5ad432745937f;
+
+uint64_t rotate_left(const uint64_t value, const int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+/// \brief Reads 8 bytes in little-endian order, which compilers turn into a
+/// single load on little-endian machines.
+uint64_t load_little_endian(const unsigned char* bytes) {
+  uint64_t value = 0;
+
+  for (size_t i = 0; i < 8; i++) {
+    value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+
+  return value;
+}
+
+uint64_t mix_k1(uint64_t k1) {
+  k1 *= C1;
+  k1 = rotate_left(k1, 31);
+  return k1 * C2;
+}
+
+uint64_t mix_k2(uint64_t k2) {
+  k2 *= C2;
+  k2 = rotate_left(k2, 33);
+  return k2 * C1;
+}
+
+uint64_t finalize(uint64_t k) {
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccd;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53;
+  return k ^ (k >> 33);
+}
+}  // namespace
+
+QuerySignature compute_signature(const std::string_view data,
+                                 const uint64_t seed) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+  const size_t block_count = data.size() / BLOCK_SIZE;
+  uint64_t h1 = seed;
+  uint64_t h2 = seed;
+
+  for (size_t i = 0; i < block_count; i++) {
+    const unsigned char* block = bytes + i * BLOCK_SIZE;
+
+    h1 ^= mix_k1(load_little_endian(block));
+    h1 = rotate_left(h1, 27);
+    h1 += h2;
+    h1 = h1 * 5 + 0x52dce729;
+
+    h2 ^= mix_k2(load_little_endian(block + 8));
+    h2 = rotate_left(h2, 31);
+    h2 += h1;
+    h2 = h2 * 5 + 0x38495ab5;
+  }
+
+  const unsigned char* tail = bytes + block_count * BLOCK_SIZE;
+  const size_t tail_size = data.size() % BLOCK_SIZE;
+  uint64_t k1 = 0;
+  uint64_t k2 = 0;
+
+  for (size_t i = tail_size; i > 8; i--) {
+    k2 |= static_cast<uint64_t>(tail[i - 1]) << (8 * (i - 9));
+  }
+
+  for (size_t i = tail_size < 8 ? tail_size : 8; i > 0; i--) {
+    k1 |= static_cast<uint64_t>(tail[i - 1]) << (8 * (i - 1));
+  }
+
+  if (tail_size > 8) {
+    h2 ^= mix_k2(k2);
+  }
+
+  if (tail_size > 0) {
+    h1 ^= mix_k1(k1);
+  }
+
+  h1 ^= data.size();
+  h2 ^= data.size();
+  h1 += h2;
+  h2 += h1;
+  h1 = finalize(h1);
+  h2 = finalize(h2);
+  h1 += h2;
+  h2 += h1;
+
+  return QuerySignature{.low_ = h1, .high_ = h2};
+}
+
+std::string to_hex(const QuerySignature& signature) {
+  constexpr char DIGITS[] = "0123456789abcdef";
+  std::string hex(32, '0');
+
+  for (size_t i = 0; i < 16; i++) {
+    hex[15 - i] = DIGITS[(signature.high_ >> (4 * i)) & 0xF];
+    hex[31 - i] = DIGITS[(signature.low_ >> (4 * i)) & 0xF];
+  }
+
+  return hex;
+}
+}  // namespace graphqlpp::language::normalization
@@ -0,0 +1,39 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef SIGNATURE_H
+#define SIGNATURE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace graphqlpp::language::normalization {
+/// \brief 128-bit signature of a normalized document. Either half can be used
+/// on its own where 64 bits are enough.
+struct QuerySignature {
+  uint64_t low_;
+  uint64_t high_;
+
+  bool operator==(const QuerySignature& other) const = default;
+};
+
+/// \brief MurmurHash3 (x64, 128-bit) of the given bytes. It reads the input
+/// in little-endian order regardless of the platform, so signatures are
+/// stable across machines.
+/// \param data Bytes to hash.
+/// \param seed Initial value of both halves of the state.
+QuerySignature compute_signature(std::string_view data, uint64_t seed = 0);
+
+/// \brief Lowercase hexadecimal representation of a signature, high half
+/// first.
+std::string to_hex(const QuerySignature& signature);
+
+struct QuerySignatureHash {
+  size_t operator()(const QuerySignature& signature) const {
+    return static_cast<size_t>(signature.low_);
+  }
+};
+}  // namespace graphqlpp::language::normalization
+
+#endif  // SIGNATURE_H
@@ -0,0 +1,113 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace graphqlpp::language::parsing {
+Arena::Arena(const size_t block_size, std::pmr::memory_resource* upstream)
+    : upstream_(upstream),
+      blocks_(upstream),
+      block_size_(std::max<size_t>(block_size, alignof(std::max_align_t))) {}
+
+Arena::~Arena() {
+  for (const Block& block : blocks_) {
+    release(block);
+  }
+}
+
+Arena::Arena(Arena&& other) noexcept
+    : upstream_(other.upstream_),
+      blocks_(std::move(other.blocks_)),
+      block_size_(other.block_size_),
+      used_(std::exchange(other.used_, 0)),
+      allocated_size_(std::exchange(other.allocated_size_, 0)) {
+  other.blocks_.clear();
+}
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  for (const Block& block : blocks_) {
+    release(block);
+  }
+
+  // Blocks are swapped rather than moved, since the vectors may use
+  // different memory resources.
+  blocks_.clear();
+  std::swap(upstream_, other.upstream_);
+  std::swap(blocks_, other.blocks_);
+  block_size_ = other.block_size_;
+  used_ = std::exchange(other.used_, 0);
+  allocated_size_ = std::exchange(other.allocated_size_, 0);
+
+  return *this;
+}
+
+void* Arena::allocate(const size_t size, const size_t alignment) {
+  if (!blocks_.empty()) {
+    const Block& block = blocks_.back();
+    const auto address = reinterpret_cast<uintptr_t>(block.data_);
+    const size_t start =
+        ((address + used_ + alignment - 1) & ~(alignment - 1)) - address;
+
+    if (start + size <= block.size_) {
+      used_ = start + size;
+      allocated_size_ += size;
+
+      return block.data_ + start;
+    }
+  }
+
+  // Blocks are aligned for any fundamental type, so a new block only needs
+  // room for the object itself unless the alignment is over-aligned.
+  add_block(size + (alignment > alignof(std::max_align_t) ? alignment : 0));
+
+  return allocate(size, alignment);
+}
+
+void Arena::reset() {
+  // The last block is the largest one, so it is the one worth keeping.
+  if (blocks_.size() > 1) {
+    std::swap(blocks_.front(), blocks_.back());
+
+    for (size_t i = 1; i < blocks_.size(); i++) {
+      release(blocks_[i]);
+    }
+
+    blocks_.resize(1);
+  }
+
+  used_ = 0;
+  allocated_size_ = 0;
+}
+
+size_t Arena::get_reserved_size() const {
+  size_t reserved_size = 0;
+
+  for (const Block& block : blocks_) {
+    reserved_size += block.size_;
+  }
+
+  return reserved_size;
+}
+
+void Arena::add_block(const size_t minimum_size) {
+  // Blocks double in size so large documents need few of them.
+  const size_t block_size = std::max(
+      minimum_size, blocks_.empty() ? block_size_ : blocks_.back().size_ * 2);
+
+  blocks_.push_back(Block{
+      .data_ = static_cast<std::byte*>(
+          upstream_->allocate(block_size, alignof(std::max_align_t))),
+      .size_ = block_size});
+  used_ = 0;
+}
+
+void Arena::release(const Block& block) {
+  upstream_->deallocate(block.data_, block.size_, alignof(std::max_align_t));
+}
+}  // namespace graphqlpp::language::parsing
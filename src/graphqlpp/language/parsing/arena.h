@@ -0,0 +1,104 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace graphqlpp::language::parsing {
+/// \brief Bump allocator. Objects are carved out of large blocks and are never
+/// freed individually, instead every object is released at once when the
+/// arena is reset or destroyed. Only trivially destructible objects can be
+/// created, since their destructors are never run.
+///
+/// Blocks are taken from an upstream memory resource, so a request-scoped
+/// resource can back every arena of the request.
+class Arena {
+ public:
+  static constexpr size_t DEFAULT_BLOCK_SIZE = 16 * 1024;
+
+  /// \param block_size Size of the first block.
+  /// \param upstream Memory resource the blocks are taken from, which must
+  /// outlive the arena.
+  explicit Arena(
+      size_t block_size = DEFAULT_BLOCK_SIZE,
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+  ~Arena();
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+  Arena(Arena&& other) noexcept;
+  Arena& operator=(Arena&& other) noexcept;
+
+  /// \brief Reserves uninitialized memory which lives as long as the arena.
+  /// \param size Amount of bytes.
+  /// \param alignment Alignment of the returned address, a power of two.
+  /// \return Address of the reserved memory.
+  void* allocate(size_t size, size_t alignment);
+
+  /// \brief Creates an object within the arena.
+  /// \param args Values used to initialize the object.
+  /// \return Pointer to the created object.
+  template <typename T, typename... Args>
+  T* create(Args&&... args) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Arena objects are released without running destructors.");
+
+    return new (allocate(sizeof(T), alignof(T)))
+        T{std::forward<Args>(args)...};
+  }
+
+  /// \brief Reserves uninitialized room for a sequence of objects.
+  /// \param count Amount of objects.
+  /// \return Address of the first object.
+  template <typename T>
+  T* allocate_array(const size_t count) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Arena objects are released without running destructors.");
+
+    return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+  }
+
+  /// \brief Releases every object created within the arena, keeping the
+  /// largest block so it can be reused.
+  void reset();
+
+  /// \brief Amount of bytes handed out since the last reset.
+  [[nodiscard]] size_t get_allocated_size() const { return allocated_size_; }
+
+  /// \brief Amount of bytes reserved from the upstream memory resource for
+  /// the arena's blocks.
+  [[nodiscard]] size_t get_reserved_size() const;
+
+  /// \brief Memory resource the blocks are taken from.
+  [[nodiscard]] std::pmr::memory_resource* get_upstream_resource() const {
+    return upstream_;
+  }
+
+ private:
+  struct Block {
+    std::byte* data_;
+    size_t size_;
+  };
+
+  std::pmr::memory_resource* upstream_;
+  std::pmr::vector<Block> blocks_;
+  size_t block_size_;
+  /// \brief Bytes of the last block already handed out.
+  size_t used_ = 0;
+  size_t allocated_size_ = 0;
+
+  /// \brief Appends a block able to hold at least the given amount of bytes.
+  void add_block(size_t minimum_size);
+
+  /// \brief Returns a block to the upstream memory resource.
+  void release(const Block& block);
+};
+}  // namespace graphqlpp::language::parsing
+
+#endif  // ARENA_H
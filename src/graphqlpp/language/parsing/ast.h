@@ -0,0 +1,185 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef AST_H
+#define AST_H
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace graphqlpp::language::parsing {
+enum class NodeKind {
+  DOCUMENT,
+  // Definitions
+  OPERATION_DEFINITION,
+  FRAGMENT_DEFINITION,
+  VARIABLE_DEFINITION,
+  // Selections
+  SELECTION_SET,
+  FIELD,
+  FRAGMENT_SPREAD,
+  INLINE_FRAGMENT,
+  ARGUMENT,
+  DIRECTIVE,
+  // Values
+  VARIABLE,
+  INT_VALUE,
+  FLOAT_VALUE,
+  STRING_VALUE,
+  BOOLEAN_VALUE,
+  NULL_VALUE,
+  ENUM_VALUE,
+  LIST_VALUE,
+  OBJECT_VALUE,
+  OBJECT_FIELD,
+  // Types
+  NAMED_TYPE,
+  LIST_TYPE,
+  NON_NULL_TYPE
+};
+
+enum class OperationType { QUERY, MUTATION, SUBSCRIPTION };
+
+/// \brief Common part of every AST node. Nodes live within the <i>Arena</i>
+/// they were parsed into, and their names and values reference the source
+/// text, so both must outlive them.
+struct Node {
+  NodeKind kind_;
+  /// \brief Code unit of the source where the node starts.
+  size_t offset_;
+};
+
+struct Value : Node {};
+
+struct Variable : Value {
+  /// \brief Name without the leading '$'.
+  std::string_view name_;
+};
+
+struct IntValue : Value {
+  std::string_view value_;
+};
+
+struct FloatValue : Value {
+  std::string_view value_;
+};
+
+struct StringValue : Value {
+  /// \brief Characters between the quotes, with escape sequences and block
+  /// string indentation left untouched.
+  std::string_view raw_value_;
+  bool block_;
+  /// \brief Whether the raw value has to be decoded to get the string's
+  /// value, through <i>decode_string</i> or <i>decode_block_string</i>.
+  /// Otherwise, the raw value is the string's value.
+  bool escaped_;
+};
+
+struct BooleanValue : Value {
+  bool value_;
+};
+
+struct NullValue : Value {};
+
+struct EnumValue : Value {
+  std::string_view value_;
+};
+
+struct ListValue : Value {
+  std::span<const Value* const> values_;
+};
+
+struct ObjectField : Node {
+  std::string_view name_;
+  const Value* value_;
+};
+
+struct ObjectValue : Value {
+  std::span<const ObjectField* const> fields_;
+};
+
+struct Type : Node {};
+
+struct NamedType : Type {
+  std::string_view name_;
+};
+
+struct ListType : Type {
+  const Type* type_;
+};
+
+struct NonNullType : Type {
+  const Type* type_;
+};
+
+struct Argument : Node {
+  std::string_view name_;
+  const Value* value_;
+};
+
+struct Directive : Node {
+  /// \brief Name without the leading '@'.
+  std::string_view name_;
+  std::span<const Argument* const> arguments_;
+};
+
+struct Selection : Node {};
+
+struct SelectionSet : Node {
+  std::span<const Selection* const> selections_;
+};
+
+struct Field : Selection {
+  /// \brief Empty if the field has no alias.
+  std::string_view alias_;
+  std::string_view name_;
+  std::span<const Argument* const> arguments_;
+  std::span<const Directive* const> directives_;
+  /// \brief Null if the field is a leaf.
+  const SelectionSet* selection_set_;
+};
+
+struct FragmentSpread : Selection {
+  std::string_view name_;
+  std::span<const Directive* const> directives_;
+};
+
+struct InlineFragment : Selection {
+  /// \brief Null if the fragment has no type condition.
+  const NamedType* type_condition_;
+  std::span<const Directive* const> directives_;
+  const SelectionSet* selection_set_;
+};
+
+struct VariableDefinition : Node {
+  const Variable* variable_;
+  const Type* type_;
+  /// \brief Null if the variable has no default value.
+  const Value* default_value_;
+  std::span<const Directive* const> directives_;
+};
+
+struct Definition : Node {};
+
+struct OperationDefinition : Definition {
+  OperationType operation_;
+  /// \brief Empty if the operation is anonymous.
+  std::string_view name_;
+  std::span<const VariableDefinition* const> variable_definitions_;
+  std::span<const Directive* const> directives_;
+  const SelectionSet* selection_set_;
+};
+
+struct FragmentDefinition : Definition {
+  std::string_view name_;
+  const NamedType* type_condition_;
+  std::span<const Directive* const> directives_;
+  const SelectionSet* selection_set_;
+};
+
+struct Document : Node {
+  std::span<const Definition* const> definitions_;
+};
+}  // namespace graphqlpp::language::parsing
+
+#endif  // AST_H
@@ -0,0 +1,47 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "parse_error.h"
+
+#include "../../execution/json_writer.h"
+
+namespace graphqlpp::language::parsing {
+std::string_view get_error_code_name(const ParseErrorCode code) {
+  switch (code) {
+    case TOKENIZE_FAILED:
+      return "TOKENIZE_FAILED";
+    case UNEXPECTED_TOKEN:
+      return "UNEXPECTED_TOKEN";
+    case UNEXPECTED_END_OF_DOCUMENT:
+      return "UNEXPECTED_END_OF_DOCUMENT";
+    case NESTING_TOO_DEEP:
+    default:
+      return "NESTING_TOO_DEEP";
+  }
+}
+
+std::string ParseError::get_message() const {
+  switch (code_) {
+    case TOKENIZE_FAILED:
+      return std::string(tokenization::get_error_message(tokenize_code_));
+    case UNEXPECTED_TOKEN:
+      return "Detected an unexpected token, expected " +
+             std::string(expected_) + ".";
+    case UNEXPECTED_END_OF_DOCUMENT:
+      return "Detected an unexpected end of document, expected " +
+             std::string(expected_) + ".";
+    case NESTING_TOO_DEEP:
+    default:
+      return "Detected selection sets, values or types nested too deeply.";
+  }
+}
+
+void ParseError::write_json(std::string& output) const {
+  execution::JsonWriter writer =
+      execution::JsonWriter(execution::JsonWriter::ERROR_CHUNK_SIZE);
+  writer.write_error(get_message(), std::span(&location_, 1), {},
+                     code_ == TOKENIZE_FAILED
+                         ? tokenization::get_error_code_name(tokenize_code_)
+                         : get_error_code_name(code_));
+  output += writer.to_string();
+}
+}  // namespace graphqlpp::language::parsing
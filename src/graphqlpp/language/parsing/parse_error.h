@@ -0,0 +1,95 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef PARSE_ERROR_H
+#define PARSE_ERROR_H
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../tokenization/location.h"
+#include "../tokenization/tokenize_error.h"
+
+namespace graphqlpp::language::parsing {
+enum ParseErrorCode : std::uint8_t {
+  /// \brief The source could not be tokenized.
+  TOKENIZE_FAILED,
+  UNEXPECTED_TOKEN,
+  UNEXPECTED_END_OF_DOCUMENT,
+  /// \brief Selection sets, values or types are nested deeper than
+  /// <i>MAX_NESTING_DEPTH</i>.
+  NESTING_TOO_DEEP
+};
+
+/// \brief Name of an error code. Errors wrapping a tokenization error are
+/// reported with the tokenization error's name instead.
+/// \param code Error code.
+/// \return Statically allocated name.
+std::string_view get_error_code_name(ParseErrorCode code);
+
+/// \brief Compact parsing error. Like <i>TokenizeError</i>, it only keeps
+/// what went wrong and where, and builds its message when asked for it.
+class ParseError {
+ public:
+  /// \param code What went wrong.
+  /// \param expected Statically allocated description of what was expected
+  /// instead, such as "a name" or "'{'".
+  /// \param offset Byte of the source where it went wrong.
+  /// \param location Line and column of the offset.
+  ParseError(const ParseErrorCode code, const std::string_view expected,
+             const size_t offset, const tokenization::Location location)
+      : code_(code),
+        tokenize_code_(tokenization::INVALID_CHARACTER),
+        expected_(expected),
+        offset_(offset),
+        location_(location) {}
+
+  /// \brief Wraps the error of the source's tokenization.
+  explicit ParseError(const tokenization::TokenizeError& error)
+      : code_(TOKENIZE_FAILED),
+        tokenize_code_(error.get_code()),
+        offset_(error.get_offset()),
+        location_(error.get_location()) {}
+
+  [[nodiscard]] ParseErrorCode get_code() const { return code_; }
+
+  /// \brief Code of the tokenization error, if the code is
+  /// <i>TOKENIZE_FAILED</i>.
+  [[nodiscard]] tokenization::TokenizeErrorCode get_tokenize_code() const {
+    return tokenize_code_;
+  }
+
+  /// \brief Byte of the source where the error was detected.
+  [[nodiscard]] size_t get_offset() const { return offset_; }
+
+  /// \brief Line and column where the error was detected.
+  [[nodiscard]] tokenization::Location get_location() const {
+    return location_;
+  }
+
+  /// \brief Locations of the error, as reported within a GraphQL response.
+  [[nodiscard]] std::optional<std::vector<tokenization::Location>>
+  get_locations() const {
+    return std::vector<tokenization::Location>{location_};
+  }
+
+  /// \brief Formats the human-readable message of the error.
+  [[nodiscard]] std::string get_message() const;
+
+  /// \brief Appends the error as an entry of a GraphQL response's "errors"
+  /// list: its message, locations and extensions with the error code.
+  /// \param output String where the JSON object is appended.
+  void write_json(std::string& output) const;
+
+ private:
+  ParseErrorCode code_;
+  tokenization::TokenizeErrorCode tokenize_code_;
+  std::string_view expected_;
+  size_t offset_;
+  tokenization::Location location_;
+};
+}  // namespace graphqlpp::language::parsing
+
+#endif  // PARSE_ERROR_H
@@ -0,0 +1,729 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "parser.h"
+
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../../instrumentation/metrics.h"
+#include "../tokenization/line_index.h"
+#include "../tokenization/token.h"
+#include "../tokenization/tokenizer.h"
+
+namespace graphqlpp::language::parsing {
+namespace {
+using tokenization::describe_punctuator;
+using tokenization::Location;
+using tokenization::TokenBuffer;
+using tokenization::TokenizeError;
+using tokenization::TokenType;
+
+constexpr size_t BLOCK_STRING_DELIMITER_LENGTH = 3;
+
+/// \brief Recursive descent parser over the lexical tokens of a buffer.
+/// Parsing stops at the first error, which is kept until the parser is done.
+class Parser {
+ public:
+  Parser(const std::string_view source, const TokenBuffer& tokens,
+         Arena& arena)
+      : source_(source),
+        tokens_(tokens),
+        arena_(arena),
+        pending_(arena.get_upstream_resource()) {
+    skip_ignored_tokens();
+  }
+
+  const Document* parse_document() {
+    Document* document = create<Document>(NodeKind::DOCUMENT, 0);
+    const size_t start = pending_.size();
+
+    if (is_at_end()) {
+      fail("a definition");
+      return nullptr;
+    }
+
+    while (!is_at_end()) {
+      const Definition* definition = parse_definition();
+
+      if (definition == nullptr) {
+        return nullptr;
+      }
+
+      pending_.push_back(definition);
+    }
+
+    document->definitions_ = take_pending<Definition>(start);
+
+    return document;
+  }
+
+  ParseError take_error() { return std::move(error_.value()); }
+
+ private:
+  std::string_view source_;
+  const TokenBuffer& tokens_;
+  Arena& arena_;
+  /// \brief Index of the current lexical token.
+  size_t position_ = 0;
+  /// \brief Elements of the lists being parsed. Nested lists push their
+  /// elements on top of the enclosing ones, and every list is copied into
+  /// the arena once complete, so its size is known.
+  std::pmr::vector<const Node*> pending_;
+  std::optional<ParseError> error_;
+  /// \brief Selection sets, values and types being parsed, each of which
+  /// encloses the next one.
+  size_t depth_ = 0;
+
+  /// \brief Counts a level of nesting for as long as it lives, and fails
+  /// the parser once the levels exceed <i>MAX_NESTING_DEPTH</i>.
+  class NestingLevel {
+   public:
+    explicit NestingLevel(Parser& parser) : parser_(parser) {
+      if (++parser_.depth_ > MAX_NESTING_DEPTH && !parser_.has_failed()) {
+        parser_.error_ = ParseError(NESTING_TOO_DEEP, "", parser_.offset(),
+                                    parser_.get_location());
+      }
+    }
+
+    ~NestingLevel() { parser_.depth_--; }
+
+    NestingLevel(const NestingLevel&) = delete;
+    NestingLevel& operator=(const NestingLevel&) = delete;
+
+    /// \brief Whether the level is too deep to be parsed.
+    [[nodiscard]] bool is_too_deep() const {
+      return parser_.depth_ > MAX_NESTING_DEPTH;
+    }
+
+   private:
+    Parser& parser_;
+  };
+
+  [[nodiscard]] bool is_at_end() const {
+    return position_ >= tokens_.size();
+  }
+
+  [[nodiscard]] TokenType type() const { return tokens_.get_type(position_); }
+
+  [[nodiscard]] size_t offset() const {
+    return is_at_end() ? source_.size() : tokens_.get_offset(position_);
+  }
+
+  [[nodiscard]] std::string_view value() const {
+    return source_.substr(tokens_.get_offset(position_),
+                          tokens_.get_length(position_));
+  }
+
+  [[nodiscard]] bool is_punctuator(const std::string_view punctuator) const {
+    return !is_at_end() && type() == tokenization::PUNCTUATOR &&
+           value() == punctuator;
+  }
+
+  [[nodiscard]] bool is_keyword(const std::string_view keyword) const {
+    return !is_at_end() && type() == tokenization::NAME && value() == keyword;
+  }
+
+  void skip_ignored_tokens() {
+    while (!is_at_end() && tokens_.is_ignored(position_)) {
+      position_++;
+    }
+  }
+
+  void advance() {
+    position_++;
+    skip_ignored_tokens();
+  }
+
+  bool accept_punctuator(const std::string_view punctuator) {
+    if (!is_punctuator(punctuator)) {
+      return false;
+    }
+
+    advance();
+
+    return true;
+  }
+
+  bool expect_punctuator(const std::string_view punctuator) {
+    if (accept_punctuator(punctuator)) {
+      return true;
+    }
+
+    fail(describe_punctuator(punctuator));
+
+    return false;
+  }
+
+  bool expect_name(std::string_view& name) {
+    if (is_at_end() || type() != tokenization::NAME) {
+      fail("a name");
+      return false;
+    }
+
+    name = value();
+    advance();
+
+    return true;
+  }
+
+  [[nodiscard]] bool has_failed() const { return error_.has_value(); }
+
+  /// \brief Records an error at the current token.
+  /// \param expected Statically allocated description of what was expected
+  /// instead.
+  void fail(const std::string_view expected) {
+    if (has_failed()) {
+      return;
+    }
+
+    error_ = ParseError(is_at_end() ? UNEXPECTED_END_OF_DOCUMENT
+                                    : UNEXPECTED_TOKEN,
+                        expected, offset(), get_location());
+  }
+
+  /// \brief Location of the current token, or of the end of the document.
+  /// It is only needed for errors, so the source is scanned on demand.
+  [[nodiscard]] Location get_location() const {
+    return tokenization::locate(source_, offset());
+  }
+
+  template <typename T>
+  T* create(const NodeKind kind, const size_t offset) {
+    T* node = arena_.create<T>();
+    node->kind_ = kind;
+    node->offset_ = offset;
+
+    return node;
+  }
+
+  /// \brief Moves the pending elements pushed since <i>start</i> into the
+  /// arena.
+  template <typename T>
+  std::span<const T* const> take_pending(const size_t start) {
+    const size_t count = pending_.size() - start;
+
+    if (count == 0) {
+      return {};
+    }
+
+    const T** items = arena_.allocate_array<const T*>(count);
+
+    for (size_t i = 0; i < count; i++) {
+      items[i] = static_cast<const T*>(pending_[start + i]);
+    }
+
+    pending_.resize(start);
+
+    return std::span<const T* const>(items, count);
+  }
+
+  const Definition* parse_definition() {
+    if (is_punctuator("{") || is_keyword("query") || is_keyword("mutation") ||
+        is_keyword("subscription")) {
+      return parse_operation_definition();
+    }
+
+    if (is_keyword("fragment")) {
+      return parse_fragment_definition();
+    }
+
+    fail("an operation or a fragment definition");
+
+    return nullptr;
+  }
+
+  const OperationDefinition* parse_operation_definition() {
+    OperationDefinition* operation =
+        create<OperationDefinition>(NodeKind::OPERATION_DEFINITION, offset());
+    operation->operation_ = OperationType::QUERY;
+
+    if (!is_punctuator("{")) {
+      if (is_keyword("mutation")) {
+        operation->operation_ = OperationType::MUTATION;
+      } else if (is_keyword("subscription")) {
+        operation->operation_ = OperationType::SUBSCRIPTION;
+      }
+
+      advance();
+
+      if (!is_at_end() && type() == tokenization::NAME) {
+        operation->name_ = value();
+        advance();
+      }
+
+      operation->variable_definitions_ = parse_variable_definitions();
+      operation->directives_ = parse_directives(false);
+
+      if (has_failed()) {
+        return nullptr;
+      }
+    }
+
+    operation->selection_set_ = parse_selection_set();
+
+    return operation->selection_set_ == nullptr ? nullptr : operation;
+  }
+
+  const FragmentDefinition* parse_fragment_definition() {
+    FragmentDefinition* fragment =
+        create<FragmentDefinition>(NodeKind::FRAGMENT_DEFINITION, offset());
+    advance();
+
+    if (is_keyword("on")) {
+      fail("a fragment name");
+      return nullptr;
+    }
+
+    if (!expect_name(fragment->name_)) {
+      return nullptr;
+    }
+
+    if (!is_keyword("on")) {
+      fail("'on'");
+      return nullptr;
+    }
+
+    advance();
+    fragment->type_condition_ = parse_named_type();
+    fragment->directives_ = parse_directives(false);
+
+    if (has_failed()) {
+      return nullptr;
+    }
+
+    fragment->selection_set_ = parse_selection_set();
+
+    return fragment->selection_set_ == nullptr ? nullptr : fragment;
+  }
+
+  std::span<const VariableDefinition* const> parse_variable_definitions() {
+    if (!accept_punctuator("(")) {
+      return {};
+    }
+
+    const size_t start = pending_.size();
+
+    do {
+      VariableDefinition* definition =
+          create<VariableDefinition>(NodeKind::VARIABLE_DEFINITION, offset());
+      definition->variable_ = parse_variable();
+
+      if (definition->variable_ == nullptr || !expect_punctuator(":")) {
+        return {};
+      }
+
+      definition->type_ = parse_type();
+
+      if (definition->type_ == nullptr) {
+        return {};
+      }
+
+      if (accept_punctuator("=")) {
+        definition->default_value_ = parse_value(true);
+      }
+
+      definition->directives_ = parse_directives(true);
+
+      if (has_failed()) {
+        return {};
+      }
+
+      pending_.push_back(definition);
+    } while (!accept_punctuator(")"));
+
+    return take_pending<VariableDefinition>(start);
+  }
+
+  const Variable* parse_variable() {
+    Variable* variable = create<Variable>(NodeKind::VARIABLE, offset());
+
+    if (!expect_punctuator("$") || !expect_name(variable->name_)) {
+      return nullptr;
+    }
+
+    return variable;
+  }
+
+  const Type* parse_type() {
+    const NestingLevel level = NestingLevel(*this);
+
+    if (level.is_too_deep()) {
+      return nullptr;
+    }
+
+    const size_t type_offset = offset();
+    const Type* type = nullptr;
+
+    if (accept_punctuator("[")) {
+      ListType* list_type = create<ListType>(NodeKind::LIST_TYPE, type_offset);
+      list_type->type_ = parse_type();
+
+      if (list_type->type_ == nullptr || !expect_punctuator("]")) {
+        return nullptr;
+      }
+
+      type = list_type;
+    } else {
+      type = parse_named_type();
+
+      if (type == nullptr) {
+        return nullptr;
+      }
+    }
+
+    if (!accept_punctuator("!")) {
+      return type;
+    }
+
+    NonNullType* non_null_type =
+        create<NonNullType>(NodeKind::NON_NULL_TYPE, type_offset);
+    non_null_type->type_ = type;
+
+    return non_null_type;
+  }
+
+  const NamedType* parse_named_type() {
+    NamedType* named_type = create<NamedType>(NodeKind::NAMED_TYPE, offset());
+
+    if (!expect_name(named_type->name_)) {
+      return nullptr;
+    }
+
+    return named_type;
+  }
+
+  std::span<const Directive* const> parse_directives(const bool is_const) {
+    const size_t start = pending_.size();
+
+    while (is_punctuator("@")) {
+      Directive* directive = create<Directive>(NodeKind::DIRECTIVE, offset());
+      advance();
+
+      if (!expect_name(directive->name_)) {
+        return {};
+      }
+
+      directive->arguments_ = parse_arguments(is_const);
+
+      if (has_failed()) {
+        return {};
+      }
+
+      pending_.push_back(directive);
+    }
+
+    return take_pending<Directive>(start);
+  }
+
+  std::span<const Argument* const> parse_arguments(const bool is_const) {
+    if (!accept_punctuator("(")) {
+      return {};
+    }
+
+    const size_t start = pending_.size();
+
+    do {
+      Argument* argument = create<Argument>(NodeKind::ARGUMENT, offset());
+
+      if (!expect_name(argument->name_) || !expect_punctuator(":")) {
+        return {};
+      }
+
+      argument->value_ = parse_value(is_const);
+
+      if (argument->value_ == nullptr) {
+        return {};
+      }
+
+      pending_.push_back(argument);
+    } while (!accept_punctuator(")"));
+
+    return take_pending<Argument>(start);
+  }
+
+  const SelectionSet* parse_selection_set() {
+    const NestingLevel level = NestingLevel(*this);
+
+    if (level.is_too_deep()) {
+      return nullptr;
+    }
+
+    SelectionSet* selection_set =
+        create<SelectionSet>(NodeKind::SELECTION_SET, offset());
+
+    if (!expect_punctuator("{")) {
+      return nullptr;
+    }
+
+    const size_t start = pending_.size();
+
+    do {
+      const Selection* selection = parse_selection();
+
+      if (selection == nullptr) {
+        return nullptr;
+      }
+
+      pending_.push_back(selection);
+    } while (!accept_punctuator("}"));
+
+    selection_set->selections_ = take_pending<Selection>(start);
+
+    return selection_set;
+  }
+
+  const Selection* parse_selection() {
+    if (is_punctuator("...")) {
+      return parse_fragment();
+    }
+
+    return parse_field();
+  }
+
+  const Field* parse_field() {
+    if (is_at_end() || type() != tokenization::NAME) {
+      fail("a selection");
+      return nullptr;
+    }
+
+    Field* field = create<Field>(NodeKind::FIELD, offset());
+    field->name_ = value();
+    advance();
+
+    if (accept_punctuator(":")) {
+      field->alias_ = field->name_;
+
+      if (!expect_name(field->name_)) {
+        return nullptr;
+      }
+    }
+
+    field->arguments_ = parse_arguments(false);
+    field->directives_ = parse_directives(false);
+
+    if (has_failed()) {
+      return nullptr;
+    }
+
+    if (is_punctuator("{")) {
+      field->selection_set_ = parse_selection_set();
+
+      if (field->selection_set_ == nullptr) {
+        return nullptr;
+      }
+    }
+
+    return field;
+  }
+
+  const Selection* parse_fragment() {
+    const size_t fragment_offset = offset();
+    advance();
+
+    if (!is_at_end() && type() == tokenization::NAME && !is_keyword("on")) {
+      FragmentSpread* spread =
+          create<FragmentSpread>(NodeKind::FRAGMENT_SPREAD, fragment_offset);
+      spread->name_ = value();
+      advance();
+      spread->directives_ = parse_directives(false);
+
+      return has_failed() ? nullptr : spread;
+    }
+
+    InlineFragment* fragment =
+        create<InlineFragment>(NodeKind::INLINE_FRAGMENT, fragment_offset);
+
+    if (is_keyword("on")) {
+      advance();
+      fragment->type_condition_ = parse_named_type();
+    }
+
+    fragment->directives_ = parse_directives(false);
+
+    if (has_failed()) {
+      return nullptr;
+    }
+
+    fragment->selection_set_ = parse_selection_set();
+
+    return fragment->selection_set_ == nullptr ? nullptr : fragment;
+  }
+
+  const Value* parse_value(const bool is_const) {
+    const NestingLevel level = NestingLevel(*this);
+
+    if (level.is_too_deep()) {
+      return nullptr;
+    }
+
+    const size_t value_offset = offset();
+
+    if (is_at_end()) {
+      fail("a value");
+      return nullptr;
+    }
+
+    if (is_punctuator("$")) {
+      if (is_const) {
+        fail("a constant value");
+        return nullptr;
+      }
+
+      return parse_variable();
+    }
+
+    if (accept_punctuator("[")) {
+      return parse_list_value(value_offset, is_const);
+    }
+
+    if (accept_punctuator("{")) {
+      return parse_object_value(value_offset, is_const);
+    }
+
+    const std::string_view token_value = value();
+
+    switch (type()) {
+      case tokenization::INT_VALUE: {
+        IntValue* int_value =
+            create<IntValue>(NodeKind::INT_VALUE, value_offset);
+        int_value->value_ = token_value;
+        advance();
+
+        return int_value;
+      }
+      case tokenization::FLOAT_VALUE: {
+        FloatValue* float_value =
+            create<FloatValue>(NodeKind::FLOAT_VALUE, value_offset);
+        float_value->value_ = token_value;
+        advance();
+
+        return float_value;
+      }
+      case tokenization::STRING_VALUE: {
+        StringValue* string_value =
+            create<StringValue>(NodeKind::STRING_VALUE, value_offset);
+        string_value->block_ =
+            token_value.size() >= 2 * BLOCK_STRING_DELIMITER_LENGTH &&
+            token_value.starts_with("\"\"\"");
+
+        const size_t delimiter_length =
+            string_value->block_ ? BLOCK_STRING_DELIMITER_LENGTH : 1;
+        string_value->raw_value_ = token_value.substr(
+            delimiter_length, token_value.size() - 2 * delimiter_length);
+        string_value->escaped_ = tokens_.is_escaped(position_);
+        advance();
+
+        return string_value;
+      }
+      case tokenization::NAME: {
+        advance();
+
+        if (token_value == "true" || token_value == "false") {
+          BooleanValue* boolean_value =
+              create<BooleanValue>(NodeKind::BOOLEAN_VALUE, value_offset);
+          boolean_value->value_ = token_value == "true";
+
+          return boolean_value;
+        }
+
+        if (token_value == "null") {
+          return create<NullValue>(NodeKind::NULL_VALUE, value_offset);
+        }
+
+        EnumValue* enum_value =
+            create<EnumValue>(NodeKind::ENUM_VALUE, value_offset);
+        enum_value->value_ = token_value;
+
+        return enum_value;
+      }
+      default:
+        fail("a value");
+        return nullptr;
+    }
+  }
+
+  const ListValue* parse_list_value(const size_t list_offset,
+                                    const bool is_const) {
+    ListValue* list = create<ListValue>(NodeKind::LIST_VALUE, list_offset);
+    const size_t start = pending_.size();
+
+    while (!accept_punctuator("]")) {
+      const Value* value = parse_value(is_const);
+
+      if (value == nullptr) {
+        return nullptr;
+      }
+
+      pending_.push_back(value);
+    }
+
+    list->values_ = take_pending<Value>(start);
+
+    return list;
+  }
+
+  const ObjectValue* parse_object_value(const size_t object_offset,
+                                        const bool is_const) {
+    ObjectValue* object =
+        create<ObjectValue>(NodeKind::OBJECT_VALUE, object_offset);
+    const size_t start = pending_.size();
+
+    while (!accept_punctuator("}")) {
+      ObjectField* field =
+          create<ObjectField>(NodeKind::OBJECT_FIELD, offset());
+
+      if (!expect_name(field->name_) || !expect_punctuator(":")) {
+        return nullptr;
+      }
+
+      field->value_ = parse_value(is_const);
+
+      if (field->value_ == nullptr) {
+        return nullptr;
+      }
+
+      pending_.push_back(field);
+    }
+
+    object->fields_ = take_pending<ObjectField>(start);
+
+    return object;
+  }
+};
+}  // namespace
+
+Result<const Document*, ParseError> parse(const std::string_view source,
+                                          const TokenBuffer& tokens,
+                                          Arena& arena) {
+  [[maybe_unused]] const instrumentation::PhaseTimer<> timer(
+      instrumentation::Phase::PARSE);
+  Parser parser = Parser(source, tokens, arena);
+  const Document* document = parser.parse_document();
+
+  if (document == nullptr) {
+    ParseError error = parser.take_error();
+    instrumentation::count_error(instrumentation::Phase::PARSE,
+                                 error.get_code());
+
+    return Result<const Document*, ParseError>::Err(error);
+  }
+
+  return Result<const Document*, ParseError>::Ok(document);
+}
+
+Result<const Document*, ParseError> parse(const std::string_view source,
+                                          Arena& arena) {
+  TokenBuffer tokens = TokenBuffer(arena.get_upstream_resource());
+  Result<size_t, TokenizeError> r =
+      tokenization::tokenize<tokenization::SIGNIFICANT_TOKENS_POLICY>(source,
+                                                                      tokens);
+
+  if (!r.IsOk()) {
+    return Result<const Document*, ParseError>::Err(ParseError(r.UnwrapErr()));
+  }
+
+  return parse(source, tokens, arena);
+}
+}  // namespace graphqlpp::language::parsing
@@ -0,0 +1,44 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <cstddef>
+#include <string_view>
+
+#include "../../result.h"
+#include "../tokenization/token_buffer.h"
+#include "arena.h"
+#include "ast.h"
+#include "parse_error.h"
+
+namespace graphqlpp::language::parsing {
+/// \brief Most selection sets, list or object values, or list types which
+/// may be nested within one another. The parser recurses for each level, so
+/// deeper documents are rejected instead of exhausting the stack.
+constexpr size_t MAX_NESTING_DEPTH = 256;
+
+/// \brief Parses a GraphQL executable document: operations, fragments,
+/// variables, directives and arguments.
+/// \param source UTF-8 source text the tokens were tokenized from. Names and
+/// values of the nodes reference it, so it must outlive the document.
+/// \param tokens Tokens of the source. Ignored tokens may be included or not.
+/// \param arena Arena where every node is created.
+/// \return The document's root node or a <i>ParseError</i>.
+Result<const Document*, ParseError> parse(
+    std::string_view source, const tokenization::TokenBuffer& tokens,
+    Arena& arena);
+
+/// \brief Tokenizes and parses a GraphQL executable document. Only the
+/// lexical tokens are kept, since the parser skips every other one. Every
+/// allocation made on the way comes from the arena's upstream resource.
+/// \param source UTF-8 source text. Names and values of the nodes reference
+/// it, so it must outlive the document.
+/// \param arena Arena where every node is created.
+/// \return The document's root node or a <i>ParseError</i>, which may come
+/// from the tokenization.
+Result<const Document*, ParseError> parse(std::string_view source,
+                                          Arena& arena);
+}  // namespace graphqlpp::language::parsing
+
+#endif  // PARSER_H
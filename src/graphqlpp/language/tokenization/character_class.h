@@ -0,0 +1,182 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef CHARACTER_CLASS_H
+#define CHARACTER_CLASS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace graphqlpp::language::tokenization {
+/// \brief Lexical class of a character, which is all the scanner needs to
+/// pick the next transition. Every character of a class behaves the same way.
+enum CharacterClass : std::uint8_t {
+  OTHER_CLASS,
+  WHITESPACE_CLASS,
+  LINE_TERMINATOR_CLASS,
+  COMMENT_CLASS,
+  COMMA_CLASS,
+  PUNCTUATOR_CLASS,
+  DOT_CLASS,
+  QUOTE_CLASS,
+  MINUS_CLASS,
+  PLUS_CLASS,
+  // Classes which may continue a name, kept last so they can be checked with
+  // a single comparison.
+  ZERO_CLASS,
+  DIGIT_CLASS,
+  EXPONENT_CLASS,
+  LETTER_CLASS,
+  CHARACTER_CLASS_COUNT
+};
+
+/// \brief Amount of characters covered by the dense lookup table.
+constexpr size_t ASCII_CHARACTER_COUNT = 128;
+
+constexpr std::array<CharacterClass, ASCII_CHARACTER_COUNT>
+make_character_classes() {
+  std::array<CharacterClass, ASCII_CHARACTER_COUNT> classes{};
+
+  for (char c = 'a'; c <= 'z'; c++) {
+    classes[c] = LETTER_CLASS;
+    classes[c - 'a' + 'A'] = LETTER_CLASS;
+  }
+
+  for (char c = '1'; c <= '9'; c++) {
+    classes[c] = DIGIT_CLASS;
+  }
+
+  for (const char c : {'!', '$', '&', '(', ')', ':', '=', '@', '[', ']', '{',
+                       '|', '}'}) {
+    classes[c] = PUNCTUATOR_CLASS;
+  }
+
+  classes['_'] = LETTER_CLASS;
+  classes['e'] = EXPONENT_CLASS;
+  classes['E'] = EXPONENT_CLASS;
+  classes['0'] = ZERO_CLASS;
+  classes['\t'] = WHITESPACE_CLASS;
+  classes[' '] = WHITESPACE_CLASS;
+  classes['\n'] = LINE_TERMINATOR_CLASS;
+  classes['\r'] = LINE_TERMINATOR_CLASS;
+  classes['#'] = COMMENT_CLASS;
+  classes[','] = COMMA_CLASS;
+  classes['.'] = DOT_CLASS;
+  classes['"'] = QUOTE_CLASS;
+  classes['-'] = MINUS_CLASS;
+  classes['+'] = PLUS_CLASS;
+
+  return classes;
+}
+
+/// \brief Class of every ASCII character, generated at compile time.
+inline constexpr std::array<CharacterClass, ASCII_CHARACTER_COUNT>
+    CHARACTER_CLASSES = make_character_classes();
+
+/// \brief Class of a code point. Only ASCII characters have a lexical
+/// meaning outside of strings and comments, so the rest are all
+/// <i>OTHER_CLASS</i>.
+constexpr CharacterClass classify(const char32_t s) {
+  return s < ASCII_CHARACTER_COUNT ? CHARACTER_CLASSES[s] : OTHER_CLASS;
+}
+
+constexpr bool is_digit_class(const CharacterClass c) {
+  return c == ZERO_CLASS || c == DIGIT_CLASS;
+}
+
+constexpr bool is_name_continue_class(const CharacterClass c) {
+  return c >= ZERO_CLASS;
+}
+
+/// \brief States of the number automaton. States from <i>INT_END</i> onwards
+/// are final, and are reached without consuming the current character.
+enum NumberState : std::uint8_t {
+  NUMBER_START,
+  NUMBER_SIGN,
+  NUMBER_ZERO,
+  NUMBER_INTEGER,
+  NUMBER_DOT,
+  NUMBER_FRACTION,
+  NUMBER_EXPONENT,
+  NUMBER_EXPONENT_SIGN,
+  NUMBER_EXPONENT_DIGITS,
+  INT_END,
+  FLOAT_END,
+  LEADING_ZERO_ERROR,
+  EXPECTED_DIGIT_ERROR
+};
+
+/// \brief Amount of states which still consume characters.
+constexpr size_t NUMBER_STATE_COUNT = INT_END;
+
+using NumberTransitions =
+    std::array<std::array<NumberState, CHARACTER_CLASS_COUNT>,
+               NUMBER_STATE_COUNT>;
+
+/// \brief Transitions of the automaton for IntValue and FloatValue. Numbers
+/// cannot be directly followed by a '.' or a name, so those characters lead
+/// to an error instead of ending the token.
+constexpr NumberTransitions make_number_transitions() {
+  NumberTransitions transitions{};
+
+  for (auto& row : transitions) {
+    row.fill(EXPECTED_DIGIT_ERROR);
+  }
+
+  const auto set_digits = [&](const NumberState from, const NumberState to) {
+    transitions[from][ZERO_CLASS] = to;
+    transitions[from][DIGIT_CLASS] = to;
+  };
+
+  // Valid ends of a number, with the characters which may not follow it.
+  const auto set_end = [&](const NumberState from, const NumberState end) {
+    for (size_t c = 0; c < CHARACTER_CLASS_COUNT; c++) {
+      const auto character_class = static_cast<CharacterClass>(c);
+
+      if (character_class != DOT_CLASS &&
+          !is_name_continue_class(character_class)) {
+        transitions[from][c] = end;
+      }
+    }
+  };
+
+  transitions[NUMBER_START][MINUS_CLASS] = NUMBER_SIGN;
+  transitions[NUMBER_START][ZERO_CLASS] = NUMBER_ZERO;
+  transitions[NUMBER_START][DIGIT_CLASS] = NUMBER_INTEGER;
+  transitions[NUMBER_SIGN][ZERO_CLASS] = NUMBER_ZERO;
+  transitions[NUMBER_SIGN][DIGIT_CLASS] = NUMBER_INTEGER;
+
+  set_end(NUMBER_ZERO, INT_END);
+  set_digits(NUMBER_ZERO, LEADING_ZERO_ERROR);
+  transitions[NUMBER_ZERO][DOT_CLASS] = NUMBER_DOT;
+  transitions[NUMBER_ZERO][EXPONENT_CLASS] = NUMBER_EXPONENT;
+
+  set_end(NUMBER_INTEGER, INT_END);
+  set_digits(NUMBER_INTEGER, NUMBER_INTEGER);
+  transitions[NUMBER_INTEGER][DOT_CLASS] = NUMBER_DOT;
+  transitions[NUMBER_INTEGER][EXPONENT_CLASS] = NUMBER_EXPONENT;
+
+  set_digits(NUMBER_DOT, NUMBER_FRACTION);
+
+  set_end(NUMBER_FRACTION, FLOAT_END);
+  set_digits(NUMBER_FRACTION, NUMBER_FRACTION);
+  transitions[NUMBER_FRACTION][EXPONENT_CLASS] = NUMBER_EXPONENT;
+
+  set_digits(NUMBER_EXPONENT, NUMBER_EXPONENT_DIGITS);
+  transitions[NUMBER_EXPONENT][MINUS_CLASS] = NUMBER_EXPONENT_SIGN;
+  transitions[NUMBER_EXPONENT][PLUS_CLASS] = NUMBER_EXPONENT_SIGN;
+
+  set_digits(NUMBER_EXPONENT_SIGN, NUMBER_EXPONENT_DIGITS);
+
+  set_end(NUMBER_EXPONENT_DIGITS, FLOAT_END);
+  set_digits(NUMBER_EXPONENT_DIGITS, NUMBER_EXPONENT_DIGITS);
+
+  return transitions;
+}
+
+/// \brief Number automaton, generated at compile time.
+inline constexpr NumberTransitions NUMBER_TRANSITIONS =
+    make_number_transitions();
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // CHARACTER_CLASS_H
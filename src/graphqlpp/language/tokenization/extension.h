@@ -1,11 +0,0 @@
-// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
-
-#ifndef EXTENSION_H
-#define EXTENSION_H
-#include <string>
-
-struct Extension {
-  std::string code_;
-};
-
-#endif  // EXTENSION_H
@@ -0,0 +1,69 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef FIXED_TOKEN_BUFFER_H
+#define FIXED_TOKEN_BUFFER_H
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+
+#include "token.h"
+#include "token_buffer.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief Container of at most <i>Capacity</i> tokens stored in place. It
+/// never allocates, so it can be filled within a constant expression and
+/// kept as a static table.
+/// \tparam Capacity Amount of tokens the container has room for.
+template <size_t Capacity>
+class FixedTokenBuffer {
+ public:
+  [[nodiscard]] constexpr size_t size() const { return size_; }
+  [[nodiscard]] static constexpr size_t capacity() { return Capacity; }
+  [[nodiscard]] constexpr bool empty() const { return size_ == 0; }
+
+  /// \brief Does nothing, as the room for the tokens is fixed. It lets the
+  /// container be filled by the tokenizer like any other.
+  constexpr void reserve(size_t) {}
+
+  /// \brief Appends a token. Throws an exception if the container is full,
+  /// which makes a constant expression filling it ill-formed.
+  constexpr void push_back(const Token& token) {
+    if (size_ == Capacity) {
+      throw std::length_error("Appended a token to a full FixedTokenBuffer.");
+    }
+
+    tokens_[size_++] = token;
+  }
+
+  [[nodiscard]] constexpr const Token& operator[](const size_t i) const {
+    return tokens_[i];
+  }
+
+  [[nodiscard]] constexpr const Token* begin() const { return tokens_.data(); }
+  [[nodiscard]] constexpr const Token* end() const {
+    return tokens_.data() + size_;
+  }
+
+  [[nodiscard]] constexpr std::span<const Token> get_tokens() const {
+    return std::span<const Token>(tokens_.data(), size_);
+  }
+
+  /// \brief Appends every token to a <i>TokenBuffer</i>, such as to parse
+  /// them.
+  void append_to(TokenBuffer& tokens) const {
+    tokens.reserve(tokens.size() + size_);
+
+    for (size_t i = 0; i < size_; i++) {
+      tokens.push_back(tokens_[i]);
+    }
+  }
+
+ private:
+  std::array<Token, Capacity> tokens_{};
+  size_t size_ = 0;
+};
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // FIXED_TOKEN_BUFFER_H
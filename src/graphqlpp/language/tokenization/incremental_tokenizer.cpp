@@ -0,0 +1,231 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "incremental_tokenizer.h"
+
+#include <algorithm>
+
+#include "line_index.h"
+#include "scanner.h"
+#include "source.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief Whether a byte continues a multi-byte UTF-8 character.
+constexpr bool is_continuation_byte(const char byte) {
+  return (static_cast<unsigned char>(byte) & 0xC0) == 0x80;
+}
+
+Result<size_t, TokenizeError> IncrementalTokenizer::reset(
+    const std::string_view source) {
+  tokens_.clear();
+  gap_start_ = 0;
+  gap_end_ = 0;
+  source_size_ = 0;
+  is_valid_ = true;
+
+  Result<size_t, TokenizeError> r =
+      apply_edit(source, TextEdit{.offset_ = 0,
+                                  .deleted_length_ = 0,
+                                  .inserted_length_ = source.size()});
+
+  if (!r.IsOk()) {
+    return r;
+  }
+
+  return Result<size_t, TokenizeError>::Ok(size());
+}
+
+Result<size_t, TokenizeError> IncrementalTokenizer::apply_edit(
+    const std::string_view source, const TextEdit& edit) {
+  // Failed edits are merged with this one into a single edit of the last
+  // valid document, which replaces every byte any of them touched.
+  const size_t previous_size = is_valid_ ? source_size_ : edited_size_;
+
+  if (edit.offset_ + edit.deleted_length_ > previous_size ||
+      source.size() !=
+          previous_size - edit.deleted_length_ + edit.inserted_length_) {
+    // The edit does not describe this document, so it starts over.
+    return reset(source);
+  }
+
+  const size_t unchanged_suffix =
+      previous_size - edit.offset_ - edit.deleted_length_;
+  const size_t prefix = is_valid_
+                            ? edit.offset_
+                            : std::min(unchanged_prefix_, edit.offset_);
+  const size_t suffix = is_valid_
+                            ? unchanged_suffix
+                            : std::min(unchanged_suffix_, unchanged_suffix);
+
+  Result<size_t, TokenizeError> r =
+      relex(source, prefix, source_size_ - prefix - suffix,
+            source.size() - prefix - suffix);
+
+  is_valid_ = r.IsOk();
+
+  if (!is_valid_) {
+    edited_size_ = source.size();
+    unchanged_prefix_ = prefix;
+    unchanged_suffix_ = suffix;
+  }
+
+  return r;
+}
+
+std::vector<Token> IncrementalTokenizer::get_tokens() const {
+  std::vector<Token> tokens;
+  tokens.reserve(size());
+
+  for (size_t i = 0; i < size(); i++) {
+    tokens.push_back(get(i));
+  }
+
+  return tokens;
+}
+
+Result<size_t, TokenizeError> IncrementalTokenizer::relex(
+    const std::string_view source, const size_t offset, const size_t deleted,
+    const size_t inserted) {
+  const size_t count = size();
+  const size_t inserted_end = offset + inserted;
+
+  // The token before the edit may grow into it, since tokens end where the
+  // next character cannot continue them.
+  const size_t first = offset > 0 ? find_token(offset - 1) : 0;
+  const size_t start = first < count ? get(first).offset_ : 0;
+
+  // The rest of the document was already validated, so only the characters
+  // touched by the edit are. Its bounds are widened to whole characters, in
+  // case it split one.
+  size_t validated_start = offset;
+
+  while (validated_start > 0 &&
+         is_continuation_byte(source[validated_start - 1])) {
+    validated_start--;
+  }
+
+  if (validated_start > 0 &&
+      static_cast<unsigned char>(source[validated_start - 1]) >= 0xC0) {
+    validated_start--;
+  }
+
+  size_t validated_end = inserted_end;
+
+  while (validated_end < source.size() &&
+         is_continuation_byte(source[validated_end])) {
+    validated_end++;
+  }
+
+  const InvalidCharacter invalid =
+      Utf8Source(source.substr(validated_start,
+                               validated_end - validated_start))
+          .find_invalid_character();
+
+  if (invalid.offset_ < validated_end - validated_start) {
+    const size_t invalid_offset = validated_start + invalid.offset_;
+
+    return Result<size_t, TokenizeError>::Err(invalid_character_error(
+        invalid, invalid_offset, locate(source, invalid_offset)));
+  }
+
+  const Utf8Source utf8(source);
+  Scanner<Utf8Source> scanner(utf8, source.size(), true);
+  size_t i = start;
+  size_t old = first;
+  size_t last = count;
+  lexed_.clear();
+
+  while (i < source.size()) {
+    const ScanResult r = scanner.scan(i);
+
+    if (r.status_ != SCANNED) {
+      return Result<size_t, TokenizeError>::Err(
+          scan_error(r, r.end_, locate(source, r.end_)));
+    }
+
+    lexed_.push_back(Token{.type_ = r.type_,
+                           .ignored_ = is_token_type_ignored(r.type_),
+                           .escaped_ = r.escaped_,
+                           .offset_ = i,
+                           .length_ = r.end_ - i});
+    i = r.end_;
+
+    if (i < inserted_end) {
+      continue;
+    }
+
+    // Past the edit, lexing continues exactly like it did before as soon as
+    // a token starts where a previous one started.
+    const size_t previous_offset = i - inserted + deleted;
+
+    while (old < count && get(old).offset_ < previous_offset) {
+      old++;
+    }
+
+    if (old < count && get(old).offset_ == previous_offset) {
+      last = old;
+      break;
+    }
+  }
+
+  replace(first, last, source.size());
+
+  return Result<size_t, TokenizeError>::Ok(lexed_.size());
+}
+
+size_t IncrementalTokenizer::find_token(const size_t offset) const {
+  size_t low = 0;
+  size_t high = size();
+
+  // Finds the last token starting at or before the offset.
+  while (high - low > 1) {
+    const size_t middle = low + (high - low) / 2;
+
+    if (get(middle).offset_ <= offset) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+
+  return low;
+}
+
+void IncrementalTokenizer::move_gap(const size_t index) {
+  while (gap_start_ > index) {
+    Token& token = tokens_[--gap_end_];
+    token = tokens_[--gap_start_];
+    token.offset_ = source_size_ - token.offset_;
+  }
+
+  while (gap_start_ < index) {
+    Token& token = tokens_[gap_start_++];
+    token = tokens_[gap_end_++];
+    token.offset_ = source_size_ - token.offset_;
+  }
+}
+
+void IncrementalTokenizer::replace(const size_t first, const size_t last,
+                                   const size_t source_size) {
+  move_gap(first);
+  // Tokens after the gap keep their distance to the end of the document,
+  // which the edit did not change.
+  gap_end_ += last - first;
+
+  if (gap_end_ - gap_start_ < lexed_.size()) {
+    const size_t suffix = tokens_.size() - gap_end_;
+    const size_t required = gap_start_ + lexed_.size() + suffix;
+    std::vector<Token> grown(std::max(required, 2 * tokens_.size()));
+
+    std::copy_n(tokens_.begin(), gap_start_, grown.begin());
+    std::copy_n(tokens_.begin() + static_cast<ptrdiff_t>(gap_end_), suffix,
+                grown.end() - static_cast<ptrdiff_t>(suffix));
+    gap_end_ = grown.size() - suffix;
+    tokens_ = std::move(grown);
+  }
+
+  std::copy(lexed_.begin(), lexed_.end(),
+            tokens_.begin() + static_cast<ptrdiff_t>(gap_start_));
+  gap_start_ += lexed_.size();
+  source_size_ = source_size;
+}
+}  // namespace graphqlpp::language::tokenization
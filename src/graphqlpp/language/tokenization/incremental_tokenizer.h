@@ -0,0 +1,125 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef INCREMENTAL_TOKENIZER_H
+#define INCREMENTAL_TOKENIZER_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "../../result.h"
+#include "token.h"
+#include "tokenize_error.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief Replacement of a range of a document's bytes. The inserted text is
+/// read from the edited document, so only its length is needed.
+struct TextEdit {
+  /// \brief Byte where the edit starts.
+  size_t offset_;
+  /// \brief Amount of bytes of the previous document which were removed.
+  size_t deleted_length_;
+  /// \brief Amount of bytes of the edited document which were inserted.
+  size_t inserted_length_;
+};
+
+/// \brief Keeps the tokens of a document which is edited over time, such as
+/// the one open in an editor. After each edit, only the tokens around it are
+/// lexed again, until lexing resynchronizes with the previous tokens; the
+/// rest are reused. The tokens are always identical to the ones of
+/// <i>tokenize</i>.
+///
+/// Tokens are kept within a gap buffer, whose gap follows the edits. Tokens
+/// after the gap store their distance to the end of the document instead of
+/// their offset, so edits never shift them: an edit only costs the lexing of
+/// the affected tokens and the distance the gap moves, regardless of the
+/// size of the document.
+class IncrementalTokenizer {
+ public:
+  /// \brief Starts with an empty document.
+  IncrementalTokenizer() = default;
+
+  /// \brief Tokenizes a whole document, discarding the previous one.
+  /// \param source GraphQL source text encoded as UTF-8.
+  /// \return The amount of tokens or an <i>TokenizeError</i>.
+  Result<size_t, TokenizeError> reset(std::string_view source);
+
+  /// \brief Updates the tokens after an edit of the document.
+  ///
+  /// If the edited document cannot be tokenized, its error is returned and
+  /// the tokens of the last valid document are kept. Following edits are
+  /// merged with the failed ones, so lexing still starts from the last
+  /// valid tokens.
+  /// \param source Edited document, encoded as UTF-8.
+  /// \param edit Edit which turned the previous document into this one.
+  /// \return The amount of tokens which were lexed again or an
+  /// <i>TokenizeError</i>.
+  Result<size_t, TokenizeError> apply_edit(std::string_view source,
+                                           const TextEdit& edit);
+
+  /// \brief Whether the tokens correspond to the last document, i.e. it
+  /// could be tokenized.
+  [[nodiscard]] bool is_valid() const { return is_valid_; }
+
+  [[nodiscard]] size_t size() const {
+    return tokens_.size() - (gap_end_ - gap_start_);
+  }
+
+  /// \brief Token at the given index, with its offset within the document.
+  [[nodiscard]] Token get(const size_t i) const {
+    if (i < gap_start_) {
+      return tokens_[i];
+    }
+
+    Token token = tokens_[i + gap_end_ - gap_start_];
+    token.offset_ = source_size_ - token.offset_;
+
+    return token;
+  }
+
+  /// \brief Copy of every token, in order.
+  [[nodiscard]] std::vector<Token> get_tokens() const;
+
+ private:
+  /// \brief Tokens before the gap store their offset, and tokens after it
+  /// store their distance to the end of the document.
+  std::vector<Token> tokens_;
+  size_t gap_start_ = 0;
+  size_t gap_end_ = 0;
+  /// \brief Size of the document the tokens belong to.
+  size_t source_size_ = 0;
+  bool is_valid_ = true;
+  /// \brief Size of the last edited document, which differs from
+  /// <i>source_size_</i> while it is not valid.
+  size_t edited_size_ = 0;
+  /// \brief While not valid, amount of bytes at the start and at the end of
+  /// the document which no edit has touched since it was last valid.
+  size_t unchanged_prefix_ = 0;
+  size_t unchanged_suffix_ = 0;
+  /// \brief Tokens lexed by the last edit, kept to reuse their storage.
+  std::vector<Token> lexed_;
+
+  /// \brief Lexes again the tokens affected by an edit of the last valid
+  /// document.
+  /// \param source Edited document.
+  /// \param offset Byte where the edit starts.
+  /// \param deleted Amount of bytes of the valid document which were removed.
+  /// \param inserted Amount of bytes of the edited document which were
+  /// inserted.
+  /// \return The amount of lexed tokens or an <i>TokenizeError</i>.
+  Result<size_t, TokenizeError> relex(std::string_view source, size_t offset,
+                                      size_t deleted, size_t inserted);
+
+  /// \brief Index of the token containing the given byte.
+  [[nodiscard]] size_t find_token(size_t offset) const;
+
+  /// \brief Moves the gap right before the token at the given index.
+  void move_gap(size_t index);
+
+  /// \brief Replaces the tokens [first, last) with the lexed tokens.
+  /// \param source_size Size of the document after the replacement.
+  void replace(size_t first, size_t last, size_t source_size);
+};
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // INCREMENTAL_TOKENIZER_H
@@ -0,0 +1,142 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "lexer.h"
+
+#include "scanner.h"
+#include "source.h"
+
+namespace graphqlpp::language::tokenization {
+
+/// \brief Amount of trailing bytes which start a UTF-8 sequence that has not
+/// been fully fed yet.
+size_t get_incomplete_sequence_length(std::string_view bytes);
+
+void Lexer::feed(const std::string_view chunk) {
+  // Tokenized bytes are discarded so only the token being scanned survives.
+  buffer_location_ = locate(consumed_);
+  buffer_.erase(0, consumed_);
+  buffer_offset_ += consumed_;
+  validated_ -= consumed_;
+  consumed_ = 0;
+
+  buffer_.append(chunk);
+}
+
+void Lexer::finish() { is_finished_ = true; }
+
+Result<std::optional<Token>, TokenizeError> Lexer::next() {
+  if (error_.has_value()) {
+    return Result<std::optional<Token>, TokenizeError>::Err(*error_);
+  }
+
+  if (!validate()) {
+    return Result<std::optional<Token>, TokenizeError>::Err(*error_);
+  }
+
+  if (consumed_ == validated_) {
+    return Result<std::optional<Token>, TokenizeError>::Ok(std::nullopt);
+  }
+
+  const Utf8Source source = Utf8Source(std::string_view(buffer_));
+  Scanner<Utf8Source> scanner =
+      Scanner(source, validated_, is_finished_ && validated_ == buffer_.size());
+  const ScanResult r = scanner.scan(consumed_);
+
+  if (r.status_ == INCOMPLETE) {
+    return Result<std::optional<Token>, TokenizeError>::Ok(std::nullopt);
+  }
+
+  if (r.status_ == FAILED) {
+    error_ = scan_error(r, buffer_offset_ + r.end_, locate(r.end_));
+
+    return Result<std::optional<Token>, TokenizeError>::Err(*error_);
+  }
+
+  const Token token = Token{.type_ = r.type_,
+                            .ignored_ = is_token_type_ignored(r.type_),
+                            .escaped_ = r.escaped_,
+                            .offset_ = buffer_offset_ + consumed_,
+                            .length_ = r.end_ - consumed_};
+
+  consumed_ = r.end_;
+
+  return Result<std::optional<Token>, TokenizeError>::Ok(token);
+}
+
+bool Lexer::is_done() const {
+  return is_finished_ && !error_.has_value() && consumed_ == buffer_.size();
+}
+
+std::string_view Lexer::get_value(const Token& token) const {
+  return std::string_view(buffer_).substr(token.offset_ - buffer_offset_,
+                                          token.length_);
+}
+
+Location Lexer::locate(const size_t i) const {
+  const Location location =
+      tokenization::locate(std::string_view(buffer_), i);
+
+  // Only the first line of the buffer may start before the buffer does.
+  if (location.line_ == 1) {
+    return Location{.line_ = buffer_location_.line_,
+                    .column_ = buffer_location_.column_ + location.column_ - 1};
+  }
+
+  return Location{.line_ = buffer_location_.line_ + location.line_ - 1,
+                  .column_ = location.column_};
+}
+
+bool Lexer::validate() {
+  size_t complete = buffer_.size();
+
+  if (!is_finished_) {
+    complete -= get_incomplete_sequence_length(buffer_);
+  }
+
+  if (validated_ >= complete) {
+    return true;
+  }
+
+  const InvalidCharacter invalid =
+      Utf8Source(std::string_view(buffer_).substr(validated_,
+                                                  complete - validated_))
+          .find_invalid_character();
+
+  if (invalid.offset_ < complete - validated_) {
+    const size_t offset = validated_ + invalid.offset_;
+
+    error_ = invalid_character_error(invalid, buffer_offset_ + offset,
+                                     locate(offset));
+    return false;
+  }
+
+  validated_ = complete;
+  return true;
+}
+
+size_t get_incomplete_sequence_length(const std::string_view bytes) {
+  // A sequence is at most four bytes long, so only the last three bytes can
+  // belong to an incomplete one.
+  for (size_t length = 1; length <= 3 && length <= bytes.size(); length++) {
+    const auto b = static_cast<unsigned char>(bytes[bytes.size() - length]);
+
+    if ((b & 0xC0) == 0x80) {
+      continue;
+    }
+
+    size_t width = 1;
+
+    if ((b & 0xE0) == 0xC0) {
+      width = 2;
+    } else if ((b & 0xF0) == 0xE0) {
+      width = 3;
+    } else if ((b & 0xF8) == 0xF0) {
+      width = 4;
+    }
+
+    return width > length ? length : 0;
+  }
+
+  return 0;
+}
+}  // namespace graphqlpp::language::tokenization
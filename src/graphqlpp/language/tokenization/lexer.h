@@ -0,0 +1,82 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "../../result.h"
+#include "location.h"
+#include "token.h"
+#include "tokenize_error.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief Pull-based tokenizer for UTF-8 source text which arrives in chunks.
+/// Only the bytes of the token being scanned are retained between chunks, so
+/// memory usage does not grow with the size of the document.
+///
+/// Token offsets are relative to the start of the whole document, and the
+/// value of a token can be retrieved through <i>get_value</i> until the next
+/// chunk is fed.
+class Lexer {
+ public:
+  Lexer() = default;
+
+  /// \param resource Memory resource of the lexer's buffer, which must
+  /// outlive the lexer.
+  explicit Lexer(std::pmr::memory_resource* resource) : buffer_(resource) {}
+
+  /// \brief Appends a chunk of the document. Tokens returned before this call
+  /// can no longer be looked up through <i>get_value</i>.
+  /// \param chunk Next bytes of the document.
+  void feed(std::string_view chunk);
+
+  /// \brief Indicates that no more chunks will be fed, so any token reaching
+  /// the end of the fed text is complete.
+  void finish();
+
+  /// \brief Scans the next token.
+  /// \return The next token, <i>std::nullopt</i> if more chunks are needed or
+  /// the document has ended, or a <i>TokenizeError</i>. Once an error is
+  /// returned, every following call returns it again.
+  Result<std::optional<Token>, TokenizeError> next();
+
+  /// \brief Whether every token of the document has been returned.
+  [[nodiscard]] bool is_done() const;
+
+  /// \brief Value of a token returned since the last fed chunk.
+  /// \param token Token returned by <i>next</i>.
+  /// \return View of the token's bytes.
+  [[nodiscard]] std::string_view get_value(const Token& token) const;
+
+  /// \brief Amount of bytes retained by the lexer.
+  [[nodiscard]] size_t get_buffered_size() const { return buffer_.size(); }
+
+ private:
+  /// \brief Fed bytes which have not been discarded yet.
+  std::pmr::string buffer_;
+  /// \brief Document offset of the first byte of the buffer.
+  size_t buffer_offset_ = 0;
+  /// \brief Bytes of the buffer which have already been tokenized.
+  size_t consumed_ = 0;
+  /// \brief Bytes of the buffer which are known to be valid source text.
+  size_t validated_ = 0;
+  /// \brief Location of the first byte of the buffer, which is only updated
+  /// when bytes are discarded.
+  Location buffer_location_ = Location{.line_ = 1, .column_ = 1};
+  bool is_finished_ = false;
+  std::optional<TokenizeError> error_;
+
+  /// \brief Location of a byte of the buffer within the document.
+  [[nodiscard]] Location locate(size_t i) const;
+
+  /// \brief Validates the complete characters of the buffer.
+  /// \return True if they are valid, false if an error was recorded.
+  bool validate();
+};
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // LEXER_H
@@ -0,0 +1,66 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "line_index.h"
+
+#include <algorithm>
+
+#include "source_scan.h"
+#include "tokenizer.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief Amount of characters within a run of code units.
+size_t count_characters(const std::string_view units) {
+  size_t count = 0;
+
+  for (const char unit : units) {
+    count += (static_cast<unsigned char>(unit) & 0xC0) != 0x80;
+  }
+
+  return count;
+}
+
+size_t count_characters(const std::u32string_view units) {
+  return units.size();
+}
+
+template <typename CharType>
+BasicLineIndex<CharType>::BasicLineIndex(
+    const std::basic_string_view<CharType> source)
+    : source_(source) {
+  line_starts_.push_back(0);
+  size_t i = 0;
+
+  while (true) {
+    i += find_line_terminator(source.substr(i));
+
+    if (i == source.size()) {
+      return;
+    }
+
+    if (source[i] == CARRIAGE_RETURN && i + 1 < source.size() &&
+        source[i + 1] == NEW_LINE) {
+      i++;
+    }
+
+    i++;
+    line_starts_.push_back(i);
+  }
+}
+
+template <typename CharType>
+Location BasicLineIndex<CharType>::get_location(const size_t offset) const {
+  // The line is the last one starting at or before the offset.
+  const auto next_line =
+      std::upper_bound(line_starts_.begin(), line_starts_.end(), offset);
+  const auto line = static_cast<size_t>(next_line - line_starts_.begin());
+  const size_t line_start = line_starts_[line - 1];
+
+  return Location{
+      .line_ = line,
+      .column_ = 1 + count_characters(
+                         source_.substr(line_start, offset - line_start))};
+}
+
+template class BasicLineIndex<char>;
+template class BasicLineIndex<char32_t>;
+}  // namespace graphqlpp::language::tokenization
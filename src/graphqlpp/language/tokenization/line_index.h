@@ -0,0 +1,64 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef LINE_INDEX_H
+#define LINE_INDEX_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "location.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief Offsets where the lines of a source text start. Tokens only store
+/// their offset, so an index is built once a location is actually needed,
+/// such as when reporting an error, instead of tracking lines and columns
+/// while tokenizing.
+///
+/// Lines are split by '\\n', '\\r' and "\\r\\n", and columns count characters,
+/// so they match the positions defined by the GraphQL specification.
+/// \tparam CharType Either <i>char</i> for UTF-8 or <i>char32_t</i> for UTF-32
+/// source text.
+template <typename CharType>
+class BasicLineIndex {
+ public:
+  /// \param source Source text, which must outlive the index.
+  explicit BasicLineIndex(std::basic_string_view<CharType> source);
+
+  /// \brief Line and column of a code unit of the source.
+  /// \param offset Code unit of the source, or the size of the source to
+  /// locate its end.
+  /// \return Location of the code unit.
+  [[nodiscard]] Location get_location(size_t offset) const;
+
+  /// \brief Amount of lines within the source.
+  [[nodiscard]] size_t get_line_count() const { return line_starts_.size(); }
+
+  /// \brief Code unit where a line starts.
+  /// \param line Line, starting from 1.
+  [[nodiscard]] size_t get_line_start(const size_t line) const {
+    return line_starts_[line - 1];
+  }
+
+ private:
+  std::basic_string_view<CharType> source_;
+  std::vector<size_t> line_starts_;
+};
+
+using LineIndex = BasicLineIndex<char>;
+using Utf32LineIndex = BasicLineIndex<char32_t>;
+
+/// \brief Locates a single code unit without keeping an index, scanning only
+/// the source text before it.
+/// \param source Source text.
+/// \param offset Code unit of the source, or the size of the source.
+/// \return Location of the code unit.
+template <typename CharType>
+Location locate(const std::basic_string_view<CharType> source,
+                const size_t offset) {
+  return BasicLineIndex<CharType>(source.substr(0, offset))
+      .get_location(offset);
+}
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // LINE_INDEX_H
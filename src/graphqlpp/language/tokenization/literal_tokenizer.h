@@ -0,0 +1,163 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef LITERAL_TOKENIZER_H
+#define LITERAL_TOKENIZER_H
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "fixed_token_buffer.h"
+#include "scanner.h"
+#include "source.h"
+#include "token.h"
+#include "tokenize_error.h"
+#include "tokenizer.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief GraphQL document embedded as a string literal, whose lexical tokens
+/// were worked out at compile time.
+/// \tparam TokenCount Amount of lexical tokens of the document.
+template <size_t TokenCount>
+struct LiteralDocument {
+  /// \brief Source text, which is the literal itself.
+  std::string_view source_;
+  FixedTokenBuffer<TokenCount> tokens_;
+};
+
+/// \brief Counts the tokens appended by the tokenizer, without storing them.
+class TokenCounter {
+ public:
+  [[nodiscard]] constexpr size_t size() const { return size_; }
+
+  constexpr void reserve(size_t) {}
+
+  constexpr void push_back(const Token&) { size_++; }
+
+ private:
+  size_t size_ = 0;
+};
+
+// The functions below are deliberately not constexpr. Calling one while
+// evaluating a literal makes the compiler reject it, and name the problem
+// within its diagnostic.
+inline void graphql_literal_has_invalid_character() {}
+inline void graphql_literal_has_malformed_utf8() {}
+inline void graphql_literal_has_unexpected_character() {}
+inline void graphql_literal_has_number_with_leading_zero() {}
+inline void graphql_literal_has_number_missing_digit() {}
+inline void graphql_literal_has_unterminated_string() {}
+inline void graphql_literal_has_invalid_escape_sequence() {}
+inline void graphql_literal_has_unbalanced_brackets() {}
+
+/// \brief Rejects a literal which could not be tokenized.
+consteval void reject_literal(const TokenizeErrorCode code) {
+  switch (code) {
+    case INVALID_CHARACTER:
+      graphql_literal_has_invalid_character();
+      break;
+    case MALFORMED_UTF8:
+      graphql_literal_has_malformed_utf8();
+      break;
+    case UNEXPECTED_CHARACTER:
+      graphql_literal_has_unexpected_character();
+      break;
+    case INVALID_NUMBER_LEADING_ZERO:
+      graphql_literal_has_number_with_leading_zero();
+      break;
+    case INVALID_NUMBER_EXPECTED_DIGIT:
+      graphql_literal_has_number_missing_digit();
+      break;
+    case UNTERMINATED_STRING:
+      graphql_literal_has_unterminated_string();
+      break;
+    case INVALID_ESCAPE_SEQUENCE:
+    default:
+      graphql_literal_has_invalid_escape_sequence();
+      break;
+  }
+}
+
+/// \brief Whether every '{', '(' and '[' of the lexical tokens of a document
+/// is closed by its matching bracket, which is the syntax check cheap enough
+/// to run on every literal at compile time.
+/// \param source Source text the tokens were tokenized from.
+/// \param tokens Lexical tokens of the source.
+template <size_t TokenCount>
+constexpr bool are_brackets_balanced(
+    const std::string_view source, const FixedTokenBuffer<TokenCount>& tokens) {
+  // Brackets still open. Each token opens at most one, so there is room for
+  // all of them.
+  std::array<char, TokenCount> open{};
+  size_t open_count = 0;
+
+  for (const Token& token : tokens) {
+    if (token.type_ != PUNCTUATOR) {
+      continue;
+    }
+
+    const char c = source[token.offset_];
+
+    if (c == '{' || c == '(' || c == '[') {
+      open[open_count++] = c == '{' ? '}' : c == '(' ? ')' : ']';
+    } else if (c == '}' || c == ')' || c == ']') {
+      if (open_count == 0 || open[open_count - 1] != c) {
+        return false;
+      }
+
+      open_count--;
+    }
+  }
+
+  return open_count == 0;
+}
+
+/// \brief Amount of lexical tokens of a literal, which sizes the container
+/// its tokens are stored in.
+/// \param source GraphQL source text encoded as UTF-8.
+consteval size_t count_literal_tokens(const std::string_view source) {
+  TokenCounter counter;
+  Result<size_t, TokenizeError> r =
+      tokenize_source<SIGNIFICANT_TOKENS_POLICY>(Utf8Source(source), counter);
+
+  if (!r.IsOk()) {
+    reject_literal(r.UnwrapErr().get_code());
+  }
+
+  return counter.size();
+}
+
+/// \brief Tokenizes a literal at compile time. A literal which is not valid,
+/// either lexically or because its brackets are unbalanced, does not compile.
+/// \tparam TokenCount Amount of lexical tokens of the literal, as counted by
+/// <i>count_literal_tokens</i>.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \return The literal and its lexical tokens.
+template <size_t TokenCount>
+consteval LiteralDocument<TokenCount> tokenize_literal(
+    const std::string_view source) {
+  LiteralDocument<TokenCount> document{.source_ = source, .tokens_ = {}};
+  Result<size_t, TokenizeError> r = tokenize_source<SIGNIFICANT_TOKENS_POLICY>(
+      Utf8Source(source), document.tokens_);
+
+  if (!r.IsOk()) {
+    reject_literal(r.UnwrapErr().get_code());
+  }
+
+  if (!are_brackets_balanced(source, document.tokens_)) {
+    graphql_literal_has_unbalanced_brackets();
+  }
+
+  return document;
+}
+}  // namespace graphqlpp::language::tokenization
+
+/// \brief Tokenizes a GraphQL string literal at compile time, into a
+/// <i>LiteralDocument</i> holding exactly as many tokens as it has. Malformed
+/// literals are compile errors instead of runtime ones.
+#define GRAPHQLPP_GQL(source)                                            \
+  ::graphqlpp::language::tokenization::tokenize_literal<                 \
+      ::graphqlpp::language::tokenization::count_literal_tokens(source)>( \
+      source)
+
+#endif  // LITERAL_TOKENIZER_H
@@ -3,6 +3,8 @@
 #ifndef LOCATION_H
 #define LOCATION_H
 
+#include <cstddef>
+
 namespace graphqlpp::language::tokenization {
 /// \brief Location, within a GraphQL, script where an error occurred.
 struct Location {
@@ -10,6 +12,8 @@ struct Location {
   size_t line_;
   /// \brief Column of the error.
   size_t column_;
+
+  bool operator==(const Location& other) const = default;
 };
 }  // namespace graphqlpp::language::tokenization
 
@@ -0,0 +1,171 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "parallel_tokenizer.h"
+
+#include <algorithm>
+#include <future>
+#include <optional>
+
+#include "source_scan.h"
+#include "tokenizer.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief Chunks per thread, so threads which finish early can pick up the
+/// remaining chunks.
+constexpr size_t CHUNKS_PER_THREAD = 4;
+
+/// \brief Lexical context of the split offsets pre-scan.
+enum SplitScanState { OUTSIDE, IN_COMMENT, IN_STRING, IN_BLOCK_STRING };
+
+std::vector<size_t> find_split_offsets(const std::string_view source,
+                                       const size_t chunk_count) {
+  constexpr std::string_view BLOCK_STRING_DELIMITER = "\"\"\"";
+  constexpr std::string_view ESCAPED_BLOCK_STRING_DELIMITER = "\\\"\"\"";
+
+  std::vector<size_t> offsets = {0};
+  SplitScanState state = OUTSIDE;
+  size_t target = source.size() / std::max<size_t>(chunk_count, 1);
+  size_t i = 0;
+
+  // Only strings, block strings and comments may contain the characters
+  // which start one another, so this pass just tracks which one it is in,
+  // skipping every other byte in bulk. Any document for which it goes wrong
+  // fails to tokenize.
+  while (i < source.size() && offsets.size() < chunk_count) {
+    i += find_structural_byte(source.substr(i));
+
+    if (i >= source.size()) {
+      break;
+    }
+
+    const char c = source[i];
+    const bool is_line_terminator = c == '\n' || c == '\r';
+
+    switch (state) {
+      case OUTSIDE:
+        if (c == '#') {
+          state = IN_COMMENT;
+          i++;
+        } else if (c == '"') {
+          const bool is_block =
+              source.substr(i).starts_with(BLOCK_STRING_DELIMITER);
+          state = is_block ? IN_BLOCK_STRING : IN_STRING;
+          i += is_block ? BLOCK_STRING_DELIMITER.size() : 1;
+        } else if (is_line_terminator) {
+          i += c == '\r' && i + 1 < source.size() && source[i + 1] == '\n'
+                   ? 2
+                   : 1;
+
+          if (i >= target && i < source.size()) {
+            offsets.push_back(i);
+            target = offsets.size() * source.size() / chunk_count;
+          }
+        } else {
+          i++;
+        }
+        break;
+      case IN_COMMENT:
+        if (is_line_terminator) {
+          state = OUTSIDE;
+        } else {
+          i++;
+        }
+        break;
+      case IN_STRING:
+        if (c == '\\') {
+          i += 2;
+        } else if (c == '"' || is_line_terminator) {
+          // Strings cannot contain line terminators, so the string either
+          // ends here or the document fails to tokenize anyway.
+          state = OUTSIDE;
+          i += c == '"' ? 1 : 0;
+        } else {
+          i++;
+        }
+        break;
+      case IN_BLOCK_STRING:
+        if (source.substr(i).starts_with(ESCAPED_BLOCK_STRING_DELIMITER)) {
+          i += ESCAPED_BLOCK_STRING_DELIMITER.size();
+        } else if (source.substr(i).starts_with(BLOCK_STRING_DELIMITER)) {
+          state = OUTSIDE;
+          i += BLOCK_STRING_DELIMITER.size();
+        } else {
+          i++;
+        }
+        break;
+    }
+  }
+
+  offsets.push_back(source.size());
+
+  return offsets;
+}
+
+Result<size_t, TokenizeError> tokenize_parallel(
+    const std::string_view source, TokenBuffer& tokens,
+    concurrency::ThreadPool& pool) {
+  const size_t chunk_count =
+      std::min(pool.get_thread_count() * CHUNKS_PER_THREAD,
+               source.size() / MINIMUM_PARALLEL_CHUNK_SIZE);
+
+  if (pool.get_thread_count() < 2 || chunk_count < 2) {
+    return tokenize(source, tokens);
+  }
+
+  const std::vector<size_t> offsets = find_split_offsets(source, chunk_count);
+  std::vector<std::future<std::optional<TokenBuffer>>> chunks;
+  chunks.reserve(offsets.size() - 1);
+
+  for (size_t k = 0; k + 1 < offsets.size(); k++) {
+    const std::string_view chunk =
+        source.substr(offsets[k], offsets[k + 1] - offsets[k]);
+
+    chunks.push_back(pool.submit([chunk]() -> std::optional<TokenBuffer> {
+      TokenBuffer chunk_tokens = TokenBuffer();
+
+      if (!tokenize(chunk, chunk_tokens).IsOk()) {
+        return std::nullopt;
+      }
+
+      return chunk_tokens;
+    }));
+  }
+
+  std::vector<TokenBuffer> chunk_tokens;
+  chunk_tokens.reserve(chunks.size());
+  bool has_failed = false;
+
+  for (std::future<std::optional<TokenBuffer>>& chunk : chunks) {
+    std::optional<TokenBuffer> r = chunk.get();
+
+    if (r.has_value()) {
+      chunk_tokens.push_back(std::move(r.value()));
+    } else {
+      has_failed = true;
+    }
+  }
+
+  // Errors are rare, so rather than stitching the error of a chunk, the
+  // whole document is tokenized again to report exactly the same error.
+  if (has_failed) {
+    return tokenize(source, tokens);
+  }
+
+  const size_t initial_size = tokens.size();
+  size_t token_count = 0;
+
+  for (const TokenBuffer& chunk : chunk_tokens) {
+    token_count += chunk.size();
+  }
+
+  tokens.reserve(initial_size + token_count);
+
+  // Tokens only record their offset, so they just need to be shifted by the
+  // start of their chunk.
+  for (size_t k = 0; k < chunk_tokens.size(); k++) {
+    tokens.append(chunk_tokens[k], offsets[k]);
+  }
+
+  return Result<size_t, TokenizeError>::Ok(tokens.size() - initial_size);
+}
+}  // namespace graphqlpp::language::tokenization
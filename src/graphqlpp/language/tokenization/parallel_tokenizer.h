@@ -0,0 +1,41 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef PARALLEL_TOKENIZER_H
+#define PARALLEL_TOKENIZER_H
+
+#include <string_view>
+#include <vector>
+
+#include "../../concurrency/thread_pool.h"
+#include "../../result.h"
+#include "token_buffer.h"
+#include "tokenize_error.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief Documents smaller than this are not worth splitting.
+constexpr size_t MINIMUM_PARALLEL_CHUNK_SIZE = 256 * 1024;
+
+/// \brief GraphQL UTF-8 source text to tokens, tokenizing chunks of the
+/// source concurrently. Meant for very large documents, e.g. a memory-mapped
+/// schema. The appended tokens, and the error if any, are identical to the
+/// ones of <i>tokenize</i>.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \param tokens Buffer where the tokens are appended.
+/// \param pool Pool whose threads tokenize the chunks.
+/// \return The amount of appended tokens or an <i>TokenizeError</i>.
+Result<size_t, TokenizeError> tokenize_parallel(
+    std::string_view source, TokenBuffer& tokens,
+    concurrency::ThreadPool& pool);
+
+/// \brief Offsets where a source can be split into chunks which tokenize
+/// independently: right after line terminators which are outside of strings,
+/// block strings and comments.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \param chunk_count Desired amount of chunks of similar size.
+/// \return Offsets of the start of every chunk followed by the size of the
+/// source. There may be fewer chunks than desired.
+std::vector<size_t> find_split_offsets(std::string_view source,
+                                       size_t chunk_count);
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // PARALLEL_TOKENIZER_H
@@ -0,0 +1,554 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <cstddef>
+
+#include "../../instrumentation/metrics.h"
+#include "character_class.h"
+#include "source.h"
+#include "token.h"
+#include "tokenizer.h"
+
+namespace graphqlpp::language::tokenization {
+constexpr char32_t UNICODE_BOM_CHARACTER = U'\U0000FEFF';
+
+/// \brief Value returned when peeking past the scanned range.
+constexpr char32_t END_OF_SOURCE = U'\U0010FFFF' + 1;
+
+enum ScanStatus {
+  /// \brief A whole token was scanned.
+  SCANNED,
+  /// \brief The token reaches the end of the scanned range and more source
+  /// text is needed to know where it ends.
+  INCOMPLETE,
+  /// \brief The source text does not form a valid token.
+  FAILED
+};
+
+struct ScanResult {
+  ScanStatus status_;
+  TokenType type_;
+  /// \brief Code unit after the token if scanned, or code unit where the
+  /// error was detected if failed.
+  size_t end_;
+  /// \brief What went wrong if failed.
+  TokenizeErrorCode error_;
+  /// \brief Whether a scanned string has to be decoded.
+  bool escaped_ = false;
+};
+
+/// \brief Scans one token at a time following the GraphQL lexical grammar.
+/// The scanned range may be a prefix of a larger document, in which case
+/// tokens reaching the end of the range are reported as incomplete instead of
+/// being cut short.
+/// \tparam Source Either <i>Utf32Source</i> or <i>Utf8Source</i>.
+template <typename Source>
+class Scanner {
+ public:
+  /// \param source GraphQL source text, already validated up to <i>end</i>.
+  /// \param end Code unit where the scanned range ends.
+  /// \param is_final Whether the range ends where the document ends.
+  constexpr Scanner(const Source& source, const size_t end,
+                    const bool is_final)
+      : source_(source), end_(end), is_final_(is_final) {}
+
+  /// \brief Scans the token starting at the given code unit. The token is
+  /// picked from the class of its first character, so ASCII characters take
+  /// a single table lookup and only the rest are decoded.
+  constexpr ScanResult scan(const size_t i) {
+    reached_end_ = false;
+    const char32_t s = peek(i);
+
+    switch (classify(s)) {
+      case WHITESPACE_CLASS:
+        return scan_whitespace(i);
+      case LINE_TERMINATOR_CLASS:
+        return scan_line_terminator(i);
+      case COMMENT_CLASS:
+        return scan_comment(i);
+      case COMMA_CLASS:
+        return token(COMMA, i + 1);
+      case PUNCTUATOR_CLASS:
+        return token(PUNCTUATOR, i + 1);
+      case DOT_CLASS:
+        return scan_spread(i);
+      case QUOTE_CLASS:
+        return scan_string(i);
+      case MINUS_CLASS:
+      case ZERO_CLASS:
+      case DIGIT_CLASS:
+        return scan_number(i);
+      case EXPONENT_CLASS:
+      case LETTER_CLASS:
+        return token(NAME, scan_name_continue(i + 1));
+      default:
+        break;
+    }
+
+    const DecodedCharacter decoded = source_.decode(i);
+
+    if (decoded.character_ == UNICODE_BOM_CHARACTER) {
+      return token(UNICODE_BOM, i + decoded.width_);
+    }
+
+    return error(UNEXPECTED_CHARACTER, i);
+  }
+
+ private:
+  const Source& source_;
+  size_t end_;
+  bool is_final_;
+  bool reached_end_ = false;
+
+  static constexpr bool is_digit(const char32_t s) {
+    return is_digit_class(classify(s));
+  }
+
+  static constexpr bool is_hex_digit(const char32_t s) {
+    return is_digit(s) || (s >= U'a' && s <= U'f') || (s >= U'A' && s <= U'F');
+  }
+
+  /// \brief Code unit at the given offset, or <i>END_OF_SOURCE</i> if it is
+  /// outside the scanned range.
+  constexpr char32_t peek(const size_t i) {
+    if (i >= end_) {
+      reached_end_ = true;
+      return END_OF_SOURCE;
+    }
+
+    return source_.unit(i);
+  }
+
+  /// \brief A token is only known to be complete if scanning it did not need
+  /// to look past the scanned range.
+  constexpr ScanResult token(const TokenType type, const size_t end,
+                             const bool escaped = false) const {
+    return ScanResult{.status_ = reached_end_ && !is_final_ ? INCOMPLETE
+                                                            : SCANNED,
+                      .type_ = type,
+                      .end_ = end,
+                      .error_ = UNEXPECTED_CHARACTER,
+                      .escaped_ = escaped};
+  }
+
+  constexpr ScanResult error(const TokenizeErrorCode code,
+                             const size_t offset) const {
+    return ScanResult{.status_ = reached_end_ && !is_final_ ? INCOMPLETE
+                                                            : FAILED,
+                      .type_ = PUNCTUATOR,
+                      .end_ = offset,
+                      .error_ = code};
+  }
+
+  constexpr ScanResult scan_whitespace(const size_t i) {
+    // Most runs are a single space, which is cheaper to check through the
+    // table than by starting a vectorized scan.
+    if (classify(peek(i + 1)) != WHITESPACE_CLASS) {
+      return token(WHITESPACE, i + 1);
+    }
+
+    const size_t end = source_.skip_whitespace(i, end_);
+    reached_end_ = end == end_;
+
+    return token(WHITESPACE, end);
+  }
+
+  constexpr ScanResult scan_line_terminator(const size_t i) {
+    if (peek(i) == CARRIAGE_RETURN && peek(i + 1) == NEW_LINE) {
+      return token(LINE_TERMINATOR, i + 2);
+    }
+
+    return token(LINE_TERMINATOR, i + 1);
+  }
+
+  constexpr ScanResult scan_comment(const size_t i) {
+    const size_t end = source_.find_line_terminator(i, end_);
+    reached_end_ = end == end_;
+
+    return token(COMMENT, end);
+  }
+
+  constexpr ScanResult scan_spread(const size_t i) {
+    if (peek(i + 1) == U'.' && peek(i + 2) == U'.') {
+      return token(PUNCTUATOR, i + 3);
+    }
+
+    return error(UNEXPECTED_CHARACTER, i);
+  }
+
+  constexpr size_t scan_name_continue(size_t i) {
+    while (is_name_continue_class(classify(peek(i)))) {
+      i++;
+    }
+
+    return i;
+  }
+
+  /// \brief Runs the number automaton until it reaches a final state.
+  constexpr ScanResult scan_number(size_t i) {
+    NumberState state = NUMBER_START;
+
+    while (true) {
+      const NumberState next = NUMBER_TRANSITIONS[state][classify(peek(i))];
+
+      if (next >= NUMBER_STATE_COUNT) {
+        switch (next) {
+          case INT_END:
+            return token(INT_VALUE, i);
+          case FLOAT_END:
+            return token(FLOAT_VALUE, i);
+          case LEADING_ZERO_ERROR:
+            return error(INVALID_NUMBER_LEADING_ZERO, i);
+          default:
+            return error(INVALID_NUMBER_EXPECTED_DIGIT, i);
+        }
+      }
+
+      state = next;
+      i++;
+    }
+  }
+
+  constexpr ScanResult scan_string(const size_t i) {
+    if (peek(i + 1) == U'"') {
+      if (peek(i + 2) == U'"') {
+        return scan_block_string(i);
+      }
+
+      return token(STRING_VALUE, i + 2);
+    }
+
+    size_t j = i + 1;
+    bool escaped = false;
+
+    while (true) {
+      const char32_t s = peek(j);
+
+      if (s == U'"') {
+        return token(STRING_VALUE, j + 1, escaped);
+      }
+
+      if (s == END_OF_SOURCE || is_line_terminator(s)) {
+        return error(UNTERMINATED_STRING, j);
+      }
+
+      if (s == U'\\') {
+        const size_t escape_end = scan_escape_sequence(j);
+
+        if (escape_end == 0) {
+          return error(INVALID_ESCAPE_SEQUENCE, j);
+        }
+
+        escaped = true;
+        j = escape_end;
+        continue;
+      }
+
+      j++;
+    }
+  }
+
+  /// \brief Scans the escape sequence starting at the given backslash.
+  /// \return Code unit after the escape sequence, or zero if it is invalid.
+  constexpr size_t scan_escape_sequence(const size_t i) {
+    switch (peek(i + 1)) {
+      case U'"':
+      case U'\\':
+      case U'/':
+      case U'b':
+      case U'f':
+      case U'n':
+      case U'r':
+      case U't':
+        return i + 2;
+      case U'u':
+        break;
+      default:
+        return 0;
+    }
+
+    if (peek(i + 2) == U'{') {
+      size_t j = i + 3;
+      char32_t value = 0;
+
+      while (is_hex_digit(peek(j))) {
+        value = value * 16 + hex_value(peek(j));
+        j++;
+
+        if (value > U'\U0010FFFF') {
+          return 0;
+        }
+      }
+
+      if (j == i + 3 || peek(j) != U'}' ||
+          (value >= 0xD800 && value <= 0xDFFF)) {
+        return 0;
+      }
+
+      return j + 1;
+    }
+
+    const char32_t value = scan_fixed_width_hex(i + 2);
+
+    if (value >= 0xDC00 && value <= 0xDFFF) {
+      return 0;
+    }
+
+    if (value < 0xD800 || value > 0xDBFF) {
+      return value == END_OF_SOURCE ? 0 : i + 6;
+    }
+
+    // A leading surrogate is only valid as the first half of a pair.
+    if (peek(i + 6) != U'\\' || peek(i + 7) != U'u') {
+      return 0;
+    }
+
+    const char32_t trailing = scan_fixed_width_hex(i + 8);
+
+    if (trailing < 0xDC00 || trailing > 0xDFFF) {
+      return 0;
+    }
+
+    return i + 12;
+  }
+
+  /// \brief Value of the four hexadecimal digits starting at the given code
+  /// unit.
+  /// \return The value, or <i>END_OF_SOURCE</i> if any of them is not a
+  /// hexadecimal digit.
+  constexpr char32_t scan_fixed_width_hex(const size_t i) {
+    char32_t value = 0;
+
+    for (size_t j = i; j < i + 4; j++) {
+      if (!is_hex_digit(peek(j))) {
+        return END_OF_SOURCE;
+      }
+
+      value = value * 16 + hex_value(peek(j));
+    }
+
+    return value;
+  }
+
+  static constexpr char32_t hex_value(const char32_t s) {
+    if (is_digit(s)) {
+      return s - U'0';
+    }
+
+    return (s | 0x20) - U'a' + 10;
+  }
+
+  constexpr ScanResult scan_block_string(const size_t i) {
+    size_t j = i + 3;
+    // Single-line block strings without escapes are their own value, unless
+    // they are blank, which makes their value empty.
+    bool escaped = false;
+    bool blank = true;
+
+    while (true) {
+      const char32_t s = peek(j);
+
+      if (s == END_OF_SOURCE) {
+        return error(UNTERMINATED_STRING, j);
+      }
+
+      if (s == U'"' && peek(j + 1) == U'"' && peek(j + 2) == U'"') {
+        return token(STRING_VALUE, j + 3, escaped || blank);
+      }
+
+      if (s == U'\\' && peek(j + 1) == U'"' && peek(j + 2) == U'"' &&
+          peek(j + 3) == U'"') {
+        escaped = true;
+        j += 4;
+        continue;
+      }
+
+      if (is_line_terminator(s)) {
+        escaped = true;
+      } else if (s != SPACE && s != TAB) {
+        blank = false;
+      }
+
+      j++;
+    }
+  }
+};
+
+/// \brief Error for a character which may not appear within a document.
+/// \param invalid First invalid character.
+/// \param offset Code unit of the document where the character starts.
+/// \param location Location of the character.
+constexpr TokenizeError invalid_character_error(
+    const InvalidCharacter& invalid, const size_t offset,
+    const Location location) {
+  return TokenizeError(invalid.malformed_ ? MALFORMED_UTF8 : INVALID_CHARACTER,
+                       offset, location);
+}
+
+/// \brief Error for a token which could not be scanned.
+/// \param result Failed scan of the token.
+/// \param offset Code unit of the document where the scan failed, which
+/// differs from the result's end when scanning a chunk of it.
+/// \param location Location of the code unit where the scan failed.
+/// \return Error located where the scan failed.
+constexpr TokenizeError scan_error(const ScanResult& result,
+                                   const size_t offset,
+                                   const Location location) {
+  return TokenizeError(result.error_, offset, location);
+}
+
+/// \brief Expected amount of source code units per token, used to size the
+/// token storage before tokenizing so it rarely has to grow.
+constexpr size_t ESTIMATED_CODE_UNITS_PER_TOKEN = 8;
+
+/// \brief Expected amount of source code units per lexical token, which are
+/// roughly half of the tokens.
+constexpr size_t ESTIMATED_CODE_UNITS_PER_SIGNIFICANT_TOKEN = 16;
+
+/// \brief Appends a token which covers the code units [start, end).
+template <typename Tokens>
+constexpr void push_token(Tokens& tokens, const TokenType type,
+                          const size_t start, const size_t end,
+                          const bool escaped) {
+  tokens.push_back(Token{.type_ = type,
+                         .ignored_ = is_token_type_ignored(type),
+                         .escaped_ = escaped,
+                         .offset_ = start,
+                         .length_ = end - start});
+}
+
+/// \brief Amount of tokens scanned by <i>scan_source</i>.
+struct ScanTally {
+  size_t tokens_ = 0;
+  size_t ignored_tokens_ = 0;
+};
+
+/// \brief Tallies the tokens scanned so far, if the policy records metrics.
+/// \param appended_token_count Amount of tokens appended to the container.
+/// \param ignored_token_count Amount of ignored tokens scanned.
+template <TokenizePolicy Policy>
+constexpr void tally_scan(const size_t appended_token_count,
+                          const size_t ignored_token_count, ScanTally& tally) {
+  if constexpr (Policy.record_metrics_) {
+    tally.tokens_ = appended_token_count +
+                    (Policy.emit_ignored_tokens_ ? 0 : ignored_token_count);
+    tally.ignored_tokens_ = ignored_token_count;
+  }
+}
+
+/// \brief Tokenizes a source as <i>tokenize_source</i> does, tallying the
+/// scanned tokens if the policy records metrics.
+/// \param tally Tally of the scanned tokens, set if the policy records them.
+template <TokenizePolicy Policy, typename Source, typename Tokens>
+constexpr Result<size_t, TokenizeError> scan_source(const Source& source,
+                                                    Tokens& tokens,
+                                                    ScanTally& tally) {
+  const size_t initial_size = tokens.size();
+
+  tokens.reserve(initial_size +
+                 source.size() /
+                     (Policy.emit_ignored_tokens_
+                          ? ESTIMATED_CODE_UNITS_PER_TOKEN
+                          : ESTIMATED_CODE_UNITS_PER_SIGNIFICANT_TOKEN) +
+                 1);
+
+  // Characters are validated in bulk before tokenizing, and invalid ones
+  // are reported before any lexical error.
+  if constexpr (Policy.validate_characters_) {
+    const InvalidCharacter invalid = source.find_invalid_character();
+
+    if (invalid.offset_ < source.size()) {
+      return Result<size_t, TokenizeError>::Err(invalid_character_error(
+          invalid, invalid.offset_, source.locate(invalid.offset_)));
+    }
+  }
+
+  Scanner<Source> scanner = Scanner(source, source.size(), true);
+  size_t i = 0;
+  // Ignored tokens are counted within the branches which already tell them
+  // apart, so tallying adds next to nothing to the loop. The other tokens are
+  // counted by the container.
+  size_t ignored_token_count = 0;
+
+  while (i < source.size()) {
+    const ScanResult r = scanner.scan(i);
+
+    if (r.status_ != SCANNED) {
+      tally_scan<Policy>(tokens.size() - initial_size, ignored_token_count,
+                         tally);
+
+      return Result<size_t, TokenizeError>::Err(
+          scan_error(r, r.end_, source.locate(r.end_)));
+    }
+
+    const bool ignored = is_token_type_ignored(r.type_);
+
+    if (Policy.emit_ignored_tokens_ || !ignored) {
+      push_token(tokens, r.type_, i, r.end_, r.escaped_);
+
+      if constexpr (Policy.record_metrics_ && Policy.emit_ignored_tokens_) {
+        ignored_token_count += ignored ? 1 : 0;
+      }
+    } else if constexpr (Policy.record_metrics_) {
+      ignored_token_count++;
+    }
+
+    i = r.end_;
+  }
+
+  tally_scan<Policy>(tokens.size() - initial_size, ignored_token_count, tally);
+
+  return Result<size_t, TokenizeError>::Ok(tokens.size() - initial_size);
+}
+
+/// \brief Tokenizes a source, recording the tokenizer's metrics: its
+/// duration, the code units and tokens it scanned, and its error.
+template <TokenizePolicy Policy, typename Source, typename Tokens>
+Result<size_t, TokenizeError> scan_source_metered(const Source& source,
+                                                  Tokens& tokens) {
+  using instrumentation::Counter;
+  using instrumentation::Phase;
+
+  const instrumentation::PhaseTimer<true> timer(Phase::TOKENIZE);
+  ScanTally tally;
+  Result<size_t, TokenizeError> r = scan_source<Policy>(source, tokens, tally);
+
+  instrumentation::add_to_counter(Counter::LEXED_BYTES, source.size());
+  instrumentation::add_to_counter(Counter::TOKENS, tally.tokens_);
+  instrumentation::add_to_counter(Counter::IGNORED_TOKENS,
+                                  tally.ignored_tokens_);
+
+  if (!r.IsOk()) {
+    instrumentation::record_error(Phase::TOKENIZE, r.UnwrapErr().get_code());
+  }
+
+  return r;
+}
+
+/// \brief Tokenizes any source which can be decoded into code points. Tokens
+/// only record their offset, so lines and columns are only worked out for the
+/// reported error. With a <i>Utf8Source</i> and a container which does not
+/// allocate, such as a <i>FixedTokenBuffer</i>, it runs at compile time,
+/// unless the policy records metrics.
+/// \tparam Policy Features of the tokenizer.
+/// \tparam Source Either <i>Utf32Source</i> or <i>Utf8Source</i>.
+/// \tparam Tokens Container of tokens with a <i>push_back(Token)</i> method.
+/// \param source GraphQL source text.
+/// \param tokens Container where the tokens are appended.
+/// \return The amount of appended tokens or an <i>TokenizeError</i>.
+template <TokenizePolicy Policy, typename Source, typename Tokens>
+constexpr Result<size_t, TokenizeError> tokenize_source(const Source& source,
+                                                        Tokens& tokens) {
+  if constexpr (Policy.record_metrics_) {
+    return scan_source_metered<Policy>(source, tokens);
+  } else {
+    ScanTally tally;
+
+    return scan_source<Policy>(source, tokens, tally);
+  }
+}
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // SCANNER_H
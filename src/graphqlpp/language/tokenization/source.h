@@ -0,0 +1,249 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "line_index.h"
+#include "source_scan.h"
+#include "tokenizer.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief Character decoded from a source text.
+struct DecodedCharacter {
+  char32_t character_;
+  /// \brief Amount of code units used by the character. Zero if the code
+  /// units do not form a well-formed character.
+  size_t width_;
+};
+
+/// \brief First character of a source which cannot be tokenized.
+struct InvalidCharacter {
+  /// \brief Code unit where the character starts, or the size of the source
+  /// if every character is valid.
+  size_t offset_;
+  /// \brief Whether the code units do not form a well-formed character, as
+  /// opposed to forming a character which is not a valid source character.
+  bool malformed_;
+};
+
+/// \brief Source text already decoded into UTF-32 code points.
+class Utf32Source {
+ public:
+  explicit Utf32Source(const std::vector<char32_t>& source)
+      : source_(source.data(), source.size()) {}
+
+  /// \brief Amount of code units within the source.
+  [[nodiscard]] size_t size() const { return source_.size(); }
+
+  /// \brief Code unit at the given offset, without decoding it.
+  [[nodiscard]] char32_t unit(const size_t i) const { return source_[i]; }
+
+  /// \brief Decodes the character starting at the given offset.
+  [[nodiscard]] DecodedCharacter decode(const size_t i) const {
+    return DecodedCharacter{.character_ = source_[i], .width_ = 1};
+  }
+
+  /// \brief Finds the first character which cannot be tokenized.
+  [[nodiscard]] InvalidCharacter find_invalid_character() const {
+    return InvalidCharacter{
+        .offset_ = tokenization::find_invalid_source_character(source_),
+        .malformed_ = false};
+  }
+
+  /// \brief Finds the first line terminator within the code units [i, end).
+  [[nodiscard]] size_t find_line_terminator(const size_t i,
+                                            const size_t end) const {
+    return i + tokenization::find_line_terminator(source_.substr(i, end - i));
+  }
+
+  /// \brief Finds the end of the run of spaces and tabs starting at i, without
+  /// going past end.
+  [[nodiscard]] size_t skip_whitespace(const size_t i, const size_t end) const {
+    return i + tokenization::find_non_whitespace(source_.substr(i, end - i));
+  }
+
+  /// \brief Line and column of the given code unit.
+  [[nodiscard]] Location locate(const size_t i) const {
+    return tokenization::locate(source_, i);
+  }
+
+ private:
+  std::u32string_view source_;
+};
+
+/// \brief Source text encoded as UTF-8, which is decoded on the fly.
+///
+/// It can be used in constant expressions, such as to tokenize a string
+/// literal at compile time. Bulk scans then fall back to plain loops, since
+/// the vectorized kernels cannot be evaluated by the compiler.
+class Utf8Source {
+ public:
+  constexpr explicit Utf8Source(const std::string_view source)
+      : bytes_(source) {}
+
+  explicit Utf8Source(const std::u8string_view source)
+      : bytes_(reinterpret_cast<const char*>(source.data()), source.size()) {}
+
+  /// \brief Source viewed as bytes.
+  [[nodiscard]] constexpr std::string_view get_bytes() const { return bytes_; }
+
+  /// \brief Amount of code units within the source.
+  [[nodiscard]] constexpr size_t size() const { return bytes_.size(); }
+
+  /// \brief Code unit at the given offset, without decoding it.
+  [[nodiscard]] constexpr char32_t unit(const size_t i) const {
+    return static_cast<unsigned char>(bytes_[i]);
+  }
+
+  /// \brief Decodes the character starting at the given offset. Overlong
+  /// encodings, surrogates, truncated sequences and code points above
+  /// U+10FFFF are reported as malformed.
+  [[nodiscard]] constexpr DecodedCharacter decode(const size_t i) const {
+    constexpr DecodedCharacter malformed{.character_ = 0, .width_ = 0};
+    const char32_t lead = unit(i);
+
+    if (lead < 0x80) {
+      return DecodedCharacter{.character_ = lead, .width_ = 1};
+    }
+
+    size_t width;
+    char32_t character;
+    char32_t minimum;
+
+    if ((lead & 0xE0) == 0xC0) {
+      width = 2;
+      character = lead & 0x1F;
+      minimum = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+      width = 3;
+      character = lead & 0x0F;
+      minimum = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+      width = 4;
+      character = lead & 0x07;
+      minimum = 0x10000;
+    } else {
+      return malformed;
+    }
+
+    if (width > size() - i) {
+      return malformed;
+    }
+
+    for (size_t j = 1; j < width; j++) {
+      const char32_t continuation = unit(i + j);
+
+      if ((continuation & 0xC0) != 0x80) {
+        return malformed;
+      }
+
+      character = (character << 6) | (continuation & 0x3F);
+    }
+
+    if (character < minimum || character > 0x10FFFF ||
+        (character >= 0xD800 && character <= 0xDFFF)) {
+      return malformed;
+    }
+
+    return DecodedCharacter{.character_ = character, .width_ = width};
+  }
+
+  /// \brief Finds the first character which cannot be tokenized. ASCII runs
+  /// are validated in bulk, and only the rest is decoded one at a time.
+  [[nodiscard]] constexpr InvalidCharacter find_invalid_character() const {
+    size_t i = 0;
+
+    while (true) {
+      if (std::is_constant_evaluated()) {
+        while (i < size() && unit(i) < 0x80 &&
+               is_source_character_valid(unit(i))) {
+          i++;
+        }
+      } else {
+        i += find_non_ascii_or_invalid_byte(bytes_.substr(i));
+      }
+
+      if (i == size()) {
+        return InvalidCharacter{.offset_ = size(), .malformed_ = false};
+      }
+
+      const DecodedCharacter decoded = decode(i);
+
+      if (decoded.width_ == 0) {
+        return InvalidCharacter{.offset_ = i, .malformed_ = true};
+      }
+
+      // Valid ASCII characters were already skipped.
+      if (decoded.width_ == 1 || decoded.character_ > 0xFFFF) {
+        return InvalidCharacter{.offset_ = i, .malformed_ = false};
+      }
+
+      i += decoded.width_;
+    }
+  }
+
+  /// \brief Finds the first line terminator within the code units [i, end).
+  [[nodiscard]] constexpr size_t find_line_terminator(const size_t i,
+                                                      const size_t end) const {
+    if (std::is_constant_evaluated()) {
+      size_t j = i;
+
+      while (j < end && !is_line_terminator(unit(j))) {
+        j++;
+      }
+
+      return j;
+    }
+
+    return i + tokenization::find_line_terminator(bytes_.substr(i, end - i));
+  }
+
+  /// \brief Finds the end of the run of spaces and tabs starting at i, without
+  /// going past end.
+  [[nodiscard]] constexpr size_t skip_whitespace(const size_t i,
+                                                 const size_t end) const {
+    if (std::is_constant_evaluated()) {
+      size_t j = i;
+
+      while (j < end && (unit(j) == SPACE || unit(j) == TAB)) {
+        j++;
+      }
+
+      return j;
+    }
+
+    return i + find_non_whitespace(bytes_.substr(i, end - i));
+  }
+
+  /// \brief Line and column of the given code unit.
+  [[nodiscard]] constexpr Location locate(const size_t i) const {
+    if (std::is_constant_evaluated()) {
+      Location location{.line_ = 1, .column_ = 1};
+
+      for (size_t j = 0; j < i; j++) {
+        if (unit(j) == NEW_LINE ||
+            (unit(j) == CARRIAGE_RETURN &&
+             (j + 1 == size() || unit(j + 1) != NEW_LINE))) {
+          location = Location{.line_ = location.line_ + 1, .column_ = 1};
+        } else if ((unit(j) & 0xC0) != 0x80) {
+          location.column_++;
+        }
+      }
+
+      return location;
+    }
+
+    return tokenization::locate(bytes_, i);
+  }
+
+ private:
+  std::string_view bytes_;
+};
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // SOURCE_H
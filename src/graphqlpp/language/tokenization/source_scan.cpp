@@ -0,0 +1,654 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "source_scan.h"
+
+#include "tokenizer.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define GRAPHQLPP_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace graphqlpp::language::tokenization {
+constexpr char QUOTE = '"';
+constexpr char HASH = '#';
+constexpr char BACKSLASH = '\\';
+
+bool is_plain_ascii_byte(const unsigned char b) {
+  return (b >= 0x20 && b < 0x80) || b == TAB || b == NEW_LINE ||
+         b == CARRIAGE_RETURN;
+}
+
+size_t find_invalid_source_character_scalar(const std::u32string_view source,
+                                            size_t i) {
+  for (; i < source.size(); i++) {
+    if (!is_source_character_valid(source[i])) {
+      return i;
+    }
+  }
+
+  return source.size();
+}
+
+size_t find_non_ascii_or_invalid_byte_scalar(const std::string_view source,
+                                             size_t i) {
+  for (; i < source.size(); i++) {
+    if (!is_plain_ascii_byte(static_cast<unsigned char>(source[i]))) {
+      return i;
+    }
+  }
+
+  return source.size();
+}
+
+template <typename CharType>
+size_t find_line_terminator_scalar(
+    const std::basic_string_view<CharType> source, size_t i) {
+  for (; i < source.size(); i++) {
+    const auto s = static_cast<char32_t>(source[i]);
+
+    if (s == NEW_LINE || s == CARRIAGE_RETURN) {
+      return i;
+    }
+  }
+
+  return source.size();
+}
+
+bool is_structural_byte(const char b) {
+  return b == QUOTE || b == HASH || b == BACKSLASH || b == NEW_LINE ||
+         b == CARRIAGE_RETURN;
+}
+
+size_t find_structural_byte_scalar(const std::string_view source, size_t i) {
+  for (; i < source.size(); i++) {
+    if (is_structural_byte(source[i])) {
+      return i;
+    }
+  }
+
+  return source.size();
+}
+
+bool is_json_escape_byte(const char b) {
+  return b == QUOTE || b == BACKSLASH || static_cast<unsigned char>(b) < 0x20;
+}
+
+size_t find_json_escape_byte_scalar(const std::string_view value, size_t i) {
+  for (; i < value.size(); i++) {
+    if (is_json_escape_byte(value[i])) {
+      return i;
+    }
+  }
+
+  return value.size();
+}
+
+template <typename CharType>
+size_t find_non_whitespace_scalar(const std::basic_string_view<CharType> source,
+                                  size_t i) {
+  for (; i < source.size(); i++) {
+    const auto s = static_cast<char32_t>(source[i]);
+
+    if (s != SPACE && s != TAB) {
+      return i;
+    }
+  }
+
+  return source.size();
+}
+
+#ifdef GRAPHQLPP_X86_SIMD
+// Every kernel builds a byte mask of the lanes which match, and the index of
+// the first match is the amount of trailing zeros of that mask. UTF-32 lanes
+// set four mask bits each, hence the division by the code unit size.
+
+__attribute__((target("sse4.2"))) size_t find_invalid_source_character_sse(
+    const std::u32string_view source) {
+  const auto* data = reinterpret_cast<const __m128i*>(source.data());
+  const __m128i offset = _mm_set1_epi32(SPACE);
+  const __m128i range = _mm_set1_epi32(0xFFFF - SPACE);
+  const __m128i tab = _mm_set1_epi32(TAB);
+  const __m128i new_line = _mm_set1_epi32(NEW_LINE);
+  const __m128i carriage_return = _mm_set1_epi32(CARRIAGE_RETURN);
+  constexpr size_t lanes = sizeof(__m128i) / sizeof(char32_t);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m128i v = _mm_loadu_si128(data + i / lanes);
+    const __m128i shifted = _mm_sub_epi32(v, offset);
+    const __m128i in_range =
+        _mm_cmpeq_epi32(_mm_max_epu32(shifted, range), range);
+    const __m128i special =
+        _mm_or_si128(_mm_cmpeq_epi32(v, tab),
+                     _mm_or_si128(_mm_cmpeq_epi32(v, new_line),
+                                  _mm_cmpeq_epi32(v, carriage_return)));
+    const auto invalid = static_cast<unsigned>(
+        ~_mm_movemask_epi8(_mm_or_si128(in_range, special)) & 0xFFFF);
+
+    if (invalid != 0) {
+      return i + __builtin_ctz(invalid) / sizeof(char32_t);
+    }
+  }
+
+  return find_invalid_source_character_scalar(source, i);
+}
+
+__attribute__((target("avx2"))) size_t find_invalid_source_character_avx2(
+    const std::u32string_view source) {
+  const auto* data = reinterpret_cast<const __m256i*>(source.data());
+  const __m256i offset = _mm256_set1_epi32(SPACE);
+  const __m256i range = _mm256_set1_epi32(0xFFFF - SPACE);
+  const __m256i tab = _mm256_set1_epi32(TAB);
+  const __m256i new_line = _mm256_set1_epi32(NEW_LINE);
+  const __m256i carriage_return = _mm256_set1_epi32(CARRIAGE_RETURN);
+  constexpr size_t lanes = sizeof(__m256i) / sizeof(char32_t);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m256i v = _mm256_loadu_si256(data + i / lanes);
+    const __m256i shifted = _mm256_sub_epi32(v, offset);
+    const __m256i in_range =
+        _mm256_cmpeq_epi32(_mm256_max_epu32(shifted, range), range);
+    const __m256i special =
+        _mm256_or_si256(_mm256_cmpeq_epi32(v, tab),
+                        _mm256_or_si256(_mm256_cmpeq_epi32(v, new_line),
+                                        _mm256_cmpeq_epi32(v, carriage_return)));
+    const auto invalid = ~static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_or_si256(in_range, special)));
+
+    if (invalid != 0) {
+      return i + __builtin_ctz(invalid) / sizeof(char32_t);
+    }
+  }
+
+  return find_invalid_source_character_scalar(source, i);
+}
+
+__attribute__((target("sse4.2"))) size_t find_non_ascii_or_invalid_byte_sse(
+    const std::string_view source) {
+  const __m128i below_space = _mm_set1_epi8(SPACE - 1);
+  const __m128i tab = _mm_set1_epi8(TAB);
+  const __m128i new_line = _mm_set1_epi8(NEW_LINE);
+  const __m128i carriage_return = _mm_set1_epi8(CARRIAGE_RETURN);
+  constexpr size_t lanes = sizeof(__m128i);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i));
+    // Bytes at or above 0x80 are negative, so a signed comparison rejects
+    // them together with the control characters.
+    const __m128i printable = _mm_cmpgt_epi8(v, below_space);
+    const __m128i special =
+        _mm_or_si128(_mm_cmpeq_epi8(v, tab),
+                     _mm_or_si128(_mm_cmpeq_epi8(v, new_line),
+                                  _mm_cmpeq_epi8(v, carriage_return)));
+    const auto other = static_cast<unsigned>(
+        ~_mm_movemask_epi8(_mm_or_si128(printable, special)) & 0xFFFF);
+
+    if (other != 0) {
+      return i + __builtin_ctz(other);
+    }
+  }
+
+  return find_non_ascii_or_invalid_byte_scalar(source, i);
+}
+
+__attribute__((target("avx2"))) size_t find_non_ascii_or_invalid_byte_avx2(
+    const std::string_view source) {
+  const __m256i below_space = _mm256_set1_epi8(SPACE - 1);
+  const __m256i tab = _mm256_set1_epi8(TAB);
+  const __m256i new_line = _mm256_set1_epi8(NEW_LINE);
+  const __m256i carriage_return = _mm256_set1_epi8(CARRIAGE_RETURN);
+  constexpr size_t lanes = sizeof(__m256i);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(source.data() + i));
+    const __m256i printable = _mm256_cmpgt_epi8(v, below_space);
+    const __m256i special =
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, tab),
+                        _mm256_or_si256(_mm256_cmpeq_epi8(v, new_line),
+                                        _mm256_cmpeq_epi8(v, carriage_return)));
+    const auto other = ~static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_or_si256(printable, special)));
+
+    if (other != 0) {
+      return i + __builtin_ctz(other);
+    }
+  }
+
+  return find_non_ascii_or_invalid_byte_scalar(source, i);
+}
+
+__attribute__((target("sse4.2"))) size_t find_line_terminator_sse(
+    const std::u32string_view source) {
+  const __m128i new_line = _mm_set1_epi32(NEW_LINE);
+  const __m128i carriage_return = _mm_set1_epi32(CARRIAGE_RETURN);
+  constexpr size_t lanes = sizeof(__m128i) / sizeof(char32_t);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i));
+    const auto found = static_cast<unsigned>(_mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi32(v, new_line),
+                     _mm_cmpeq_epi32(v, carriage_return))));
+
+    if (found != 0) {
+      return i + __builtin_ctz(found) / sizeof(char32_t);
+    }
+  }
+
+  return find_line_terminator_scalar(source, i);
+}
+
+__attribute__((target("avx2"))) size_t find_line_terminator_avx2(
+    const std::u32string_view source) {
+  const __m256i new_line = _mm256_set1_epi32(NEW_LINE);
+  const __m256i carriage_return = _mm256_set1_epi32(CARRIAGE_RETURN);
+  constexpr size_t lanes = sizeof(__m256i) / sizeof(char32_t);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(source.data() + i));
+    const auto found = static_cast<unsigned>(_mm256_movemask_epi8(
+        _mm256_or_si256(_mm256_cmpeq_epi32(v, new_line),
+                        _mm256_cmpeq_epi32(v, carriage_return))));
+
+    if (found != 0) {
+      return i + __builtin_ctz(found) / sizeof(char32_t);
+    }
+  }
+
+  return find_line_terminator_scalar(source, i);
+}
+
+__attribute__((target("sse4.2"))) size_t find_line_terminator_sse(
+    const std::string_view source) {
+  const __m128i new_line = _mm_set1_epi8(NEW_LINE);
+  const __m128i carriage_return = _mm_set1_epi8(CARRIAGE_RETURN);
+  constexpr size_t lanes = sizeof(__m128i);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i));
+    const auto found = static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, new_line),
+                                       _mm_cmpeq_epi8(v, carriage_return))));
+
+    if (found != 0) {
+      return i + __builtin_ctz(found);
+    }
+  }
+
+  return find_line_terminator_scalar(source, i);
+}
+
+__attribute__((target("avx2"))) size_t find_line_terminator_avx2(
+    const std::string_view source) {
+  const __m256i new_line = _mm256_set1_epi8(NEW_LINE);
+  const __m256i carriage_return = _mm256_set1_epi8(CARRIAGE_RETURN);
+  constexpr size_t lanes = sizeof(__m256i);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(source.data() + i));
+    const auto found = static_cast<unsigned>(_mm256_movemask_epi8(
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, new_line),
+                        _mm256_cmpeq_epi8(v, carriage_return))));
+
+    if (found != 0) {
+      return i + __builtin_ctz(found);
+    }
+  }
+
+  return find_line_terminator_scalar(source, i);
+}
+
+__attribute__((target("sse4.2"))) size_t find_non_whitespace_sse(
+    const std::u32string_view source) {
+  const __m128i space = _mm_set1_epi32(SPACE);
+  const __m128i tab = _mm_set1_epi32(TAB);
+  constexpr size_t lanes = sizeof(__m128i) / sizeof(char32_t);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i));
+    const auto other = static_cast<unsigned>(
+        ~_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi32(v, space),
+                                        _mm_cmpeq_epi32(v, tab))) &
+        0xFFFF);
+
+    if (other != 0) {
+      return i + __builtin_ctz(other) / sizeof(char32_t);
+    }
+  }
+
+  return find_non_whitespace_scalar(source, i);
+}
+
+__attribute__((target("avx2"))) size_t find_non_whitespace_avx2(
+    const std::u32string_view source) {
+  const __m256i space = _mm256_set1_epi32(SPACE);
+  const __m256i tab = _mm256_set1_epi32(TAB);
+  constexpr size_t lanes = sizeof(__m256i) / sizeof(char32_t);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(source.data() + i));
+    const auto other = ~static_cast<unsigned>(_mm256_movemask_epi8(
+        _mm256_or_si256(_mm256_cmpeq_epi32(v, space),
+                        _mm256_cmpeq_epi32(v, tab))));
+
+    if (other != 0) {
+      return i + __builtin_ctz(other) / sizeof(char32_t);
+    }
+  }
+
+  return find_non_whitespace_scalar(source, i);
+}
+
+__attribute__((target("sse4.2"))) size_t find_non_whitespace_sse(
+    const std::string_view source) {
+  const __m128i space = _mm_set1_epi8(SPACE);
+  const __m128i tab = _mm_set1_epi8(TAB);
+  constexpr size_t lanes = sizeof(__m128i);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i));
+    const auto other = static_cast<unsigned>(
+        ~_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab))) &
+        0xFFFF);
+
+    if (other != 0) {
+      return i + __builtin_ctz(other);
+    }
+  }
+
+  return find_non_whitespace_scalar(source, i);
+}
+
+__attribute__((target("avx2"))) size_t find_non_whitespace_avx2(
+    const std::string_view source) {
+  const __m256i space = _mm256_set1_epi8(SPACE);
+  const __m256i tab = _mm256_set1_epi8(TAB);
+  constexpr size_t lanes = sizeof(__m256i);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(source.data() + i));
+    const auto other = ~static_cast<unsigned>(_mm256_movemask_epi8(
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab))));
+
+    if (other != 0) {
+      return i + __builtin_ctz(other);
+    }
+  }
+
+  return find_non_whitespace_scalar(source, i);
+}
+
+__attribute__((target("sse4.2"))) size_t find_structural_byte_sse(
+    const std::string_view source) {
+  const __m128i quote = _mm_set1_epi8(QUOTE);
+  const __m128i hash = _mm_set1_epi8(HASH);
+  const __m128i backslash = _mm_set1_epi8(BACKSLASH);
+  const __m128i new_line = _mm_set1_epi8(NEW_LINE);
+  const __m128i carriage_return = _mm_set1_epi8(CARRIAGE_RETURN);
+  constexpr size_t lanes = sizeof(__m128i);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.data() + i));
+    const __m128i delimiter =
+        _mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                     _mm_or_si128(_mm_cmpeq_epi8(v, hash),
+                                  _mm_cmpeq_epi8(v, backslash)));
+    const __m128i line_terminator = _mm_or_si128(
+        _mm_cmpeq_epi8(v, new_line), _mm_cmpeq_epi8(v, carriage_return));
+    const auto found = static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_or_si128(delimiter, line_terminator)));
+
+    if (found != 0) {
+      return i + __builtin_ctz(found);
+    }
+  }
+
+  return find_structural_byte_scalar(source, i);
+}
+
+__attribute__((target("avx2"))) size_t find_structural_byte_avx2(
+    const std::string_view source) {
+  const __m256i quote = _mm256_set1_epi8(QUOTE);
+  const __m256i hash = _mm256_set1_epi8(HASH);
+  const __m256i backslash = _mm256_set1_epi8(BACKSLASH);
+  const __m256i new_line = _mm256_set1_epi8(NEW_LINE);
+  const __m256i carriage_return = _mm256_set1_epi8(CARRIAGE_RETURN);
+  constexpr size_t lanes = sizeof(__m256i);
+  size_t i = 0;
+
+  for (; i + lanes <= source.size(); i += lanes) {
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(source.data() + i));
+    const __m256i delimiter =
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, quote),
+                        _mm256_or_si256(_mm256_cmpeq_epi8(v, hash),
+                                        _mm256_cmpeq_epi8(v, backslash)));
+    const __m256i line_terminator = _mm256_or_si256(
+        _mm256_cmpeq_epi8(v, new_line), _mm256_cmpeq_epi8(v, carriage_return));
+    const auto found = static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_or_si256(delimiter, line_terminator)));
+
+    if (found != 0) {
+      return i + __builtin_ctz(found);
+    }
+  }
+
+  return find_structural_byte_scalar(source, i);
+}
+
+__attribute__((target("sse4.2"))) size_t find_json_escape_byte_sse(
+    const std::string_view value) {
+  const __m128i quote = _mm_set1_epi8(QUOTE);
+  const __m128i backslash = _mm_set1_epi8(BACKSLASH);
+  const __m128i last_control = _mm_set1_epi8(0x1F);
+  constexpr size_t lanes = sizeof(__m128i);
+  size_t i = 0;
+
+  for (; i + lanes <= value.size(); i += lanes) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(value.data() + i));
+    // A byte is a control character if it is its own unsigned minimum with
+    // 0x1F, which leaves the bytes of multibyte characters out.
+    const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(v, last_control), v);
+    const __m128i delimiter = _mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                           _mm_cmpeq_epi8(v, backslash));
+    const auto found = static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_or_si128(control, delimiter)));
+
+    if (found != 0) {
+      return i + __builtin_ctz(found);
+    }
+  }
+
+  return find_json_escape_byte_scalar(value, i);
+}
+
+__attribute__((target("avx2"))) size_t find_json_escape_byte_avx2(
+    const std::string_view value) {
+  const __m256i quote = _mm256_set1_epi8(QUOTE);
+  const __m256i backslash = _mm256_set1_epi8(BACKSLASH);
+  const __m256i last_control = _mm256_set1_epi8(0x1F);
+  constexpr size_t lanes = sizeof(__m256i);
+  size_t i = 0;
+
+  for (; i + lanes <= value.size(); i += lanes) {
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(value.data() + i));
+    const __m256i control =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(v, last_control), v);
+    const __m256i delimiter = _mm256_or_si256(
+        _mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash));
+    const auto found = static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_or_si256(control, delimiter)));
+
+    if (found != 0) {
+      return i + __builtin_ctz(found);
+    }
+  }
+
+  return find_json_escape_byte_scalar(value, i);
+}
+#endif
+
+bool is_scan_level_supported(const ScanLevel level) {
+  switch (level) {
+#ifdef GRAPHQLPP_X86_SIMD
+    case AVX2:
+      return __builtin_cpu_supports("avx2");
+    case SSE4_2:
+      return __builtin_cpu_supports("sse4.2");
+#else
+    case AVX2:
+    case SSE4_2:
+      return false;
+#endif
+    case SCALAR:
+    default:
+      return true;
+  }
+}
+
+ScanLevel get_best_scan_level() {
+  static const ScanLevel level = is_scan_level_supported(AVX2)     ? AVX2
+                                 : is_scan_level_supported(SSE4_2) ? SSE4_2
+                                                                   : SCALAR;
+  return level;
+}
+
+size_t find_invalid_source_character(const std::u32string_view source,
+                                     const ScanLevel level) {
+  switch (level) {
+#ifdef GRAPHQLPP_X86_SIMD
+    case AVX2:
+      return find_invalid_source_character_avx2(source);
+    case SSE4_2:
+      return find_invalid_source_character_sse(source);
+#endif
+    default:
+      return find_invalid_source_character_scalar(source, 0);
+  }
+}
+
+size_t find_non_ascii_or_invalid_byte(const std::string_view source,
+                                      const ScanLevel level) {
+  switch (level) {
+#ifdef GRAPHQLPP_X86_SIMD
+    case AVX2:
+      return find_non_ascii_or_invalid_byte_avx2(source);
+    case SSE4_2:
+      return find_non_ascii_or_invalid_byte_sse(source);
+#endif
+    default:
+      return find_non_ascii_or_invalid_byte_scalar(source, 0);
+  }
+}
+
+size_t find_line_terminator(const std::u32string_view source,
+                            const ScanLevel level) {
+  switch (level) {
+#ifdef GRAPHQLPP_X86_SIMD
+    case AVX2:
+      return find_line_terminator_avx2(source);
+    case SSE4_2:
+      return find_line_terminator_sse(source);
+#endif
+    default:
+      return find_line_terminator_scalar(source, 0);
+  }
+}
+
+size_t find_line_terminator(const std::string_view source,
+                            const ScanLevel level) {
+  switch (level) {
+#ifdef GRAPHQLPP_X86_SIMD
+    case AVX2:
+      return find_line_terminator_avx2(source);
+    case SSE4_2:
+      return find_line_terminator_sse(source);
+#endif
+    default:
+      return find_line_terminator_scalar(source, 0);
+  }
+}
+
+size_t find_non_whitespace(const std::u32string_view source,
+                           const ScanLevel level) {
+  switch (level) {
+#ifdef GRAPHQLPP_X86_SIMD
+    case AVX2:
+      return find_non_whitespace_avx2(source);
+    case SSE4_2:
+      return find_non_whitespace_sse(source);
+#endif
+    default:
+      return find_non_whitespace_scalar(source, 0);
+  }
+}
+
+size_t find_non_whitespace(const std::string_view source,
+                           const ScanLevel level) {
+  switch (level) {
+#ifdef GRAPHQLPP_X86_SIMD
+    case AVX2:
+      return find_non_whitespace_avx2(source);
+    case SSE4_2:
+      return find_non_whitespace_sse(source);
+#endif
+    default:
+      return find_non_whitespace_scalar(source, 0);
+  }
+}
+
+size_t find_structural_byte(const std::string_view source,
+                            const ScanLevel level) {
+  switch (level) {
+#ifdef GRAPHQLPP_X86_SIMD
+    case AVX2:
+      return find_structural_byte_avx2(source);
+    case SSE4_2:
+      return find_structural_byte_sse(source);
+#endif
+    default:
+      return find_structural_byte_scalar(source, 0);
+  }
+}
+
+size_t find_json_escape_byte(const std::string_view value,
+                             const ScanLevel level) {
+  switch (level) {
+#ifdef GRAPHQLPP_X86_SIMD
+    case AVX2:
+      return find_json_escape_byte_avx2(value);
+    case SSE4_2:
+      return find_json_escape_byte_sse(value);
+#endif
+    default:
+      return find_json_escape_byte_scalar(value, 0);
+  }
+}
+}  // namespace graphqlpp::language::tokenization
@@ -0,0 +1,86 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef SOURCE_SCAN_H
+#define SOURCE_SCAN_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace graphqlpp::language::tokenization {
+/// \brief Instruction set used by the bulk scanning kernels.
+enum ScanLevel { SCALAR, SSE4_2, AVX2 };
+
+/// \brief Whether the running CPU supports the scanning level.
+/// \param level Scanning level to be tested.
+/// \return True if the kernels of the level can be used, false otherwise.
+bool is_scan_level_supported(ScanLevel level);
+
+/// \brief Best scanning level supported by the running CPU. It is detected
+/// once and cached.
+/// \return The widest supported scanning level.
+ScanLevel get_best_scan_level();
+
+/// \brief Finds the first code point which is not a valid source character.
+/// \param source UTF-32 source text.
+/// \param level Scanning level to be used.
+/// \return Index of the first invalid code point, or the size of the source
+/// if every code point is valid.
+size_t find_invalid_source_character(std::u32string_view source,
+                                     ScanLevel level = get_best_scan_level());
+
+/// \brief Finds the first byte which is either not ASCII or an ASCII
+/// character which is not a valid source character. Everything before it is
+/// valid source text, everything from it must be decoded to be validated.
+/// \param source UTF-8 source text.
+/// \param level Scanning level to be used.
+/// \return Index of the first byte, or the size of the source if every byte
+/// is a valid ASCII source character.
+size_t find_non_ascii_or_invalid_byte(std::string_view source,
+                                      ScanLevel level = get_best_scan_level());
+
+/// \brief Finds the first '\\n' or '\\r'.
+/// \param source UTF-32 source text.
+/// \param level Scanning level to be used.
+/// \return Index of the line terminator, or the size of the source.
+size_t find_line_terminator(std::u32string_view source,
+                            ScanLevel level = get_best_scan_level());
+
+/// \brief Finds the first '\\n' or '\\r'.
+/// \param source UTF-8 source text.
+/// \param level Scanning level to be used.
+/// \return Index of the line terminator, or the size of the source.
+size_t find_line_terminator(std::string_view source,
+                            ScanLevel level = get_best_scan_level());
+
+/// \brief Finds the first code point which is neither a space nor a tab.
+/// \param source UTF-32 source text.
+/// \param level Scanning level to be used.
+/// \return Index of the code point, or the size of the source.
+size_t find_non_whitespace(std::u32string_view source,
+                           ScanLevel level = get_best_scan_level());
+
+/// \brief Finds the first byte which is neither a space nor a tab.
+/// \param source UTF-8 source text.
+/// \param level Scanning level to be used.
+/// \return Index of the byte, or the size of the source.
+size_t find_non_whitespace(std::string_view source,
+                           ScanLevel level = get_best_scan_level());
+
+/// \brief Finds the first byte which may start or end a string, a block
+/// string or a comment: '"', '\\', '#', '\\n' or '\\r'.
+/// \param source UTF-8 source text.
+/// \param level Scanning level to be used.
+/// \return Index of the byte, or the size of the source.
+size_t find_structural_byte(std::string_view source,
+                            ScanLevel level = get_best_scan_level());
+
+/// \brief Finds the first byte which has to be escaped within a JSON string:
+/// '"', '\\' or a control character below 0x20.
+/// \param value UTF-8 text.
+/// \param level Scanning level to be used.
+/// \return Index of the byte, or the size of the text.
+size_t find_json_escape_byte(std::string_view value,
+                             ScanLevel level = get_best_scan_level());
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // SOURCE_SCAN_H
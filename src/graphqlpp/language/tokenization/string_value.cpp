@@ -0,0 +1,259 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "string_value.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace graphqlpp::language::tokenization {
+namespace {
+constexpr size_t BLOCK_STRING_DELIMITER_LENGTH = 3;
+constexpr std::string_view ESCAPED_BLOCK_STRING_DELIMITER = "\\\"\"\"";
+
+/// \brief Value of a hexadecimal digit, which the scanner already validated.
+constexpr char32_t hex_value(const char digit) {
+  if (digit <= '9') {
+    return digit - '0';
+  }
+
+  return (digit | 0x20) - 'a' + 10;
+}
+
+constexpr bool is_leading_surrogate(const char32_t value) {
+  return value >= 0xD800 && value <= 0xDBFF;
+}
+
+void append_utf8(const char32_t character, std::string& output) {
+  if (character < 0x80) {
+    output += static_cast<char>(character);
+  } else if (character < 0x800) {
+    output += static_cast<char>(0xC0 | (character >> 6));
+    output += static_cast<char>(0x80 | (character & 0x3F));
+  } else if (character < 0x10000) {
+    output += static_cast<char>(0xE0 | (character >> 12));
+    output += static_cast<char>(0x80 | ((character >> 6) & 0x3F));
+    output += static_cast<char>(0x80 | (character & 0x3F));
+  } else {
+    output += static_cast<char>(0xF0 | (character >> 18));
+    output += static_cast<char>(0x80 | ((character >> 12) & 0x3F));
+    output += static_cast<char>(0x80 | ((character >> 6) & 0x3F));
+    output += static_cast<char>(0x80 | (character & 0x3F));
+  }
+}
+
+/// \brief Value of the four hexadecimal digits starting at the given offset.
+char32_t read_fixed_width_hex(const std::string_view raw_value,
+                              const size_t i) {
+  char32_t value = 0;
+
+  for (size_t j = i; j < i + 4; j++) {
+    value = value * 16 + hex_value(raw_value[j]);
+  }
+
+  return value;
+}
+
+/// \brief Decodes the '\\u' escape sequence starting at the given backslash.
+/// \return Offset after the escape sequence.
+size_t decode_unicode_escape(const std::string_view raw_value, const size_t i,
+                             std::string& output) {
+  if (raw_value[i + 2] == '{') {
+    size_t j = i + 3;
+    char32_t value = 0;
+
+    for (; raw_value[j] != '}'; j++) {
+      value = value * 16 + hex_value(raw_value[j]);
+    }
+
+    append_utf8(value, output);
+
+    return j + 1;
+  }
+
+  const char32_t value = read_fixed_width_hex(raw_value, i + 2);
+
+  // The scanner only accepts leading surrogates followed by a trailing one.
+  if (is_leading_surrogate(value)) {
+    const char32_t trailing = read_fixed_width_hex(raw_value, i + 8);
+    append_utf8(0x10000 + ((value - 0xD800) << 10) + (trailing - 0xDC00),
+                output);
+
+    return i + 12;
+  }
+
+  append_utf8(value, output);
+
+  return i + 6;
+}
+
+/// \brief Offset where the next line starts, after the line terminator at
+/// the given offset.
+size_t skip_line_terminator(const std::string_view raw_value, const size_t i) {
+  if (raw_value[i] == '\r' && i + 1 < raw_value.size() &&
+      raw_value[i + 1] == '\n') {
+    return i + 2;
+  }
+
+  return i + 1;
+}
+
+/// \brief Appends a line of a block string, unescaping its triple quotes.
+void append_block_string_line(const std::string_view line, std::string& output,
+                              const ScanLevel level) {
+  size_t i = 0;
+
+  while (true) {
+    const size_t run = find_structural_byte(line.substr(i), level);
+    output.append(line, i, run);
+    i += run;
+
+    if (i == line.size()) {
+      return;
+    }
+
+    if (line.substr(i).starts_with(ESCAPED_BLOCK_STRING_DELIMITER)) {
+      output.append(ESCAPED_BLOCK_STRING_DELIMITER.substr(1));
+      i += ESCAPED_BLOCK_STRING_DELIMITER.size();
+    } else {
+      output += line[i];
+      i++;
+    }
+  }
+}
+}  // namespace
+
+void decode_string(const std::string_view raw_value, std::string& output,
+                   const ScanLevel level) {
+  // Escape sequences are never shorter than what they stand for.
+  output.reserve(output.size() + raw_value.size());
+  size_t i = 0;
+
+  while (true) {
+    // Strings cannot contain line terminators or unescaped quotes, so the
+    // kernel only stops at backslashes and at the odd '#'.
+    const size_t run = find_structural_byte(raw_value.substr(i), level);
+    output.append(raw_value, i, run);
+    i += run;
+
+    if (i == raw_value.size()) {
+      return;
+    }
+
+    if (raw_value[i] != '\\') {
+      output += raw_value[i];
+      i++;
+      continue;
+    }
+
+    switch (raw_value[i + 1]) {
+      case 'b':
+        output += '\b';
+        break;
+      case 'f':
+        output += '\f';
+        break;
+      case 'n':
+        output += '\n';
+        break;
+      case 'r':
+        output += '\r';
+        break;
+      case 't':
+        output += '\t';
+        break;
+      case 'u':
+        i = decode_unicode_escape(raw_value, i, output);
+        continue;
+      default:
+        // '"', '\\' and '/' stand for themselves.
+        output += raw_value[i + 1];
+    }
+
+    i += 2;
+  }
+}
+
+void decode_block_string(const std::string_view raw_value, std::string& output,
+                         const ScanLevel level) {
+  // The lines are walked twice: first to find the common indentation and the
+  // lines which are not blank, then to append them. Neither pass stores the
+  // lines.
+  size_t common_indentation = std::numeric_limits<size_t>::max();
+  size_t first_line = raw_value.size();
+  size_t last_line = 0;
+
+  for (size_t i = 0; i <= raw_value.size();) {
+    const std::string_view rest = raw_value.substr(i);
+    const size_t length = find_line_terminator(rest, level);
+    const size_t indentation =
+        find_non_whitespace(rest.substr(0, length), level);
+
+    if (indentation < length) {
+      // The first line's indentation precedes the opening quotes.
+      if (i > 0) {
+        common_indentation = std::min(common_indentation, indentation);
+      }
+
+      first_line = std::min(first_line, i);
+      last_line = i;
+    }
+
+    if (i + length == raw_value.size()) {
+      break;
+    }
+
+    i = skip_line_terminator(raw_value, i + length);
+  }
+
+  if (first_line == raw_value.size()) {
+    return;
+  }
+
+  output.reserve(output.size() + raw_value.size());
+
+  for (size_t i = first_line; i <= last_line;) {
+    const size_t length = find_line_terminator(raw_value.substr(i), level);
+    std::string_view line = raw_value.substr(i, length);
+
+    if (i > first_line) {
+      output += '\n';
+    }
+
+    if (i > 0) {
+      line.remove_prefix(std::min(common_indentation, line.size()));
+    }
+
+    append_block_string_line(line, output, level);
+
+    if (i == last_line) {
+      break;
+    }
+
+    i = skip_line_terminator(raw_value, i + length);
+  }
+}
+
+std::string_view get_string_value(const std::string_view token_value,
+                                  const bool escaped, std::string& storage) {
+  const bool block =
+      token_value.size() >= 2 * BLOCK_STRING_DELIMITER_LENGTH &&
+      token_value.starts_with("\"\"\"");
+  const size_t delimiter_length = block ? BLOCK_STRING_DELIMITER_LENGTH : 1;
+  const std::string_view raw_value = token_value.substr(
+      delimiter_length, token_value.size() - 2 * delimiter_length);
+
+  if (!escaped) {
+    return raw_value;
+  }
+
+  storage.clear();
+
+  if (block) {
+    decode_block_string(raw_value, storage);
+  } else {
+    decode_string(raw_value, storage);
+  }
+
+  return storage;
+}
+}  // namespace graphqlpp::language::tokenization
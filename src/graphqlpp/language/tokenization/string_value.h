@@ -0,0 +1,47 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef STRING_VALUE_H
+#define STRING_VALUE_H
+
+#include <string>
+#include <string_view>
+
+#include "source_scan.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief Appends the value of a string, replacing its escape sequences with
+/// the characters they stand for. Runs without escape sequences are found
+/// through the bulk scanning kernels and copied at once.
+///
+/// Escaped surrogate pairs are combined into a single character. Lone
+/// escaped surrogates are rejected by the scanner, so they never reach the
+/// decoder.
+/// \param raw_value Characters between the quotes of a string token.
+/// \param output String where the UTF-8 value is appended.
+/// \param level Scanning level to be used.
+void decode_string(std::string_view raw_value, std::string& output,
+                   ScanLevel level = get_best_scan_level());
+
+/// \brief Appends the value of a block string: the common indentation of its
+/// lines and its leading and trailing blank lines are removed, its line
+/// terminators become '\\n' and its escaped triple quotes are unescaped.
+/// \param raw_value Characters between the triple quotes of a block string
+/// token.
+/// \param output String where the UTF-8 value is appended.
+/// \param level Scanning level to be used.
+void decode_block_string(std::string_view raw_value, std::string& output,
+                         ScanLevel level = get_best_scan_level());
+
+/// \brief Value of a string token, only decoded if the token was flagged as
+/// escaped. Otherwise, the value is a view of the token's characters, so
+/// strings which are just passed through are never copied.
+/// \param token_value Characters of the string token, quotes included.
+/// \param escaped Whether the token was flagged as escaped.
+/// \param storage String where a decoded value is written, which is left
+/// untouched otherwise.
+/// \return View of the value, within either the token or the storage.
+std::string_view get_string_value(std::string_view token_value, bool escaped,
+                                  std::string& storage);
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // STRING_VALUE_H
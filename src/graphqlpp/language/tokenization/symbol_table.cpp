@@ -0,0 +1,114 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "symbol_table.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <mutex>
+
+namespace graphqlpp::language::tokenization {
+/// \brief Keywords in the order of <i>KeywordSymbol</i>.
+constexpr std::array<std::string_view, KEYWORD_SYMBOL_COUNT> KEYWORDS = {
+    "query",     "mutation",  "subscription", "fragment",   "on",
+    "true",      "false",     "null",         "schema",     "scalar",
+    "type",      "interface", "union",        "enum",       "input",
+    "extend",    "directive", "implements",   "repeatable"};
+
+SymbolTable::SymbolTable(const size_t shard_count)
+    : SymbolTable(std::span<const std::string_view>(), shard_count) {}
+
+SymbolTable::SymbolTable(const std::span<const std::string_view> names,
+                         const size_t shard_count)
+    : shard_count_(std::max<size_t>(shard_count, 1)),
+      shards_(std::make_unique<Shard[]>(shard_count_)) {
+  names_.reserve(KEYWORDS.size() + names.size());
+
+  for (const std::string_view keyword : KEYWORDS) {
+    intern(keyword);
+  }
+
+  for (const std::string_view name : names) {
+    intern(name);
+  }
+}
+
+Symbol SymbolTable::intern(const std::string_view name) {
+  const size_t hash = std::hash<std::string_view>{}(name);
+  Shard& shard = get_shard(hash);
+
+  {
+    std::shared_lock lock(shard.mutex_);
+    const auto it = shard.symbols_.find(Key{.hash_ = hash, .name_ = name});
+
+    if (it != shard.symbols_.end()) {
+      return it->second;
+    }
+  }
+
+  std::unique_lock lock(shard.mutex_);
+  const auto it = shard.symbols_.find(Key{.hash_ = hash, .name_ = name});
+
+  // Another thread may have interned the name while the lock was released.
+  if (it != shard.symbols_.end()) {
+    return it->second;
+  }
+
+  const std::string_view stored_name = shard.names_.emplace_back(name);
+  Symbol symbol;
+
+  {
+    std::unique_lock names_lock(names_mutex_);
+    symbol = static_cast<Symbol>(names_.size());
+    names_.push_back(stored_name);
+  }
+
+  shard.symbols_.emplace(Key{.hash_ = hash, .name_ = stored_name}, symbol);
+
+  return symbol;
+}
+
+std::optional<Symbol> SymbolTable::find(const std::string_view name) const {
+  const size_t hash = std::hash<std::string_view>{}(name);
+  const Shard& shard = get_shard(hash);
+  std::shared_lock lock(shard.mutex_);
+  const auto it = shard.symbols_.find(Key{.hash_ = hash, .name_ = name});
+
+  if (it == shard.symbols_.end()) {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+
+std::string_view SymbolTable::get_name(const Symbol symbol) const {
+  std::shared_lock lock(names_mutex_);
+
+  return names_.at(symbol);
+}
+
+size_t SymbolTable::size() const {
+  std::shared_lock lock(names_mutex_);
+
+  return names_.size();
+}
+
+SymbolTable::Shard& SymbolTable::get_shard(const size_t hash) const {
+  return shards_[hash % shard_count_];
+}
+
+std::vector<Symbol> intern_names(const std::string_view source,
+                                 const TokenBuffer& tokens,
+                                 SymbolTable& table) {
+  std::vector<Symbol> symbols(tokens.size(), NO_SYMBOL);
+
+  for (size_t i = 0; i < tokens.size(); i++) {
+    if (tokens.get_type(i) == NAME) {
+      symbols[i] = table.intern(
+          source.substr(tokens.get_offset(i), tokens.get_length(i)));
+    }
+  }
+
+  return symbols;
+}
+}  // namespace graphqlpp::language::tokenization
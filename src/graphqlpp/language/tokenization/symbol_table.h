@@ -0,0 +1,129 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "token_buffer.h"
+
+namespace graphqlpp::language::tokenization {
+/// \brief Compact identifier of an interned name. Two names are equal if and
+/// only if their symbols, obtained from the same table, are equal.
+using Symbol = uint32_t;
+
+constexpr Symbol NO_SYMBOL = std::numeric_limits<Symbol>::max();
+
+/// \brief Symbols of the keywords of the GraphQL specification. Every table
+/// is seeded with them in this order, so they are the same in every table.
+enum KeywordSymbol : Symbol {
+  QUERY_SYMBOL,
+  MUTATION_SYMBOL,
+  SUBSCRIPTION_SYMBOL,
+  FRAGMENT_SYMBOL,
+  ON_SYMBOL,
+  TRUE_SYMBOL,
+  FALSE_SYMBOL,
+  NULL_SYMBOL,
+  SCHEMA_SYMBOL,
+  SCALAR_SYMBOL,
+  TYPE_SYMBOL,
+  INTERFACE_SYMBOL,
+  UNION_SYMBOL,
+  ENUM_SYMBOL,
+  INPUT_SYMBOL,
+  EXTEND_SYMBOL,
+  DIRECTIVE_SYMBOL,
+  IMPLEMENTS_SYMBOL,
+  REPEATABLE_SYMBOL,
+  KEYWORD_SYMBOL_COUNT
+};
+
+/// \brief Thread-safe table mapping names to symbols. Each distinct name is
+/// stored once, and symbols are handed out sequentially.
+///
+/// Names are spread across shards, each one with a reader-writer lock, so
+/// looking up names which are already interned, which is the common case
+/// once the table is seeded, only takes a shared lock on a single shard.
+class SymbolTable {
+ public:
+  static constexpr size_t DEFAULT_SHARD_COUNT = 16;
+
+  /// \brief Creates a table seeded with the keywords of the specification.
+  explicit SymbolTable(size_t shard_count = DEFAULT_SHARD_COUNT);
+
+  /// \brief Creates a table seeded with the keywords of the specification
+  /// and the given names, e.g. the types and fields of a schema.
+  explicit SymbolTable(std::span<const std::string_view> names,
+                       size_t shard_count = DEFAULT_SHARD_COUNT);
+
+  SymbolTable(const SymbolTable&) = delete;
+  SymbolTable& operator=(const SymbolTable&) = delete;
+
+  /// \brief Symbol of the given name, interning it if needed.
+  Symbol intern(std::string_view name);
+
+  /// \brief Symbol of the given name, without interning it.
+  /// \return The symbol, or <i>std::nullopt</i> if the name is not interned.
+  [[nodiscard]] std::optional<Symbol> find(std::string_view name) const;
+
+  /// \brief Name of an interned symbol. The view is valid as long as the
+  /// table.
+  [[nodiscard]] std::string_view get_name(Symbol symbol) const;
+
+  /// \brief Amount of interned names.
+  [[nodiscard]] size_t size() const;
+
+ private:
+  struct Key {
+    size_t hash_;
+    std::string_view name_;
+
+    bool operator==(const Key& other) const {
+      return hash_ == other.hash_ && name_ == other.name_;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const { return key.hash_; }
+  };
+
+  struct Shard {
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<Key, Symbol, KeyHash> symbols_;
+    /// \brief Interned names. A deque never relocates its elements, so the
+    /// keys' views stay valid as it grows.
+    std::deque<std::string> names_;
+  };
+
+  size_t shard_count_;
+  std::unique_ptr<Shard[]> shards_;
+  /// \brief Name of every symbol, indexed by symbol. Only locked after a
+  /// shard's lock.
+  mutable std::shared_mutex names_mutex_;
+  std::vector<std::string_view> names_;
+
+  [[nodiscard]] Shard& get_shard(size_t hash) const;
+};
+
+/// \brief Interns every NAME token of a buffer.
+/// \param source UTF-8 source text the tokens were tokenized from.
+/// \param tokens Tokens of the source.
+/// \param table Table the names are interned into.
+/// \return Symbol of every token, in the same order as the buffer, with
+/// <i>NO_SYMBOL</i> for the tokens which are not names.
+std::vector<Symbol> intern_names(std::string_view source,
+                                 const TokenBuffer& tokens, SymbolTable& table);
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // SYMBOL_TABLE_H
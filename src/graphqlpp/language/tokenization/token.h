@@ -3,6 +3,8 @@
 #ifndef TOKEN_H
 #define TOKEN_H
 
+#include <cstddef>
+#include <string_view>
 #include <vector>
 
 namespace graphqlpp::language::tokenization {
@@ -21,22 +23,65 @@ enum TokenType {
   COMMA
 };
 
-/// \brief GraphQL token.
+/// \brief GraphQL token. It does not own its value, instead it references the
+/// source it was tokenized from. Its line and column are found through a
+/// <i>LineIndex</i> of the source.
 struct Token {
-  std::vector<char32_t> value_;
   TokenType type_;
   bool ignored_;
-  /// \brief Line where the token starts.
-  size_t line_;
-  /// \brief Column where the token starts.
-  size_t column_;
-
-  bool operator==(const Token& other) const {
-    return ignored_ == other.ignored_ && type_ == other.type_ &&
-           line_ == other.line_ && column_ == other.column_ &&
-           std::ranges::equal(value_, other.value_);
+  /// \brief Whether the token is a string whose value differs from its raw
+  /// characters: it contains escape sequences or, being a block string,
+  /// several lines whose indentation may be stripped. Only flagged strings
+  /// have to be decoded.
+  bool escaped_ = false;
+  /// \brief Code unit of the source where the token starts.
+  size_t offset_;
+  /// \brief Amount of code units of the source covered by the token.
+  size_t length_;
+
+  bool operator==(const Token& other) const = default;
+
+  /// \brief Value of the token within the UTF-32 source it was tokenized from.
+  /// \param source GraphQL source text the token was tokenized from.
+  /// \return View of the token's characters.
+  [[nodiscard]] std::u32string_view get_value(
+      const std::vector<char32_t>& source) const {
+    return std::u32string_view(source.data() + offset_, length_);
+  }
+
+  /// \brief Value of the token within the UTF-8 source it was tokenized from.
+  /// \param source GraphQL source text the token was tokenized from.
+  /// \return View of the token's bytes.
+  [[nodiscard]] std::string_view get_value(std::string_view source) const {
+    return source.substr(offset_, length_);
+  }
+
+  /// \brief Value of the token within the UTF-8 source it was tokenized from.
+  /// \param source GraphQL source text the token was tokenized from.
+  /// \return View of the token's bytes.
+  [[nodiscard]] std::u8string_view get_value(std::u8string_view source) const {
+    return source.substr(offset_, length_);
   }
 };
+
+/// \brief Quoted punctuator, as described within error messages. The
+/// descriptions are static so recording an error never allocates.
+/// \param punctuator Value of a punctuator token.
+/// \return Description of the punctuator, or "a punctuator" if it is unknown.
+constexpr std::string_view describe_punctuator(
+    const std::string_view punctuator) {
+  constexpr std::string_view DESCRIPTIONS[] = {
+      "'!'", "'$'", "'&'", "'('", "')'", "'...'", "':'", "'='", "'@'",
+      "'['", "']'", "'{'", "'|'", "'}'"};
+
+  for (const std::string_view description : DESCRIPTIONS) {
+    if (description.substr(1, description.size() - 2) == punctuator) {
+      return description;
+    }
+  }
+
+  return "a punctuator";
+}
 }  // namespace graphqlpp::language::tokenization
 
-#endif  // TOKEN_H
\ No newline at end of file
+#endif  // TOKEN_H
@@ -0,0 +1,132 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "token_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace graphqlpp::language::tokenization {
+constexpr size_t MINIMUM_CAPACITY = 16;
+
+/// \brief Bytes used by a single token across every array of the buffer.
+constexpr size_t BYTES_PER_TOKEN =
+    2 * sizeof(size_t) + sizeof(std::uint8_t) + 2 * sizeof(bool);
+
+/// \brief Alignment of the storage, which the widest array needs.
+constexpr size_t STORAGE_ALIGNMENT = alignof(size_t);
+
+TokenBuffer::TokenBuffer(std::pmr::memory_resource* resource)
+    : resource_(resource) {}
+
+TokenBuffer::TokenBuffer(const size_t capacity,
+                         std::pmr::memory_resource* resource)
+    : resource_(resource) {
+  reserve(capacity);
+}
+
+TokenBuffer::~TokenBuffer() { release(); }
+
+TokenBuffer::TokenBuffer(TokenBuffer&& other) noexcept {
+  *this = std::move(other);
+}
+
+TokenBuffer& TokenBuffer::operator=(TokenBuffer&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  release();
+  resource_ = other.resource_;
+  storage_ = std::exchange(other.storage_, nullptr);
+  size_ = std::exchange(other.size_, 0);
+  capacity_ = std::exchange(other.capacity_, 0);
+  offsets_ = std::exchange(other.offsets_, nullptr);
+  lengths_ = std::exchange(other.lengths_, nullptr);
+  types_ = std::exchange(other.types_, nullptr);
+  ignored_ = std::exchange(other.ignored_, nullptr);
+  escaped_ = std::exchange(other.escaped_, nullptr);
+
+  return *this;
+}
+
+size_t TokenBuffer::get_memory_usage() const {
+  return capacity_ * BYTES_PER_TOKEN;
+}
+
+void TokenBuffer::reserve(const size_t capacity) {
+  if (capacity <= capacity_) {
+    return;
+  }
+
+  auto* storage = static_cast<std::byte*>(
+      resource_->allocate(capacity * BYTES_PER_TOKEN, STORAGE_ALIGNMENT));
+
+  // Wider arrays go first so that every array stays naturally aligned.
+  auto* offsets = reinterpret_cast<size_t*>(storage);
+  size_t* lengths = offsets + capacity;
+  auto* types = reinterpret_cast<std::uint8_t*>(lengths + capacity);
+  auto* ignored = reinterpret_cast<bool*>(types + capacity);
+  bool* escaped = ignored + capacity;
+
+  if (size_ > 0) {
+    std::memcpy(offsets, offsets_, size_ * sizeof(size_t));
+    std::memcpy(lengths, lengths_, size_ * sizeof(size_t));
+    std::memcpy(types, types_, size_ * sizeof(std::uint8_t));
+    std::memcpy(ignored, ignored_, size_ * sizeof(bool));
+    std::memcpy(escaped, escaped_, size_ * sizeof(bool));
+  }
+
+  release();
+  storage_ = storage;
+  capacity_ = capacity;
+  offsets_ = offsets;
+  lengths_ = lengths;
+  types_ = types;
+  ignored_ = ignored;
+  escaped_ = escaped;
+}
+
+void TokenBuffer::push_back(const Token& token) {
+  if (size_ == capacity_) {
+    reserve(std::max(MINIMUM_CAPACITY, capacity_ * 2));
+  }
+
+  offsets_[size_] = token.offset_;
+  lengths_[size_] = token.length_;
+  types_[size_] = static_cast<std::uint8_t>(token.type_);
+  ignored_[size_] = token.ignored_;
+  escaped_[size_] = token.escaped_;
+  size_++;
+}
+
+void TokenBuffer::append(const TokenBuffer& other,
+                         const size_t offset_delta) {
+  if (other.size_ == 0) {
+    return;
+  }
+
+  if (size_ + other.size_ > capacity_) {
+    reserve(std::max(size_ + other.size_, capacity_ * 2));
+  }
+
+  for (size_t i = 0; i < other.size_; i++) {
+    offsets_[size_ + i] = other.offsets_[i] + offset_delta;
+  }
+
+  std::memcpy(lengths_ + size_, other.lengths_, other.size_ * sizeof(size_t));
+  std::memcpy(types_ + size_, other.types_,
+              other.size_ * sizeof(std::uint8_t));
+  std::memcpy(ignored_ + size_, other.ignored_, other.size_ * sizeof(bool));
+  std::memcpy(escaped_ + size_, other.escaped_, other.size_ * sizeof(bool));
+  size_ += other.size_;
+}
+
+void TokenBuffer::release() {
+  if (storage_ != nullptr) {
+    resource_->deallocate(storage_, capacity_ * BYTES_PER_TOKEN,
+                          STORAGE_ALIGNMENT);
+    storage_ = nullptr;
+  }
+}
+}  // namespace graphqlpp::language::tokenization
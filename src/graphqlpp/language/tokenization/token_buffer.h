@@ -0,0 +1,225 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef TOKEN_BUFFER_H
+#define TOKEN_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+
+#include "token.h"
+
+namespace graphqlpp::language::tokenization {
+class TokenBuffer;
+
+/// \brief Lightweight read-only view over a token stored within a
+/// <i>TokenBuffer</i>.
+class TokenView {
+ public:
+  TokenView(const TokenBuffer* buffer, const size_t index)
+      : buffer_(buffer), index_(index) {}
+
+  [[nodiscard]] TokenType get_type() const;
+  [[nodiscard]] bool is_ignored() const;
+  /// \brief Whether the token is a string which has to be decoded.
+  [[nodiscard]] bool is_escaped() const;
+  /// \brief Code unit of the source where the token starts.
+  [[nodiscard]] size_t get_offset() const;
+  /// \brief Amount of code units of the source covered by the token.
+  [[nodiscard]] size_t get_length() const;
+  /// \brief Position of the token within its buffer.
+  [[nodiscard]] size_t get_index() const { return index_; }
+
+  /// \brief Copies the viewed token into a standalone <i>Token</i>.
+  [[nodiscard]] Token to_token() const;
+
+  template <typename SourceType>
+  [[nodiscard]] auto get_value(const SourceType& source) const {
+    return to_token().get_value(source);
+  }
+
+  bool operator==(const TokenView& other) const = default;
+
+ private:
+  const TokenBuffer* buffer_;
+  size_t index_;
+};
+
+/// \brief Structure-of-arrays container of tokens. Every token field is stored
+/// in its own contiguous array, and all the arrays share a single block taken
+/// from the buffer's memory resource, so filling the buffer for a whole
+/// document takes one allocation per growth.
+class TokenBuffer {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = TokenView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = TokenView;
+
+    Iterator() = default;
+    Iterator(const TokenBuffer* buffer, const size_t index)
+        : buffer_(buffer), index_(index) {}
+
+    TokenView operator*() const { return TokenView(buffer_, index_); }
+    TokenView operator[](const difference_type n) const {
+      return TokenView(buffer_, index_ + n);
+    }
+
+    Iterator& operator++() {
+      index_++;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator copy = *this;
+      index_++;
+      return copy;
+    }
+    Iterator& operator--() {
+      index_--;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator copy = *this;
+      index_--;
+      return copy;
+    }
+    Iterator& operator+=(const difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    Iterator& operator-=(const difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+    friend Iterator operator+(Iterator it, const difference_type n) {
+      return it += n;
+    }
+    friend Iterator operator+(const difference_type n, Iterator it) {
+      return it += n;
+    }
+    friend Iterator operator-(Iterator it, const difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const Iterator& a, const Iterator& b) {
+      return static_cast<difference_type>(a.index_) -
+             static_cast<difference_type>(b.index_);
+    }
+
+    bool operator==(const Iterator& other) const {
+      return index_ == other.index_;
+    }
+    auto operator<=>(const Iterator& other) const {
+      return index_ <=> other.index_;
+    }
+
+   private:
+    const TokenBuffer* buffer_ = nullptr;
+    size_t index_ = 0;
+  };
+
+  TokenBuffer() = default;
+  /// \param resource Memory resource the storage is taken from, which must
+  /// outlive the buffer.
+  explicit TokenBuffer(std::pmr::memory_resource* resource);
+  /// \param capacity Amount of tokens the buffer can hold before growing.
+  /// \param resource Memory resource the storage is taken from, which must
+  /// outlive the buffer.
+  explicit TokenBuffer(
+      size_t capacity,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+  ~TokenBuffer();
+
+  TokenBuffer(TokenBuffer&& other) noexcept;
+  TokenBuffer& operator=(TokenBuffer&& other) noexcept;
+  TokenBuffer(const TokenBuffer&) = delete;
+  TokenBuffer& operator=(const TokenBuffer&) = delete;
+
+  [[nodiscard]] size_t size() const { return size_; }
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  /// \brief Amount of bytes held by the buffer.
+  [[nodiscard]] size_t get_memory_usage() const;
+  /// \brief Memory resource the storage is taken from.
+  [[nodiscard]] std::pmr::memory_resource* get_memory_resource() const {
+    return resource_;
+  }
+
+  /// \brief Ensures the buffer can hold at least <i>capacity</i> tokens
+  /// without allocating again.
+  void reserve(size_t capacity);
+
+  /// \brief Removes every token, keeping the allocated storage.
+  void clear() { size_ = 0; }
+
+  void push_back(const Token& token);
+
+  /// \brief Appends every token of another buffer, shifting their offsets.
+  /// \param other Buffer whose tokens are appended.
+  /// \param offset_delta Code units added to every offset.
+  void append(const TokenBuffer& other, size_t offset_delta);
+
+  [[nodiscard]] TokenView operator[](const size_t i) const {
+    return TokenView(this, i);
+  }
+
+  [[nodiscard]] Iterator begin() const { return Iterator(this, 0); }
+  [[nodiscard]] Iterator end() const { return Iterator(this, size_); }
+
+  [[nodiscard]] TokenType get_type(const size_t i) const {
+    return static_cast<TokenType>(types_[i]);
+  }
+  [[nodiscard]] bool is_ignored(const size_t i) const { return ignored_[i]; }
+  [[nodiscard]] bool is_escaped(const size_t i) const { return escaped_[i]; }
+  [[nodiscard]] size_t get_offset(const size_t i) const { return offsets_[i]; }
+  [[nodiscard]] size_t get_length(const size_t i) const { return lengths_[i]; }
+
+ private:
+  std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
+  std::byte* storage_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+
+  size_t* offsets_ = nullptr;
+  size_t* lengths_ = nullptr;
+  std::uint8_t* types_ = nullptr;
+  bool* ignored_ = nullptr;
+  bool* escaped_ = nullptr;
+
+  /// \brief Returns the storage to the memory resource.
+  void release();
+};
+
+inline TokenType TokenView::get_type() const {
+  return buffer_->get_type(index_);
+}
+
+inline bool TokenView::is_ignored() const {
+  return buffer_->is_ignored(index_);
+}
+
+inline bool TokenView::is_escaped() const {
+  return buffer_->is_escaped(index_);
+}
+
+inline size_t TokenView::get_offset() const {
+  return buffer_->get_offset(index_);
+}
+
+inline size_t TokenView::get_length() const {
+  return buffer_->get_length(index_);
+}
+
+inline Token TokenView::to_token() const {
+  return Token{.type_ = get_type(),
+               .ignored_ = is_ignored(),
+               .escaped_ = is_escaped(),
+               .offset_ = get_offset(),
+               .length_ = get_length()};
+}
+}  // namespace graphqlpp::language::tokenization
+
+#endif  // TOKEN_BUFFER_H
@@ -0,0 +1,99 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "tokenize_error.h"
+
+#include "../../execution/json_writer.h"
+#include "source_scan.h"
+
+namespace graphqlpp::language::tokenization {
+std::string_view get_error_message(const TokenizeErrorCode code) {
+  switch (code) {
+    case INVALID_CHARACTER:
+      return "Detected an invalid Unicode character.";
+    case MALFORMED_UTF8:
+      return "Detected a malformed UTF-8 sequence.";
+    case UNEXPECTED_CHARACTER:
+      return "Detected an unexpected character.";
+    case INVALID_NUMBER_LEADING_ZERO:
+      return "Detected an invalid number, unexpected digit after 0.";
+    case INVALID_NUMBER_EXPECTED_DIGIT:
+      return "Detected an invalid number, expected a digit.";
+    case UNTERMINATED_STRING:
+      return "Detected an unterminated string.";
+    case INVALID_ESCAPE_SEQUENCE:
+    default:
+      return "Detected an invalid escape sequence.";
+  }
+}
+
+std::string_view get_error_code_name(const TokenizeErrorCode code) {
+  switch (code) {
+    case INVALID_CHARACTER:
+      return "INVALID_CHARACTER";
+    case MALFORMED_UTF8:
+      return "MALFORMED_UTF8";
+    case UNEXPECTED_CHARACTER:
+      return "UNEXPECTED_CHARACTER";
+    case INVALID_NUMBER_LEADING_ZERO:
+      return "INVALID_NUMBER_LEADING_ZERO";
+    case INVALID_NUMBER_EXPECTED_DIGIT:
+      return "INVALID_NUMBER_EXPECTED_DIGIT";
+    case UNTERMINATED_STRING:
+      return "UNTERMINATED_STRING";
+    case INVALID_ESCAPE_SEQUENCE:
+    default:
+      return "INVALID_ESCAPE_SEQUENCE";
+  }
+}
+
+std::string_view get_json_escape_sequence(const char b, char (&buffer)[6]) {
+  switch (b) {
+    case '"':
+      return "\\\"";
+    case '\\':
+      return "\\\\";
+    case '\n':
+      return "\\n";
+    case '\r':
+      return "\\r";
+    case '\t':
+      return "\\t";
+    default: {
+      constexpr char HEX_DIGITS[] = "0123456789abcdef";
+      const auto u = static_cast<unsigned char>(b);
+      buffer[0] = '\\';
+      buffer[1] = 'u';
+      buffer[2] = '0';
+      buffer[3] = '0';
+      buffer[4] = HEX_DIGITS[u >> 4];
+      buffer[5] = HEX_DIGITS[u & 0xF];
+
+      return {buffer, sizeof(buffer)};
+    }
+  }
+}
+
+void append_json_string(std::string_view value, std::string& output) {
+  output += '"';
+
+  // Plain runs are copied at once, and only the bytes found by the scan are
+  // escaped one by one.
+  for (size_t i = find_json_escape_byte(value); i < value.size();
+       i = find_json_escape_byte(value)) {
+    char buffer[6];
+    output.append(value.data(), i);
+    output += get_json_escape_sequence(value[i], buffer);
+    value.remove_prefix(i + 1);
+  }
+
+  output += value;
+  output += '"';
+}
+
+void TokenizeError::write_json(std::string& output) const {
+  execution::JsonWriter writer =
+      execution::JsonWriter(execution::JsonWriter::ERROR_CHUNK_SIZE);
+  writer.write_error(*this);
+  output += writer.to_string();
+}
+}  // namespace graphqlpp::language::tokenization
@@ -2,32 +2,89 @@
 
 #ifndef TOKENIZE_ERROR_H
 #define TOKENIZE_ERROR_H
-#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
-#include "extension.h"
 #include "location.h"
 
 namespace graphqlpp::language::tokenization {
-class TokenizeError {
- private:
-  std::string message_;
-  std::optional<std::vector<Location>> locations_;
-  std::optional<std::vector<std::string>> path_;
-  std::optional<std::vector<Extension>> extensions_;
+enum TokenizeErrorCode : std::uint8_t {
+  INVALID_CHARACTER,
+  MALFORMED_UTF8,
+  UNEXPECTED_CHARACTER,
+  INVALID_NUMBER_LEADING_ZERO,
+  INVALID_NUMBER_EXPECTED_DIGIT,
+  UNTERMINATED_STRING,
+  INVALID_ESCAPE_SEQUENCE
+};
+
+/// \brief Human-readable description of an error code.
+/// \param code Error code.
+/// \return Statically allocated message.
+std::string_view get_error_message(TokenizeErrorCode code);
+
+/// \brief Name of an error code, as reported within the error's extensions.
+/// \param code Error code.
+/// \return Statically allocated name.
+std::string_view get_error_code_name(TokenizeErrorCode code);
 
+/// \brief Escape sequence of a byte which has to be escaped within a JSON
+/// string, as found by <i>find_json_escape_byte</i>.
+/// \param b Byte to be escaped.
+/// \param buffer Storage of the sequence, unless it is a static one.
+/// \return The sequence, which may point into <i>buffer</i>.
+std::string_view get_json_escape_sequence(char b, char (&buffer)[6]);
+
+/// \brief Appends a JSON string literal to a string, escaping it as needed.
+/// \param value Unescaped value.
+/// \param output String where the literal is appended.
+void append_json_string(std::string_view value, std::string& output);
+
+/// \brief Compact tokenization error. It only keeps what went wrong and
+/// where, and never allocates: the message and the GraphQL response
+/// representation are only built once they are asked for.
+class TokenizeError {
  public:
-  TokenizeError(std::string message,
-                std::optional<std::vector<Location>> locations,
-                std::optional<std::vector<std::string>> path,
-                std::optional<std::vector<Extension>> extensions) {
-    message_ = std::move(message);
-    locations_ = std::move(locations);
-    path_ = std::move(path);
-    extensions_ = std::move(extensions);
+  /// \param code What went wrong.
+  /// \param offset Code unit of the source where it went wrong.
+  /// \param location Line and column of the offset.
+  constexpr TokenizeError(const TokenizeErrorCode code, const size_t offset,
+                          const Location location)
+      : code_(code), offset_(offset), location_(location) {}
+
+  [[nodiscard]] constexpr TokenizeErrorCode get_code() const { return code_; }
+
+  /// \brief Code unit of the source where the error was detected.
+  [[nodiscard]] constexpr size_t get_offset() const { return offset_; }
+
+  /// \brief Line and column where the error was detected.
+  [[nodiscard]] constexpr Location get_location() const { return location_; }
+
+  /// \brief Locations of the error, as reported within a GraphQL response.
+  /// Tokenization errors always have a single one.
+  [[nodiscard]] std::optional<std::vector<Location>> get_locations() const {
+    return std::vector<Location>{location_};
+  }
+
+  [[nodiscard]] std::string_view get_message() const {
+    return get_error_message(code_);
   }
 
-  std::optional<std::vector<Location>> get_locations() { return locations_; }
+  /// \brief Appends the error as an entry of a GraphQL response's "errors"
+  /// list: its message, locations and extensions with the error code.
+  /// \param output String where the JSON object is appended.
+  void write_json(std::string& output) const;
+
+  bool operator==(const TokenizeError& other) const = default;
+
+ private:
+  TokenizeErrorCode code_;
+  size_t offset_;
+  Location location_;
 };
 }  // namespace graphqlpp::language::tokenization
 
@@ -2,154 +2,222 @@
 
 #include "tokenizer.h"
 
-constexpr char32_t SPECIAL_VALID_SOURCE_CHARACTERS[] = {
-    U'\U00000009', U'\U0000000A', U'\U0000000D'};
+#include <algorithm>
+#include <utility>
+
+#include "line_index.h"
+#include "scanner.h"
+#include "source.h"
 
 namespace graphqlpp::language::tokenization {
 
-Result<std::vector<Token>, TokenizeError> invalid_source_character_error(
-    size_t line, size_t column);
+/// \brief Policy the tokenizer runs with when called through the library's
+/// entry points, which record metrics if instrumentation is enabled.
+constexpr TokenizePolicy get_entry_policy(TokenizePolicy policy) {
+  policy.record_metrics_ =
+      policy.record_metrics_ || instrumentation::INSTRUMENTATION_ENABLED;
+
+  return policy;
+}
 
-/// \brief Checks whether a source character is a line terminator.
+constexpr TokenizePolicy FULL_FIDELITY_ENTRY_POLICY =
+    get_entry_policy(FULL_FIDELITY_POLICY);
+
+/// \brief Tokenizes a source into a new vector of tokens.
 /// \param source GraphQL source text.
-/// \param i Current character within the source text.
-/// \return The first boolean indicates whether the character is a line
-/// terminator, and the second boolean indicates if the line terminator is a
-/// '\r\n'.
-std::tuple<bool, bool> is_source_character_a_line_terminator(
-    const std::vector<char32_t>& source, size_t i);
+/// \param tokens Empty vector, which may carry an allocator.
+template <typename Source, typename Vector = std::vector<Token>>
+Result<Vector, TokenizeError> tokenize_source(const Source& source,
+                                              Vector tokens = Vector()) {
+  Result<size_t, TokenizeError> r =
+      tokenize_source<FULL_FIDELITY_ENTRY_POLICY>(source, tokens);
+
+  if (!r.IsOk()) {
+    return Result<Vector, TokenizeError>::Err(r.UnwrapErr());
+  }
+
+  return Result<Vector, TokenizeError>::Ok(std::move(tokens));
+}
 
 Result<std::vector<Token>, TokenizeError> tokenize(
     const std::vector<char32_t>& source) {
-  std::vector<Token> tokens = std::vector<Token>();
-  size_t line = 1;
-  size_t column = 1;
-
-  // TODO: #1 handle more than `long`'s maximum value characters within a
-  // document.
-  if (source.size() > std::numeric_limits<long>::max()) {
-    return Result<std::vector<Token>, TokenizeError>::Err(
-        TokenizeError("The document exceeds the maximum value of 'long'.",
-                      std::vector{Location{.line_ = line, .column_ = column}},
-                      std::nullopt, std::nullopt));
-  }
+  return tokenize_source(Utf32Source(source));
+}
 
-  size_t token_start_line = 1;
-  size_t token_start_column = 1;
-  long token_start = 0;
-  TokenType token_type;
-  bool is_token_end = false;
+Result<std::pmr::vector<Token>, TokenizeError> tokenize(
+    const std::vector<char32_t>& source,
+    std::pmr::memory_resource* resource) {
+  return tokenize_source(Utf32Source(source),
+                         std::pmr::vector<Token>(resource));
+}
 
-  for (long i = 0; i < source.size(); i++) {
-    char32_t s = source.at(i);
+Result<std::pmr::vector<Token>, TokenizeError> tokenize(
+    const std::string_view source, std::pmr::memory_resource* resource) {
+  return tokenize_source(Utf8Source(source),
+                         std::pmr::vector<Token>(resource));
+}
 
-    if (!is_source_character_valid(s)) {
-      return invalid_source_character_error(line, column);
-    }
+Result<std::vector<Token>, TokenizeError> tokenize(
+    const std::string_view source) {
+  return tokenize_source(Utf8Source(source));
+}
+
+Result<std::vector<Token>, TokenizeError> tokenize(
+    const std::u8string_view source) {
+  return tokenize_source(Utf8Source(source));
+}
 
-    // Punctuator
+Result<size_t, TokenizeError> tokenize(const std::vector<char32_t>& source,
+                                       TokenBuffer& tokens) {
+  return tokenize_source<FULL_FIDELITY_ENTRY_POLICY>(Utf32Source(source),
+                                                     tokens);
+}
 
-    // Line terminator
-    auto [is_line_terminator, is_carriage_return_and_new_line] =
-        is_source_character_a_line_terminator(source, i);
+Result<size_t, TokenizeError> tokenize(const std::string_view source,
+                                       TokenBuffer& tokens) {
+  return tokenize_source<FULL_FIDELITY_ENTRY_POLICY>(Utf8Source(source),
+                                                     tokens);
+}
 
-    if (is_line_terminator) {
-      token_type = LINE_TERMINATOR;
-      line++;
-      column = 1;
+Result<size_t, TokenizeError> tokenize(const std::u8string_view source,
+                                       TokenBuffer& tokens) {
+  return tokenize_source<FULL_FIDELITY_ENTRY_POLICY>(Utf8Source(source),
+                                                     tokens);
+}
 
-      if (is_carriage_return_and_new_line) {
-        i++;
-      }
+template <TokenizePolicy Policy>
+Result<size_t, TokenizeError> tokenize(const std::string_view source,
+                                       TokenBuffer& tokens) {
+  return tokenize_source<get_entry_policy(Policy)>(Utf8Source(source), tokens);
+}
 
-      is_token_end = true;
+template Result<size_t, TokenizeError> tokenize<FULL_FIDELITY_POLICY>(
+    std::string_view source, TokenBuffer& tokens);
+template Result<size_t, TokenizeError> tokenize<SIGNIFICANT_TOKENS_POLICY>(
+    std::string_view source, TokenBuffer& tokens);
+template Result<size_t, TokenizeError>
+tokenize<TRUSTED_SIGNIFICANT_TOKENS_POLICY>(std::string_view source,
+                                            TokenBuffer& tokens);
+template Result<size_t, TokenizeError>
+tokenize<METERED_SIGNIFICANT_TOKENS_POLICY>(std::string_view source,
+                                            TokenBuffer& tokens);
+
+/// \brief Offsets of the first invalid characters of a source.
+/// \param source GraphQL source text.
+/// \param max_errors Amount of invalid characters after which it stops.
+std::vector<InvalidCharacter> find_invalid_characters(
+    const Utf8Source& source, const size_t max_errors) {
+  const std::string_view bytes = source.get_bytes();
+  std::vector<InvalidCharacter> invalid_characters;
+  size_t i = 0;
+
+  while (invalid_characters.size() < max_errors) {
+    InvalidCharacter invalid =
+        Utf8Source(bytes.substr(i)).find_invalid_character();
+
+    if (i + invalid.offset_ == bytes.size()) {
+      break;
     }
 
-    if (token_type != LINE_TERMINATOR) {
-      column++;
-    }
+    invalid.offset_ += i;
+    invalid_characters.push_back(invalid);
 
-    if (is_token_end) {
-      tokens.push_back(Token{.value_ = std::vector(source.begin() + token_start,
-                                                   source.begin() + i + 1),
-                             .type_ = token_type,
-                             .ignored_ = is_token_type_ignored(token_type),
-                             .line_ = token_start_line,
-                             .column_ = token_start_column});
-
-      token_start_line = line;
-      token_start_column = column;
-      token_start = i + 1;
-      is_token_end = false;
-    }
+    // Malformed sequences are skipped one byte at a time, as the next byte
+    // may start a valid character.
+    const size_t width = source.decode(invalid.offset_).width_;
+    i = invalid.offset_ + std::max<size_t>(width, 1);
   }
 
-  return Result<std::vector<Token>, TokenizeError>::Ok(tokens);
+  return invalid_characters;
 }
 
-bool is_source_character_valid(const char32_t source_character) {
-  for (const char32_t s : SPECIAL_VALID_SOURCE_CHARACTERS) {
-    if (source_character == s) {
-      return true;
-    }
+/// \brief Code unit where scanning resumes after a failed scan. Strings
+/// cannot span lines, so the rest of the line of a broken string is skipped
+/// instead of being scanned as if it was outside of the string.
+size_t get_recovery_offset(const Utf8Source& source, const size_t start,
+                           const ScanResult& result) {
+  size_t i = std::max(result.end_, start + 1);
+
+  if (result.error_ == INVALID_ESCAPE_SEQUENCE) {
+    i = source.find_line_terminator(i, source.size());
   }
 
-  if (source_character >= U'\U00000020' && source_character <= U'\U0000FFFF') {
-    return true;
+  while (i < source.size() && (source.unit(i) & 0xC0) == 0x80) {
+    i++;
   }
 
-  return false;
+  return i;
 }
 
-bool is_token_type_ignored(TokenType type) {
-  switch (type) {
-    case PUNCTUATOR:
-    case NAME:
-    case INT_VALUE:
-    case FLOAT_VALUE:
-    case STRING_VALUE:
-      return false;
-    case UNICODE_BOM:
-    case WHITESPACE:
-    case LINE_TERMINATOR:
-    case COMMENT:
-    case COMMA:
-    default:
-      return true;
+Result<size_t, std::vector<TokenizeError>> tokenize_collecting_errors(
+    const std::string_view source, TokenBuffer& tokens,
+    size_t max_errors) {
+  // Without room for a single error, both passes would be skipped and the
+  // source reported as valid.
+  max_errors = std::max<size_t>(max_errors, 1);
+  const Utf8Source utf8_source = Utf8Source(source);
+  const size_t initial_size = tokens.size();
+  const std::vector<InvalidCharacter> invalid_characters =
+      find_invalid_characters(utf8_source, max_errors);
+
+  // Errors are kept as offsets, and only located once tokenizing is over.
+  std::vector<std::pair<size_t, TokenizeErrorCode>> errors;
+  errors.reserve(invalid_characters.size());
+
+  for (const InvalidCharacter& invalid : invalid_characters) {
+    errors.emplace_back(invalid.offset_, invalid.malformed_
+                                             ? MALFORMED_UTF8
+                                             : INVALID_CHARACTER);
   }
-}
 
-Result<std::vector<Token>, TokenizeError> invalid_source_character_error(
-    size_t line, size_t column) {
-  std::vector<Location> locations = std::vector<Location>();
-  locations.push_back(Location{.line_ = line, .column_ = column});
+  const size_t invalid_count = errors.size();
+  size_t scan_error_count = 0;
+  Scanner<Utf8Source> scanner = Scanner(utf8_source, source.size(), true);
+  size_t i = 0;
 
-  return Result<std::vector<Token>, TokenizeError>::Err(
-      TokenizeError("Detected an invalid Unicode character.",
-                    std::move(locations), std::nullopt, std::nullopt));
-}
+  while (i < source.size() && scan_error_count < max_errors) {
+    const ScanResult r = scanner.scan(i);
+
+    if (r.status_ == SCANNED) {
+      push_token(tokens, r.type_, i, r.end_, r.escaped_);
+      i = r.end_;
+      continue;
+    }
 
-std::tuple<bool, bool> is_source_character_a_line_terminator(
-    const std::vector<char32_t>& source, size_t i) {
-  const char32_t s = source.at(i);
+    // Invalid characters outside of strings also fail to scan, but they were
+    // already reported.
+    const auto invalid_end = errors.begin() + invalid_count;
+    const bool is_reported = std::binary_search(
+        errors.begin(), invalid_end, std::make_pair(r.end_, r.error_),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
 
-  bool is_line_terminator = false;
-  bool is_carriage_return_and_new_line = false;
+    if (!is_reported) {
+      errors.emplace_back(r.end_, r.error_);
+      scan_error_count++;
+    }
+
+    i = get_recovery_offset(utf8_source, i, r);
+  }
 
-  if (s == NEW_LINE) {
-    is_line_terminator = true;
+  if (errors.empty()) {
+    return Result<size_t, std::vector<TokenizeError>>::Ok(tokens.size() -
+                                                          initial_size);
   }
 
-  if (s == CARRIAGE_RETURN) {
-    const char32_t n = source.at(i + 1);
+  std::stable_sort(
+      errors.begin(), errors.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
+  errors.resize(std::min(errors.size(), max_errors));
 
-    is_line_terminator = true;
+  const LineIndex line_index = LineIndex(source);
+  std::vector<TokenizeError> located_errors;
+  located_errors.reserve(errors.size());
 
-    if (n == NEW_LINE) {
-      is_carriage_return_and_new_line = true;
-    }
+  for (const auto& [offset, code] : errors) {
+    located_errors.emplace_back(code, offset, line_index.get_location(offset));
   }
 
-  return std::make_tuple(is_line_terminator, is_carriage_return_and_new_line);
+  return Result<size_t, std::vector<TokenizeError>>::Err(
+      std::move(located_errors));
 }
-}  // namespace graphqlpp::language::tokenization
\ No newline at end of file
+}  // namespace graphqlpp::language::tokenization
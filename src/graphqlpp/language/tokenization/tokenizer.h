@@ -2,13 +2,58 @@
 
 #ifndef TOKENIZER_H
 #define TOKENIZER_H
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
 #include "../../result.h"
 #include "token.h"
+#include "token_buffer.h"
 #include "tokenize_error.h"
 
 namespace graphqlpp::language::tokenization {
 constexpr char32_t NEW_LINE = U'\U0000000A';
 constexpr char32_t CARRIAGE_RETURN = U'\U0000000D';
+constexpr char32_t TAB = U'\U00000009';
+constexpr char32_t SPACE = U'\U00000020';
+
+/// \brief Compile-time features of a tokenizer instantiation. Features which
+/// are turned off are compiled away instead of being checked for every token.
+struct TokenizePolicy {
+  /// \brief Whether whitespace, line terminators, comments, commas and BOMs
+  /// are appended as ignored tokens, instead of being skipped.
+  bool emit_ignored_tokens_;
+  /// \brief Whether every character is checked to be a valid source character
+  /// before tokenizing. Characters which start a token are always checked, so
+  /// only the contents of strings and comments go unchecked without it.
+  bool validate_characters_;
+  /// \brief Whether the tokenizer records its duration, the code units and
+  /// tokens it scanned, and its errors. Builds with instrumentation enabled
+  /// record them for every policy.
+  bool record_metrics_ = false;
+};
+
+/// \brief Every token of a fully validated source, as returned by the
+/// non-templated <i>tokenize</i> overloads.
+constexpr TokenizePolicy FULL_FIDELITY_POLICY = {
+    .emit_ignored_tokens_ = true, .validate_characters_ = true};
+
+/// \brief Only the lexical tokens of a fully validated source, which is all
+/// a parser needs.
+constexpr TokenizePolicy SIGNIFICANT_TOKENS_POLICY = {
+    .emit_ignored_tokens_ = false, .validate_characters_ = true};
+
+/// \brief Only the lexical tokens of a source already known to be valid, such
+/// as a document which was tokenized before.
+constexpr TokenizePolicy TRUSTED_SIGNIFICANT_TOKENS_POLICY = {
+    .emit_ignored_tokens_ = false, .validate_characters_ = false};
+
+/// \brief Only the lexical tokens of a fully validated source, recording the
+/// tokenizer's metrics even if instrumentation is not enabled.
+constexpr TokenizePolicy METERED_SIGNIFICANT_TOKENS_POLICY = {
+    .emit_ignored_tokens_ = false,
+    .validate_characters_ = true,
+    .record_metrics_ = true};
 
 /// \brief GraphQL source text to tokens.
 /// \param source GraphQL source text.
@@ -16,15 +61,129 @@ constexpr char32_t CARRIAGE_RETURN = U'\U0000000D';
 Result<std::vector<Token>, TokenizeError> tokenize(
     const std::vector<char32_t>& source);
 
+/// \brief GraphQL UTF-8 source text to tokens. The source is decoded while it
+/// is being tokenized, so no intermediate UTF-32 copy is made. Token offsets
+/// and lengths are expressed in bytes.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \return A vector of <i>Token</i>s or an <i>TokenizeError</i>.
+Result<std::vector<Token>, TokenizeError> tokenize(std::string_view source);
+
+/// \brief GraphQL UTF-8 source text to tokens. The source is decoded while it
+/// is being tokenized, so no intermediate UTF-32 copy is made. Token offsets
+/// and lengths are expressed in bytes.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \return A vector of <i>Token</i>s or an <i>TokenizeError</i>.
+Result<std::vector<Token>, TokenizeError> tokenize(std::u8string_view source);
+
+/// \brief GraphQL source text to tokens, stored in a vector which takes its
+/// memory from the given resource.
+/// \param source GraphQL source text.
+/// \param resource Memory resource of the returned vector.
+/// \return A vector of <i>Token</i>s or an <i>TokenizeError</i>.
+Result<std::pmr::vector<Token>, TokenizeError> tokenize(
+    const std::vector<char32_t>& source, std::pmr::memory_resource* resource);
+
+/// \brief GraphQL UTF-8 source text to tokens, stored in a vector which takes
+/// its memory from the given resource. Token offsets and lengths are
+/// expressed in bytes.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \param resource Memory resource of the returned vector.
+/// \return A vector of <i>Token</i>s or an <i>TokenizeError</i>.
+Result<std::pmr::vector<Token>, TokenizeError> tokenize(
+    std::string_view source, std::pmr::memory_resource* resource);
+
+/// \brief GraphQL source text to tokens, appended to a <i>TokenBuffer</i>.
+/// The buffer is sized up front from the source length, so tokenizing a
+/// document usually takes one or two allocations from the buffer's memory
+/// resource.
+/// \param source GraphQL source text.
+/// \param tokens Buffer where the tokens are appended.
+/// \return The amount of appended tokens or an <i>TokenizeError</i>.
+Result<size_t, TokenizeError> tokenize(const std::vector<char32_t>& source,
+                                       TokenBuffer& tokens);
+
+/// \brief GraphQL UTF-8 source text to tokens, appended to a
+/// <i>TokenBuffer</i>. Token offsets and lengths are expressed in bytes.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \param tokens Buffer where the tokens are appended.
+/// \return The amount of appended tokens or an <i>TokenizeError</i>.
+Result<size_t, TokenizeError> tokenize(std::string_view source,
+                                       TokenBuffer& tokens);
+
+/// \brief GraphQL UTF-8 source text to tokens, appended to a
+/// <i>TokenBuffer</i>. Token offsets and lengths are expressed in bytes.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \param tokens Buffer where the tokens are appended.
+/// \return The amount of appended tokens or an <i>TokenizeError</i>.
+Result<size_t, TokenizeError> tokenize(std::u8string_view source,
+                                       TokenBuffer& tokens);
+
+/// \brief GraphQL UTF-8 source text to tokens, appended to a
+/// <i>TokenBuffer</i>, with the features selected by a policy. It is
+/// instantiated for the policies declared within this header.
+/// \tparam Policy Features of the tokenizer.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \param tokens Buffer where the tokens are appended.
+/// \return The amount of appended tokens or an <i>TokenizeError</i>.
+template <TokenizePolicy Policy>
+Result<size_t, TokenizeError> tokenize(std::string_view source,
+                                       TokenBuffer& tokens);
+
+/// \brief Default cap of <i>tokenize_collecting_errors</i>.
+constexpr size_t DEFAULT_MAX_TOKENIZE_ERRORS = 16;
+
+/// \brief GraphQL UTF-8 source text to tokens, appended to a
+/// <i>TokenBuffer</i>, without stopping at the first error. Invalid
+/// characters are skipped, and scanning resumes after each token which could
+/// not be scanned, so a single pass reports many errors.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \param tokens Buffer where the tokens are appended. If there are errors,
+/// it holds the tokens which could be scanned.
+/// \param max_errors Amount of errors after which tokenizing stops. Zero is
+/// treated as one, so an invalid source is never reported as valid.
+/// \return The amount of appended tokens or the errors sorted by offset.
+Result<size_t, std::vector<TokenizeError>> tokenize_collecting_errors(
+    std::string_view source, TokenBuffer& tokens,
+    size_t max_errors = DEFAULT_MAX_TOKENIZE_ERRORS);
+
 /// \brief Detect whether or not a character is a valid source character.
 /// \param source_character Character to be tested.
 /// \return True if the character is a valid source character, false otherwise.
-bool is_source_character_valid(char32_t source_character);
+constexpr bool is_source_character_valid(const char32_t source_character) {
+  if (source_character == TAB || source_character == NEW_LINE ||
+      source_character == CARRIAGE_RETURN) {
+    return true;
+  }
+
+  return source_character >= SPACE && source_character <= U'\U0000FFFF';
+}
+
+/// \brief Whether a character ends a line: '\\n' or '\\r', which may be
+/// followed by '\\n' to form a single line terminator.
+constexpr bool is_line_terminator(const char32_t source_character) {
+  return source_character == NEW_LINE || source_character == CARRIAGE_RETURN;
+}
 
 /// \brief Return whether or not the type is an ignored token.
 /// \param type Type of the token.
 /// \return True if the token type is an ignored token, false otherwise.
-bool is_token_type_ignored(TokenType type);
+constexpr bool is_token_type_ignored(const TokenType type) {
+  switch (type) {
+    case PUNCTUATOR:
+    case NAME:
+    case INT_VALUE:
+    case FLOAT_VALUE:
+    case STRING_VALUE:
+      return false;
+    case UNICODE_BOM:
+    case WHITESPACE:
+    case LINE_TERMINATOR:
+    case COMMENT:
+    case COMMA:
+    default:
+      return true;
+  }
+}
 
 }  // namespace graphqlpp::language::tokenization
 
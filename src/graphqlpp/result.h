@@ -2,11 +2,17 @@
 
 #ifndef RESULT_H
 #define RESULT_H
-#include <memory>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
 
 namespace graphqlpp {
 /// \brief Rust's Result type. Indicates whether an operation was a success or a
 /// failure by containing two possible values.
+/// The value is stored in place, so creating a result never allocates, and
+/// results of literal types may be used in constant expressions.
 /// Its inner value can only be accessed once since the value's ownership
 /// is moved to the caller.
 /// \tparam OkType Type of the value related to the success of the operation.
@@ -16,58 +22,102 @@ class Result {
  public:
   /// \brief Whether the contained value is related to a success or a failure.
   /// \return True if the contained value is ok, false otherwise.
-  [[nodiscard]] bool IsOk() const { return is_ok_; }
+  [[nodiscard]] constexpr bool IsOk() const {
+    return value_.index() == OK_INDEX;
+  }
 
   /// \brief Extracts the <b>Ok</b> value from the result. Throws an exception
   /// if the result does not contain a successful value.
   /// \return The <b>Ok</b> value from the result.
-  [[nodiscard]] std::unique_ptr<OkType> Unwrap() {
+  [[nodiscard]] constexpr OkType Unwrap() {
     if (!this->IsOk()) {
       throw std::logic_error("Unwrapped 'Ok' when the value was an 'Error'.");
     }
 
-    return std::move(this->ok_);
+    return std::move(std::get<OK_INDEX>(this->value_));
   }
 
   /// \brief Extracts the <b>Error</b> value from the result. Throws an
   /// exception if the result does not contain a successful value.
   /// \return The <b>Error</b> value from the result.
-  [[nodiscard]] std::unique_ptr<ErrorType> UnwrapErr() {
+  [[nodiscard]] constexpr ErrorType UnwrapErr() {
     if (this->IsOk()) {
       throw std::logic_error("Unwrapped 'Error' when the value was an 'Ok'.");
     }
 
-    return std::move(this->error_);
+    return std::move(std::get<ERROR_INDEX>(this->value_));
+  }
+
+  /// \brief Extracts the <b>Ok</b> value from the result, or returns the given
+  /// value if the result contains an <b>Error</b>.
+  /// \param default_value Value returned if the result is a failure.
+  /// \return The <b>Ok</b> value or the default value.
+  [[nodiscard]] constexpr OkType ValueOr(OkType default_value) {
+    if (!this->IsOk()) {
+      return default_value;
+    }
+
+    return std::move(std::get<OK_INDEX>(this->value_));
+  }
+
+  /// \brief Transforms the <b>Ok</b> value, keeping the <b>Error</b> value
+  /// untouched.
+  /// \param f Callable which receives the <b>Ok</b> value.
+  /// \return Result containing either the transformed value or the error.
+  template <typename Function>
+  [[nodiscard]] auto Map(Function&& f) {
+    using MappedType = std::invoke_result_t<Function, OkType>;
+
+    if (!this->IsOk()) {
+      return Result<MappedType, ErrorType>::Err(
+          std::move(std::get<ERROR_INDEX>(this->value_)));
+    }
+
+    return Result<MappedType, ErrorType>::Ok(std::invoke(
+        std::forward<Function>(f), std::move(std::get<OK_INDEX>(this->value_))));
+  }
+
+  /// \brief Chains an operation which may fail on the <b>Ok</b> value.
+  /// \param f Callable which receives the <b>Ok</b> value and returns a
+  /// <i>Result</i> with the same <b>Error</b> type.
+  /// \return The result of the operation, or the current error.
+  template <typename Function>
+  [[nodiscard]] auto AndThen(Function&& f) {
+    using ChainedResult = std::invoke_result_t<Function, OkType>;
+
+    if (!this->IsOk()) {
+      return ChainedResult::Err(std::move(std::get<ERROR_INDEX>(this->value_)));
+    }
+
+    return std::invoke(std::forward<Function>(f),
+                       std::move(std::get<OK_INDEX>(this->value_)));
   }
 
   /// \brief Creates a successful result containing an <b>Ok</b> value.
-  /// \param o Ok value which is moved into an <i>unique_ptr</i>.
+  /// \param o Ok value which is moved into the result.
   /// \return Result containing the <b>Ok</b> value.
-  static Result Ok(OkType o) {
-    return Result(std::make_unique<OkType>(std::move(o)),
-                  std::unique_ptr<ErrorType>(), true);
+  static constexpr Result Ok(OkType o) {
+    return Result(std::in_place_index<OK_INDEX>, std::move(o));
   }
 
   /// \brief Creates a failed result containing an <b>Error</b> value.
-  /// \param e Error value which is moved into an <i>unique_ptr</i>.
+  /// \param e Error value which is moved into the result.
   /// \return Result containing the <b>Error</b> value.
-  static Result Err(ErrorType e) {
-    return Result(std::unique_ptr<OkType>(),
-                  std::make_unique<ErrorType>(std::move(e)), false);
+  static constexpr Result Err(ErrorType e) {
+    return Result(std::in_place_index<ERROR_INDEX>, std::move(e));
   }
 
  private:
-  std::unique_ptr<OkType> ok_;
-  std::unique_ptr<ErrorType> error_;
-  bool is_ok_;
-
-  Result(std::unique_ptr<OkType> v, std::unique_ptr<ErrorType> e,
-         const bool is_ok) {
-    ok_ = std::move(v);
-    error_ = std::move(e);
-    is_ok_ = is_ok;
-  }
+  static constexpr size_t OK_INDEX = 0;
+  static constexpr size_t ERROR_INDEX = 1;
+
+  // Indexes are used instead of types so both types may be the same.
+  std::variant<OkType, ErrorType> value_;
+
+  template <size_t Index, typename ValueType>
+  constexpr Result(std::in_place_index_t<Index> index, ValueType&& value)
+      : value_(index, std::forward<ValueType>(value)) {}
 };
 }  // namespace graphqlpp
 
-#endif  // RESULT_H
\ No newline at end of file
+#endif  // RESULT_H
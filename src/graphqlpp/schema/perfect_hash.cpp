@@ -0,0 +1,240 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "perfect_hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace graphqlpp::schema {
+namespace {
+/// \brief Average amount of keys per bucket. Larger buckets take less
+/// memory but longer to place.
+constexpr size_t KEYS_PER_BUCKET = 4;
+
+/// \brief Displacements tried for a bucket before trying another seed.
+constexpr uint32_t MAX_DISPLACEMENT = 1 << 16;
+
+constexpr uint64_t GOLDEN_RATIO = 0x9E3779B97F4A7C15;
+constexpr uint64_t MULTIPLIER = 0xBF58476D1CE4E5B9;
+
+constexpr uint64_t mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCD;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53;
+  h ^= h >> 33;
+
+  return h;
+}
+
+/// \brief Loads the last bytes of a name, fewer than eight, without a call
+/// to <i>memcpy</i> of variable size. Overlapping loads are fine, since the
+/// length of the name is hashed too.
+uint64_t load_tail(const char* data, const size_t size) {
+  if (size >= sizeof(uint32_t)) {
+    uint32_t low;
+    uint32_t high;
+    std::memcpy(&low, data, sizeof(uint32_t));
+    std::memcpy(&high, data + size - sizeof(uint32_t), sizeof(uint32_t));
+
+    return low | static_cast<uint64_t>(high) << 32;
+  }
+
+  if (size == 0) {
+    return 0;
+  }
+
+  const auto first = static_cast<uint8_t>(data[0]);
+  const auto middle = static_cast<uint8_t>(data[size / 2]);
+  const auto last = static_cast<uint8_t>(data[size - 1]);
+
+  return first | static_cast<uint64_t>(middle) << 8 |
+         static_cast<uint64_t>(last) << 16;
+}
+
+/// \brief Hashes a key eight bytes at a time. The hash never leaves the
+/// process, so the bytes are read in native order.
+uint64_t hash_key(const std::string_view name, const uint32_t scope,
+                  const uint64_t seed) {
+  uint64_t h = seed ^ ((static_cast<uint64_t>(scope) << 32 | name.size()) *
+                       GOLDEN_RATIO);
+  size_t i = 0;
+
+  for (; i + sizeof(uint64_t) <= name.size(); i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, name.data() + i, sizeof(uint64_t));
+    h = (h ^ word) * MULTIPLIER;
+    h ^= h >> 31;
+  }
+
+  h = (h ^ load_tail(name.data() + i, name.size() - i)) * MULTIPLIER;
+
+  return mix(h);
+}
+
+/// \brief Maps 32 bits of a hash onto [0, size) without a division.
+uint32_t reduce(const uint32_t h, const size_t size) {
+  return static_cast<uint32_t>((static_cast<uint64_t>(h) * size) >> 32);
+}
+
+/// \brief The bucket is taken from the high half of the hash.
+uint32_t get_bucket(const uint64_t h, const size_t bucket_count) {
+  return reduce(static_cast<uint32_t>(h >> 32), bucket_count);
+}
+
+/// \brief The slot is taken from the low half of the hash, moved by a
+/// displacement times a step. Keys of a bucket share the top of their high
+/// half, but not the rest, so their steps differ and a displacement which
+/// places them apart is quickly found.
+uint32_t get_slot(const uint64_t h, const uint32_t displacement,
+                  const size_t slot_count) {
+  const auto step = static_cast<uint32_t>(h >> 32) | 1;
+
+  return reduce(static_cast<uint32_t>(h) + displacement * step, slot_count);
+}
+}  // namespace
+
+Result<PerfectHash, size_t> PerfectHash::build(
+    const std::span<const PerfectHashKey> keys) {
+  PerfectHash hash = PerfectHash();
+  std::vector<uint64_t> hashes(keys.size());
+  std::optional<std::pair<uint32_t, uint32_t>> collision;
+
+  for (uint64_t seed = 0;; seed++) {
+    hash.seed_ = seed * GOLDEN_RATIO;
+
+    for (size_t i = 0; i < keys.size(); i++) {
+      hashes[i] = hash_key(keys[i].name_, keys[i].scope_, hash.seed_);
+    }
+
+    collision.reset();
+
+    if (hash.place(hashes, collision)) {
+      return Result<PerfectHash, size_t>::Ok(std::move(hash));
+    }
+
+    // Equal hashes come from repeated keys or, very rarely, from distinct
+    // keys which another seed tells apart.
+    if (collision.has_value()) {
+      const PerfectHashKey& first = keys[collision->first];
+      const PerfectHashKey& second = keys[collision->second];
+
+      if (first.name_ == second.name_ && first.scope_ == second.scope_) {
+        return Result<PerfectHash, size_t>::Err(
+            std::max(collision->first, collision->second));
+      }
+    }
+  }
+}
+
+uint32_t PerfectHash::find(const std::string_view name,
+                           const uint32_t scope) const {
+  if (slots_.empty()) {
+    return NOT_FOUND;
+  }
+
+  const uint64_t h = hash_key(name, scope, seed_);
+  const uint32_t displacement =
+      displacements_[get_bucket(h, displacements_.size())];
+
+  return slots_[get_slot(h, displacement, slots_.size())];
+}
+
+bool PerfectHash::place(
+    const std::span<const uint64_t> hashes,
+    std::optional<std::pair<uint32_t, uint32_t>>& collision) {
+  const size_t key_count = hashes.size();
+  const size_t bucket_count =
+      std::max<size_t>(1, (key_count + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET);
+  // A fifth of the slots stay empty, which keeps the last buckets quick to
+  // place.
+  const size_t slot_count = key_count + key_count / 4 + 1;
+
+  displacements_.assign(bucket_count, 0);
+  slots_.assign(slot_count, NOT_FOUND);
+
+  // Keys are grouped by bucket through a counting sort.
+  std::vector<uint32_t> bucket_starts(bucket_count + 1, 0);
+
+  for (const uint64_t h : hashes) {
+    bucket_starts[get_bucket(h, bucket_count) + 1]++;
+  }
+
+  std::partial_sum(bucket_starts.begin(), bucket_starts.end(),
+                   bucket_starts.begin());
+
+  std::vector<uint32_t> bucket_keys(key_count);
+  std::vector<uint32_t> next = bucket_starts;
+
+  for (uint32_t i = 0; i < key_count; i++) {
+    bucket_keys[next[get_bucket(hashes[i], bucket_count)]++] = i;
+  }
+
+  // Larger buckets are placed first, while most slots are still free.
+  std::vector<uint32_t> buckets(bucket_count);
+  std::iota(buckets.begin(), buckets.end(), 0);
+  std::stable_sort(buckets.begin(), buckets.end(),
+                   [&](const uint32_t a, const uint32_t b) {
+                     return bucket_starts[a + 1] - bucket_starts[a] >
+                            bucket_starts[b + 1] - bucket_starts[b];
+                   });
+
+  std::vector<uint32_t> bucket_slots;
+
+  for (const uint32_t bucket : buckets) {
+    const std::span<const uint32_t> keys =
+        std::span<const uint32_t>(bucket_keys)
+            .subspan(bucket_starts[bucket],
+                     bucket_starts[bucket + 1] - bucket_starts[bucket]);
+
+    if (keys.empty()) {
+      break;
+    }
+
+    for (size_t i = 0; i < keys.size(); i++) {
+      for (size_t j = i + 1; j < keys.size(); j++) {
+        if (hashes[keys[i]] == hashes[keys[j]]) {
+          collision = std::make_pair(keys[i], keys[j]);
+          return false;
+        }
+      }
+    }
+
+    uint32_t displacement = 0;
+
+    for (;; displacement++) {
+      if (displacement == MAX_DISPLACEMENT) {
+        return false;
+      }
+
+      bucket_slots.clear();
+
+      for (const uint32_t key : keys) {
+        const uint32_t slot =
+            get_slot(hashes[key], displacement, slot_count);
+
+        if (slots_[slot] != NOT_FOUND ||
+            std::find(bucket_slots.begin(), bucket_slots.end(), slot) !=
+                bucket_slots.end()) {
+          break;
+        }
+
+        bucket_slots.push_back(slot);
+      }
+
+      if (bucket_slots.size() == keys.size()) {
+        break;
+      }
+    }
+
+    displacements_[bucket] = displacement;
+
+    for (size_t i = 0; i < keys.size(); i++) {
+      slots_[bucket_slots[i]] = keys[i];
+    }
+  }
+
+  return true;
+}
+}  // namespace graphqlpp::schema
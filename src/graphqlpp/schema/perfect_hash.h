@@ -0,0 +1,76 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef PERFECT_HASH_H
+#define PERFECT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../result.h"
+
+namespace graphqlpp::schema {
+/// \brief Key of a <i>PerfectHash</i>: a name within a scope, such as a
+/// field name within the type it belongs to.
+struct PerfectHashKey {
+  std::string_view name_;
+  uint32_t scope_;
+};
+
+/// \brief Hash built once for a fixed set of keys, which places every key
+/// within its own slot, so looking a key up takes a single probe.
+///
+/// Keys are spread over small buckets, and each bucket gets the displacement
+/// which places all of its keys within free slots. Finding a key hashes it
+/// once, reads its bucket's displacement and then its slot. Neither the keys
+/// nor their hashes are stored: a lookup returns the index of the only key
+/// which may match, and the caller compares it with its own copy.
+class PerfectHash {
+ public:
+  /// \brief Returned by <i>find</i> when no key may match.
+  static constexpr uint32_t NOT_FOUND = std::numeric_limits<uint32_t>::max();
+
+  /// \brief Hash without keys.
+  PerfectHash() = default;
+
+  /// \brief Builds the hash of a set of keys.
+  /// \param keys Keys, whose indexes are returned by <i>find</i>.
+  /// \return The hash or, if a key is repeated, the index of its second
+  /// occurrence.
+  static Result<PerfectHash, size_t> build(
+      std::span<const PerfectHashKey> keys);
+
+  /// \brief Finds the only key which may be equal to the given one.
+  /// \param name Name of the key.
+  /// \param scope Scope of the key.
+  /// \return The index of the key, which must still be compared with the
+  /// given one, or <i>NOT_FOUND</i>.
+  [[nodiscard]] uint32_t find(std::string_view name, uint32_t scope) const;
+
+  /// \brief Amount of bytes held by the hash.
+  [[nodiscard]] size_t get_memory_usage() const {
+    return (displacements_.size() + slots_.size()) * sizeof(uint32_t);
+  }
+
+ private:
+  uint64_t seed_ = 0;
+  /// \brief Displacement of each bucket.
+  std::vector<uint32_t> displacements_;
+  /// \brief Index of the key placed within each slot, or <i>NOT_FOUND</i>.
+  std::vector<uint32_t> slots_;
+
+  /// \brief Tries to place every key with the current seed.
+  /// \param hashes Hash of each key.
+  /// \param collision Set to two keys with equal hashes, if any was found.
+  /// \return Whether every key could be placed.
+  bool place(std::span<const uint64_t> hashes,
+             std::optional<std::pair<uint32_t, uint32_t>>& collision);
+};
+}  // namespace graphqlpp::schema
+
+#endif  // PERFECT_HASH_H
@@ -0,0 +1,186 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "schema.h"
+
+#include <algorithm>
+
+namespace graphqlpp::schema {
+TypeId Schema::find_type(const std::string_view name) const {
+  const uint32_t candidate = type_hash_.find(name, 0);
+
+  if (candidate >= types_.size() ||
+      get_string(types_[candidate].name_) != name) {
+    return INVALID_ID;
+  }
+
+  return candidate;
+}
+
+FieldId Schema::find_field(const TypeId type,
+                           const std::string_view name) const {
+  const TypeDefinition& definition = types_[type];
+
+  if (definition.kind_ != TypeKind::OBJECT &&
+      definition.kind_ != TypeKind::INTERFACE) {
+    return INVALID_ID;
+  }
+
+  const uint32_t candidate = field_hash_.find(name, type);
+
+  if (!definition.members_.contains(candidate) ||
+      get_string(fields_[candidate].name_) != name) {
+    return INVALID_ID;
+  }
+
+  return candidate;
+}
+
+InputValueId Schema::find_input_field(const TypeId type,
+                                      const std::string_view name) const {
+  const TypeDefinition& definition = types_[type];
+
+  if (definition.kind_ != TypeKind::INPUT_OBJECT) {
+    return INVALID_ID;
+  }
+
+  return find_input_value(definition.members_, get_input_field_scope(type),
+                          name);
+}
+
+InputValueId Schema::find_argument(const FieldId field,
+                                   const std::string_view name) const {
+  return find_input_value(fields_[field].arguments_, get_argument_scope(field),
+                          name);
+}
+
+EnumValueId Schema::find_enum_value(const TypeId type,
+                                    const std::string_view name) const {
+  const TypeDefinition& definition = types_[type];
+
+  if (definition.kind_ != TypeKind::ENUM) {
+    return INVALID_ID;
+  }
+
+  const uint32_t candidate = enum_value_hash_.find(name, type);
+
+  if (!definition.members_.contains(candidate) ||
+      get_string(enum_values_[candidate].name_) != name) {
+    return INVALID_ID;
+  }
+
+  return candidate;
+}
+
+DirectiveId Schema::find_directive(const std::string_view name) const {
+  const uint32_t candidate = directive_hash_.find(name, 0);
+
+  if (candidate >= directives_.size() ||
+      get_string(directives_[candidate].name_) != name) {
+    return INVALID_ID;
+  }
+
+  return candidate;
+}
+
+InputValueId Schema::find_directive_argument(
+    const DirectiveId directive, const std::string_view name) const {
+  return find_input_value(directives_[directive].arguments_,
+                          get_directive_argument_scope(directive), name);
+}
+
+bool Schema::is_possible_type(const TypeId type, const TypeId object) const {
+  if (type == object) {
+    return types_[type].kind_ == TypeKind::OBJECT;
+  }
+
+  const std::span<const TypeId> possible_types = get_possible_types(type);
+
+  return std::binary_search(possible_types.begin(), possible_types.end(),
+                            object);
+}
+
+std::span<const FieldDefinition> Schema::get_fields(const TypeId type) const {
+  const TypeDefinition& definition = types_[type];
+
+  if (definition.kind_ != TypeKind::OBJECT &&
+      definition.kind_ != TypeKind::INTERFACE) {
+    return {};
+  }
+
+  return std::span<const FieldDefinition>(fields_).subspan(
+      definition.members_.first_, definition.members_.count_);
+}
+
+std::span<const InputValueDefinition> Schema::get_input_fields(
+    const TypeId type) const {
+  const TypeDefinition& definition = types_[type];
+
+  if (definition.kind_ != TypeKind::INPUT_OBJECT) {
+    return {};
+  }
+
+  return std::span<const InputValueDefinition>(input_values_)
+      .subspan(definition.members_.first_, definition.members_.count_);
+}
+
+std::span<const InputValueDefinition> Schema::get_arguments(
+    const FieldId field) const {
+  const IdRange range = fields_[field].arguments_;
+
+  return std::span<const InputValueDefinition>(input_values_)
+      .subspan(range.first_, range.count_);
+}
+
+std::span<const EnumValueDefinition> Schema::get_enum_values(
+    const TypeId type) const {
+  const TypeDefinition& definition = types_[type];
+
+  if (definition.kind_ != TypeKind::ENUM) {
+    return {};
+  }
+
+  return std::span<const EnumValueDefinition>(enum_values_)
+      .subspan(definition.members_.first_, definition.members_.count_);
+}
+
+std::span<const TypeId> Schema::get_interfaces(const TypeId type) const {
+  const IdRange range = types_[type].interfaces_;
+
+  return std::span<const TypeId>(type_ids_).subspan(range.first_,
+                                                    range.count_);
+}
+
+std::span<const TypeId> Schema::get_possible_types(const TypeId type) const {
+  const IdRange range = types_[type].possible_types_;
+
+  return std::span<const TypeId>(type_ids_).subspan(range.first_,
+                                                    range.count_);
+}
+
+size_t Schema::get_memory_usage() const {
+  return strings_.capacity() +
+         types_.capacity() * sizeof(TypeDefinition) +
+         fields_.capacity() * sizeof(FieldDefinition) +
+         input_values_.capacity() * sizeof(InputValueDefinition) +
+         enum_values_.capacity() * sizeof(EnumValueDefinition) +
+         directives_.capacity() * sizeof(DirectiveDefinition) +
+         type_ids_.capacity() * sizeof(TypeId) +
+         type_hash_.get_memory_usage() + field_hash_.get_memory_usage() +
+         input_value_hash_.get_memory_usage() +
+         enum_value_hash_.get_memory_usage() +
+         directive_hash_.get_memory_usage();
+}
+
+InputValueId Schema::find_input_value(const IdRange range,
+                                      const uint32_t scope,
+                                      const std::string_view name) const {
+  const uint32_t candidate = input_value_hash_.find(name, scope);
+
+  if (!range.contains(candidate) ||
+      get_string(input_values_[candidate].name_) != name) {
+    return INVALID_ID;
+  }
+
+  return candidate;
+}
+}  // namespace graphqlpp::schema
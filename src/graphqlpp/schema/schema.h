@@ -0,0 +1,305 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "perfect_hash.h"
+
+namespace graphqlpp::schema {
+using TypeId = uint32_t;
+using FieldId = uint32_t;
+/// \brief Identifier of an argument or an input field.
+using InputValueId = uint32_t;
+using EnumValueId = uint32_t;
+using DirectiveId = uint32_t;
+
+/// \brief Returned by lookups which find nothing.
+constexpr uint32_t INVALID_ID = std::numeric_limits<uint32_t>::max();
+
+/// \brief Most lists a <i>TypeReference</i> can wrap a named type within.
+constexpr uint8_t MAX_LIST_DEPTH = 15;
+
+enum class TypeKind : uint8_t {
+  SCALAR,
+  OBJECT,
+  INTERFACE,
+  UNION,
+  ENUM,
+  INPUT_OBJECT
+};
+
+enum class DirectiveLocation : uint8_t {
+  QUERY,
+  MUTATION,
+  SUBSCRIPTION,
+  FIELD,
+  FRAGMENT_DEFINITION,
+  FRAGMENT_SPREAD,
+  INLINE_FRAGMENT,
+  VARIABLE_DEFINITION,
+  SCHEMA,
+  SCALAR,
+  OBJECT,
+  FIELD_DEFINITION,
+  ARGUMENT_DEFINITION,
+  INTERFACE,
+  UNION,
+  ENUM,
+  ENUM_VALUE,
+  INPUT_OBJECT,
+  INPUT_FIELD_DEFINITION
+};
+
+/// \brief Characters within the string storage of a <i>Schema</i>.
+struct StringRange {
+  uint32_t offset_ = 0;
+  uint32_t length_ = 0;
+};
+
+/// \brief Consecutive elements of one of the arrays of a <i>Schema</i>.
+struct IdRange {
+  uint32_t first_ = 0;
+  uint32_t count_ = 0;
+
+  [[nodiscard]] bool contains(const uint32_t id) const {
+    return id - first_ < count_;
+  }
+};
+
+/// \brief Type of a field, argument or input field, such as "[String!]!".
+struct TypeReference {
+  TypeId type_ = INVALID_ID;
+  /// \brief Amount of lists wrapping the named type.
+  uint8_t list_depth_ = 0;
+  /// \brief Bit i tells whether the type found within i lists, counted from
+  /// the outside, is non-null: bit 0 stands for the whole type, and bit
+  /// <i>list_depth_</i> for the named type.
+  uint16_t non_null_mask_ = 0;
+
+  [[nodiscard]] bool is_non_null() const { return (non_null_mask_ & 1) != 0; }
+
+  [[nodiscard]] bool is_list() const { return list_depth_ > 0; }
+};
+
+struct TypeDefinition {
+  StringRange name_;
+  TypeKind kind_ = TypeKind::SCALAR;
+  /// \brief Fields of objects and interfaces, input fields of input objects
+  /// or values of enums.
+  IdRange members_;
+  /// \brief Interfaces implemented by objects and interfaces, sorted by
+  /// identifier.
+  IdRange interfaces_;
+  /// \brief Objects implementing interfaces or members of unions, sorted by
+  /// identifier.
+  IdRange possible_types_;
+};
+
+struct FieldDefinition {
+  StringRange name_;
+  TypeReference type_;
+  IdRange arguments_;
+};
+
+/// \brief Argument of a field or a directive, or field of an input object.
+struct InputValueDefinition {
+  StringRange name_;
+  TypeReference type_;
+  /// \brief Source text of the default value, which is kept as written.
+  StringRange default_value_;
+  bool has_default_value_ = false;
+};
+
+struct EnumValueDefinition {
+  StringRange name_;
+};
+
+struct DirectiveDefinition {
+  StringRange name_;
+  IdRange arguments_;
+  /// \brief Bit i is set if the directive can be used at the location whose
+  /// value is i.
+  uint32_t locations_ = 0;
+  bool repeatable_ = false;
+
+  [[nodiscard]] bool is_allowed_at(const DirectiveLocation location) const {
+    return (locations_ >> static_cast<uint32_t>(location) & 1) != 0;
+  }
+};
+
+class SchemaCompiler;
+
+/// \brief Compiled GraphQL schema, built by <i>compile_schema</i>.
+///
+/// Every definition lives within a flat array and is referred to by its
+/// index: the members of a type, or the arguments of a field, are
+/// consecutive within their array, so a definition only stores the range
+/// they take. Names are copied into a single string, and are looked up
+/// through perfect hashes built while compiling, so a lookup hashes the name
+/// once, probes once and compares a single candidate.
+class Schema {
+ public:
+  Schema() = default;
+
+  /// \brief Finds a type by name.
+  /// \return Its identifier or <i>INVALID_ID</i>.
+  [[nodiscard]] TypeId find_type(std::string_view name) const;
+
+  /// \brief Finds a field of an object or an interface.
+  /// \return Its identifier or <i>INVALID_ID</i>.
+  [[nodiscard]] FieldId find_field(TypeId type, std::string_view name) const;
+
+  /// \brief Finds a field of an input object.
+  /// \return Its identifier or <i>INVALID_ID</i>.
+  [[nodiscard]] InputValueId find_input_field(TypeId type,
+                                              std::string_view name) const;
+
+  /// \brief Finds an argument of a field.
+  /// \return Its identifier or <i>INVALID_ID</i>.
+  [[nodiscard]] InputValueId find_argument(FieldId field,
+                                           std::string_view name) const;
+
+  /// \brief Finds a value of an enum.
+  /// \return Its identifier or <i>INVALID_ID</i>.
+  [[nodiscard]] EnumValueId find_enum_value(TypeId type,
+                                            std::string_view name) const;
+
+  /// \brief Finds a directive by name, without its '@'.
+  /// \return Its identifier or <i>INVALID_ID</i>.
+  [[nodiscard]] DirectiveId find_directive(std::string_view name) const;
+
+  /// \brief Finds an argument of a directive.
+  /// \return Its identifier or <i>INVALID_ID</i>.
+  [[nodiscard]] InputValueId find_directive_argument(
+      DirectiveId directive, std::string_view name) const;
+
+  /// \brief Whether an object is a possible type of a type: the type
+  /// itself, an interface it implements or a union it belongs to.
+  [[nodiscard]] bool is_possible_type(TypeId type, TypeId object) const;
+
+  [[nodiscard]] std::string_view get_string(const StringRange range) const {
+    return std::string_view(strings_).substr(range.offset_, range.length_);
+  }
+
+  [[nodiscard]] const TypeDefinition& get_type(const TypeId type) const {
+    return types_[type];
+  }
+
+  [[nodiscard]] const FieldDefinition& get_field(const FieldId field) const {
+    return fields_[field];
+  }
+
+  [[nodiscard]] const InputValueDefinition& get_input_value(
+      const InputValueId input_value) const {
+    return input_values_[input_value];
+  }
+
+  [[nodiscard]] const EnumValueDefinition& get_enum_value(
+      const EnumValueId enum_value) const {
+    return enum_values_[enum_value];
+  }
+
+  [[nodiscard]] const DirectiveDefinition& get_directive(
+      const DirectiveId directive) const {
+    return directives_[directive];
+  }
+
+  [[nodiscard]] std::span<const TypeDefinition> get_types() const {
+    return types_;
+  }
+
+  [[nodiscard]] std::span<const DirectiveDefinition> get_directives() const {
+    return directives_;
+  }
+
+  /// \brief Fields of an object or an interface.
+  [[nodiscard]] std::span<const FieldDefinition> get_fields(
+      TypeId type) const;
+
+  /// \brief Fields of an input object.
+  [[nodiscard]] std::span<const InputValueDefinition> get_input_fields(
+      TypeId type) const;
+
+  [[nodiscard]] std::span<const InputValueDefinition> get_arguments(
+      FieldId field) const;
+
+  [[nodiscard]] std::span<const EnumValueDefinition> get_enum_values(
+      TypeId type) const;
+
+  /// \brief Interfaces implemented by an object or an interface.
+  [[nodiscard]] std::span<const TypeId> get_interfaces(TypeId type) const;
+
+  /// \brief Objects implementing an interface or members of a union.
+  [[nodiscard]] std::span<const TypeId> get_possible_types(TypeId type) const;
+
+  /// \brief Root query type, or <i>INVALID_ID</i>.
+  [[nodiscard]] TypeId get_query_type() const { return query_type_; }
+
+  /// \brief Root mutation type, or <i>INVALID_ID</i>.
+  [[nodiscard]] TypeId get_mutation_type() const { return mutation_type_; }
+
+  /// \brief Root subscription type, or <i>INVALID_ID</i>.
+  [[nodiscard]] TypeId get_subscription_type() const {
+    return subscription_type_;
+  }
+
+  /// \brief Amount of bytes held by the schema, its hashes included.
+  [[nodiscard]] size_t get_memory_usage() const;
+
+ private:
+  friend class SchemaCompiler;
+
+  std::string strings_;
+  std::vector<TypeDefinition> types_;
+  std::vector<FieldDefinition> fields_;
+  /// \brief Input fields sorted by input object, then field arguments sorted
+  /// by field, then directive arguments sorted by directive.
+  std::vector<InputValueDefinition> input_values_;
+  std::vector<EnumValueDefinition> enum_values_;
+  std::vector<DirectiveDefinition> directives_;
+  /// \brief Implemented interfaces and possible types of every type.
+  std::vector<TypeId> type_ids_;
+  TypeId query_type_ = INVALID_ID;
+  TypeId mutation_type_ = INVALID_ID;
+  TypeId subscription_type_ = INVALID_ID;
+  /// \brief Types, within scope 0.
+  PerfectHash type_hash_;
+  /// \brief Fields, within the scope of their type.
+  PerfectHash field_hash_;
+  /// \brief Input values, within the scope of their owner. Scopes follow the
+  /// order of <i>input_values_</i>: input objects take the scopes of their
+  /// type, followed by those of fields and then those of directives.
+  PerfectHash input_value_hash_;
+  /// \brief Enum values, within the scope of their enum.
+  PerfectHash enum_value_hash_;
+  /// \brief Directives, within scope 0.
+  PerfectHash directive_hash_;
+
+  [[nodiscard]] static uint32_t get_input_field_scope(const TypeId type) {
+    return type;
+  }
+
+  [[nodiscard]] uint32_t get_argument_scope(const FieldId field) const {
+    return static_cast<uint32_t>(types_.size()) + field;
+  }
+
+  [[nodiscard]] uint32_t get_directive_argument_scope(
+      const DirectiveId directive) const {
+    return static_cast<uint32_t>(types_.size() + fields_.size()) + directive;
+  }
+
+  /// \brief Finds an input value within a range of its owner.
+  [[nodiscard]] InputValueId find_input_value(IdRange range, uint32_t scope,
+                                              std::string_view name) const;
+};
+}  // namespace graphqlpp::schema
+
+#endif  // SCHEMA_H
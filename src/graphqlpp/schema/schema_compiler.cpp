@@ -0,0 +1,1197 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "schema_compiler.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../language/tokenization/line_index.h"
+#include "../language/tokenization/token.h"
+#include "../language/tokenization/token_buffer.h"
+#include "../language/tokenization/tokenizer.h"
+
+namespace graphqlpp::schema {
+using language::parsing::ParseError;
+using language::tokenization::describe_punctuator;
+using language::tokenization::TokenBuffer;
+using language::tokenization::TokenizeError;
+using language::tokenization::TokenType;
+
+namespace {
+/// \brief Definitions every schema has, unless the document defines them.
+constexpr std::string_view PRELUDE =
+    "scalar Int scalar Float scalar String scalar Boolean scalar ID "
+    "directive @skip(if: Boolean!) "
+    "on FIELD | FRAGMENT_SPREAD | INLINE_FRAGMENT "
+    "directive @include(if: Boolean!) "
+    "on FIELD | FRAGMENT_SPREAD | INLINE_FRAGMENT "
+    "directive @deprecated(reason: String = \"No longer supported\") "
+    "on FIELD_DEFINITION | ARGUMENT_DEFINITION | INPUT_FIELD_DEFINITION "
+    "| ENUM_VALUE "
+    "directive @specifiedBy(url: String!) on SCALAR";
+
+/// \brief Names of the directive locations, indexed by their value.
+constexpr std::string_view DIRECTIVE_LOCATIONS[] = {
+    "QUERY",
+    "MUTATION",
+    "SUBSCRIPTION",
+    "FIELD",
+    "FRAGMENT_DEFINITION",
+    "FRAGMENT_SPREAD",
+    "INLINE_FRAGMENT",
+    "VARIABLE_DEFINITION",
+    "SCHEMA",
+    "SCALAR",
+    "OBJECT",
+    "FIELD_DEFINITION",
+    "ARGUMENT_DEFINITION",
+    "INTERFACE",
+    "UNION",
+    "ENUM",
+    "ENUM_VALUE",
+    "INPUT_OBJECT",
+    "INPUT_FIELD_DEFINITION"};
+
+constexpr size_t ROOT_OPERATION_COUNT = 3;
+constexpr std::string_view ROOT_OPERATIONS[] = {"query", "mutation",
+                                                "subscription"};
+constexpr std::string_view DEFAULT_ROOT_TYPES[] = {"Query", "Mutation",
+                                                   "Subscription"};
+
+struct DefinitionKeyword {
+  std::string_view keyword_;
+  TypeKind kind_;
+};
+
+constexpr DefinitionKeyword DEFINITION_KEYWORDS[] = {
+    {"scalar", TypeKind::SCALAR}, {"type", TypeKind::OBJECT},
+    {"interface", TypeKind::INTERFACE}, {"union", TypeKind::UNION},
+    {"enum", TypeKind::ENUM}, {"input", TypeKind::INPUT_OBJECT}};
+
+/// \brief Type reference whose named type is not resolved yet.
+struct PendingTypeReference {
+  std::string_view name_;
+  size_t offset_ = 0;
+  uint8_t list_depth_ = 0;
+  uint16_t non_null_mask_ = 0;
+};
+
+/// \brief Type definition or extension.
+struct PendingDefinition {
+  std::string_view name_;
+  size_t offset_ = 0;
+  TypeKind kind_ = TypeKind::SCALAR;
+  bool extension_ = false;
+  /// \brief Type the definition declares or extends, once resolved.
+  TypeId type_ = INVALID_ID;
+};
+
+struct PendingField {
+  /// \brief Index of the definition declaring the field.
+  uint32_t definition_;
+  std::string_view name_;
+  size_t offset_;
+  PendingTypeReference type_;
+};
+
+enum class InputValueOwner : uint8_t { INPUT_OBJECT, FIELD, DIRECTIVE };
+
+struct PendingInputValue {
+  InputValueOwner owner_kind_;
+  /// \brief Index of the owning definition, pending field or directive.
+  uint32_t owner_;
+  std::string_view name_;
+  size_t offset_;
+  PendingTypeReference type_;
+  std::string_view default_value_;
+  bool has_default_value_ = false;
+};
+
+struct PendingEnumValue {
+  uint32_t definition_;
+  std::string_view name_;
+  size_t offset_;
+};
+
+/// \brief Interface implemented by a type, or member of a union.
+struct PendingLink {
+  uint32_t definition_;
+  std::string_view name_;
+  size_t offset_;
+};
+
+struct PendingDirective {
+  std::string_view name_;
+  size_t offset_ = 0;
+  uint32_t locations_ = 0;
+  bool repeatable_ = false;
+};
+
+struct PendingRoot {
+  std::string_view name_;
+  size_t offset_;
+};
+
+/// \brief Stable counting sort of items by key.
+/// \param keys Key of each item, below <i>key_count</i>.
+/// \param key_count Amount of keys.
+/// \param order Set to the indexes of the items, sorted by key.
+/// \param starts Set to where the items of each key start within the order,
+/// followed by the amount of items.
+void sort_by_key(const std::vector<uint32_t>& keys, const size_t key_count,
+                 std::vector<uint32_t>& order, std::vector<uint32_t>& starts) {
+  starts.assign(key_count + 1, 0);
+
+  for (const uint32_t key : keys) {
+    starts[key + 1]++;
+  }
+
+  std::partial_sum(starts.begin(), starts.end(), starts.begin());
+  order.resize(keys.size());
+  std::vector<uint32_t> next(starts.begin(), starts.end() - 1);
+
+  for (uint32_t i = 0; i < keys.size(); i++) {
+    order[next[keys[i]]++] = i;
+  }
+}
+
+IdRange get_range(const std::vector<uint32_t>& starts, const uint32_t key) {
+  return IdRange{.first_ = starts[key],
+                 .count_ = starts[key + 1] - starts[key]};
+}
+
+bool is_input_type(const TypeKind kind) {
+  return kind == TypeKind::SCALAR || kind == TypeKind::ENUM ||
+         kind == TypeKind::INPUT_OBJECT;
+}
+
+bool has_fields(const TypeKind kind) {
+  return kind == TypeKind::OBJECT || kind == TypeKind::INTERFACE;
+}
+}  // namespace
+
+/// \brief Parses schema documents into pending definitions, which are then
+/// laid out into a <i>Schema</i>. Like the parser, it stops at the first
+/// error.
+class SchemaCompiler {
+ public:
+  Result<Schema, SchemaError> compile(const std::string_view source) {
+    if (!parse(source, false) || !parse(PRELUDE, true) || !build(source)) {
+      return Result<Schema, SchemaError>::Err(std::move(error_.value()));
+    }
+
+    return Result<Schema, SchemaError>::Ok(std::move(schema_));
+  }
+
+ private:
+  Schema schema_;
+  std::string_view source_;
+  TokenBuffer tokens_;
+  /// \brief Index of the current token.
+  size_t position_ = 0;
+  bool is_prelude_ = false;
+  std::optional<SchemaError> error_;
+  std::vector<PendingDefinition> definitions_;
+  std::vector<PendingField> fields_;
+  std::vector<PendingInputValue> input_values_;
+  std::vector<PendingEnumValue> enum_values_;
+  std::vector<PendingLink> interfaces_;
+  std::vector<PendingLink> union_members_;
+  std::vector<PendingDirective> directives_;
+  /// \brief Amount of definitions and directives of the document itself,
+  /// which come before the built-in ones.
+  size_t document_definition_count_ = 0;
+  size_t document_directive_count_ = 0;
+  bool has_schema_definition_ = false;
+  std::array<std::optional<PendingRoot>, ROOT_OPERATION_COUNT> roots_;
+  /// \brief Final identifier of each pending field.
+  std::vector<FieldId> field_ids_;
+  /// \brief Brackets closing the value being skipped.
+  std::string closing_brackets_;
+
+  bool parse(const std::string_view source, const bool is_prelude) {
+    source_ = source;
+    is_prelude_ = is_prelude;
+    position_ = 0;
+    tokens_.clear();
+
+    Result<size_t, TokenizeError> r = language::tokenization::tokenize<
+        language::tokenization::SIGNIFICANT_TOKENS_POLICY>(source, tokens_);
+
+    if (!r.IsOk()) {
+      error_ = SchemaError(ParseError(r.UnwrapErr()));
+      return false;
+    }
+
+    if (is_at_end()) {
+      fail("a definition");
+      return false;
+    }
+
+    while (!is_at_end()) {
+      const size_t definition_count = definitions_.size();
+      const size_t input_value_count = input_values_.size();
+      const size_t directive_count = directives_.size();
+
+      if (!parse_definition()) {
+        return false;
+      }
+
+      // Built-in definitions give way to those of the document.
+      if (is_prelude_ && is_redefined(definition_count, directive_count)) {
+        definitions_.resize(definition_count);
+        input_values_.resize(input_value_count);
+        directives_.resize(directive_count);
+      }
+    }
+
+    if (!is_prelude_) {
+      document_definition_count_ = definitions_.size();
+      document_directive_count_ = directives_.size();
+    }
+
+    return true;
+  }
+
+  /// \brief Whether the built-in definition just parsed is also defined by
+  /// the document.
+  [[nodiscard]] bool is_redefined(const size_t definition_count,
+                                  const size_t directive_count) const {
+    if (definitions_.size() > definition_count) {
+      const std::string_view name = definitions_.back().name_;
+
+      return std::any_of(definitions_.begin(),
+                         definitions_.begin() + document_definition_count_,
+                         [&](const PendingDefinition& definition) {
+                           return !definition.extension_ &&
+                                  definition.name_ == name;
+                         });
+    }
+
+    if (directives_.size() > directive_count) {
+      const std::string_view name = directives_.back().name_;
+
+      return std::any_of(
+          directives_.begin(), directives_.begin() + document_directive_count_,
+          [&](const PendingDirective& directive) {
+            return directive.name_ == name;
+          });
+    }
+
+    return false;
+  }
+
+  [[nodiscard]] bool is_at_end() const {
+    return position_ >= tokens_.size();
+  }
+
+  [[nodiscard]] TokenType type() const { return tokens_.get_type(position_); }
+
+  /// \brief Offset of the current token. Built-in definitions are not part
+  /// of the document, so they are reported at its start.
+  [[nodiscard]] size_t offset() const {
+    if (is_prelude_) {
+      return 0;
+    }
+
+    return is_at_end() ? source_.size() : tokens_.get_offset(position_);
+  }
+
+  [[nodiscard]] std::string_view value() const {
+    return source_.substr(tokens_.get_offset(position_),
+                          tokens_.get_length(position_));
+  }
+
+  [[nodiscard]] bool is_punctuator(const std::string_view punctuator) const {
+    return !is_at_end() && type() == language::tokenization::PUNCTUATOR &&
+           value() == punctuator;
+  }
+
+  [[nodiscard]] bool is_keyword(const std::string_view keyword) const {
+    return !is_at_end() && type() == language::tokenization::NAME &&
+           value() == keyword;
+  }
+
+  bool accept_punctuator(const std::string_view punctuator) {
+    if (!is_punctuator(punctuator)) {
+      return false;
+    }
+
+    position_++;
+
+    return true;
+  }
+
+  bool accept_keyword(const std::string_view keyword) {
+    if (!is_keyword(keyword)) {
+      return false;
+    }
+
+    position_++;
+
+    return true;
+  }
+
+  bool expect_punctuator(const std::string_view punctuator) {
+    if (accept_punctuator(punctuator)) {
+      return true;
+    }
+
+    return fail(describe_punctuator(punctuator));
+  }
+
+  bool expect_name(std::string_view& name) {
+    if (is_at_end() || type() != language::tokenization::NAME) {
+      return fail("a name");
+    }
+
+    name = value();
+    position_++;
+
+    return true;
+  }
+
+  /// \brief Skips the description of a definition, if any.
+  bool accept_description() {
+    if (is_at_end() || type() != language::tokenization::STRING_VALUE) {
+      return false;
+    }
+
+    position_++;
+
+    return true;
+  }
+
+  /// \brief Records a syntax error at the current token.
+  /// \param expected Statically allocated description of what was expected
+  /// instead.
+  /// \return False, so callers can return it.
+  bool fail(const std::string_view expected) {
+    const size_t error_offset = offset();
+    error_ = SchemaError(
+        ParseError(is_at_end() ? language::parsing::UNEXPECTED_END_OF_DOCUMENT
+                               : language::parsing::UNEXPECTED_TOKEN,
+                   expected, error_offset,
+                   language::tokenization::locate(source_, error_offset)));
+
+    return false;
+  }
+
+  /// \brief Records a schema error.
+  /// \return False, so callers can return it.
+  bool fail(const SchemaErrorCode code, const std::string_view name,
+            const size_t error_offset) {
+    error_ = SchemaError(code, name, error_offset,
+                         language::tokenization::locate(source_,
+                                                        error_offset));
+
+    return false;
+  }
+
+  bool parse_definition() {
+    // Extensions have no description.
+    const bool extension = !accept_description() && accept_keyword("extend");
+
+    if (accept_keyword("schema")) {
+      return parse_schema_definition(extension);
+    }
+
+    if (!extension && accept_keyword("directive")) {
+      return parse_directive_definition();
+    }
+
+    const auto keyword =
+        std::find_if(std::begin(DEFINITION_KEYWORDS),
+                     std::end(DEFINITION_KEYWORDS),
+                     [&](const DefinitionKeyword& definition_keyword) {
+                       return is_keyword(definition_keyword.keyword_);
+                     });
+
+    if (keyword == std::end(DEFINITION_KEYWORDS)) {
+      return fail(extension ? "a type system extension"
+                            : "a type system definition");
+    }
+
+    position_++;
+
+    const auto definition = static_cast<uint32_t>(definitions_.size());
+    definitions_.push_back(PendingDefinition{.name_ = std::string_view(),
+                                             .offset_ = offset(),
+                                             .kind_ = keyword->kind_,
+                                             .extension_ = extension,
+                                             .type_ = INVALID_ID});
+
+    if (!expect_name(definitions_.back().name_)) {
+      return false;
+    }
+
+    switch (keyword->kind_) {
+      case TypeKind::OBJECT:
+      case TypeKind::INTERFACE:
+        return parse_implemented_interfaces(definition) && skip_directives() &&
+               parse_fields(definition);
+      case TypeKind::UNION:
+        return skip_directives() && (!accept_punctuator("=") ||
+                                     parse_union_members(definition));
+      case TypeKind::ENUM:
+        return skip_directives() && parse_enum_values(definition);
+      case TypeKind::INPUT_OBJECT:
+        return skip_directives() &&
+               parse_input_values(InputValueOwner::INPUT_OBJECT, definition,
+                                  "{", "}");
+      case TypeKind::SCALAR:
+      default:
+        return skip_directives();
+    }
+  }
+
+  bool parse_schema_definition(const bool extension) {
+    has_schema_definition_ = true;
+
+    if (!skip_directives()) {
+      return false;
+    }
+
+    // Extensions may only add directives.
+    if (extension && !is_punctuator("{")) {
+      return true;
+    }
+
+    if (!expect_punctuator("{")) {
+      return false;
+    }
+
+    do {
+      size_t operation = 0;
+
+      while (operation < ROOT_OPERATION_COUNT &&
+             !is_keyword(ROOT_OPERATIONS[operation])) {
+        operation++;
+      }
+
+      if (operation == ROOT_OPERATION_COUNT) {
+        return fail("an operation type");
+      }
+
+      position_++;
+      PendingRoot root =
+          PendingRoot{.name_ = std::string_view(), .offset_ = 0};
+
+      if (!expect_punctuator(":")) {
+        return false;
+      }
+
+      root.offset_ = offset();
+
+      if (!expect_name(root.name_)) {
+        return false;
+      }
+
+      roots_[operation] = root;
+    } while (!accept_punctuator("}"));
+
+    return true;
+  }
+
+  bool parse_directive_definition() {
+    if (!expect_punctuator("@")) {
+      return false;
+    }
+
+    const auto directive = static_cast<uint32_t>(directives_.size());
+    directives_.push_back(PendingDirective{.name_ = std::string_view(),
+                                           .offset_ = offset(),
+                                           .locations_ = 0,
+                                           .repeatable_ = false});
+
+    if (!expect_name(directives_.back().name_) ||
+        !parse_input_values(InputValueOwner::DIRECTIVE, directive, "(",
+                            ")")) {
+      return false;
+    }
+
+    directives_[directive].repeatable_ = accept_keyword("repeatable");
+
+    if (!accept_keyword("on")) {
+      return fail("'on'");
+    }
+
+    accept_punctuator("|");
+
+    do {
+      const auto location = std::find_if(
+          std::begin(DIRECTIVE_LOCATIONS), std::end(DIRECTIVE_LOCATIONS),
+          [&](const std::string_view name) { return is_keyword(name); });
+
+      if (location == std::end(DIRECTIVE_LOCATIONS)) {
+        return fail("a directive location");
+      }
+
+      directives_[directive].locations_ |=
+          1U << (location - std::begin(DIRECTIVE_LOCATIONS));
+      position_++;
+    } while (accept_punctuator("|"));
+
+    return true;
+  }
+
+  bool parse_implemented_interfaces(const uint32_t definition) {
+    if (!accept_keyword("implements")) {
+      return true;
+    }
+
+    accept_punctuator("&");
+
+    do {
+      if (!parse_link(definition, interfaces_)) {
+        return false;
+      }
+    } while (accept_punctuator("&"));
+
+    return true;
+  }
+
+  bool parse_union_members(const uint32_t definition) {
+    accept_punctuator("|");
+
+    do {
+      if (!parse_link(definition, union_members_)) {
+        return false;
+      }
+    } while (accept_punctuator("|"));
+
+    return true;
+  }
+
+  bool parse_link(const uint32_t definition, std::vector<PendingLink>& links) {
+    PendingLink link = PendingLink{.definition_ = definition,
+                                   .name_ = std::string_view(),
+                                   .offset_ = offset()};
+
+    if (!expect_name(link.name_)) {
+      return false;
+    }
+
+    links.push_back(link);
+
+    return true;
+  }
+
+  bool parse_fields(const uint32_t definition) {
+    if (!accept_punctuator("{")) {
+      return true;
+    }
+
+    do {
+      accept_description();
+      const auto field = static_cast<uint32_t>(fields_.size());
+      fields_.push_back(PendingField{.definition_ = definition,
+                                     .name_ = std::string_view(),
+                                     .offset_ = offset(),
+                                     .type_ = PendingTypeReference{}});
+
+      if (!expect_name(fields_.back().name_) ||
+          !parse_input_values(InputValueOwner::FIELD, field, "(", ")") ||
+          !expect_punctuator(":") ||
+          !parse_type_reference(fields_[field].type_, 0) ||
+          !skip_directives()) {
+        return false;
+      }
+    } while (!accept_punctuator("}"));
+
+    return true;
+  }
+
+  /// \brief Parses the arguments of a field or a directive, or the fields of
+  /// an input object, if any.
+  bool parse_input_values(const InputValueOwner owner_kind,
+                          const uint32_t owner, const std::string_view open,
+                          const std::string_view close) {
+    if (!accept_punctuator(open)) {
+      return true;
+    }
+
+    do {
+      accept_description();
+      PendingInputValue input_value =
+          PendingInputValue{.owner_kind_ = owner_kind,
+                            .owner_ = owner,
+                            .name_ = std::string_view(),
+                            .offset_ = offset(),
+                            .type_ = PendingTypeReference{},
+                            .default_value_ = std::string_view(),
+                            .has_default_value_ = false};
+
+      if (!expect_name(input_value.name_) || !expect_punctuator(":") ||
+          !parse_type_reference(input_value.type_, 0)) {
+        return false;
+      }
+
+      if (accept_punctuator("=")) {
+        const size_t first = position_;
+
+        if (!skip_value()) {
+          return false;
+        }
+
+        const size_t start = tokens_.get_offset(first);
+        const size_t end = tokens_.get_offset(position_ - 1) +
+                           tokens_.get_length(position_ - 1);
+        input_value.default_value_ = source_.substr(start, end - start);
+        input_value.has_default_value_ = true;
+      }
+
+      if (!skip_directives()) {
+        return false;
+      }
+
+      input_values_.push_back(input_value);
+    } while (!accept_punctuator(close));
+
+    return true;
+  }
+
+  bool parse_enum_values(const uint32_t definition) {
+    if (!accept_punctuator("{")) {
+      return true;
+    }
+
+    do {
+      accept_description();
+
+      if (is_keyword("true") || is_keyword("false") || is_keyword("null")) {
+        return fail("an enum value");
+      }
+
+      PendingEnumValue enum_value =
+          PendingEnumValue{.definition_ = definition,
+                           .name_ = std::string_view(),
+                           .offset_ = offset()};
+
+      if (!expect_name(enum_value.name_) || !skip_directives()) {
+        return false;
+      }
+
+      enum_values_.push_back(enum_value);
+    } while (!accept_punctuator("}"));
+
+    return true;
+  }
+
+  /// \brief Parses a type, such as "[String!]!".
+  /// \param level Amount of lists the type is nested within.
+  bool parse_type_reference(PendingTypeReference& reference,
+                            const uint8_t level) {
+    if (accept_punctuator("[")) {
+      if (level == MAX_LIST_DEPTH) {
+        return fail(TYPE_NESTING_TOO_DEEP, "", offset());
+      }
+
+      if (!parse_type_reference(reference, level + 1) ||
+          !expect_punctuator("]")) {
+        return false;
+      }
+    } else {
+      reference.offset_ = offset();
+      reference.list_depth_ = level;
+
+      if (!expect_name(reference.name_)) {
+        return false;
+      }
+    }
+
+    if (accept_punctuator("!")) {
+      reference.non_null_mask_ |= 1U << level;
+    }
+
+    return true;
+  }
+
+  /// \brief Skips the directives applied to a definition, if any.
+  bool skip_directives() {
+    while (accept_punctuator("@")) {
+      std::string_view name;
+
+      if (!expect_name(name)) {
+        return false;
+      }
+
+      if (!accept_punctuator("(")) {
+        continue;
+      }
+
+      do {
+        if (!expect_name(name) || !expect_punctuator(":") || !skip_value()) {
+          return false;
+        }
+      } while (!accept_punctuator(")"));
+    }
+
+    return true;
+  }
+
+  /// \brief Skips a constant value. Only its brackets are checked, which is
+  /// enough to find where it ends.
+  bool skip_value() {
+    closing_brackets_.clear();
+
+    do {
+      if (is_at_end()) {
+        return fail("a value");
+      }
+
+      if (type() == language::tokenization::PUNCTUATOR) {
+        const std::string_view punctuator = value();
+
+        if (punctuator == "[") {
+          closing_brackets_ += ']';
+        } else if (punctuator == "{") {
+          closing_brackets_ += '}';
+        } else if (!closing_brackets_.empty() &&
+                   punctuator[0] == closing_brackets_.back()) {
+          closing_brackets_.pop_back();
+        } else if (closing_brackets_.empty() || punctuator != ":") {
+          return fail("a constant value");
+        }
+      }
+
+      position_++;
+    } while (!closing_brackets_.empty());
+
+    return true;
+  }
+
+  bool build(const std::string_view source) {
+    source_ = source;
+    is_prelude_ = false;
+
+    if (!build_types() || !build_fields() || !build_enum_values() ||
+        !build_directives() || !build_input_values() ||
+        !build_links(interfaces_, TypeKind::INTERFACE, INVALID_INTERFACE,
+                     &TypeDefinition::interfaces_) ||
+        !build_links(union_members_, TypeKind::OBJECT, INVALID_UNION_MEMBER,
+                     &TypeDefinition::possible_types_) ||
+        !build_roots()) {
+      return false;
+    }
+
+    build_implementations();
+    schema_.strings_.shrink_to_fit();
+    schema_.type_ids_.shrink_to_fit();
+
+    return true;
+  }
+
+  StringRange add_string(const std::string_view value) {
+    const StringRange range =
+        StringRange{.offset_ = static_cast<uint32_t>(schema_.strings_.size()),
+                    .length_ = static_cast<uint32_t>(value.size())};
+    schema_.strings_.append(value);
+
+    return range;
+  }
+
+  /// \brief Builds the hash of a list of keys, reporting the first repeated
+  /// key.
+  /// \param order Index of the pending definition of each key.
+  template <typename Pending>
+  bool build_hash(const std::vector<PerfectHashKey>& keys,
+                  const std::vector<Pending>& pending,
+                  const std::vector<uint32_t>& order,
+                  const SchemaErrorCode code, PerfectHash& hash) {
+    Result<PerfectHash, size_t> r = PerfectHash::build(keys);
+
+    if (!r.IsOk()) {
+      const Pending& repeated = pending[order[r.UnwrapErr()]];
+
+      return fail(code, repeated.name_, repeated.offset_);
+    }
+
+    hash = r.Unwrap();
+
+    return true;
+  }
+
+  bool build_types() {
+    std::vector<uint32_t> declarations;
+    std::vector<PerfectHashKey> keys;
+
+    for (uint32_t i = 0; i < definitions_.size(); i++) {
+      PendingDefinition& definition = definitions_[i];
+
+      if (definition.extension_) {
+        continue;
+      }
+
+      definition.type_ = static_cast<TypeId>(declarations.size());
+      declarations.push_back(i);
+      keys.push_back(PerfectHashKey{.name_ = definition.name_, .scope_ = 0});
+    }
+
+    schema_.types_.reserve(declarations.size());
+
+    for (const uint32_t i : declarations) {
+      schema_.types_.push_back(
+          TypeDefinition{.name_ = add_string(definitions_[i].name_),
+                         .kind_ = definitions_[i].kind_,
+                         .members_ = IdRange{},
+                         .interfaces_ = IdRange{},
+                         .possible_types_ = IdRange{}});
+    }
+
+    if (!build_hash(keys, definitions_, declarations, DUPLICATE_TYPE,
+                    schema_.type_hash_)) {
+      return false;
+    }
+
+    for (PendingDefinition& definition : definitions_) {
+      if (!definition.extension_) {
+        continue;
+      }
+
+      definition.type_ = schema_.find_type(definition.name_);
+
+      if (definition.type_ == INVALID_ID) {
+        return fail(UNDEFINED_TYPE, definition.name_, definition.offset_);
+      }
+
+      if (schema_.types_[definition.type_].kind_ != definition.kind_) {
+        return fail(INVALID_EXTENSION, definition.name_, definition.offset_);
+      }
+    }
+
+    return true;
+  }
+
+  /// \brief Resolves the named type of a reference, checking it can be used
+  /// as an input or output type.
+  bool resolve(const PendingTypeReference& pending, const bool input,
+               TypeReference& reference) {
+    reference = TypeReference{.type_ = schema_.find_type(pending.name_),
+                              .list_depth_ = pending.list_depth_,
+                              .non_null_mask_ = pending.non_null_mask_};
+
+    if (reference.type_ == INVALID_ID) {
+      return fail(UNDEFINED_TYPE, pending.name_, pending.offset_);
+    }
+
+    const TypeKind kind = schema_.types_[reference.type_].kind_;
+
+    if (input ? !is_input_type(kind) : kind == TypeKind::INPUT_OBJECT) {
+      return fail(INVALID_TYPE_REFERENCE, pending.name_, pending.offset_);
+    }
+
+    return true;
+  }
+
+  bool build_fields() {
+    std::vector<uint32_t> owners(fields_.size());
+
+    for (size_t i = 0; i < fields_.size(); i++) {
+      owners[i] = definitions_[fields_[i].definition_].type_;
+    }
+
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> starts;
+    sort_by_key(owners, schema_.types_.size(), order, starts);
+
+    std::vector<PerfectHashKey> keys(fields_.size());
+    schema_.fields_.resize(fields_.size());
+    field_ids_.resize(fields_.size());
+
+    for (uint32_t id = 0; id < order.size(); id++) {
+      const PendingField& pending = fields_[order[id]];
+      FieldDefinition& field = schema_.fields_[id];
+      field.name_ = add_string(pending.name_);
+      field_ids_[order[id]] = id;
+      keys[id] = PerfectHashKey{.name_ = pending.name_,
+                                .scope_ = owners[order[id]]};
+
+      if (!resolve(pending.type_, false, field.type_)) {
+        return false;
+      }
+    }
+
+    for (TypeId type = 0; type < schema_.types_.size(); type++) {
+      if (has_fields(schema_.types_[type].kind_)) {
+        schema_.types_[type].members_ = get_range(starts, type);
+      }
+    }
+
+    return build_hash(keys, fields_, order, DUPLICATE_MEMBER,
+                      schema_.field_hash_);
+  }
+
+  bool build_enum_values() {
+    std::vector<uint32_t> owners(enum_values_.size());
+
+    for (size_t i = 0; i < enum_values_.size(); i++) {
+      owners[i] = definitions_[enum_values_[i].definition_].type_;
+    }
+
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> starts;
+    sort_by_key(owners, schema_.types_.size(), order, starts);
+
+    std::vector<PerfectHashKey> keys(enum_values_.size());
+    schema_.enum_values_.resize(enum_values_.size());
+
+    for (uint32_t id = 0; id < order.size(); id++) {
+      const PendingEnumValue& pending = enum_values_[order[id]];
+      schema_.enum_values_[id].name_ = add_string(pending.name_);
+      keys[id] = PerfectHashKey{.name_ = pending.name_,
+                                .scope_ = owners[order[id]]};
+    }
+
+    for (TypeId type = 0; type < schema_.types_.size(); type++) {
+      if (schema_.types_[type].kind_ == TypeKind::ENUM) {
+        schema_.types_[type].members_ = get_range(starts, type);
+      }
+    }
+
+    return build_hash(keys, enum_values_, order, DUPLICATE_MEMBER,
+                      schema_.enum_value_hash_);
+  }
+
+  bool build_directives() {
+    std::vector<uint32_t> order(directives_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<PerfectHashKey> keys;
+    keys.reserve(directives_.size());
+    schema_.directives_.reserve(directives_.size());
+
+    for (const PendingDirective& pending : directives_) {
+      keys.push_back(PerfectHashKey{.name_ = pending.name_, .scope_ = 0});
+      schema_.directives_.push_back(
+          DirectiveDefinition{.name_ = add_string(pending.name_),
+                              .arguments_ = IdRange{},
+                              .locations_ = pending.locations_,
+                              .repeatable_ = pending.repeatable_});
+    }
+
+    return build_hash(keys, directives_, order, DUPLICATE_DIRECTIVE,
+                      schema_.directive_hash_);
+  }
+
+  bool build_input_values() {
+    std::vector<uint32_t> scopes(input_values_.size());
+
+    for (size_t i = 0; i < input_values_.size(); i++) {
+      const PendingInputValue& pending = input_values_[i];
+
+      switch (pending.owner_kind_) {
+        case InputValueOwner::INPUT_OBJECT:
+          scopes[i] = Schema::get_input_field_scope(
+              definitions_[pending.owner_].type_);
+          break;
+        case InputValueOwner::FIELD:
+          scopes[i] = schema_.get_argument_scope(field_ids_[pending.owner_]);
+          break;
+        case InputValueOwner::DIRECTIVE:
+        default:
+          scopes[i] = schema_.get_directive_argument_scope(pending.owner_);
+          break;
+      }
+    }
+
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> starts;
+    sort_by_key(scopes,
+                schema_.get_directive_argument_scope(
+                    static_cast<DirectiveId>(schema_.directives_.size())),
+                order, starts);
+
+    std::vector<PerfectHashKey> keys(input_values_.size());
+    schema_.input_values_.resize(input_values_.size());
+
+    for (uint32_t id = 0; id < order.size(); id++) {
+      const PendingInputValue& pending = input_values_[order[id]];
+      InputValueDefinition& input_value = schema_.input_values_[id];
+      input_value.name_ = add_string(pending.name_);
+      input_value.has_default_value_ = pending.has_default_value_;
+
+      if (pending.has_default_value_) {
+        input_value.default_value_ = add_string(pending.default_value_);
+      }
+
+      keys[id] = PerfectHashKey{.name_ = pending.name_,
+                                .scope_ = scopes[order[id]]};
+
+      if (!resolve(pending.type_, true, input_value.type_)) {
+        return false;
+      }
+    }
+
+    for (TypeId type = 0; type < schema_.types_.size(); type++) {
+      if (schema_.types_[type].kind_ == TypeKind::INPUT_OBJECT) {
+        schema_.types_[type].members_ =
+            get_range(starts, Schema::get_input_field_scope(type));
+      }
+    }
+
+    for (FieldId field = 0; field < schema_.fields_.size(); field++) {
+      schema_.fields_[field].arguments_ =
+          get_range(starts, schema_.get_argument_scope(field));
+    }
+
+    for (DirectiveId directive = 0; directive < schema_.directives_.size();
+         directive++) {
+      schema_.directives_[directive].arguments_ =
+          get_range(starts, schema_.get_directive_argument_scope(directive));
+    }
+
+    return build_hash(keys, input_values_, order, DUPLICATE_MEMBER,
+                      schema_.input_value_hash_);
+  }
+
+  /// \brief Lays out the implemented interfaces or the union members of
+  /// every type, sorted by identifier.
+  /// \param links Pending interfaces or union members.
+  /// \param kind Kind every linked type must have.
+  /// \param code Error reported when a linked type has another kind.
+  /// \param range Range of the type definition the links are laid out into.
+  bool build_links(const std::vector<PendingLink>& links, const TypeKind kind,
+                   const SchemaErrorCode code,
+                   IdRange TypeDefinition::*range) {
+    std::vector<uint32_t> owners(links.size());
+
+    for (size_t i = 0; i < links.size(); i++) {
+      owners[i] = definitions_[links[i].definition_].type_;
+    }
+
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> starts;
+    sort_by_key(owners, schema_.types_.size(), order, starts);
+    std::vector<TypeId>& type_ids = schema_.type_ids_;
+
+    for (TypeId type = 0; type < schema_.types_.size(); type++) {
+      const auto first = static_cast<uint32_t>(type_ids.size());
+
+      for (uint32_t i = starts[type]; i < starts[type + 1]; i++) {
+        const PendingLink& link = links[order[i]];
+        const TypeId linked = schema_.find_type(link.name_);
+
+        if (linked == INVALID_ID) {
+          return fail(UNDEFINED_TYPE, link.name_, link.offset_);
+        }
+
+        if (schema_.types_[linked].kind_ != kind) {
+          return fail(code, link.name_, link.offset_);
+        }
+
+        type_ids.push_back(linked);
+      }
+
+      std::sort(type_ids.begin() + first, type_ids.end());
+      const auto repeated =
+          std::adjacent_find(type_ids.begin() + first, type_ids.end());
+
+      if (repeated != type_ids.end()) {
+        // The second link to the repeated type is reported.
+        const std::string_view name = schema_.get_string(
+            schema_.types_[*repeated].name_);
+        bool seen = false;
+
+        for (uint32_t i = starts[type];; i++) {
+          const PendingLink& link = links[order[i]];
+
+          if (link.name_ == name && seen) {
+            return fail(DUPLICATE_MEMBER, link.name_, link.offset_);
+          }
+
+          seen = seen || link.name_ == name;
+        }
+      }
+
+      schema_.types_[type].*range = IdRange{
+          .first_ = first,
+          .count_ = static_cast<uint32_t>(type_ids.size()) - first};
+    }
+
+    return true;
+  }
+
+  /// \brief Lays out the objects implementing each interface. Objects are
+  /// visited in order, so each interface gets them sorted.
+  void build_implementations() {
+    std::vector<uint32_t> interfaces;
+    std::vector<TypeId> objects;
+
+    for (TypeId type = 0; type < schema_.types_.size(); type++) {
+      if (schema_.types_[type].kind_ != TypeKind::OBJECT) {
+        continue;
+      }
+
+      for (const TypeId implemented : schema_.get_interfaces(type)) {
+        interfaces.push_back(implemented);
+        objects.push_back(type);
+      }
+    }
+
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> starts;
+    sort_by_key(interfaces, schema_.types_.size(), order, starts);
+    const auto first = static_cast<uint32_t>(schema_.type_ids_.size());
+
+    for (const uint32_t i : order) {
+      schema_.type_ids_.push_back(objects[i]);
+    }
+
+    for (TypeId type = 0; type < schema_.types_.size(); type++) {
+      if (schema_.types_[type].kind_ == TypeKind::INTERFACE) {
+        const IdRange range = get_range(starts, type);
+        schema_.types_[type].possible_types_ =
+            IdRange{.first_ = first + range.first_, .count_ = range.count_};
+      }
+    }
+  }
+
+  bool build_roots() {
+    constexpr TypeId Schema::*ROOT_TYPES[] = {&Schema::query_type_,
+                                              &Schema::mutation_type_,
+                                              &Schema::subscription_type_};
+
+    for (size_t operation = 0; operation < ROOT_OPERATION_COUNT;
+         operation++) {
+      if (!has_schema_definition_) {
+        const TypeId type =
+            schema_.find_type(DEFAULT_ROOT_TYPES[operation]);
+
+        if (type != INVALID_ID &&
+            schema_.types_[type].kind_ == TypeKind::OBJECT) {
+          schema_.*ROOT_TYPES[operation] = type;
+        }
+
+        continue;
+      }
+
+      if (!roots_[operation].has_value()) {
+        continue;
+      }
+
+      const PendingRoot& root = *roots_[operation];
+      const TypeId type = schema_.find_type(root.name_);
+
+      if (type == INVALID_ID) {
+        return fail(UNDEFINED_TYPE, root.name_, root.offset_);
+      }
+
+      if (schema_.types_[type].kind_ != TypeKind::OBJECT) {
+        return fail(INVALID_TYPE_REFERENCE, root.name_, root.offset_);
+      }
+
+      schema_.*ROOT_TYPES[operation] = type;
+    }
+
+    return true;
+  }
+};
+
+Result<Schema, SchemaError> compile_schema(const std::string_view source) {
+  return SchemaCompiler().compile(source);
+}
+}  // namespace graphqlpp::schema
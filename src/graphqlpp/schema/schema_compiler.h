@@ -0,0 +1,34 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef SCHEMA_COMPILER_H
+#define SCHEMA_COMPILER_H
+
+#include <string_view>
+
+#include "../result.h"
+#include "schema.h"
+#include "schema_error.h"
+
+namespace graphqlpp::schema {
+/// \brief Compiles a schema written in the GraphQL schema definition
+/// language.
+///
+/// The document is parsed straight from its tokens, without building an
+/// AST: definitions are gathered into flat lists, which are then laid out by
+/// owner through counting sorts, so compiling takes time linear to the size
+/// of the document. Extensions are merged into the types they extend, and the
+/// built-in scalars and directives are added unless the document defines
+/// them. If there is no schema definition, the root types are the objects
+/// named "Query", "Mutation" and "Subscription".
+///
+/// Type references, interfaces, union members and extensions are checked,
+/// but descriptions and applied directives are skipped, and default values
+/// are kept as written. Whether objects implement the fields of their
+/// interfaces is not checked.
+/// \param source Schema document encoded as UTF-8. The schema copies what it
+/// keeps, so the document may be released afterwards.
+/// \return The schema or the first error found.
+Result<Schema, SchemaError> compile_schema(std::string_view source);
+}  // namespace graphqlpp::schema
+
+#endif  // SCHEMA_COMPILER_H
@@ -0,0 +1,78 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "schema_error.h"
+
+#include "../execution/json_writer.h"
+
+namespace graphqlpp::schema {
+namespace {
+/// \brief Statically allocated name of an error code, as reported within the
+/// extensions of a GraphQL response.
+std::string_view get_code_name(const SchemaErrorCode code) {
+  switch (code) {
+    case SCHEMA_PARSE_FAILED:
+      return "SCHEMA_PARSE_FAILED";
+    case DUPLICATE_TYPE:
+      return "DUPLICATE_TYPE";
+    case DUPLICATE_MEMBER:
+      return "DUPLICATE_MEMBER";
+    case DUPLICATE_DIRECTIVE:
+      return "DUPLICATE_DIRECTIVE";
+    case UNDEFINED_TYPE:
+      return "UNDEFINED_TYPE";
+    case INVALID_TYPE_REFERENCE:
+      return "INVALID_TYPE_REFERENCE";
+    case INVALID_INTERFACE:
+      return "INVALID_INTERFACE";
+    case INVALID_UNION_MEMBER:
+      return "INVALID_UNION_MEMBER";
+    case INVALID_EXTENSION:
+      return "INVALID_EXTENSION";
+    case TYPE_NESTING_TOO_DEEP:
+    default:
+      return "TYPE_NESTING_TOO_DEEP";
+  }
+}
+}  // namespace
+
+std::string SchemaError::get_message() const {
+  switch (code_) {
+    case SCHEMA_PARSE_FAILED:
+      return parse_error_->get_message();
+    case DUPLICATE_TYPE:
+      return "Detected a duplicate definition of type '" + name_ + "'.";
+    case DUPLICATE_MEMBER:
+      return "Detected a duplicate definition of member '" + name_ + "'.";
+    case DUPLICATE_DIRECTIVE:
+      return "Detected a duplicate definition of directive '@" + name_ + "'.";
+    case UNDEFINED_TYPE:
+      return "Detected a reference to undefined type '" + name_ + "'.";
+    case INVALID_TYPE_REFERENCE:
+      return "Detected type '" + name_ + "' where its kind is not allowed.";
+    case INVALID_INTERFACE:
+      return "Detected an implementation of '" + name_ +
+             "', which is not an interface.";
+    case INVALID_UNION_MEMBER:
+      return "Detected union member '" + name_ + "', which is not an object.";
+    case INVALID_EXTENSION:
+      return "Detected an extension of '" + name_ +
+             "' which does not match its kind.";
+    case TYPE_NESTING_TOO_DEEP:
+    default:
+      return "Detected a type nested within too many lists.";
+  }
+}
+
+void SchemaError::write_json(std::string& output) const {
+  if (parse_error_.has_value()) {
+    parse_error_->write_json(output);
+    return;
+  }
+
+  execution::JsonWriter writer =
+      execution::JsonWriter(execution::JsonWriter::ERROR_CHUNK_SIZE);
+  writer.write_error(get_message(), std::span(&location_, 1), {},
+                     get_code_name(code_));
+  output += writer.to_string();
+}
+}  // namespace graphqlpp::schema
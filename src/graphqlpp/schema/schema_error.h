@@ -0,0 +1,96 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef SCHEMA_ERROR_H
+#define SCHEMA_ERROR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "../language/parsing/parse_error.h"
+#include "../language/tokenization/location.h"
+
+namespace graphqlpp::schema {
+enum SchemaErrorCode : std::uint8_t {
+  /// \brief The document could not be tokenized or parsed.
+  SCHEMA_PARSE_FAILED,
+  DUPLICATE_TYPE,
+  /// \brief A field, argument, enum value, implemented interface or union
+  /// member is defined twice within the same definition.
+  DUPLICATE_MEMBER,
+  DUPLICATE_DIRECTIVE,
+  UNDEFINED_TYPE,
+  /// \brief A type is used where its kind is not allowed, such as an object
+  /// as the type of an argument.
+  INVALID_TYPE_REFERENCE,
+  /// \brief A type implements a type which is not an interface.
+  INVALID_INTERFACE,
+  /// \brief A union has a member which is not an object.
+  INVALID_UNION_MEMBER,
+  /// \brief An extension does not match the kind of the extended type.
+  INVALID_EXTENSION,
+  /// \brief A type is wrapped within more lists than a <i>TypeReference</i>
+  /// holds.
+  TYPE_NESTING_TOO_DEEP
+};
+
+/// \brief Compact schema error, whose message is only built when asked for.
+class SchemaError {
+ public:
+  /// \param code What went wrong.
+  /// \param name Name of the offending type, member or directive.
+  /// \param offset Byte of the document where it went wrong.
+  /// \param location Line and column of the offset.
+  SchemaError(const SchemaErrorCode code, const std::string_view name,
+              const size_t offset,
+              const language::tokenization::Location location)
+      : code_(code), name_(name), offset_(offset), location_(location) {}
+
+  /// \brief Wraps the error of the document's parsing.
+  explicit SchemaError(const language::parsing::ParseError& error)
+      : code_(SCHEMA_PARSE_FAILED),
+        offset_(error.get_offset()),
+        location_(error.get_location()),
+        parse_error_(error) {}
+
+  [[nodiscard]] SchemaErrorCode get_code() const { return code_; }
+
+  /// \brief Name of the offending type, member or directive, which is empty
+  /// if the code is <i>SCHEMA_PARSE_FAILED</i>.
+  [[nodiscard]] const std::string& get_name() const { return name_; }
+
+  /// \brief Byte of the document where the error was detected.
+  [[nodiscard]] size_t get_offset() const { return offset_; }
+
+  /// \brief Line and column where the error was detected.
+  [[nodiscard]] language::tokenization::Location get_location() const {
+    return location_;
+  }
+
+  /// \brief Error of the document's parsing, if the code is
+  /// <i>SCHEMA_PARSE_FAILED</i>.
+  [[nodiscard]] const std::optional<language::parsing::ParseError>&
+  get_parse_error() const {
+    return parse_error_;
+  }
+
+  /// \brief Formats the human-readable message of the error.
+  [[nodiscard]] std::string get_message() const;
+
+  /// \brief Appends the error as an entry of a GraphQL response's "errors"
+  /// list: its message, locations and extensions with the error code.
+  /// \param output String where the JSON object is appended.
+  void write_json(std::string& output) const;
+
+ private:
+  SchemaErrorCode code_;
+  std::string name_;
+  size_t offset_;
+  language::tokenization::Location location_;
+  std::optional<language::parsing::ParseError> parse_error_;
+};
+}  // namespace graphqlpp::schema
+
+#endif  // SCHEMA_ERROR_H
@@ -0,0 +1,41 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<size_t> allocation_count = 0;
+
+void* allocate(const size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return pointer;
+}
+}  // namespace
+
+namespace graphqlpp::bench {
+size_t get_allocation_count() {
+  return allocation_count.load(std::memory_order_relaxed);
+}
+}  // namespace graphqlpp::bench
+
+void* operator new(const size_t size) { return allocate(size); }
+
+void* operator new[](const size_t size) { return allocate(size); }
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
@@ -0,0 +1,14 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+namespace graphqlpp::bench {
+/// \brief Amount of calls to the global <i>operator new</i> since the
+/// program started.
+size_t get_allocation_count();
+}  // namespace graphqlpp::bench
+
+#endif  // ALLOCATION_COUNTER_H
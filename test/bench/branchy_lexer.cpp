@@ -0,0 +1,234 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "branchy_lexer.h"
+
+#include <graphqlpp/language/tokenization/tokenizer.h>
+
+using namespace graphqlpp::language::tokenization;
+
+namespace graphqlpp::bench {
+namespace {
+
+constexpr size_t BLOCK_STRING_DELIMITER_LENGTH = 3;
+
+bool is_digit(const char c) { return c >= '0' && c <= '9'; }
+
+bool is_name_start(const char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+bool is_name_continue(const char c) { return is_name_start(c) || is_digit(c); }
+
+class BranchyLexer {
+ public:
+  explicit BranchyLexer(const std::string_view source) : source_(source) {}
+
+  bool tokenize(TokenBuffer& tokens) {
+    size_t i = 0;
+
+    while (i < source_.size()) {
+      const size_t start = i;
+      TokenType type = WHITESPACE;
+      bool escaped = false;
+
+      switch (source_[i]) {
+        case '\t':
+        case ' ':
+          while (peek(i) == ' ' || peek(i) == '\t') {
+            i++;
+          }
+          break;
+        case '\n':
+          type = LINE_TERMINATOR;
+          i++;
+          break;
+        case '\r':
+          type = LINE_TERMINATOR;
+          i += peek(i + 1) == '\n' ? 2 : 1;
+          break;
+        case '#':
+          type = COMMENT;
+
+          while (i < source_.size() && source_[i] != '\n' &&
+                 source_[i] != '\r') {
+            i++;
+          }
+          break;
+        case ',':
+          type = COMMA;
+          i++;
+          break;
+        case '!':
+        case '$':
+        case '&':
+        case '(':
+        case ')':
+        case ':':
+        case '=':
+        case '@':
+        case '[':
+        case ']':
+        case '{':
+        case '|':
+        case '}':
+          type = PUNCTUATOR;
+          i++;
+          break;
+        case '.':
+          if (peek(i + 1) != '.' || peek(i + 2) != '.') {
+            return false;
+          }
+
+          type = PUNCTUATOR;
+          i += 3;
+          break;
+        case '"':
+          type = STRING_VALUE;
+
+          if (!scan_string(i, escaped)) {
+            return false;
+          }
+          break;
+        default:
+          if (source_[i] == '-' || is_digit(source_[i])) {
+            if (!scan_number(i, type)) {
+              return false;
+            }
+          } else if (is_name_start(source_[i])) {
+            type = NAME;
+
+            while (is_name_continue(peek(i))) {
+              i++;
+            }
+          } else if (source_.substr(i).starts_with("\xEF\xBB\xBF")) {
+            type = UNICODE_BOM;
+            i += 3;
+          } else {
+            return false;
+          }
+          break;
+      }
+
+      if (!is_token_type_ignored(type)) {
+        tokens.push_back(Token{.type_ = type,
+                               .ignored_ = false,
+                               .escaped_ = escaped,
+                               .offset_ = start,
+                               .length_ = i - start});
+      }
+    }
+
+    return true;
+  }
+
+ private:
+  std::string_view source_;
+
+  [[nodiscard]] char peek(const size_t i) const {
+    return i < source_.size() ? source_[i] : '\0';
+  }
+
+  void scan_digits(size_t& i) const {
+    while (is_digit(peek(i))) {
+      i++;
+    }
+  }
+
+  bool scan_number(size_t& i, TokenType& type) const {
+    type = INT_VALUE;
+
+    if (peek(i) == '-') {
+      i++;
+    }
+
+    if (peek(i) == '0') {
+      i++;
+
+      if (is_digit(peek(i))) {
+        return false;
+      }
+    } else {
+      if (!is_digit(peek(i))) {
+        return false;
+      }
+
+      scan_digits(i);
+    }
+
+    if (peek(i) == '.') {
+      type = FLOAT_VALUE;
+      i++;
+
+      if (!is_digit(peek(i))) {
+        return false;
+      }
+
+      scan_digits(i);
+    }
+
+    if (peek(i) == 'e' || peek(i) == 'E') {
+      type = FLOAT_VALUE;
+      i++;
+
+      if (peek(i) == '+' || peek(i) == '-') {
+        i++;
+      }
+
+      if (!is_digit(peek(i))) {
+        return false;
+      }
+
+      scan_digits(i);
+    }
+
+    // Numbers cannot be directly followed by a '.' or a name.
+    return peek(i) != '.' && !is_name_start(peek(i));
+  }
+
+  bool scan_string(size_t& i, bool& escaped) const {
+    if (source_.substr(i).starts_with("\"\"\"")) {
+      const size_t end =
+          source_.find("\"\"\"", i + BLOCK_STRING_DELIMITER_LENGTH);
+
+      if (end == std::string_view::npos) {
+        return false;
+      }
+
+      // Escaped delimiters and line terminators are not told apart, which
+      // the corpus does not need.
+      escaped = source_.substr(i, end - i).find_first_of("\n\r") !=
+                std::string_view::npos;
+      i = end + BLOCK_STRING_DELIMITER_LENGTH;
+
+      return true;
+    }
+
+    i++;
+
+    while (i < source_.size()) {
+      switch (source_[i]) {
+        case '"':
+          i++;
+          return true;
+        case '\\':
+          escaped = true;
+          i += 2;
+          break;
+        case '\n':
+        case '\r':
+          return false;
+        default:
+          i++;
+          break;
+      }
+    }
+
+    return false;
+  }
+};
+}  // namespace
+
+bool tokenize_branchy(const std::string_view source, TokenBuffer& tokens) {
+  return BranchyLexer(source).tokenize(tokens);
+}
+}  // namespace graphqlpp::bench
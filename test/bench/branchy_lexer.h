@@ -0,0 +1,24 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef BRANCHY_LEXER_H
+#define BRANCHY_LEXER_H
+
+#include <cstddef>
+#include <string_view>
+
+#include <graphqlpp/language/tokenization/token_buffer.h>
+
+namespace graphqlpp::bench {
+/// \brief Appends the lexical tokens of a document, picking each token and
+/// scanning it with branches on its characters, as the scanner did before
+/// its classification was generated as tables. It is the baseline of the
+/// table-driven tokenizer, so, like the trusted policy, it does not validate
+/// characters, and only supports valid documents.
+/// \param source GraphQL source text encoded as UTF-8.
+/// \param tokens Buffer where the tokens are appended.
+/// \return Whether the whole document was tokenized.
+bool tokenize_branchy(std::string_view source,
+                      language::tokenization::TokenBuffer& tokens);
+}  // namespace graphqlpp::bench
+
+#endif  // BRANCHY_LEXER_H
@@ -0,0 +1,109 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "corpus.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace graphqlpp::bench {
+namespace {
+constexpr size_t LARGE_SCHEMA_TYPE_COUNT = 5000;
+constexpr size_t SYNTHETIC_DOCUMENT_SIZE = 4 * 1024 * 1024;
+const char* const CHECKED_IN_DOCUMENTS[] = {"comments", "introspection",
+                                            "nested"};
+
+std::string read_document(const std::string& name) {
+  const std::string path =
+      std::string(GRAPHQLPP_BENCH_CORPUS_DIR) + "/" + name + ".graphql";
+  std::ifstream file(path, std::ios::binary);
+
+  if (!file) {
+    throw std::runtime_error("Could not read corpus document '" + path + "'.");
+  }
+
+  std::stringstream stream;
+  stream << file.rdbuf();
+
+  return stream.str();
+}
+
+std::vector<CorpusDocument> create_corpus() {
+  std::vector<CorpusDocument> corpus;
+
+  for (const char* name : CHECKED_IN_DOCUMENTS) {
+    corpus.push_back({.name_ = name, .source_ = read_document(name)});
+  }
+
+  corpus.push_back({.name_ = "schema_5000_types",
+                    .source_ = generate_schema(LARGE_SCHEMA_TYPE_COUNT)});
+  corpus.push_back({.name_ = "synthetic_4mb",
+                    .source_ = generate_operations(SYNTHETIC_DOCUMENT_SIZE)});
+
+  std::sort(corpus.begin(), corpus.end(),
+            [](const auto& a, const auto& b) { return a.name_ < b.name_; });
+
+  return corpus;
+}
+}  // namespace
+
+const std::vector<CorpusDocument>& get_corpus() {
+  static const std::vector<CorpusDocument> corpus = create_corpus();
+
+  return corpus;
+}
+
+std::string generate_schema(const size_t type_count) {
+  std::string schema =
+      "\"\"\"\nGenerated schema used to benchmark large SDL documents.\n\"\"\"\n"
+      "schema { query: Query }\n\n"
+      "directive @cost(weight: Int = 1) on FIELD_DEFINITION\n\n"
+      "enum Status { ACTIVE INACTIVE ARCHIVED }\n\n";
+
+  for (size_t i = 0; i < type_count; i++) {
+    const std::string name = "Type" + std::to_string(i);
+    const std::string previous =
+        i == 0 ? "ID" : "Type" + std::to_string(i - 1);
+
+    schema += "\"Object type number " + std::to_string(i) + ".\"\n";
+    schema += "type " + name + " implements Node {\n";
+    schema += "  id: ID!\n";
+    schema += "  status: Status\n";
+    schema += "  score(scale: Float = 1.5e0): Float @cost(weight: " +
+              std::to_string(i % 10) + ")\n";
+    schema += "  previous(first: Int = 10, after: String): [" + previous +
+              "!]!\n";
+    schema += "}\n\n";
+  }
+
+  schema += "interface Node { id: ID! }\n\n";
+  schema += "type Query {\n  node(id: ID!): Node\n}\n";
+
+  return schema;
+}
+
+std::string generate_operations(const size_t minimum_size) {
+  std::string operations;
+  operations.reserve(minimum_size + 1024);
+
+  for (size_t i = 0; operations.size() < minimum_size; i++) {
+    const std::string index = std::to_string(i);
+
+    operations += "# Operation " + index + "\n";
+    operations += "query Operation" + index +
+                  "($id: ID!, $first: Int = " + index +
+                  ", $filter: Filter = {min: -" + index + ".25e2, tags: [\"x\", "
+                  "\"caf\xC3\xA9 \\u00e9\"]}) {\n";
+    operations += "  node(id: $id) {\n";
+    operations += "    ... on User { id, name @include(if: true) }\n";
+    operations += "    ...Details\n";
+    operations += "  }\n";
+    operations += "  search(first: $first, filter: $filter, text: \"\"\"\n"
+                  "    block string " + index + "\n  \"\"\") { id }\n";
+    operations += "}\n\n";
+  }
+
+  return operations;
+}
+}  // namespace graphqlpp::bench
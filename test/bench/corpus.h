@@ -0,0 +1,31 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <string>
+#include <vector>
+
+namespace graphqlpp::bench {
+/// \brief GraphQL document used as benchmark input.
+struct CorpusDocument {
+  std::string name_;
+  std::string source_;
+};
+
+/// \brief Every document of the corpus. Checked-in documents are read from
+/// <i>GRAPHQLPP_BENCH_CORPUS_DIR</i>, while the large ones are generated
+/// deterministically so results are comparable between runs.
+/// \return Documents ordered by name.
+const std::vector<CorpusDocument>& get_corpus();
+
+/// \brief Schema definition containing the given amount of object types, each
+/// one referencing the previous ones.
+std::string generate_schema(size_t type_count);
+
+/// \brief Sequence of operations which is at least the given amount of bytes
+/// long, mixing every kind of lexical token.
+std::string generate_operations(size_t minimum_size);
+}  // namespace graphqlpp::bench
+
+#endif  // CORPUS_H
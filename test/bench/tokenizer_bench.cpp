@@ -0,0 +1,957 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include <benchmark/benchmark.h>
+#include <graphqlpp/caching/precompiled_documents.h>
+#include <graphqlpp/concurrency/thread_pool.h>
+#include <graphqlpp/execution/executor.h>
+#include <graphqlpp/execution/json_writer.h>
+#include <graphqlpp/language/analysis/query_analyzer.h>
+#include <graphqlpp/language/normalization/normalizer.h>
+#include <graphqlpp/language/parsing/parser.h>
+#include <graphqlpp/language/tokenization/incremental_tokenizer.h>
+#include <graphqlpp/language/tokenization/lexer.h>
+#include <graphqlpp/language/tokenization/parallel_tokenizer.h>
+#include <graphqlpp/language/tokenization/source.h>
+#include <graphqlpp/language/tokenization/source_scan.h>
+#include <graphqlpp/language/tokenization/string_value.h>
+#include <graphqlpp/language/tokenization/token_buffer.h>
+#include <graphqlpp/language/tokenization/tokenizer.h>
+#include <graphqlpp/schema/schema_compiler.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "branchy_lexer.h"
+#include "corpus.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::bench;
+using namespace graphqlpp::execution;
+using namespace graphqlpp::language::tokenization;
+
+namespace {
+constexpr size_t LEXER_CHUNK_SIZE = 16 * 1024;
+constexpr size_t SCAN_SOURCE_SIZE = 1024 * 1024;
+/// \brief Amount of types of the schemas compiled by the schema benchmarks.
+constexpr int64_t SCHEMA_TYPE_COUNTS[] = {1000, 20000};
+/// \brief Threads of the pools running the execution benchmarks.
+constexpr int64_t EXECUTION_THREAD_COUNTS[] = {1, 4};
+/// \brief Items of the lists serialized by the JSON benchmarks.
+constexpr int64_t JSON_ITEM_COUNTS[] = {1000, 100000};
+/// \brief Persisted queries loaded by the startup benchmarks.
+constexpr int64_t PERSISTED_QUERY_COUNTS[] = {1000, 20000};
+/// \brief Latency of each call to the mock backend.
+constexpr std::chrono::microseconds BACKEND_LATENCY =
+    std::chrono::microseconds(100);
+/// \brief Users listed by the root field of the execution benchmarks, each of
+/// which has <i>FRIEND_COUNT</i> friends.
+constexpr int64_t USER_COUNT = 100;
+constexpr int64_t FRIEND_COUNT = 5;
+const char* const EXECUTION_SCHEMA =
+    "type User { id: ID! name: String! friends: [User!]! }\n"
+    "type Query { users: [User!]! }\n";
+const char* const EXECUTION_QUERY =
+    "{ users { id friends { name friends { name } } } }";
+
+std::vector<char32_t> decode_utf8(const std::string& source) {
+  const Utf8Source utf8_source = Utf8Source(source);
+  std::vector<char32_t> decoded;
+  decoded.reserve(source.size());
+
+  for (size_t i = 0; i < utf8_source.size();) {
+    const DecodedCharacter character = utf8_source.decode(i);
+    decoded.push_back(character.character_);
+    i += character.width_;
+  }
+
+  return decoded;
+}
+
+/// \brief Result as it was before it stored its value in place: each value
+/// is boxed within a <i>unique_ptr</i>, which allocates for every result.
+template <typename OkType, typename ErrorType>
+class BoxedResult {
+ public:
+  static BoxedResult Ok(OkType o) {
+    return BoxedResult(std::make_unique<OkType>(std::move(o)), nullptr);
+  }
+
+  static BoxedResult Err(ErrorType e) {
+    return BoxedResult(nullptr, std::make_unique<ErrorType>(std::move(e)));
+  }
+
+  [[nodiscard]] bool IsOk() const { return ok_ != nullptr; }
+
+  [[nodiscard]] std::unique_ptr<OkType> Unwrap() { return std::move(ok_); }
+
+ private:
+  std::unique_ptr<OkType> ok_;
+  std::unique_ptr<ErrorType> error_;
+
+  BoxedResult(std::unique_ptr<OkType> o, std::unique_ptr<ErrorType> e)
+      : ok_(std::move(o)), error_(std::move(e)) {}
+};
+
+/// \brief Offset of a result's value, failing every eighth time like a
+/// fallible pipeline step would.
+template <typename ResultType>
+[[gnu::noinline]] ResultType get_offset_result(const size_t i) {
+  if (i % 8 == 7) {
+    return ResultType::Err(TokenizeError(
+        UNEXPECTED_CHARACTER, i, Location{.line_ = 1, .column_ = i + 1}));
+  }
+
+  return ResultType::Ok(i);
+}
+
+size_t get_value(const size_t value) { return value; }
+
+size_t get_value(const std::unique_ptr<size_t>& value) { return *value; }
+
+/// \brief Creates and unwraps results, counting the heap allocations each
+/// one costs.
+template <typename ResultType>
+void create_result(benchmark::State& state) {
+  const size_t allocations = get_allocation_count();
+  size_t i = 0;
+  size_t sum = 0;
+
+  for (auto _ : state) {
+    ResultType r = get_offset_result<ResultType>(i++);
+
+    if (r.IsOk()) {
+      sum += get_value(r.Unwrap());
+    }
+
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.counters["allocations_per_result"] =
+      benchmark::Counter(static_cast<double>(get_allocation_count() -
+                                             allocations),
+                         benchmark::Counter::kAvgIterations);
+}
+
+/// \brief Publishes the counters shared by every tokenization benchmark:
+/// bytes/s, tokens/s and heap allocations per document.
+void set_counters(benchmark::State& state, const CorpusDocument& document,
+                  const size_t token_count, const size_t allocations) {
+  const auto iterations = static_cast<int64_t>(state.iterations());
+
+  state.SetBytesProcessed(iterations *
+                          static_cast<int64_t>(document.source_.size()));
+  state.counters["tokens"] = static_cast<double>(token_count);
+  state.counters["tokens_per_second"] =
+      benchmark::Counter(static_cast<double>(token_count) * iterations,
+                         benchmark::Counter::kIsRate);
+  state.counters["allocations_per_document"] =
+      benchmark::Counter(static_cast<double>(allocations),
+                         benchmark::Counter::kAvgIterations);
+}
+
+void tokenize_utf8_to_vector(benchmark::State& state,
+                             const CorpusDocument& document) {
+  size_t token_count = 0;
+  const size_t allocations = get_allocation_count();
+
+  for (auto _ : state) {
+    Result<std::vector<Token>, TokenizeError> r = tokenize(document.source_);
+
+    if (!r.IsOk()) {
+      state.SkipWithError("The document could not be tokenized.");
+      return;
+    }
+
+    std::vector<Token> tokens = r.Unwrap();
+    token_count = tokens.size();
+    benchmark::DoNotOptimize(tokens.data());
+  }
+
+  set_counters(state, document, token_count,
+               get_allocation_count() - allocations);
+}
+
+/// \brief Tokenizes into a reused buffer with the given tokenizer features.
+template <TokenizePolicy Policy>
+void tokenize_utf8_to_buffer(benchmark::State& state,
+                             const CorpusDocument& document) {
+  size_t token_count = 0;
+  TokenBuffer buffer = TokenBuffer();
+  const size_t allocations = get_allocation_count();
+
+  for (auto _ : state) {
+    buffer.clear();
+    Result<size_t, TokenizeError> r =
+        tokenize<Policy>(document.source_, buffer);
+
+    if (!r.IsOk()) {
+      state.SkipWithError("The document could not be tokenized.");
+      return;
+    }
+
+    token_count = r.Unwrap();
+    benchmark::ClobberMemory();
+  }
+
+  set_counters(state, document, token_count,
+               get_allocation_count() - allocations);
+}
+
+/// \brief Tokenizes with the hand-written branchy lexer, the baseline of
+/// TokenizeTrustedSignificantTokens. It must find as many tokens as the
+/// tokenizer, or the comparison would not be fair.
+void tokenize_branchy_to_buffer(benchmark::State& state,
+                                const CorpusDocument& document) {
+  TokenBuffer expected = TokenBuffer();
+  Result<size_t, TokenizeError> r =
+      tokenize<TRUSTED_SIGNIFICANT_TOKENS_POLICY>(document.source_, expected);
+  TokenBuffer buffer = TokenBuffer();
+
+  if (!r.IsOk() || !tokenize_branchy(document.source_, buffer) ||
+      buffer.size() != expected.size()) {
+    state.SkipWithError("The branchy lexer disagrees with the tokenizer.");
+    return;
+  }
+
+  const size_t allocations = get_allocation_count();
+
+  for (auto _ : state) {
+    buffer.clear();
+    tokenize_branchy(document.source_, buffer);
+    benchmark::ClobberMemory();
+  }
+
+  set_counters(state, document, buffer.size(),
+               get_allocation_count() - allocations);
+}
+
+void tokenize_utf32_to_vector(benchmark::State& state,
+                              const CorpusDocument& document) {
+  size_t token_count = 0;
+  const std::vector<char32_t> source = decode_utf8(document.source_);
+  const size_t allocations = get_allocation_count();
+
+  for (auto _ : state) {
+    Result<std::vector<Token>, TokenizeError> r = tokenize(source);
+
+    if (!r.IsOk()) {
+      state.SkipWithError("The document could not be tokenized.");
+      return;
+    }
+
+    std::vector<Token> tokens = r.Unwrap();
+    token_count = tokens.size();
+    benchmark::DoNotOptimize(tokens.data());
+  }
+
+  set_counters(state, document, token_count,
+               get_allocation_count() - allocations);
+}
+
+void tokenize_utf8_in_parallel(benchmark::State& state,
+                               const CorpusDocument& document) {
+  size_t token_count = 0;
+  concurrency::ThreadPool pool = concurrency::ThreadPool();
+  TokenBuffer buffer = TokenBuffer();
+  const size_t allocations = get_allocation_count();
+
+  for (auto _ : state) {
+    buffer.clear();
+    Result<size_t, TokenizeError> r =
+        tokenize_parallel(document.source_, buffer, pool);
+
+    if (!r.IsOk()) {
+      state.SkipWithError("The document could not be tokenized.");
+      return;
+    }
+
+    token_count = r.Unwrap();
+    benchmark::ClobberMemory();
+  }
+
+  set_counters(state, document, token_count,
+               get_allocation_count() - allocations);
+}
+
+/// \brief Returns every token the lexer can scan with the fed chunks.
+/// \return False if the document could not be tokenized.
+bool drain(Lexer& lexer, size_t& token_count) {
+  while (true) {
+    Result<std::optional<Token>, TokenizeError> r = lexer.next();
+
+    if (!r.IsOk()) {
+      return false;
+    }
+
+    if (!r.Unwrap().has_value()) {
+      return true;
+    }
+
+    token_count++;
+  }
+}
+
+void lex_in_chunks(benchmark::State& state, const CorpusDocument& document) {
+  size_t token_count = 0;
+  const std::string_view source = document.source_;
+  const size_t allocations = get_allocation_count();
+
+  for (auto _ : state) {
+    Lexer lexer = Lexer();
+    token_count = 0;
+    bool is_valid = true;
+
+    for (size_t i = 0; i < source.size() && is_valid; i += LEXER_CHUNK_SIZE) {
+      lexer.feed(source.substr(i, LEXER_CHUNK_SIZE));
+      is_valid = drain(lexer, token_count);
+    }
+
+    lexer.finish();
+
+    if (!is_valid || !drain(lexer, token_count)) {
+      state.SkipWithError("The document could not be tokenized.");
+      return;
+    }
+  }
+
+  set_counters(state, document, token_count,
+               get_allocation_count() - allocations);
+}
+
+void analyze_query(benchmark::State& state, const CorpusDocument& document) {
+  const language::analysis::QueryAnalysisOptions options =
+      language::analysis::QueryAnalysisOptions();
+  const size_t allocations = get_allocation_count();
+  size_t field_count = 0;
+
+  for (auto _ : state) {
+    Result<language::analysis::QueryMetrics,
+           language::analysis::QueryAnalysisError>
+        r = language::analysis::analyze_query(document.source_, options);
+
+    if (!r.IsOk()) {
+      state.SkipWithError("The document could not be analyzed.");
+      return;
+    }
+
+    field_count = r.Unwrap().field_count_;
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(document.source_.size()));
+  state.counters["fields"] = static_cast<double>(field_count);
+  state.counters["allocations_per_document"] =
+      benchmark::Counter(static_cast<double>(get_allocation_count() -
+                                             allocations),
+                         benchmark::Counter::kAvgIterations);
+}
+
+/// \brief Normalizes and signs documents which are already tokenized, as
+/// the tokens are shared with the rest of the request's processing.
+void normalize_tokens(benchmark::State& state,
+                      const CorpusDocument& document) {
+  TokenBuffer tokens = TokenBuffer();
+
+  if (!tokenize<SIGNIFICANT_TOKENS_POLICY>(document.source_, tokens).IsOk()) {
+    state.SkipWithError("The document could not be tokenized.");
+    return;
+  }
+
+  const language::normalization::NormalizeOptions options =
+      language::normalization::NormalizeOptions{.replace_literals_ = true};
+  std::string output;
+  const size_t allocations = get_allocation_count();
+
+  for (auto _ : state) {
+    output.clear();
+    language::normalization::normalize(document.source_, tokens, options,
+                                       output);
+    benchmark::DoNotOptimize(
+        language::normalization::compute_signature(output));
+  }
+
+  set_counters(state, document, tokens.size(),
+               get_allocation_count() - allocations);
+}
+
+/// \brief Reads the value of every string of documents which are already
+/// tokenized. Only strings flagged as escaped are decoded.
+void get_string_values(benchmark::State& state,
+                       const CorpusDocument& document) {
+  TokenBuffer tokens = TokenBuffer();
+
+  if (!tokenize<SIGNIFICANT_TOKENS_POLICY>(document.source_, tokens).IsOk()) {
+    state.SkipWithError("The document could not be tokenized.");
+    return;
+  }
+
+  std::string storage;
+  size_t string_bytes = 0;
+  size_t escaped_count = 0;
+
+  for (const TokenView token : tokens) {
+    if (token.get_type() == STRING_VALUE) {
+      string_bytes += token.get_length();
+      escaped_count += token.is_escaped() ? 1 : 0;
+    }
+  }
+
+  const size_t allocations = get_allocation_count();
+
+  for (auto _ : state) {
+    for (const TokenView token : tokens) {
+      if (token.get_type() == STRING_VALUE) {
+        benchmark::DoNotOptimize(get_string_value(
+            token.get_value(document.source_), token.is_escaped(), storage));
+      }
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(string_bytes));
+  state.counters["escaped_strings"] = static_cast<double>(escaped_count);
+  state.counters["allocations_per_document"] =
+      benchmark::Counter(static_cast<double>(get_allocation_count() -
+                                             allocations),
+                         benchmark::Counter::kAvgIterations);
+}
+
+/// \brief Types and erases a space in the middle of documents, as an editor
+/// user would. Its time should not depend on the size of the document.
+void retokenize_edit(benchmark::State& state, const CorpusDocument& document) {
+  const std::string& source = document.source_;
+  // A space is valid anywhere a space already is.
+  const size_t offset = source.find(' ', source.size() / 2);
+
+  if (offset == std::string::npos) {
+    state.SkipWithError("The document has no space to edit.");
+    return;
+  }
+
+  std::string edited = source;
+  edited.insert(offset, 1, ' ');
+  IncrementalTokenizer tokenizer = IncrementalTokenizer();
+
+  if (!tokenizer.reset(source).IsOk()) {
+    state.SkipWithError("The document could not be tokenized.");
+    return;
+  }
+
+  const TextEdit insertion =
+      TextEdit{.offset_ = offset, .deleted_length_ = 0, .inserted_length_ = 1};
+  const TextEdit deletion =
+      TextEdit{.offset_ = offset, .deleted_length_ = 1, .inserted_length_ = 0};
+  size_t lexed_tokens = 0;
+  const size_t allocations = get_allocation_count();
+
+  for (auto _ : state) {
+    lexed_tokens += tokenizer.apply_edit(edited, insertion).Unwrap();
+    lexed_tokens += tokenizer.apply_edit(source, deletion).Unwrap();
+  }
+
+  state.counters["tokens"] = static_cast<double>(tokenizer.size());
+  state.counters["lexed_tokens_per_edit"] =
+      benchmark::Counter(static_cast<double>(lexed_tokens) / 2,
+                         benchmark::Counter::kAvgIterations);
+  state.counters["allocations_per_edit"] =
+      benchmark::Counter(static_cast<double>(get_allocation_count() -
+                                             allocations) /
+                             2,
+                         benchmark::Counter::kAvgIterations);
+}
+
+/// \brief Compiles a generated schema, as a server does when it starts.
+void compile_schema(benchmark::State& state) {
+  const std::string source =
+      generate_schema(static_cast<size_t>(state.range(0)));
+  size_t memory_usage = 0;
+
+  for (auto _ : state) {
+    Result<schema::Schema, schema::SchemaError> r =
+        schema::compile_schema(source);
+
+    if (!r.IsOk()) {
+      state.SkipWithError("The schema could not be compiled.");
+      return;
+    }
+
+    memory_usage = r.Unwrap().get_memory_usage();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(source.size()));
+  state.counters["schema_bytes"] = static_cast<double>(memory_usage);
+}
+
+/// \brief Names of every type of a generated schema, looked up in turn by
+/// the lookup benchmarks.
+std::vector<std::string> get_type_names(const size_t type_count) {
+  std::vector<std::string> names;
+
+  for (size_t i = 0; i < type_count; i++) {
+    names.push_back("Type" + std::to_string(i));
+  }
+
+  return names;
+}
+
+void find_type(benchmark::State& state) {
+  const auto type_count = static_cast<size_t>(state.range(0));
+  const schema::Schema compiled =
+      schema::compile_schema(generate_schema(type_count)).Unwrap();
+  const std::vector<std::string> names = get_type_names(type_count);
+  size_t i = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(compiled.find_type(names[i]));
+    i = i + 1 == names.size() ? 0 : i + 1;
+  }
+}
+
+/// \brief Baseline of <i>find_type</i>: a hash map from names to types.
+void find_type_in_unordered_map(benchmark::State& state) {
+  const auto type_count = static_cast<size_t>(state.range(0));
+  const std::vector<std::string> names = get_type_names(type_count);
+  std::unordered_map<std::string_view, schema::TypeId> types;
+
+  for (size_t i = 0; i < names.size(); i++) {
+    types.emplace(names[i], static_cast<schema::TypeId>(i));
+  }
+
+  size_t i = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(types.find(names[i]));
+    i = i + 1 == names.size() ? 0 : i + 1;
+  }
+}
+
+/// \brief Finds a field and one of its arguments, as a validator does for
+/// every field of an operation.
+void find_field_argument(benchmark::State& state) {
+  const auto type_count = static_cast<size_t>(state.range(0));
+  const schema::Schema compiled =
+      schema::compile_schema(generate_schema(type_count)).Unwrap();
+  std::vector<schema::TypeId> types;
+
+  for (const std::string& name : get_type_names(type_count)) {
+    types.push_back(compiled.find_type(name));
+  }
+
+  size_t i = 0;
+
+  for (auto _ : state) {
+    const schema::FieldId field = compiled.find_field(types[i], "previous");
+    benchmark::DoNotOptimize(compiled.find_argument(field, "after"));
+    i = i + 1 == types.size() ? 0 : i + 1;
+  }
+}
+
+void find_non_ascii_or_invalid_byte(benchmark::State& state,
+                                    const ScanLevel level) {
+  if (!is_scan_level_supported(level)) {
+    state.SkipWithError("Scan level not supported by this CPU.");
+    return;
+  }
+
+  const std::string source(SCAN_SOURCE_SIZE, 'a');
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        language::tokenization::find_non_ascii_or_invalid_byte(source, level));
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(source.size()));
+}
+
+/// \brief In-process stand-in for a database, whose calls take
+/// <i>BACKEND_LATENCY</i> whatever the amount of users they fetch.
+class MockBackend {
+ public:
+  std::vector<FieldResult> fetch_users(const std::span<const Value> ids) {
+    call_count_++;
+    std::this_thread::sleep_for(BACKEND_LATENCY);
+
+    std::vector<FieldResult> users;
+
+    for (const Value& id : ids) {
+      const std::string name = std::to_string(id.get_int());
+      users.push_back(FieldResult::Ok(Value(Value::Object{
+          {"id", Value(name)}, {"name", Value("user" + name)}})));
+    }
+
+    return users;
+  }
+
+  [[nodiscard]] size_t get_call_count() const { return call_count_; }
+
+ private:
+  std::atomic<size_t> call_count_ = 0;
+};
+
+std::vector<Value> get_friend_ids(const Value& user) {
+  const int64_t id = std::stoll(user.find("id")->get_string());
+  std::vector<Value> ids;
+
+  for (int64_t i = 1; i <= FRIEND_COUNT; i++) {
+    ids.emplace_back((id * FRIEND_COUNT + i) % (USER_COUNT * FRIEND_COUNT));
+  }
+
+  return ids;
+}
+
+FieldResult to_list(std::vector<FieldResult> users) {
+  Value::List list;
+
+  for (FieldResult& r : users) {
+    if (!r.IsOk()) {
+      return r;
+    }
+
+    list.push_back(r.Unwrap());
+  }
+
+  return FieldResult::Ok(Value(std::move(list)));
+}
+
+/// \brief Executes a query two levels of friends deep, whose users are
+/// fetched from a mock backend either through a loader, which makes one call
+/// per level, or by each resolver on its own, which makes one call per user.
+void execute_query(benchmark::State& state, const bool is_batched) {
+  const schema::Schema compiled =
+      schema::compile_schema(EXECUTION_SCHEMA).Unwrap();
+  concurrency::ThreadPool pool =
+      concurrency::ThreadPool(static_cast<size_t>(state.range(0)));
+  Executor executor = Executor(compiled, pool);
+  MockBackend backend;
+  const LoaderId users = executor.add_loader(
+      [&](const std::span<const Value> ids) -> Task<std::vector<FieldResult>> {
+        co_return backend.fetch_users(ids);
+      });
+
+  executor.set_resolver("Query", "users", [&](const ResolveInfo& info) {
+    return [](const ResolveInfo& info, MockBackend& backend,
+              const LoaderId loader,
+              const bool is_batched) -> Task<FieldResult> {
+      std::vector<Value> ids;
+
+      for (int64_t i = 0; i < USER_COUNT; i++) {
+        ids.emplace_back(i);
+      }
+
+      if (!is_batched) {
+        co_return to_list(backend.fetch_users(ids));
+      }
+
+      std::vector<FieldResult> results =
+          co_await info.load_many(loader, std::move(ids));
+      co_return to_list(std::move(results));
+    }(info, backend, users, is_batched);
+  });
+  executor.set_resolver("User", "friends", [&](const ResolveInfo& info) {
+    return [](const ResolveInfo& info, MockBackend& backend,
+              const LoaderId loader,
+              const bool is_batched) -> Task<FieldResult> {
+      std::vector<Value> ids = get_friend_ids(info.get_source());
+
+      if (!is_batched) {
+        co_return to_list(backend.fetch_users(ids));
+      }
+
+      std::vector<FieldResult> results =
+          co_await info.load_many(loader, std::move(ids));
+      co_return to_list(std::move(results));
+    }(info, backend, users, is_batched);
+  });
+
+  language::parsing::Arena arena;
+  const ExecutionRequest request = ExecutionRequest{
+      .document_ = language::parsing::parse(EXECUTION_QUERY, arena).Unwrap(),
+      .source_ = EXECUTION_QUERY,
+      .operation_name_ = {},
+      .variables_ = Value(Value::Object()),
+      .root_value_ = {}};
+
+  for (auto _ : state) {
+    ExecutionResult result = executor.execute(request);
+
+    if (!result.errors_.empty()) {
+      state.SkipWithError("The query failed.");
+      return;
+    }
+
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.counters["backend_calls"] =
+      benchmark::Counter(static_cast<double>(backend.get_call_count()),
+                         benchmark::Counter::kAvgIterations);
+}
+
+/// \brief Response data of a list query: items holding scalars, a few of
+/// which need escaping, and a nested list of objects.
+Value generate_list_response(const size_t item_count) {
+  Value::List items;
+  items.reserve(item_count);
+
+  for (size_t i = 0; i < item_count; i++) {
+    const std::string id = std::to_string(i);
+    Value::List friends;
+
+    for (size_t j = 0; j < 3; j++) {
+      friends.emplace_back(Value::Object{
+          {"id", Value(id + "-" + std::to_string(j))},
+          {"online", Value(j % 2 == 0)}});
+    }
+
+    items.emplace_back(Value::Object{
+        {"id", Value(id)},
+        {"name", Value(i % 16 == 0 ? "user \"" + id + "\"" : "user " + id)},
+        {"score", Value(static_cast<double>(i) * 0.37)},
+        {"visits", Value(static_cast<int64_t>(i * 7919))},
+        {"friends", Value(std::move(friends))}});
+  }
+
+  return Value(Value::Object{{"users", Value(std::move(items))}});
+}
+
+void write_json_to_string(benchmark::State& state) {
+  const Value data =
+      generate_list_response(static_cast<size_t>(state.range(0)));
+  size_t size = 0;
+
+  for (auto _ : state) {
+    std::string output;
+    data.write_json(output);
+    size = output.size();
+    benchmark::DoNotOptimize(output.data());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(size));
+}
+
+/// \brief Writes the same data as <i>write_json_to_string</i> with a reused
+/// writer, as a server does for each response.
+void write_json_to_chunks(benchmark::State& state) {
+  const Value data =
+      generate_list_response(static_cast<size_t>(state.range(0)));
+  JsonWriter writer;
+  size_t size = 0;
+
+  for (auto _ : state) {
+    writer.clear();
+    writer.write_value(data);
+    size = writer.get_size();
+    benchmark::DoNotOptimize(writer.get_segments().data());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(size));
+}
+
+void find_json_escape_byte(benchmark::State& state, const ScanLevel level) {
+  if (!is_scan_level_supported(level)) {
+    state.SkipWithError("Scan level not supported by this CPU.");
+    return;
+  }
+
+  const std::string value(SCAN_SOURCE_SIZE, 'a');
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        language::tokenization::find_json_escape_byte(value, level));
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(value.size()));
+}
+
+/// \brief Persisted queries of a few hundred bytes, each of them distinct.
+std::vector<caching::DocumentSource> generate_persisted_queries(
+    const size_t count) {
+  std::vector<caching::DocumentSource> documents;
+  documents.reserve(count);
+
+  for (size_t i = 0; i < count; i++) {
+    const std::string id = std::to_string(i);
+    documents.push_back(caching::DocumentSource{
+        .name_ = "query" + id + ".graphql",
+        .source_ = "query Query" + id + "($first: Int = " + id +
+                   ", $after: String) {\n"
+                   "  users(first: $first, after: $after) {\n"
+                   "    id name @include(if: true)\n"
+                   "    friends(first: 3) { ...Friend" + id + " }\n"
+                   "  }\n"
+                   "}\n"
+                   "fragment Friend" + id + " on User { id name }\n"});
+  }
+
+  return documents;
+}
+
+/// \brief Loads persisted queries the way a server does without a
+/// precompiled file: parsing each of them.
+void parse_persisted_queries(benchmark::State& state) {
+  const std::vector<caching::DocumentSource> documents =
+      generate_persisted_queries(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    language::parsing::Arena arena;
+
+    for (const caching::DocumentSource& document : documents) {
+      benchmark::DoNotOptimize(
+          language::parsing::parse(document.source_, arena).IsOk());
+    }
+  }
+}
+
+/// \brief Loads the same queries as <i>parse_persisted_queries</i> from a
+/// precompiled file, and looks one of them up.
+void open_precompiled_documents(benchmark::State& state) {
+  const std::vector<caching::DocumentSource> documents =
+      generate_persisted_queries(static_cast<size_t>(state.range(0)));
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "graphqlpp_bench_documents")
+          .string();
+  const caching::Sha256Digest digest = caching::sha256(documents[0].source_);
+  std::ofstream(path, std::ios::binary)
+      << caching::precompile_documents(documents).Unwrap();
+
+  for (auto _ : state) {
+    Result<caching::PrecompiledDocuments, std::string> r =
+        caching::PrecompiledDocuments::open(path);
+    benchmark::DoNotOptimize(r.Unwrap().find(digest).has_value());
+  }
+
+  std::filesystem::remove(path);
+}
+
+void register_benchmarks() {
+  for (const CorpusDocument& document : get_corpus()) {
+    benchmark::RegisterBenchmark(
+        ("TokenizeUtf8ToVector/" + document.name_).c_str(),
+        tokenize_utf8_to_vector, document);
+    benchmark::RegisterBenchmark(
+        ("TokenizeUtf8ToBuffer/" + document.name_).c_str(),
+        tokenize_utf8_to_buffer<FULL_FIDELITY_POLICY>, document);
+    benchmark::RegisterBenchmark(
+        ("TokenizeSignificantTokens/" + document.name_).c_str(),
+        tokenize_utf8_to_buffer<SIGNIFICANT_TOKENS_POLICY>, document);
+    benchmark::RegisterBenchmark(
+        ("TokenizeTrustedSignificantTokens/" + document.name_).c_str(),
+        tokenize_utf8_to_buffer<TRUSTED_SIGNIFICANT_TOKENS_POLICY>, document);
+    benchmark::RegisterBenchmark(
+        ("TokenizeBranchySignificantTokens/" + document.name_).c_str(),
+        tokenize_branchy_to_buffer, document);
+    // Against TokenizeSignificantTokens, the overhead of recording metrics.
+    benchmark::RegisterBenchmark(
+        ("TokenizeMeteredSignificantTokens/" + document.name_).c_str(),
+        tokenize_utf8_to_buffer<METERED_SIGNIFICANT_TOKENS_POLICY>, document);
+    benchmark::RegisterBenchmark(
+        ("TokenizeUtf32ToVector/" + document.name_).c_str(),
+        tokenize_utf32_to_vector, document);
+    benchmark::RegisterBenchmark(("LexInChunks/" + document.name_).c_str(),
+                                 lex_in_chunks, document);
+    benchmark::RegisterBenchmark(("AnalyzeQuery/" + document.name_).c_str(),
+                                 analyze_query, document);
+    benchmark::RegisterBenchmark(
+        ("NormalizeTokens/" + document.name_).c_str(), normalize_tokens,
+        document);
+    benchmark::RegisterBenchmark(
+        ("RetokenizeEdit/" + document.name_).c_str(), retokenize_edit,
+        document);
+    benchmark::RegisterBenchmark(
+        ("GetStringValues/" + document.name_).c_str(), get_string_values,
+        document);
+
+    if (document.source_.size() >= 2 * MINIMUM_PARALLEL_CHUNK_SIZE) {
+      benchmark::RegisterBenchmark(
+          ("TokenizeUtf8InParallel/" + document.name_).c_str(),
+          tokenize_utf8_in_parallel, document)
+          ->UseRealTime();
+    }
+  }
+
+  benchmark::RegisterBenchmark("CreateResult/in_place",
+                               create_result<Result<size_t, TokenizeError>>);
+  benchmark::RegisterBenchmark(
+      "CreateResult/boxed",
+      create_result<BoxedResult<size_t, TokenizeError>>);
+
+  for (const int64_t type_count : SCHEMA_TYPE_COUNTS) {
+    benchmark::RegisterBenchmark("CompileSchema", compile_schema)
+        ->Arg(type_count)
+        ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("FindType", find_type)->Arg(type_count);
+    benchmark::RegisterBenchmark("FindTypeInUnorderedMap",
+                                 find_type_in_unordered_map)
+        ->Arg(type_count);
+    benchmark::RegisterBenchmark("FindFieldArgument", find_field_argument)
+        ->Arg(type_count);
+  }
+
+  for (const int64_t thread_count : EXECUTION_THREAD_COUNTS) {
+    benchmark::RegisterBenchmark("ExecuteWithLoader", execute_query, true)
+        ->Arg(thread_count)
+        ->UseRealTime();
+    benchmark::RegisterBenchmark("ExecuteWithoutLoader", execute_query, false)
+        ->Arg(thread_count)
+        ->UseRealTime();
+  }
+
+  for (const int64_t item_count : JSON_ITEM_COUNTS) {
+    benchmark::RegisterBenchmark("WriteJsonToString", write_json_to_string)
+        ->Arg(item_count);
+    benchmark::RegisterBenchmark("WriteJsonToChunks", write_json_to_chunks)
+        ->Arg(item_count);
+  }
+
+  for (const int64_t query_count : PERSISTED_QUERY_COUNTS) {
+    benchmark::RegisterBenchmark("ParsePersistedQueries",
+                                 parse_persisted_queries)
+        ->Arg(query_count)
+        ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("OpenPrecompiledDocuments",
+                                 open_precompiled_documents)
+        ->Arg(query_count)
+        ->Unit(benchmark::kMillisecond);
+  }
+
+  const std::pair<const char*, ScanLevel> levels[] = {
+      {"scalar", SCALAR}, {"sse4_2", SSE4_2}, {"avx2", AVX2}};
+
+  for (const auto& [name, level] : levels) {
+    benchmark::RegisterBenchmark(
+        (std::string("FindNonAsciiOrInvalidByte/") + name).c_str(),
+        find_non_ascii_or_invalid_byte, level);
+    benchmark::RegisterBenchmark(
+        (std::string("FindJsonEscapeByte/") + name).c_str(),
+        find_json_escape_byte, level);
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  register_benchmarks();
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/caching/document_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::caching;
+using graphqlpp::language::parsing::ParseError;
+
+constexpr size_t LARGE_BUDGET = 16 * 1024 * 1024;
+
+std::shared_ptr<const ParsedDocument> get_or_fail(DocumentCache& cache,
+                                                  const std::string& source) {
+  Result<std::shared_ptr<const ParsedDocument>, ParseError> r =
+      cache.get_or_parse(source);
+
+  EXPECT_TRUE(r.IsOk());
+
+  return r.IsOk() ? r.Unwrap() : nullptr;
+}
+
+TEST(DocumentCacheTest, GetOrParse_SharesCachedDocuments) {
+  DocumentCache cache = DocumentCache(LARGE_BUDGET);
+
+  const auto first = get_or_fail(cache, "{ user { id } }");
+  const auto second = get_or_fail(cache, std::string("{ user { id } }"));
+
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(1, first->get_document().definitions_.size());
+
+  const CacheStatistics statistics = cache.get_statistics();
+
+  ASSERT_EQ(1, statistics.hits_);
+  ASSERT_EQ(1, statistics.misses_);
+  ASSERT_EQ(1, statistics.entries_);
+  ASSERT_GT(statistics.memory_usage_, first->get_memory_usage());
+}
+
+TEST(DocumentCacheTest, GetOrParse_DoesNotCacheErrors) {
+  DocumentCache cache = DocumentCache(LARGE_BUDGET);
+
+  ASSERT_FALSE(cache.get_or_parse("{ a(").IsOk());
+  ASSERT_EQ(0, cache.get_statistics().entries_);
+}
+
+TEST(DocumentCacheTest, FindPersisted_FindsDocumentsBySha256) {
+  const std::string source = "query Q { a }";
+  DocumentCache cache = DocumentCache(LARGE_BUDGET);
+
+  ASSERT_EQ(nullptr, cache.find_persisted(to_hex(sha256(source))));
+
+  const auto document = get_or_fail(cache, source);
+
+  ASSERT_EQ(document, cache.find_persisted(to_hex(sha256(source))));
+  ASSERT_EQ(document, cache.find_persisted(sha256(source)));
+  ASSERT_EQ(nullptr, cache.find_persisted("not a digest"));
+}
+
+TEST(DocumentCacheTest, GetOrParse_EvictsLeastRecentlyUsedDocuments) {
+  const auto measured = ParsedDocument::create("{ field0 }").Unwrap();
+  // A single shard holding roughly three documents.
+  DocumentCache cache = DocumentCache(4 * measured->get_memory_usage(), 1);
+
+  get_or_fail(cache, "{ field0 }");
+  get_or_fail(cache, "{ field1 }");
+  get_or_fail(cache, "{ field2 }");
+  get_or_fail(cache, "{ field0 }");
+  get_or_fail(cache, "{ field3 }");
+
+  ASSERT_NE(nullptr, cache.find("{ field0 }"));
+  ASSERT_EQ(nullptr, cache.find("{ field1 }"));
+  ASSERT_EQ(nullptr, cache.find_persisted(sha256("{ field1 }")));
+  ASSERT_EQ(1, cache.get_statistics().evictions_);
+  ASSERT_LE(cache.get_statistics().memory_usage_,
+            4 * measured->get_memory_usage());
+}
+
+TEST(DocumentCacheTest, GetOrParse_DoesNotCacheDocumentsLargerThanAShard) {
+  DocumentCache cache = DocumentCache(64, 1);
+
+  const auto document = get_or_fail(cache, "{ a }");
+
+  ASSERT_NE(nullptr, document);
+  ASSERT_EQ(0, cache.get_statistics().entries_);
+}
+
+TEST(DocumentCacheTest, GetOrParse_SupportsConcurrentCallers) {
+  constexpr size_t thread_count = 8;
+  constexpr size_t document_count = 64;
+  DocumentCache cache = DocumentCache(LARGE_BUDGET);
+  std::vector<std::thread> threads;
+
+  for (size_t t = 0; t < thread_count; t++) {
+    threads.emplace_back([&cache]() {
+      for (size_t i = 0; i < 10 * document_count; i++) {
+        const std::string source =
+            "{ field" + std::to_string(i % document_count) + " }";
+        const auto document = cache.get_or_parse(source).Unwrap();
+
+        EXPECT_EQ(source, document->get_source());
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  const CacheStatistics statistics = cache.get_statistics();
+
+  ASSERT_EQ(document_count, statistics.entries_);
+  ASSERT_EQ(thread_count * 10 * document_count,
+            statistics.hits_ + statistics.misses_);
+}
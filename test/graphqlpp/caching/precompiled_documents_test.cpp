@@ -0,0 +1,418 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/caching/precompiled_documents.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "graphqlpp/language/normalization/normalizer.h"
+#include "graphqlpp/language/parsing/parser.h"
+#include "graphqlpp/language/tokenization/tokenizer.h"
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::caching;
+using namespace graphqlpp::language::parsing;
+
+const std::vector<DocumentSource> PRECOMPILED_SOURCES = {
+    {"users.graphql",
+     "query Users($first: Int = 10, $ids: [ID!]! @deprecated) {\n"
+     "  users(first: $first, ids: $ids) @include(if: true) {\n"
+     "    id\n"
+     "    display: name\n"
+     "    ...Details\n"
+     "    ... on Admin { level }\n"
+     "    ... @skip(if: false) { email }\n"
+     "  }\n"
+     "}\n"
+     "fragment Details on User { bio(format: MARKDOWN) }\n"},
+    {"literals.graphql",
+     "mutation { set(input: {a: 1, b: -2.5e3, c: \"x\\ny\", d: \"\"\"\n"
+     "  block\"\"\", e: [null, false, ENUM], f: {}}) }"},
+    {"duplicate.graphql", "{ a }"},
+    {"same_text.graphql", "{ a }"}};
+
+/// \brief Writes a node and its children as an indented outline, so that two
+/// ASTs can be compared as strings.
+void describe_node(const Node* node, std::string& output, size_t depth = 0) {
+  output.append(depth * 2, ' ');
+
+  if (node == nullptr) {
+    output += "null\n";
+    return;
+  }
+
+  output += std::to_string(static_cast<int>(node->kind_)) + "@" +
+            std::to_string(node->offset_);
+  std::vector<const Node*> children;
+
+  const auto add_all = [&](const auto& nodes) {
+    children.insert(children.end(), nodes.begin(), nodes.end());
+  };
+
+  switch (node->kind_) {
+    case NodeKind::DOCUMENT:
+      add_all(static_cast<const Document*>(node)->definitions_);
+      break;
+    case NodeKind::OPERATION_DEFINITION: {
+      const auto* operation = static_cast<const OperationDefinition*>(node);
+      output += " " + std::to_string(static_cast<int>(operation->operation_)) +
+                " " + std::string(operation->name_);
+      add_all(operation->variable_definitions_);
+      add_all(operation->directives_);
+      children.push_back(operation->selection_set_);
+      break;
+    }
+    case NodeKind::FRAGMENT_DEFINITION: {
+      const auto* fragment = static_cast<const FragmentDefinition*>(node);
+      output += " " + std::string(fragment->name_);
+      children.push_back(fragment->type_condition_);
+      add_all(fragment->directives_);
+      children.push_back(fragment->selection_set_);
+      break;
+    }
+    case NodeKind::VARIABLE_DEFINITION: {
+      const auto* definition = static_cast<const VariableDefinition*>(node);
+      children.push_back(definition->variable_);
+      children.push_back(definition->type_);
+      children.push_back(definition->default_value_);
+      add_all(definition->directives_);
+      break;
+    }
+    case NodeKind::SELECTION_SET:
+      add_all(static_cast<const SelectionSet*>(node)->selections_);
+      break;
+    case NodeKind::FIELD: {
+      const auto* field = static_cast<const Field*>(node);
+      output += " " + std::string(field->alias_) + ":" +
+                std::string(field->name_);
+      add_all(field->arguments_);
+      add_all(field->directives_);
+      children.push_back(field->selection_set_);
+      break;
+    }
+    case NodeKind::FRAGMENT_SPREAD: {
+      const auto* spread = static_cast<const FragmentSpread*>(node);
+      output += " " + std::string(spread->name_);
+      add_all(spread->directives_);
+      break;
+    }
+    case NodeKind::INLINE_FRAGMENT: {
+      const auto* fragment = static_cast<const InlineFragment*>(node);
+      children.push_back(fragment->type_condition_);
+      add_all(fragment->directives_);
+      children.push_back(fragment->selection_set_);
+      break;
+    }
+    case NodeKind::ARGUMENT:
+      output += " " + std::string(static_cast<const Argument*>(node)->name_);
+      children.push_back(static_cast<const Argument*>(node)->value_);
+      break;
+    case NodeKind::DIRECTIVE:
+      output += " " + std::string(static_cast<const Directive*>(node)->name_);
+      add_all(static_cast<const Directive*>(node)->arguments_);
+      break;
+    case NodeKind::VARIABLE:
+      output += " " + std::string(static_cast<const Variable*>(node)->name_);
+      break;
+    case NodeKind::INT_VALUE:
+      output += " " + std::string(static_cast<const IntValue*>(node)->value_);
+      break;
+    case NodeKind::FLOAT_VALUE:
+      output +=
+          " " + std::string(static_cast<const FloatValue*>(node)->value_);
+      break;
+    case NodeKind::STRING_VALUE: {
+      const auto* value = static_cast<const StringValue*>(node);
+      output += " " + std::string(value->raw_value_) + " " +
+                std::to_string(value->block_) + std::to_string(value->escaped_);
+      break;
+    }
+    case NodeKind::BOOLEAN_VALUE:
+      output += std::to_string(static_cast<const BooleanValue*>(node)->value_);
+      break;
+    case NodeKind::ENUM_VALUE:
+      output += " " + std::string(static_cast<const EnumValue*>(node)->value_);
+      break;
+    case NodeKind::LIST_VALUE:
+      add_all(static_cast<const ListValue*>(node)->values_);
+      break;
+    case NodeKind::OBJECT_VALUE:
+      add_all(static_cast<const ObjectValue*>(node)->fields_);
+      break;
+    case NodeKind::OBJECT_FIELD:
+      output +=
+          " " + std::string(static_cast<const ObjectField*>(node)->name_);
+      children.push_back(static_cast<const ObjectField*>(node)->value_);
+      break;
+    case NodeKind::NAMED_TYPE:
+      output += " " + std::string(static_cast<const NamedType*>(node)->name_);
+      break;
+    case NodeKind::LIST_TYPE:
+      children.push_back(static_cast<const ListType*>(node)->type_);
+      break;
+    case NodeKind::NON_NULL_TYPE:
+      children.push_back(static_cast<const NonNullType*>(node)->type_);
+      break;
+    default:
+      break;
+  }
+
+  output += "\n";
+
+  for (const Node* child : children) {
+    describe_node(child, output, depth + 1);
+  }
+}
+
+std::string write_precompiled_file(const std::string& name,
+                                   const std::string& contents) {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / name;
+  std::ofstream stream(path, std::ios::binary);
+  stream << contents;
+
+  return path.string();
+}
+
+PrecompiledDocuments open_or_fail(const std::string& path) {
+  Result<PrecompiledDocuments, std::string> r =
+      PrecompiledDocuments::open(path);
+
+  EXPECT_TRUE(r.IsOk());
+
+  return r.Unwrap();
+}
+
+TEST(PrecompiledDocumentsTest, Materialize_MatchesParse) {
+  Result<std::string, std::string> r =
+      precompile_documents(PRECOMPILED_SOURCES);
+
+  ASSERT_TRUE(r.IsOk());
+
+  const std::string path =
+      write_precompiled_file("graphqlpp_precompiled_test.bin", r.Unwrap());
+  const PrecompiledDocuments documents = open_or_fail(path);
+
+  // Both documents with the same text share one record.
+  ASSERT_EQ(3, documents.size());
+
+  for (size_t i = 0; i < 3; i++) {
+    const DocumentSource& source = PRECOMPILED_SOURCES[i];
+    const std::optional<PrecompiledDocument> document =
+        documents.find(sha256(source.source_));
+
+    ASSERT_TRUE(document.has_value());
+    ASSERT_EQ(source.name_, document->get_name());
+    ASSERT_EQ(source.source_, document->get_source());
+    ASSERT_EQ(language::normalization::normalize(source.source_)
+                  .Unwrap()
+                  .signature_,
+              document->get_signature());
+
+    Arena parsed_arena;
+    Arena materialized_arena;
+    Result<const Document*, ParseError> parsed =
+        parse(source.source_, parsed_arena);
+    Result<const Document*, std::string> materialized =
+        document->materialize(materialized_arena);
+
+    ASSERT_TRUE(parsed.IsOk());
+    ASSERT_TRUE(materialized.IsOk());
+
+    std::string expected;
+    std::string actual;
+    describe_node(parsed.Unwrap(), expected);
+    describe_node(materialized.Unwrap(), actual);
+
+    ASSERT_EQ(expected, actual);
+
+    language::tokenization::TokenBuffer tokens;
+    language::tokenization::tokenize<
+        language::tokenization::SIGNIFICANT_TOKENS_POLICY>(source.source_,
+                                                           tokens);
+
+    ASSERT_EQ(tokens.size(), document->get_tokens().size());
+
+    for (size_t j = 0; j < tokens.size(); j++) {
+      ASSERT_EQ(tokens.get_offset(j), document->get_tokens()[j].offset_);
+      ASSERT_EQ(tokens.get_length(j), document->get_tokens()[j].length_);
+    }
+  }
+
+  ASSERT_TRUE(documents.find(to_hex(sha256("{ a }"))).has_value());
+  ASSERT_FALSE(documents.find(sha256("{ b }")).has_value());
+  ASSERT_FALSE(documents.find("not a digest").has_value());
+
+  std::filesystem::remove(path);
+}
+
+TEST(PrecompiledDocumentsTest, Open_RejectsInvalidFiles) {
+  std::string contents =
+      precompile_documents(PRECOMPILED_SOURCES).Unwrap();
+  const std::string path = write_precompiled_file(
+      "graphqlpp_precompiled_invalid_test.bin", contents.substr(0, 100));
+
+  ASSERT_FALSE(PrecompiledDocuments::open(path).IsOk());
+
+  // Format version, right after the magic bytes.
+  contents[8]++;
+  write_precompiled_file("graphqlpp_precompiled_invalid_test.bin", contents);
+  Result<PrecompiledDocuments, std::string> r =
+      PrecompiledDocuments::open(path);
+
+  ASSERT_FALSE(r.IsOk());
+  ASSERT_NE(std::string::npos, r.UnwrapErr().find("format version"));
+
+  std::filesystem::remove(path);
+}
+
+TEST(PrecompiledDocumentsTest, Materialize_RejectsCorruptNodes) {
+  std::string contents = precompile_documents(
+      std::vector<DocumentSource>{{"a.graphql", "{ a { b } }"}}).Unwrap();
+  precompiled::FileHeader header;
+  std::memcpy(&header, contents.data(), sizeof(header));
+
+  // The selection set of the root operation becomes its own parent.
+  auto* children = reinterpret_cast<uint32_t*>(contents.data() +
+                                               header.children_offset_);
+
+  for (size_t i = 0; i < header.child_count_; i++) {
+    children[i] = 0;
+  }
+
+  const std::string path = write_precompiled_file(
+      "graphqlpp_precompiled_corrupt_test.bin", contents);
+  const PrecompiledDocuments documents = open_or_fail(path);
+  Arena arena;
+
+  ASSERT_FALSE(documents[0].materialize(arena).IsOk());
+
+  std::filesystem::remove(path);
+}
+
+/// \brief Precompiles a single document, lets the caller rewire its node
+/// records and children, and reports whether it still materializes.
+template <typename Corrupt>
+bool materialize_corrupted(const std::string& source, const Corrupt& corrupt) {
+  std::string contents = precompile_documents(
+      std::vector<DocumentSource>{{"a.graphql", source}}).Unwrap();
+  precompiled::FileHeader header;
+  std::memcpy(&header, contents.data(), sizeof(header));
+
+  corrupt(std::span(reinterpret_cast<precompiled::NodeRecord*>(
+                        contents.data() + header.nodes_offset_),
+                    header.node_count_),
+          std::span(reinterpret_cast<uint32_t*>(contents.data() +
+                                                header.children_offset_),
+                    header.child_count_));
+
+  const std::string path = write_precompiled_file(
+      "graphqlpp_precompiled_corrupt_test.bin", contents);
+  const PrecompiledDocuments documents = open_or_fail(path);
+  Arena arena;
+  const bool is_ok = documents[0].materialize(arena).IsOk();
+  std::filesystem::remove(path);
+
+  return is_ok;
+}
+
+TEST(PrecompiledDocumentsTest, Materialize_AcceptsTheDeepestDocuments) {
+  std::string source = "{";
+
+  for (size_t i = 1; i < MAX_NESTING_DEPTH - 1; i++) {
+    source += "... {";
+  }
+
+  source += " a @d(x: 1) " + std::string(MAX_NESTING_DEPTH - 1, '}');
+
+  ASSERT_TRUE(materialize_corrupted(
+      source, [](std::span<precompiled::NodeRecord>, std::span<uint32_t>) {}));
+}
+
+TEST(PrecompiledDocumentsTest, Materialize_RejectsDeepNodeChains) {
+  constexpr size_t LIST_COUNT = 100000;
+  std::string source = "{ a(b: [";
+
+  for (size_t i = 0; i < LIST_COUNT; i++) {
+    source += "[] ";
+  }
+
+  // Every empty list becomes the parent of the next one, so the lists form
+  // a chain far deeper than any parsed document.
+  const auto chain = [](const std::span<precompiled::NodeRecord> nodes,
+                        std::span<uint32_t>) {
+    for (size_t i = 0; i < nodes.size(); i++) {
+      if (nodes[i].group_sizes_[0] != LIST_COUNT) {
+        continue;
+      }
+
+      nodes[i].group_sizes_[0] = 1;
+
+      for (size_t j = 1; j < LIST_COUNT; j++) {
+        nodes[i + j].first_child_ = nodes[i].first_child_ + j;
+        nodes[i + j].group_sizes_[0] = 1;
+      }
+    }
+  };
+
+  ASSERT_FALSE(materialize_corrupted(source + "]) }", chain));
+}
+
+TEST(PrecompiledDocumentsTest, Materialize_RejectsSharedChildren) {
+  std::string value = "0";
+
+  for (size_t i = 0; i < 64; i++) {
+    value = "[" + value + ", 0]";
+  }
+
+  // Every list holds its inner list twice, which would expand to 2^64 nodes.
+  const auto share = [](const std::span<precompiled::NodeRecord> nodes,
+                        const std::span<uint32_t> children) {
+    for (const precompiled::NodeRecord& node : nodes) {
+      if (node.kind_ == static_cast<uint8_t>(NodeKind::LIST_VALUE)) {
+        children[node.first_child_ + 1] = children[node.first_child_];
+      }
+    }
+  };
+
+  ASSERT_FALSE(materialize_corrupted("{ a(b: " + value + ") }", share));
+}
+
+TEST(PrecompiledDocumentsTest, PrecompileDocuments_NamesInvalidDocument) {
+  Result<std::string, std::string> r = precompile_documents(
+      std::vector<DocumentSource>{{"valid.graphql", "{ a }"},
+                                  {"broken.graphql", "{ a(: 1) }"}});
+
+  ASSERT_FALSE(r.IsOk());
+  ASSERT_NE(std::string::npos, r.UnwrapErr().find("'broken.graphql'"));
+}
+
+TEST(PrecompiledDocumentsTest, PrecompileDirectory_FindsNestedDocuments) {
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "graphqlpp_precompiled_dir";
+  std::filesystem::create_directories(directory / "nested");
+  std::ofstream(directory / "a.graphql") << "{ a }";
+  std::ofstream(directory / "nested" / "b.graphql") << "{ b }";
+  std::ofstream(directory / "ignored.txt") << "not graphql";
+  const std::string path = (directory / "documents.bin").string();
+
+  Result<size_t, std::string> r =
+      precompile_directory(directory.string(), path);
+
+  ASSERT_TRUE(r.IsOk());
+  ASSERT_EQ(2, r.Unwrap());
+
+  const PrecompiledDocuments documents = open_or_fail(path);
+
+  ASSERT_EQ("nested/b.graphql",
+            documents.find(sha256("{ b }"))->get_name());
+
+  std::filesystem::remove_all(directory);
+}
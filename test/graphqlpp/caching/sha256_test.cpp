@@ -0,0 +1,47 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/caching/sha256.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace graphqlpp::caching;
+
+class Sha256TestFixture
+    : public testing::TestWithParam<std::tuple<std::string, std::string>> {};
+
+TEST_P(Sha256TestFixture, Sha256_MatchesKnownDigests) {
+  const auto [data, expected_hex] = GetParam();
+
+  ASSERT_EQ(expected_hex, to_hex(sha256(data)));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Sha256Test, Sha256TestFixture,
+    testing::Values(
+        std::make_tuple("", "e3b0c44298fc1c149afbf4c8996fb924"
+                            "27ae41e4649b934ca495991b7852b855"),
+        std::make_tuple("abc", "ba7816bf8f01cfea414140de5dae2223"
+                               "b00361a396177a9cb410ff61f20015ad"),
+        std::make_tuple(
+            "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+            "248d6a61d20638b8e5c026930c3e6039"
+            "a33ce45964ff2167f6ecedd419db06c1"),
+        std::make_tuple(std::string(64, 'a'),
+                        "ffe054fe7ae0cb6dc65c3af9b61d5209"
+                        "f439851db43d0ba5997337df154668eb"),
+        std::make_tuple(std::string(1000, 'a'),
+                        "41edece42d63e8d9bf515a9ba6932e1c"
+                        "20cbc9f5a5d134645adb5db1b9737ea3")));
+
+TEST(Sha256Test, ParseSha256Hex_RoundTrips) {
+  const Sha256Digest digest = sha256("{ a }");
+
+  ASSERT_EQ(digest, parse_sha256_hex(to_hex(digest)).value());
+}
+
+TEST(Sha256Test, ParseSha256Hex_RejectsInvalidText) {
+  ASSERT_FALSE(parse_sha256_hex("abc").has_value());
+  ASSERT_FALSE(parse_sha256_hex(std::string(64, 'g')).has_value());
+}
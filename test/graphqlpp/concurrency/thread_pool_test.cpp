@@ -0,0 +1,76 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/concurrency/thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+using namespace graphqlpp::concurrency;
+
+TEST(ThreadPoolTest, Submit_ReturnsTaskValues) {
+  ThreadPool pool = ThreadPool(4);
+  std::vector<std::future<size_t>> futures;
+
+  for (size_t i = 0; i < 100; i++) {
+    futures.push_back(pool.submit([i]() { return i * i; }));
+  }
+
+  for (size_t i = 0; i < futures.size(); i++) {
+    ASSERT_EQ(i * i, futures[i].get());
+  }
+}
+
+TEST(ThreadPoolTest, Submit_PropagatesExceptions) {
+  ThreadPool pool = ThreadPool(1);
+
+  std::future<int> future =
+      pool.submit([]() -> int { throw std::runtime_error("failure"); });
+
+  ASSERT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, Destructor_RunsPendingTasks) {
+  std::atomic<size_t> count = 0;
+
+  {
+    ThreadPool pool = ThreadPool(2);
+
+    for (size_t i = 0; i < 100; i++) {
+      pool.submit([&count]() { count++; });
+    }
+  }
+
+  ASSERT_EQ(100, count);
+}
+
+TEST(ThreadPoolTest, Post_RunsTasksQueuedByWorkers) {
+  std::atomic<size_t> count = 0;
+
+  {
+    ThreadPool pool = ThreadPool(4);
+
+    // Every task queues two more on its worker's own queue, which idle
+    // workers steal from.
+    std::function<void(size_t)> spread = [&](const size_t depth) {
+      count++;
+
+      if (depth < 10) {
+        pool.post([&, depth]() { spread(depth + 1); });
+        pool.post([&, depth]() { spread(depth + 1); });
+      }
+    };
+
+    pool.post([&]() { spread(0); });
+
+    // The destructor only returns once every queued task ran.
+    while (count < (size_t{1} << 11) - 1) {
+      std::this_thread::yield();
+    }
+  }
+
+  ASSERT_EQ((size_t{1} << 11) - 1, count);
+}
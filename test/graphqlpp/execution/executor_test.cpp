@@ -0,0 +1,412 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/execution/executor.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "graphqlpp/language/parsing/parser.h"
+#include "graphqlpp/result.h"
+#include "graphqlpp/schema/schema_compiler.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::execution;
+
+const char* const SCHEMA =
+    "interface Node { id: ID! }\n"
+    "type User implements Node {\n"
+    "  id: ID!\n"
+    "  name: String!\n"
+    "  friends(first: Int = 2): [User!]!\n"
+    "}\n"
+    "type Post implements Node { id: ID! title: String }\n"
+    "type Query {\n"
+    "  user(id: ID!): User\n"
+    "  users: [User!]!\n"
+    "  node(id: ID!): Node\n"
+    "  slow: Boolean\n"
+    "  slower: Boolean\n"
+    "}\n"
+    "type Mutation { append(value: String!): [String!]! }\n";
+
+schema::Schema compile_test_schema() {
+  Result<schema::Schema, schema::SchemaError> r =
+      schema::compile_schema(SCHEMA);
+
+  EXPECT_TRUE(r.IsOk());
+
+  return r.IsOk() ? r.Unwrap() : schema::Schema();
+}
+
+/// \brief Executes a document and writes the response as JSON.
+std::string execute_to_json(const Executor& executor,
+                            const std::string& source,
+                            Value variables = Value(Value::Object())) {
+  language::parsing::Arena arena = language::parsing::Arena();
+  Result<const language::parsing::Document*, language::parsing::ParseError>
+      r = language::parsing::parse(source, arena);
+  EXPECT_TRUE(r.IsOk());
+
+  ExecutionRequest request;
+  request.document_ = r.Unwrap();
+  request.source_ = source;
+  request.variables_ = std::move(variables);
+
+  std::string output;
+  executor.execute(request).write_json(output);
+
+  return output;
+}
+
+/// \brief Users of the tests: user i has the name "user<i>" and is friends
+/// with users i + 1 and i + 2.
+Value get_user(const int64_t id) {
+  return Value(Value::Object{{"id", Value(std::to_string(id))},
+                             {"name", Value("user" + std::to_string(id))}});
+}
+
+TEST(ExecutorTest, Execute_ResolvesFieldsFragmentsAndDirectives) {
+  const schema::Schema schema = compile_test_schema();
+  concurrency::ThreadPool pool = concurrency::ThreadPool(2);
+  Executor executor = Executor(schema, pool);
+
+  ASSERT_TRUE(executor.set_resolver(
+      "Query", "user", [](const ResolveInfo& info) -> Task<FieldResult> {
+        co_return FieldResult::Ok(
+            get_user(std::stoll(info.get_argument("id")->get_string())));
+      }));
+  ASSERT_TRUE(executor.set_resolver(
+      "Query", "node", [](const ResolveInfo& info) -> Task<FieldResult> {
+        co_return FieldResult::Ok(Value(Value::Object{
+            {"__typename", Value("Post")},
+            {"id", *info.get_argument("id")},
+            {"title", Value("Hello")}}));
+      }));
+  ASSERT_TRUE(executor.set_resolver(
+      "User", "friends", [](const ResolveInfo& info) -> Task<FieldResult> {
+        const int64_t id =
+            std::stoll(info.get_source().find("id")->get_string());
+        Value::List friends;
+
+        for (int64_t i = 1; i <= info.get_argument("first")->get_int(); i++) {
+          friends.push_back(get_user(id + i));
+        }
+
+        co_return FieldResult::Ok(Value(std::move(friends)));
+      }));
+  ASSERT_FALSE(executor.set_resolver("Query", "missing", nullptr));
+  ASSERT_FALSE(executor.set_resolver("Node", "id", nullptr));
+
+  ASSERT_EQ(
+      "{\"data\":{\"me\":{\"id\":\"1\",\"name\":\"user1\",\"friends\":["
+      "{\"name\":\"user2\"},{\"name\":\"user3\"}],\"__typename\":\"User\"},"
+      "\"node\":{\"id\":\"7\",\"title\":\"Hello\"}}}",
+      execute_to_json(executor,
+                      "query Q($skip: Boolean!) {\n"
+                      "  me: user(id: \"1\") {\n"
+                      "    ...UserFields\n"
+                      "    friends { name }\n"
+                      "    friends @skip(if: $skip) { id }\n"
+                      "    __typename\n"
+                      "  }\n"
+                      "  node(id: \"7\") {\n"
+                      "    id\n"
+                      "    ... on User { name }\n"
+                      "    ... on Post { title }\n"
+                      "  }\n"
+                      "}\n"
+                      "fragment UserFields on User { id name }\n",
+                      Value(Value::Object{{"skip", Value(true)}})));
+}
+
+/// \brief Loader of the users of <i>get_user</i>, which records the size of
+/// each batch.
+LoaderId add_user_loader(Executor& executor, std::mutex& mutex,
+                         std::vector<size_t>& batch_sizes) {
+  return executor.add_loader(
+      [&](const std::span<const Value> keys)
+          -> Task<std::vector<FieldResult>> {
+        {
+          std::lock_guard lock(mutex);
+          batch_sizes.push_back(keys.size());
+        }
+
+        std::vector<FieldResult> results;
+
+        for (const Value& key : keys) {
+          if (key.get_int() < 0) {
+            results.push_back(FieldResult::Err("Detected a missing user."));
+          } else {
+            results.push_back(FieldResult::Ok(get_user(key.get_int())));
+          }
+        }
+
+        co_return results;
+      });
+}
+
+/// \brief Resolver of a list of users known by identifier.
+Task<FieldResult> load_users(const ResolveInfo& info, const LoaderId loader,
+                             const std::vector<int64_t> ids) {
+  std::vector<Value> keys(ids.begin(), ids.end());
+  std::vector<FieldResult> results =
+      co_await info.load_many(loader, std::move(keys));
+  Value::List users;
+
+  for (FieldResult& r : results) {
+    if (!r.IsOk()) {
+      co_return r;
+    }
+
+    users.push_back(r.Unwrap());
+  }
+
+  co_return FieldResult::Ok(Value(std::move(users)));
+}
+
+TEST(ExecutorTest, Execute_BatchesLoadsPerLevel) {
+  const schema::Schema schema = compile_test_schema();
+  concurrency::ThreadPool pool = concurrency::ThreadPool(4);
+  Executor executor = Executor(schema, pool);
+  std::mutex mutex;
+  std::vector<size_t> batch_sizes;
+  const LoaderId users = add_user_loader(executor, mutex, batch_sizes);
+
+  executor.set_resolver("Query", "users", [&](const ResolveInfo& info) {
+    std::vector<int64_t> ids;
+
+    for (int64_t i = 0; i < 50; i++) {
+      ids.push_back(i);
+    }
+
+    return load_users(info, users, ids);
+  });
+  executor.set_resolver("Query", "user", [&](const ResolveInfo& info) {
+    return [](const ResolveInfo& info, const LoaderId loader)
+               -> Task<FieldResult> {
+      co_return co_await info.load(
+          loader, Value(std::stoll(info.get_argument("id")->get_string())));
+    }(info, users);
+  });
+  executor.set_resolver("User", "friends", [&](const ResolveInfo& info) {
+    const int64_t id = std::stoll(info.get_source().find("id")->get_string());
+
+    return load_users(info, users, {id + 1, id + 2});
+  });
+
+  const std::string output = execute_to_json(
+      executor,
+      "{ users { name friends { name friends { id } } } "
+      "  a: user(id: \"7\") { name } b: user(id: \"100\") { name } }");
+
+  // The 50 friend lists of a level are loaded by a single batch, which only
+  // holds the users no earlier level loaded. Sibling root fields join the
+  // first batch.
+  ASSERT_EQ((std::vector<size_t>{51, 2, 2}), batch_sizes);
+  ASSERT_NE(std::string::npos,
+            output.find("{\"name\":\"user49\",\"friends\":[{\"name\":"
+                        "\"user50\",\"friends\":[{\"id\":\"51\"},{\"id\":"
+                        "\"52\"}]},{\"name\":\"user51\""));
+  ASSERT_NE(std::string::npos,
+            output.find("\"a\":{\"name\":\"user7\"},\"b\":{\"name\":"
+                        "\"user100\"}}}"));
+}
+
+TEST(ExecutorTest, Execute_CollectsFieldErrorsWithTheirPaths) {
+  const schema::Schema schema = compile_test_schema();
+  concurrency::ThreadPool pool = concurrency::ThreadPool(2);
+  Executor executor = Executor(schema, pool);
+  std::mutex mutex;
+  std::vector<size_t> batch_sizes;
+  const LoaderId users = add_user_loader(executor, mutex, batch_sizes);
+
+  executor.set_resolver("Query", "users", [&](const ResolveInfo& info) {
+    return load_users(info, users, {0, 1});
+  });
+  executor.set_resolver("Query", "user", [](const ResolveInfo&) {
+    return []() -> Task<FieldResult> {
+      co_return FieldResult::Ok(Value(Value::Object{{"id", Value("3")}}));
+    }();
+  });
+  // The friends of user 1 include a missing user, which fails the whole
+  // list.
+  executor.set_resolver("User", "friends", [&](const ResolveInfo& info) {
+    const int64_t id = std::stoll(info.get_source().find("id")->get_string());
+
+    return load_users(info, users, {id == 1 ? -1 : id + 1});
+  });
+  executor.set_resolver("Query", "node", [](const ResolveInfo&) {
+    return []() -> Task<FieldResult> {
+      throw std::runtime_error("Detected a broken backend.");
+      co_return FieldResult::Ok(Value());
+    }();
+  });
+
+  const std::string source =
+      "{\n"
+      "  users { id friends { id } }\n"
+      "  user(id: \"3\") { name }\n"
+      "  node(id: \"1\") { id }\n"
+      "}";
+  language::parsing::Arena arena = language::parsing::Arena();
+  Result<const language::parsing::Document*, language::parsing::ParseError>
+      r = language::parsing::parse(source, arena);
+  ASSERT_TRUE(r.IsOk());
+
+  ExecutionRequest request;
+  request.document_ = r.Unwrap();
+  request.source_ = source;
+  const ExecutionResult result = executor.execute(request);
+
+  // Non-null fields make their parent null, up to the first nullable one:
+  // the failed friends null their user, and so the users list, which is
+  // non-null itself, nulls the whole data.
+  ASSERT_EQ(3, result.errors_.size());
+  ASSERT_EQ(RESOLVER_FAILED, result.errors_[0].get_code());
+  ASSERT_EQ("Detected a broken backend.", result.errors_[0].get_message());
+  ASSERT_EQ(NULL_NON_NULL_FIELD, result.errors_[1].get_code());
+  ASSERT_EQ(RESOLVER_FAILED, result.errors_[2].get_code());
+  ASSERT_EQ((std::vector<PathSegment>{"users", size_t{1}, "friends"}),
+            result.errors_[2].get_path());
+  ASSERT_TRUE(result.data_.has_value());
+  ASSERT_TRUE(result.data_->is_null());
+
+  std::string output;
+  result.errors_[2].write_json(output);
+  ASSERT_EQ(
+      "{\"message\":\"Detected a missing user.\",\"locations\":[{\"line\":2,"
+      "\"column\":14}],\"path\":[\"users\",1,\"friends\"],\"extensions\":{"
+      "\"code\":\"RESOLVER_FAILED\"}}",
+      output);
+
+  // Without the users, the nullable fields keep the rest of the data.
+  ASSERT_EQ(
+      "{\"errors\":[{\"message\":\"Detected a broken backend.\",\"locations\":"
+      "[{\"line\":3,\"column\":3}],\"path\":[\"node\"],\"extensions\":{"
+      "\"code\":\"RESOLVER_FAILED\"}},{\"message\":\"Detected a null value "
+      "for non-null field 'name'.\",\"locations\":[{\"line\":2,\"column\":"
+      "19}],\"path\":[\"user\",\"name\"],\"extensions\":{\"code\":"
+      "\"NULL_NON_NULL_FIELD\"}}],\"data\":{\"user\":null,\"node\":null}}",
+      execute_to_json(executor,
+                      "{\n"
+                      "  user(id: \"3\") { name }\n"
+                      "  node(id: \"1\") { id }\n"
+                      "}"));
+}
+
+TEST(ExecutorTest, Execute_ReportsResolversThrowingAnything) {
+  const schema::Schema schema = compile_test_schema();
+  concurrency::ThreadPool pool = concurrency::ThreadPool(2);
+  Executor executor = Executor(schema, pool);
+
+  executor.set_resolver("Query", "slow", [](const ResolveInfo&) {
+    return []() -> Task<FieldResult> {
+      throw 42;
+      co_return FieldResult::Ok(Value());
+    }();
+  });
+
+  const std::string source = "{ slow }";
+  language::parsing::Arena arena = language::parsing::Arena();
+  Result<const language::parsing::Document*, language::parsing::ParseError>
+      r = language::parsing::parse(source, arena);
+  ASSERT_TRUE(r.IsOk());
+
+  ExecutionRequest request;
+  request.document_ = r.Unwrap();
+  request.source_ = source;
+  const ExecutionResult result = executor.execute(request);
+
+  ASSERT_EQ(1, result.errors_.size());
+  ASSERT_EQ(RESOLVER_FAILED, result.errors_[0].get_code());
+  ASSERT_EQ("Detected a resolver throwing an unknown exception.",
+            result.errors_[0].get_message());
+  ASSERT_EQ((std::vector<PathSegment>{"slow"}), result.errors_[0].get_path());
+  ASSERT_TRUE(result.data_.has_value());
+  ASSERT_TRUE(result.data_->find("slow")->is_null());
+}
+
+TEST(ExecutorTest, Execute_RunsSiblingFieldsConcurrently) {
+  const schema::Schema schema = compile_test_schema();
+  concurrency::ThreadPool pool = concurrency::ThreadPool(2);
+  Executor executor = Executor(schema, pool);
+  std::atomic<size_t> started_count = 0;
+
+  // Each field waits for the other one to start, which only happens if they
+  // run at the same time.
+  const Resolver resolver = [&](const ResolveInfo&) -> Task<FieldResult> {
+    started_count++;
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    while (started_count < 2 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+
+    co_return FieldResult::Ok(Value(started_count == 2));
+  };
+
+  executor.set_resolver("Query", "slow", resolver);
+  executor.set_resolver("Query", "slower", resolver);
+
+  ASSERT_EQ("{\"data\":{\"slow\":true,\"slower\":true}}",
+            execute_to_json(executor, "{ slow slower }"));
+}
+
+TEST(ExecutorTest, Execute_RunsMutationFieldsSerially) {
+  const schema::Schema schema = compile_test_schema();
+  concurrency::ThreadPool pool = concurrency::ThreadPool(4);
+  Executor executor = Executor(schema, pool);
+  std::vector<std::string> values;
+
+  executor.set_resolver(
+      "Mutation", "append", [&](const ResolveInfo& info) -> Task<FieldResult> {
+        values.push_back(info.get_argument("value")->get_string());
+        co_return FieldResult::Ok(Value(Value::List(values.begin(),
+                                                    values.end())));
+      });
+
+  ASSERT_EQ(
+      "{\"data\":{\"a\":[\"a\"],\"b\":[\"a\",\"b\"],\"c\":[\"a\",\"b\","
+      "\"c\"]}}",
+      execute_to_json(executor,
+                      "mutation M($c: String!) { a: append(value: \"a\") "
+                      "b: append(value: \"b\") c: append(value: $c) }",
+                      Value(Value::Object{{"c", Value("c")}})));
+}
+
+TEST(ExecutorTest, Execute_ReportsRequestErrors) {
+  const schema::Schema schema = compile_test_schema();
+  concurrency::ThreadPool pool = concurrency::ThreadPool(1);
+  const Executor executor = Executor(schema, pool);
+
+  ASSERT_EQ(
+      "{\"errors\":[{\"message\":\"Detected several operations, but no "
+      "operation name.\",\"extensions\":{\"code\":\"AMBIGUOUS_OPERATION\"}}]}",
+      execute_to_json(executor, "query A { slow } query B { slow }"));
+  ASSERT_EQ(
+      "{\"errors\":[{\"message\":\"Detected no operation named 'C'.\","
+      "\"extensions\":{\"code\":\"OPERATION_NOT_FOUND\"}}]}",
+      [&]() {
+        const std::string source = "query A { slow } query B { slow }";
+        language::parsing::Arena arena = language::parsing::Arena();
+        ExecutionRequest request;
+        request.document_ = language::parsing::parse(source, arena).Unwrap();
+        request.operation_name_ = "C";
+        std::string output;
+        executor.execute(request).write_json(output);
+
+        return output;
+      }());
+  ASSERT_EQ(
+      "{\"errors\":[{\"message\":\"Detected a subscription operation, which "
+      "cannot be executed against the schema.\",\"extensions\":{\"code\":"
+      "\"UNSUPPORTED_OPERATION\"}}]}",
+      execute_to_json(executor, "subscription { slow }"));
+}
@@ -0,0 +1,118 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/execution/json_writer.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace graphqlpp;
+using namespace graphqlpp::execution;
+
+/// \brief Value exercising every kind, and every escape.
+Value get_nested_value() {
+  Value::List items;
+
+  for (int64_t i = 0; i < 50; i++) {
+    items.emplace_back(Value::Object{
+        {"id", Value(i)},
+        {"name", Value("item \"" + std::to_string(i) + "\"\n\t\x01")},
+        {"score", Value(static_cast<double>(i) / 8)},
+        {"tags",
+         Value(Value::List{Value("a\\b"), Value(), Value(i % 2 == 0)})}});
+  }
+
+  return Value(Value::Object{
+      {"items", Value(std::move(items))},
+      {"min", Value(std::numeric_limits<int64_t>::min())},
+      {"infinity", Value(std::numeric_limits<double>::infinity())},
+      {"na\"me", Value("caf\xC3\xA9")}});
+}
+
+std::string concatenate(const std::span<const std::span<const char>> segments) {
+  std::string output;
+
+  for (const std::span<const char> segment : segments) {
+    output.append(segment.data(), segment.size());
+  }
+
+  return output;
+}
+
+TEST(JsonWriterTest, WriteValue_MatchesValueWriteJson) {
+  const Value value = get_nested_value();
+  std::string expected;
+  value.write_json(expected);
+
+  for (const size_t chunk_size : {size_t{1}, size_t{33}, size_t{4096}}) {
+    JsonWriter writer = JsonWriter(chunk_size);
+    writer.write_value(value);
+
+    ASSERT_EQ(expected.size(), writer.get_size());
+    ASSERT_EQ(expected, writer.to_string());
+    ASSERT_EQ(expected, concatenate(writer.get_segments()));
+  }
+}
+
+TEST(JsonWriterTest, WriteString_RefersToLongPlainStrings) {
+  const std::string plain(JsonWriter::MINIMUM_REFERENCED_SIZE, 'a');
+  const std::string escaped = plain + "\n";
+  const Value value = Value(Value::List{Value(plain), Value(escaped)});
+  JsonWriter writer;
+
+  writer.write_value(value);
+  const std::span<const std::span<const char>> segments =
+      writer.get_segments();
+
+  ASSERT_EQ(3, segments.size());
+  ASSERT_EQ(value.get_list()[0].get_string().data(), segments[1].data());
+  ASSERT_EQ(plain.size(), segments[1].size());
+  ASSERT_EQ("[\"" + plain + "\",\"" + plain + "\\n\"]",
+            concatenate(segments));
+}
+
+TEST(JsonWriterTest, WriteError_MatchesErrorWriteJson) {
+  const language::tokenization::TokenizeError tokenize_error =
+      language::tokenization::TokenizeError(
+          language::tokenization::UNTERMINATED_STRING, 4,
+          language::tokenization::Location{.line_ = 2, .column_ = 3});
+  const ExecutionError execution_error = ExecutionError(
+      RESOLVER_FAILED, std::string(300, 'x'),
+      std::vector<PathSegment>{std::string("users"), size_t{1}}, 10,
+      language::tokenization::Location{.line_ = 1, .column_ = 11});
+  std::string expected = "{\"errors\":[";
+  tokenize_error.write_json(expected);
+  expected += "]}";
+  JsonWriter writer;
+
+  writer.write_response(std::span(&tokenize_error, 1));
+
+  ASSERT_EQ(expected, writer.to_string());
+
+  expected.clear();
+  execution_error.write_json(expected);
+  writer.clear();
+  writer.write_error(execution_error);
+
+  ASSERT_EQ(expected, writer.to_string());
+}
+
+TEST(JsonWriterTest, WriteResponse_MatchesExecutionResultWriteJson) {
+  ExecutionResult result;
+  result.data_ = get_nested_value();
+  result.errors_.emplace_back(UNDEFINED_FIELD, "missing",
+                              std::vector<PathSegment>{std::string("a")}, 0,
+                              std::nullopt);
+  std::string expected;
+  result.write_json(expected);
+  JsonWriter writer = JsonWriter(64);
+
+  // A cleared writer starts over, reusing its chunks.
+  writer.write_value(Value("discarded"));
+  writer.clear();
+  writer.write_response(result);
+
+  ASSERT_EQ(expected, concatenate(writer.get_segments()));
+}
@@ -0,0 +1,111 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/instrumentation/metrics.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "graphqlpp/language/tokenization/tokenizer.h"
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::instrumentation;
+using namespace graphqlpp::language::tokenization;
+
+static_assert(std::is_empty_v<PhaseTimer<false>>);
+
+TEST(MetricsTest, TakeSnapshot_AddsUpEveryThread) {
+  constexpr size_t THREAD_COUNT = 4;
+  constexpr size_t RECORD_COUNT = 1000;
+  const MetricsSnapshot before = take_snapshot();
+
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < THREAD_COUNT; i++) {
+    threads.emplace_back([] {
+      for (size_t j = 0; j < RECORD_COUNT; j++) {
+        add_to_counter(Counter::SERIALIZED_BYTES, 2);
+        record_duration(Phase::PARSE, 2'000);
+        record_error(Phase::EXECUTE, 3);
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  const MetricsSnapshot after = take_snapshot();
+  const DurationHistogram& durations_before =
+      before.get_durations(Phase::PARSE);
+  const DurationHistogram& durations_after =
+      after.get_durations(Phase::PARSE);
+
+  ASSERT_EQ(2 * THREAD_COUNT * RECORD_COUNT,
+            after.get_counter(Counter::SERIALIZED_BYTES) -
+                before.get_counter(Counter::SERIALIZED_BYTES));
+  ASSERT_EQ(THREAD_COUNT * RECORD_COUNT,
+            durations_after.count_ - durations_before.count_);
+  ASSERT_EQ(2'000 * THREAD_COUNT * RECORD_COUNT,
+            durations_after.sum_nanoseconds_ -
+                durations_before.sum_nanoseconds_);
+  // 2000 ns falls within the bucket bounded by 4000 ns.
+  ASSERT_EQ(THREAD_COUNT * RECORD_COUNT,
+            durations_after.bucket_counts_[1] -
+                durations_before.bucket_counts_[1]);
+  ASSERT_EQ(THREAD_COUNT * RECORD_COUNT,
+            after.get_errors(Phase::EXECUTE, 3) -
+                before.get_errors(Phase::EXECUTE, 3));
+}
+
+TEST(MetricsTest, RecordDuration_LongDurationsFallInLastBucket) {
+  const MetricsSnapshot before = take_snapshot();
+  record_duration(Phase::SERIALIZE, 5'000'000'000);
+  const MetricsSnapshot after = take_snapshot();
+
+  ASSERT_EQ(1, after.get_durations(Phase::SERIALIZE)
+                       .bucket_counts_[DURATION_BUCKET_COUNT - 1] -
+                   before.get_durations(Phase::SERIALIZE)
+                       .bucket_counts_[DURATION_BUCKET_COUNT - 1]);
+}
+
+TEST(MetricsTest, MeteredTokenize_RecordsTokensAndErrors) {
+  const MetricsSnapshot before = take_snapshot();
+  TokenBuffer tokens;
+  Result<size_t, TokenizeError> r =
+      tokenize<METERED_SIGNIFICANT_TOKENS_POLICY>("{ a, b } # c", tokens);
+  Result<size_t, TokenizeError> failed =
+      tokenize<METERED_SIGNIFICANT_TOKENS_POLICY>("{ \"a }", tokens);
+  const MetricsSnapshot after = take_snapshot();
+
+  ASSERT_TRUE(r.IsOk());
+  ASSERT_EQ(4, r.Unwrap());
+  ASSERT_FALSE(failed.IsOk());
+  ASSERT_EQ(18, after.get_counter(Counter::LEXED_BYTES) -
+                    before.get_counter(Counter::LEXED_BYTES));
+  // Scanning stops at the unterminated string, after "{" and a space.
+  ASSERT_EQ(12, after.get_counter(Counter::TOKENS) -
+                    before.get_counter(Counter::TOKENS));
+  ASSERT_EQ(7, after.get_counter(Counter::IGNORED_TOKENS) -
+                   before.get_counter(Counter::IGNORED_TOKENS));
+  ASSERT_EQ(2, after.get_durations(Phase::TOKENIZE).count_ -
+                   before.get_durations(Phase::TOKENIZE).count_);
+  ASSERT_EQ(1, after.get_errors(Phase::TOKENIZE, UNTERMINATED_STRING) -
+                   before.get_errors(Phase::TOKENIZE, UNTERMINATED_STRING));
+}
+
+TEST(MetricsTest, UnmeteredTokenize_RecordsOnlyIfEnabled) {
+  const MetricsSnapshot before = take_snapshot();
+  TokenBuffer tokens;
+  Result<size_t, TokenizeError> r =
+      tokenize<SIGNIFICANT_TOKENS_POLICY>("{ a }", tokens);
+  const MetricsSnapshot after = take_snapshot();
+
+  ASSERT_TRUE(r.IsOk());
+  ASSERT_EQ(INSTRUMENTATION_ENABLED ? 5 : 0,
+            after.get_counter(Counter::LEXED_BYTES) -
+                before.get_counter(Counter::LEXED_BYTES));
+}
@@ -0,0 +1,122 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/instrumentation/prometheus.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+#include "graphqlpp/execution/execution_error.h"
+#include "graphqlpp/instrumentation/metrics.h"
+#include "graphqlpp/language/tokenization/tokenize_error.h"
+
+using namespace graphqlpp::instrumentation;
+
+bool contains_line(const std::string& output, const std::string& line) {
+  return output.find(line + "\n") != std::string::npos;
+}
+
+size_t count_occurrences(const std::string& output,
+                         const std::string_view text) {
+  size_t count = 0;
+
+  for (size_t i = output.find(text); i != std::string::npos;
+       i = output.find(text, i + text.size())) {
+    count++;
+  }
+
+  return count;
+}
+
+TEST(PrometheusTest, WritePrometheus_WritesCounters) {
+  MetricsSnapshot snapshot = MetricsSnapshot();
+  snapshot.counters_[static_cast<size_t>(Counter::LEXED_BYTES)] = 1234;
+  snapshot.counters_[static_cast<size_t>(Counter::TOKENS)] = 56;
+
+  std::string output;
+  write_prometheus(snapshot, output);
+
+  ASSERT_TRUE(contains_line(output, "# TYPE graphqlpp_lexed_bytes_total "
+                                    "counter"));
+  ASSERT_TRUE(contains_line(output, "graphqlpp_lexed_bytes_total 1234"));
+  ASSERT_TRUE(contains_line(output, "graphqlpp_tokens_total 56"));
+  ASSERT_TRUE(contains_line(output, "graphqlpp_serialized_bytes_total 0"));
+}
+
+TEST(PrometheusTest, WritePrometheus_WritesCumulativeBuckets) {
+  MetricsSnapshot snapshot = MetricsSnapshot();
+  DurationHistogram& histogram =
+      snapshot.durations_[static_cast<size_t>(Phase::PARSE)];
+  histogram.bucket_counts_[0] = 2;
+  histogram.bucket_counts_[2] = 3;
+  histogram.bucket_counts_[DURATION_BUCKET_COUNT - 1] = 1;
+  histogram.count_ = 6;
+  histogram.sum_nanoseconds_ = 1'500'000'000;
+
+  std::string output;
+  write_prometheus(snapshot, output);
+
+  ASSERT_TRUE(contains_line(
+      output, "# TYPE graphqlpp_phase_duration_seconds histogram"));
+  ASSERT_TRUE(contains_line(
+      output,
+      "graphqlpp_phase_duration_seconds_bucket{phase=\"parse\",le=\"1e-06\"}"
+      " 2"));
+  ASSERT_TRUE(contains_line(
+      output,
+      "graphqlpp_phase_duration_seconds_bucket{phase=\"parse\",le=\"4e-06\"}"
+      " 2"));
+  ASSERT_TRUE(contains_line(
+      output,
+      "graphqlpp_phase_duration_seconds_bucket{phase=\"parse\","
+      "le=\"1.6e-05\"} 5"));
+  ASSERT_TRUE(contains_line(
+      output,
+      "graphqlpp_phase_duration_seconds_bucket{phase=\"parse\",le=\"+Inf\"}"
+      " 6"));
+  ASSERT_TRUE(contains_line(
+      output, "graphqlpp_phase_duration_seconds_sum{phase=\"parse\"} 1.5"));
+  ASSERT_TRUE(contains_line(
+      output, "graphqlpp_phase_duration_seconds_count{phase=\"parse\"} 6"));
+  ASSERT_TRUE(contains_line(
+      output, "graphqlpp_phase_duration_seconds_count{phase=\"execute\"} 0"));
+}
+
+TEST(PrometheusTest, WritePrometheus_WritesOnlyOccurredErrors) {
+  MetricsSnapshot snapshot = MetricsSnapshot();
+  snapshot.errors_[static_cast<size_t>(Phase::TOKENIZE)]
+                  [graphqlpp::language::tokenization::UNTERMINATED_STRING] = 4;
+  snapshot.errors_[static_cast<size_t>(Phase::EXECUTE)]
+                  [graphqlpp::execution::RESOLVER_FAILED] = 1;
+
+  std::string output;
+  write_prometheus(snapshot, output);
+
+  ASSERT_TRUE(contains_line(output,
+                            "graphqlpp_errors_total{phase=\"tokenize\","
+                            "code=\"UNTERMINATED_STRING\"} 4"));
+  ASSERT_TRUE(contains_line(output,
+                            "graphqlpp_errors_total{phase=\"execute\","
+                            "code=\"RESOLVER_FAILED\"} 1"));
+  ASSERT_EQ(2, count_occurrences(output, "graphqlpp_errors_total{"));
+}
+
+TEST(PrometheusTest, WritePrometheus_LabelsUntrackedCodesAsOther) {
+  const MetricsSnapshot before = take_snapshot();
+  record_error(Phase::EXECUTE, 200);
+  const MetricsSnapshot after = take_snapshot();
+
+  ASSERT_EQ(1, after.get_errors(Phase::EXECUTE, OTHER_ERROR_CODE) -
+                   before.get_errors(Phase::EXECUTE, OTHER_ERROR_CODE));
+
+  MetricsSnapshot snapshot = MetricsSnapshot();
+  snapshot.errors_[static_cast<size_t>(Phase::EXECUTE)][OTHER_ERROR_CODE] = 1;
+
+  std::string output;
+  write_prometheus(snapshot, output);
+
+  ASSERT_TRUE(contains_line(output,
+                            "graphqlpp_errors_total{phase=\"execute\","
+                            "code=\"OTHER\"} 1"));
+}
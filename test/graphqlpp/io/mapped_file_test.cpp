@@ -0,0 +1,61 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/io/mapped_file.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::io;
+
+std::string write_temporary_file(const std::string& name,
+                                 const std::string& contents) {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / name;
+  std::ofstream stream(path, std::ios::binary);
+  stream << contents;
+
+  return path.string();
+}
+
+TEST(MappedFileTest, Open_MapsContents) {
+  const std::string contents = "type Query {\r\n  a: Int\n}";
+  const std::string path =
+      write_temporary_file("graphqlpp_mapped_file_test.graphql", contents);
+
+  Result<MappedFile, std::string> r = MappedFile::open(path);
+
+  ASSERT_TRUE(r.IsOk());
+
+  MappedFile file = r.Unwrap();
+  MappedFile moved = std::move(file);
+
+  ASSERT_EQ(contents, moved.get_contents());
+  ASSERT_TRUE(file.get_contents().empty());
+
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, Open_MapsEmptyFiles) {
+  const std::string path =
+      write_temporary_file("graphqlpp_mapped_file_empty_test.graphql", "");
+
+  Result<MappedFile, std::string> r = MappedFile::open(path);
+
+  ASSERT_TRUE(r.IsOk());
+  ASSERT_TRUE(r.Unwrap().get_contents().empty());
+
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, Open_ReportsMissingFiles) {
+  Result<MappedFile, std::string> r =
+      MappedFile::open("/nonexistent/graphqlpp/schema.graphql");
+
+  ASSERT_FALSE(r.IsOk());
+  ASSERT_NE(std::string::npos, r.UnwrapErr().find("schema.graphql"));
+}
@@ -0,0 +1,236 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/analysis/query_analyzer.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::analysis;
+
+QueryMetrics analyze_or_fail(const std::string& source,
+                             const QueryAnalysisOptions& options =
+                                 QueryAnalysisOptions()) {
+  Result<QueryMetrics, QueryAnalysisError> r = analyze_query(source, options);
+
+  EXPECT_TRUE(r.IsOk());
+
+  return r.IsOk() ? r.Unwrap() : QueryMetrics{};
+}
+
+QueryAnalysisError analyze_and_fail(const std::string& source,
+                                    const QueryAnalysisOptions& options) {
+  Result<QueryMetrics, QueryAnalysisError> r = analyze_query(source, options);
+
+  EXPECT_FALSE(r.IsOk());
+
+  return r.UnwrapErr();
+}
+
+TEST(QueryAnalyzerTest, Analyze_CountsFieldsAliasesAndDepth) {
+  const QueryMetrics metrics =
+      analyze_or_fail("query Q { a { b c @skip(if: true) } d: e }");
+
+  ASSERT_EQ((QueryMetrics{
+                .depth_ = 2, .field_count_ = 4, .alias_count_ = 1, .cost_ = 4}),
+            metrics);
+}
+
+TEST(QueryAnalyzerTest, Analyze_MultipliesCostByListSizes) {
+  const QueryMetrics metrics = analyze_or_fail(
+      "{ users(first: 10) { friends(last: 5) { name } id } }");
+
+  // users + 10 * friends + 50 * name + 10 * id
+  ASSERT_EQ(71, metrics.cost_);
+  ASSERT_EQ(3, metrics.depth_);
+}
+
+TEST(QueryAnalyzerTest, Analyze_AssumesTheListSizeOfVariables) {
+  QueryAnalysisOptions options = QueryAnalysisOptions();
+  options.variable_list_size_ = 20;
+
+  const QueryMetrics metrics = analyze_or_fail(
+      "query ($n: Int = 3) { users(first: $n) { id } }", options);
+
+  ASSERT_EQ(21, metrics.cost_);
+}
+
+TEST(QueryAnalyzerTest, Analyze_IgnoresNamesWithinArgumentValues) {
+  const QueryMetrics metrics = analyze_or_fail(
+      "{ a(f: {first: 100, b: [c, {last: 2}]}) @d(first: 3) { e } }");
+
+  ASSERT_EQ((QueryMetrics{
+                .depth_ = 2, .field_count_ = 2, .alias_count_ = 0, .cost_ = 2}),
+            metrics);
+}
+
+TEST(QueryAnalyzerTest, Analyze_AppliesFieldWeights) {
+  QueryAnalysisOptions options = QueryAnalysisOptions();
+  options.field_weights_.emplace("search", 10);
+
+  const QueryMetrics metrics =
+      analyze_or_fail("{ s: search(first: 2) { id } }", options);
+
+  ASSERT_EQ(12, metrics.cost_);
+}
+
+TEST(QueryAnalyzerTest, Analyze_ExpandsFragmentSpreads) {
+  const QueryMetrics metrics = analyze_or_fail(
+      "{ a(first: 3) { ...F ... on T { d } } }\n"
+      "fragment F on T { b { c } }");
+
+  // a + 3 * (d + b + c)
+  ASSERT_EQ((QueryMetrics{.depth_ = 3,
+                         .field_count_ = 4,
+                         .alias_count_ = 0,
+                         .cost_ = 10}),
+            metrics);
+}
+
+TEST(QueryAnalyzerTest, Analyze_InlineFragmentsAddNoDepth) {
+  const QueryMetrics spread =
+      analyze_or_fail("{ a { ...F } } fragment F on T { b }");
+  const QueryMetrics conditional =
+      analyze_or_fail("{ a { ... on T { b } } }");
+  const QueryMetrics unconditional =
+      analyze_or_fail("{ a { ... @include(if: true) { ... { b } } } }");
+
+  ASSERT_EQ(2, spread.depth_);
+  ASSERT_EQ(spread.depth_, conditional.depth_);
+  ASSERT_EQ(spread.depth_, unconditional.depth_);
+}
+
+TEST(QueryAnalyzerTest, Finish_RejectsFragmentExplosions) {
+  // Every fragment spreads the next one ten times, so the last one is
+  // spread 10^30 times.
+  std::string source = "{ ...F0 }";
+
+  for (int i = 0; i < 30; i++) {
+    source += " fragment F" + std::to_string(i) + " on T {";
+
+    for (int j = 0; j < 10; j++) {
+      source += " a" + std::to_string(j) + ": a { ...F" +
+                std::to_string(i + 1) + " }";
+    }
+
+    source += " }";
+  }
+
+  source += " fragment F30 on T { b }";
+
+  QueryAnalysisOptions options = QueryAnalysisOptions();
+  options.limits_.max_fields_ = 1000000;
+
+  const QueryAnalysisError error = analyze_and_fail(source, options);
+
+  ASSERT_EQ(FIELD_LIMIT_EXCEEDED, error.get_code());
+  ASSERT_EQ(0, error.get_offset());
+}
+
+TEST(QueryAnalyzerTest, Finish_IgnoresFragmentCycles) {
+  const QueryMetrics metrics = analyze_or_fail(
+      "{ ...A } fragment A on T { a ...B } fragment B on T { b ...A }");
+
+  ASSERT_EQ(2, metrics.field_count_);
+}
+
+TEST(QueryAnalyzerTest, Feed_RejectsAsSoonAsALimitIsExceeded) {
+  QueryAnalysisOptions options = QueryAnalysisOptions();
+  options.limits_.max_aliases_ = 2;
+  QueryAnalyzer analyzer = QueryAnalyzer(options);
+
+  ASSERT_TRUE(analyzer.feed("{ a: x b: x ").IsOk());
+
+  Result<QueryMetrics, QueryAnalysisError> r = analyzer.feed("c: x d: x }");
+
+  ASSERT_FALSE(r.IsOk());
+
+  const QueryAnalysisError error = r.UnwrapErr();
+
+  ASSERT_EQ(ALIAS_LIMIT_EXCEEDED, error.get_code());
+  ASSERT_EQ(13, error.get_offset());
+  ASSERT_FALSE(analyzer.feed("e: x").IsOk());
+}
+
+TEST(QueryAnalyzerTest, Analyze_RejectsDeepQueriesBeforeLexingTheRest) {
+  QueryAnalysisOptions options = QueryAnalysisOptions();
+  options.limits_.max_depth_ = 3;
+  QueryAnalyzer analyzer = QueryAnalyzer(options);
+
+  const std::string nested = "{ a { a { a { a { a";
+
+  Result<QueryMetrics, QueryAnalysisError> r = analyzer.feed(nested);
+
+  ASSERT_FALSE(r.IsOk());
+  ASSERT_EQ(DEPTH_LIMIT_EXCEEDED, r.UnwrapErr().get_code());
+}
+
+TEST(QueryAnalyzerTest, Analyze_RejectsCostlyQueries) {
+  QueryAnalysisOptions options = QueryAnalysisOptions();
+  options.limits_.max_cost_ = 100;
+
+  const QueryAnalysisError error = analyze_and_fail(
+      "{ a(first: 10) { b(first: 10) { c } } }", options);
+
+  ASSERT_EQ(COST_LIMIT_EXCEEDED, error.get_code());
+
+  std::string json;
+  error.write_json(json);
+
+  ASSERT_EQ(
+      "{\"message\":\"Detected a query costlier than the limit of 100.\","
+      "\"extensions\":{\"code\":\"COST_LIMIT_EXCEEDED\"}}",
+      json);
+}
+
+TEST(QueryAnalyzerTest, Analyze_ReportsTokenizeErrors) {
+  const QueryAnalysisError error =
+      analyze_and_fail("{ a(b: 01) }", QueryAnalysisOptions());
+
+  ASSERT_EQ(ANALYSIS_TOKENIZE_FAILED, error.get_code());
+  ASSERT_EQ(8, error.get_offset());
+  ASSERT_EQ("Detected an invalid number, unexpected digit after 0.",
+            error.get_message());
+}
+
+TEST(QueryAnalyzerTest, Analyze_RejectsDeepArgumentValues) {
+  QueryAnalysisOptions options = QueryAnalysisOptions();
+  options.limits_.max_depth_ = 10;
+
+  const std::string source =
+      "{ a(b: " + std::string(200000, '[') + std::string(200000, ']') + ") }";
+
+  const QueryAnalysisError error = analyze_and_fail(source, options);
+
+  ASSERT_EQ(VALUE_NESTING_TOO_DEEP, error.get_code());
+  ASSERT_EQ(7 + MAX_VALUE_DEPTH, error.get_offset());
+
+  const std::string allowed = "{ a(b: " + std::string(MAX_VALUE_DEPTH, '[') +
+                              std::string(MAX_VALUE_DEPTH, ']') + ") }";
+
+  analyze_or_fail(allowed, options);
+}
+
+TEST(QueryAnalyzerTest, Analyze_RejectsUnbalancedBrackets) {
+  const QueryAnalysisOptions options = QueryAnalysisOptions();
+
+  QueryAnalysisError error = analyze_and_fail("{ a(b: ]) { c } }", options);
+
+  ASSERT_EQ(UNBALANCED_BRACKETS, error.get_code());
+  ASSERT_EQ(7, error.get_offset());
+
+  error = analyze_and_fail("{ a(b: [1}) }", options);
+
+  ASSERT_EQ(UNBALANCED_BRACKETS, error.get_code());
+  ASSERT_EQ(9, error.get_offset());
+
+  error = analyze_and_fail("{ a(b: {c: [1) }", options);
+
+  ASSERT_EQ(UNBALANCED_BRACKETS, error.get_code());
+  ASSERT_EQ(13, error.get_offset());
+  ASSERT_EQ("Detected an unbalanced bracket within arguments.",
+            error.get_message());
+}
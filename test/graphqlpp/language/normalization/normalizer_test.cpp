@@ -0,0 +1,125 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/normalization/normalizer.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "graphqlpp/language/parsing/parser.h"
+#include "graphqlpp/language/tokenization/tokenizer.h"
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::normalization;
+using graphqlpp::language::tokenization::TokenizeError;
+
+NormalizedDocument normalize_or_fail(const std::string& source,
+                                     const NormalizeOptions& options =
+                                         NormalizeOptions()) {
+  Result<NormalizedDocument, TokenizeError> r = normalize(source, options);
+
+  EXPECT_TRUE(r.IsOk());
+
+  return r.IsOk() ? r.Unwrap() : NormalizedDocument{};
+}
+
+class NormalizeTestFixture
+    : public testing::TestWithParam<std::tuple<std::string, std::string>> {};
+
+TEST_P(NormalizeTestFixture, Normalize_StripsIgnoredTokens) {
+  const auto [source, expected] = GetParam();
+
+  ASSERT_EQ(expected, normalize_or_fail(source).text_);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    NormalizeTest, NormalizeTestFixture,
+    testing::Values(
+        std::make_tuple("{ a }", "{a}"),
+        std::make_tuple("\xEF\xBB\xBF query  Q ($v: [Int!] = [1, 2,3])\n"
+                        "{\r\n  a(b: $v) @c { ...F ... on T { d } } }",
+                        "query Q($v:[Int!]=[1 2 3])"
+                        "{a(b:$v)@c{...F...on T{d}}}"),
+        std::make_tuple("# comment\n{ a(b: 1.5e3, c: \"x  y\") }",
+                        "{a(b:1.5e3 c:\"x  y\")}"),
+        std::make_tuple("fragment F on T { a, b }", "fragment F on T{a b}"),
+        std::make_tuple("", "")));
+
+TEST(NormalizeTest, Normalize_IgnoresFormatting) {
+  const NormalizedDocument a = normalize_or_fail("query { a { b } }");
+  const NormalizedDocument b =
+      normalize_or_fail("query {\n  a {\n    b,\n  }\n} # trailing");
+
+  ASSERT_EQ(a.text_, b.text_);
+  ASSERT_EQ(a.signature_, b.signature_);
+  ASSERT_EQ(compute_signature("query{a{b}}"), a.signature_);
+}
+
+TEST(NormalizeTest, Normalize_ReplacesLiterals) {
+  NormalizeOptions options = NormalizeOptions();
+  options.replace_literals_ = true;
+
+  const NormalizedDocument a = normalize_or_fail(
+      "{ a(b: 1, c: \"x\", d: [2.5 3], e: \"\"\"y\"\"\", f: ENUM, g: true) }",
+      options);
+  const NormalizedDocument b = normalize_or_fail(
+      "{ a(b: 7, c: \"z\", d: [1 0.1], e: \"\"\"w\"\"\", f: ENUM, g: true) }",
+      options);
+
+  ASSERT_EQ("{a(b:0 c:\"\"d:[0 0]e:\"\"f:ENUM g:true)}", a.text_);
+  ASSERT_EQ(a.signature_, b.signature_);
+  ASSERT_NE(normalize_or_fail("{ a(b: 1) }").signature_,
+            normalize_or_fail("{ a(b: 2) }").signature_);
+}
+
+TEST(NormalizeTest, Normalize_AcceptsFullFidelityTokens) {
+  const std::string source = "query Q { a, b }";
+  language::tokenization::TokenBuffer tokens =
+      language::tokenization::TokenBuffer();
+
+  ASSERT_TRUE(language::tokenization::tokenize(source, tokens).IsOk());
+
+  std::string output = "prefix:";
+  normalize(source, tokens, NormalizeOptions(), output);
+
+  ASSERT_EQ("prefix:query Q{a b}", output);
+}
+
+TEST(NormalizeTest, Normalize_KeepsTheDocumentReadable) {
+  NormalizeOptions options = NormalizeOptions();
+  options.replace_literals_ = true;
+  const std::string source =
+      "query ($a: Int = 1) { b(c: $a, d: -2) { e } ...F }";
+
+  const NormalizedDocument document = normalize_or_fail(source, options);
+
+  // The canonical form tokenizes back into the same significant tokens.
+  ASSERT_EQ(document.text_, normalize_or_fail(document.text_, options).text_);
+  ASSERT_TRUE(language::tokenization::tokenize(document.text_).IsOk());
+}
+
+TEST(NormalizeTest, Normalize_SeparatesAdjacentStrings) {
+  NormalizeOptions options = NormalizeOptions();
+  options.replace_literals_ = true;
+
+  const NormalizedDocument kept =
+      normalize_or_fail("{ f(a: [\"\" \"b\"], c: [\"\"\"d\"\"\" \"\"]) }");
+  const NormalizedDocument replaced =
+      normalize_or_fail("{ f(a: [\"x\" \"y\"]) }", options);
+
+  // An empty string right before another one would open a block string.
+  ASSERT_EQ("{f(a:[\"\" \"b\"]c:[\"\"\"d\"\"\" \"\"])}", kept.text_);
+  ASSERT_EQ("{f(a:[\"\" \"\"])}", replaced.text_);
+
+  for (const std::string& text : {kept.text_, replaced.text_}) {
+    language::parsing::Arena arena = language::parsing::Arena();
+
+    ASSERT_TRUE(language::parsing::parse(text, arena).IsOk()) << text;
+  }
+
+  ASSERT_NE(normalize_or_fail("{ f(a: [\"b\"]) }").signature_,
+            kept.signature_);
+  ASSERT_NE(normalize_or_fail("{ f(a: [\"x\"]) }", options).signature_,
+            replaced.signature_);
+}
@@ -0,0 +1,35 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/normalization/signature.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace graphqlpp::language::normalization;
+
+class SignatureTestFixture
+    : public testing::TestWithParam<std::tuple<std::string, std::string>> {};
+
+TEST_P(SignatureTestFixture, ComputeSignature_MatchesMurmurHash3) {
+  const auto [data, expected_hex] = GetParam();
+
+  ASSERT_EQ(expected_hex, to_hex(compute_signature(data)));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SignatureTest, SignatureTestFixture,
+    testing::Values(
+        std::make_tuple("", "00000000000000000000000000000000"),
+        std::make_tuple("hello", "5b1e906a48ae1d19cbd8a7b341bd9b02"),
+        std::make_tuple("query{a}", "8acddc9ce3c9675935c2f8ac5412549d"),
+        std::make_tuple("The quick brown fox jumps over the lazy dog",
+                        "7a433ca9c49a9347e34bbc7bbc071b6c"),
+        std::make_tuple("\x01\x02\x03\x04\x05\x06\x07\x08\t\n\x0b\x0c\r\x0e"
+                        "\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a"
+                        "\x1b\x1c\x1d\x1e\x1f",
+                        "2b46270af0ee6ef6e67d62e397513ddb")));
+
+TEST(SignatureTest, ComputeSignature_DependsOnTheSeed) {
+  ASSERT_NE(compute_signature("{a}", 0), compute_signature("{a}", 1));
+}
@@ -0,0 +1,106 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/parsing/arena.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+
+using namespace graphqlpp::language::parsing;
+
+struct alignas(32) OverAligned {
+  char value_;
+};
+
+TEST(ArenaTest, Create_InitializesObjects) {
+  Arena arena = Arena();
+
+  const int* a = arena.create<int>(1);
+  const int* b = arena.create<int>(2);
+
+  ASSERT_EQ(1, *a);
+  ASSERT_EQ(2, *b);
+  ASSERT_EQ(2 * sizeof(int), arena.get_allocated_size());
+}
+
+TEST(ArenaTest, Allocate_RespectsAlignment) {
+  Arena arena = Arena(64);
+  arena.create<char>('a');
+
+  for (size_t i = 0; i < 10; i++) {
+    const OverAligned* o = arena.create<OverAligned>('b');
+
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(o) % alignof(OverAligned));
+  }
+}
+
+TEST(ArenaTest, Allocate_ServesObjectsLargerThanTheBlockSize) {
+  Arena arena = Arena(64);
+
+  char* data = arena.allocate_array<char>(1000);
+  data[999] = 'a';
+
+  ASSERT_GE(arena.get_reserved_size(), 1000);
+}
+
+TEST(ArenaTest, Reset_KeepsTheLargestBlock) {
+  Arena arena = Arena(64);
+
+  for (size_t i = 0; i < 100; i++) {
+    arena.create<size_t>(i);
+  }
+
+  const size_t reserved_size = arena.get_reserved_size();
+  arena.reset();
+
+  ASSERT_EQ(0, arena.get_allocated_size());
+  ASSERT_LT(arena.get_reserved_size(), reserved_size);
+  ASSERT_GT(arena.get_reserved_size(), 0);
+}
+
+/// \brief Resource which counts the bytes it currently hands out.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t outstanding_ = 0;
+
+ private:
+  void* do_allocate(const size_t bytes, const size_t alignment) override {
+    outstanding_ += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, const size_t bytes,
+                     const size_t alignment) override {
+    outstanding_ -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  [[nodiscard]] bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+TEST(ArenaTest, Upstream_ProvidesAndReceivesEveryBlock) {
+  CountingResource resource;
+
+  {
+    Arena arena = Arena(64, &resource);
+
+    for (size_t i = 0; i < 100; i++) {
+      arena.allocate(48, 8);
+    }
+
+    ASSERT_GE(resource.outstanding_, arena.get_reserved_size());
+
+    arena.reset();
+
+    Arena moved = std::move(arena);
+    moved.allocate(8, 8);
+
+    ASSERT_EQ(&resource, moved.get_upstream_resource());
+  }
+
+  ASSERT_EQ(0, resource.outstanding_);
+}
@@ -0,0 +1,241 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/parsing/parser.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory_resource>
+#include <string>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::parsing;
+using graphqlpp::language::tokenization::Location;
+
+template <typename T>
+const T* as(const Node* node) {
+  return static_cast<const T*>(node);
+}
+
+const Document* parse_or_fail(const std::string& source, Arena& arena) {
+  Result<const Document*, ParseError> r = parse(source, arena);
+
+  EXPECT_TRUE(r.IsOk());
+
+  return r.IsOk() ? r.Unwrap() : nullptr;
+}
+
+TEST(ParserTest, Parse_Operation) {
+  const std::string source =
+      "query Q($id: ID!, $n: [Int] = [1, 2]) @live {\n"
+      "  u: user(id: $id, f: {a: 1.5, b: \"x\", c: \"\"\"y\"\"\"}) {\n"
+      "    name @include(if: true)\n"
+      "  }\n"
+      "}";
+  Arena arena = Arena();
+
+  const Document* document = parse_or_fail(source, arena);
+
+  ASSERT_NE(nullptr, document);
+  ASSERT_EQ(1, document->definitions_.size());
+
+  const auto* operation =
+      as<OperationDefinition>(document->definitions_.front());
+
+  ASSERT_EQ(NodeKind::OPERATION_DEFINITION, operation->kind_);
+  ASSERT_EQ(OperationType::QUERY, operation->operation_);
+  ASSERT_EQ("Q", operation->name_);
+  ASSERT_EQ(2, operation->variable_definitions_.size());
+  ASSERT_EQ("live", operation->directives_.front()->name_);
+
+  const VariableDefinition* id = operation->variable_definitions_[0];
+  const VariableDefinition* n = operation->variable_definitions_[1];
+
+  ASSERT_EQ("id", id->variable_->name_);
+  ASSERT_EQ(NodeKind::NON_NULL_TYPE, id->type_->kind_);
+  ASSERT_EQ(nullptr, id->default_value_);
+  ASSERT_EQ(NodeKind::LIST_TYPE, n->type_->kind_);
+  ASSERT_EQ(2, as<ListValue>(n->default_value_)->values_.size());
+
+  const auto* user =
+      as<Field>(operation->selection_set_->selections_.front());
+
+  ASSERT_EQ("u", user->alias_);
+  ASSERT_EQ("user", user->name_);
+  ASSERT_EQ(2, user->arguments_.size());
+  ASSERT_EQ(NodeKind::VARIABLE, user->arguments_[0]->value_->kind_);
+
+  const auto* filter = as<ObjectValue>(user->arguments_[1]->value_);
+
+  ASSERT_EQ(3, filter->fields_.size());
+  ASSERT_EQ("1.5", as<FloatValue>(filter->fields_[0]->value_)->value_);
+  ASSERT_EQ("x", as<StringValue>(filter->fields_[1]->value_)->raw_value_);
+  ASSERT_FALSE(as<StringValue>(filter->fields_[1]->value_)->block_);
+  ASSERT_FALSE(as<StringValue>(filter->fields_[1]->value_)->escaped_);
+  ASSERT_EQ("y", as<StringValue>(filter->fields_[2]->value_)->raw_value_);
+  ASSERT_TRUE(as<StringValue>(filter->fields_[2]->value_)->block_);
+
+  const auto* name = as<Field>(user->selection_set_->selections_.front());
+
+  ASSERT_EQ("name", name->name_);
+  ASSERT_EQ(nullptr, name->selection_set_);
+  ASSERT_TRUE(
+      as<BooleanValue>(name->directives_[0]->arguments_[0]->value_)->value_);
+}
+
+TEST(ParserTest, Parse_NamesReferenceTheSource) {
+  const std::string source = "{ field }";
+  Arena arena = Arena();
+
+  const Document* document = parse_or_fail(source, arena);
+  const auto* operation =
+      as<OperationDefinition>(document->definitions_.front());
+  const auto* field = as<Field>(operation->selection_set_->selections_[0]);
+
+  ASSERT_EQ(source.data() + 2, field->name_.data());
+  ASSERT_EQ(2, field->offset_);
+}
+
+TEST(ParserTest, Parse_Fragments) {
+  const std::string source =
+      "mutation { ...F ... on User @skip(if: $s) { id } ... { id } }\n"
+      "fragment F on Query { id }";
+  Arena arena = Arena();
+
+  const Document* document = parse_or_fail(source, arena);
+
+  ASSERT_EQ(2, document->definitions_.size());
+
+  const auto* operation =
+      as<OperationDefinition>(document->definitions_[0]);
+  const auto selections = operation->selection_set_->selections_;
+
+  ASSERT_EQ(OperationType::MUTATION, operation->operation_);
+  ASSERT_EQ(3, selections.size());
+  ASSERT_EQ("F", as<FragmentSpread>(selections[0])->name_);
+
+  const auto* on_user = as<InlineFragment>(selections[1]);
+
+  ASSERT_EQ("User", on_user->type_condition_->name_);
+  ASSERT_EQ("skip", on_user->directives_[0]->name_);
+  ASSERT_EQ(nullptr, as<InlineFragment>(selections[2])->type_condition_);
+
+  const auto* fragment = as<FragmentDefinition>(document->definitions_[1]);
+
+  ASSERT_EQ(NodeKind::FRAGMENT_DEFINITION, fragment->kind_);
+  ASSERT_EQ("F", fragment->name_);
+  ASSERT_EQ("Query", fragment->type_condition_->name_);
+}
+
+class ParseErrorTestFixture
+    : public testing::TestWithParam<std::tuple<std::string, size_t, size_t>> {
+};
+
+TEST_P(ParseErrorTestFixture, Parse_ReportsErrorLocation) {
+  const auto [source, line, column] = GetParam();
+  Arena arena = Arena();
+
+  Result<const Document*, ParseError> r = parse(source, arena);
+
+  ASSERT_FALSE(r.IsOk());
+
+  std::vector<Location> locations = r.UnwrapErr().get_locations().value();
+
+  ASSERT_EQ(1, locations.size());
+  ASSERT_EQ(line, locations.at(0).line_);
+  ASSERT_EQ(column, locations.at(0).column_);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ParseErrorTest, ParseErrorTestFixture,
+    testing::Values(std::make_tuple("", 1, 1),
+                    std::make_tuple("{ a }\ntype T { a: Int }", 2, 1),
+                    std::make_tuple("{ a(b: ) }", 1, 8),
+                    std::make_tuple("query ($v: Int = $w) { a }", 1, 18),
+                    std::make_tuple("fragment on on T { a }", 1, 10),
+                    std::make_tuple("{ a {", 1, 6),
+                    std::make_tuple("query ($v: String = \"\"\"\nb\"\"\"", 2, 5),
+                    std::make_tuple("{ a \"unterminated }", 1, 20)));
+
+TEST(ParserTest, Parse_DescribesTheUnexpectedToken) {
+  Arena arena = Arena();
+
+  Result<const Document*, ParseError> r = parse("{ a(b: ) }", arena);
+
+  ASSERT_EQ("Detected an unexpected token, expected a value.",
+            r.UnwrapErr().get_message());
+}
+
+/// \brief Operation whose selection sets are nested <i>depth</i> levels.
+std::string nest_selection_sets(const size_t depth) {
+  std::string source;
+
+  for (size_t i = 0; i < depth; i++) {
+    source += i == 0 ? "{" : "a{";
+  }
+
+  return source + "a" + std::string(depth, '}');
+}
+
+void expect_nesting_too_deep(const std::string& source) {
+  Arena arena = Arena();
+
+  Result<const Document*, ParseError> r = parse(source, arena);
+
+  ASSERT_FALSE(r.IsOk());
+  ASSERT_EQ(NESTING_TOO_DEEP, r.UnwrapErr().get_code());
+}
+
+TEST(ParserTest, Parse_AcceptsNestingUpToTheLimit) {
+  Arena arena = Arena();
+
+  ASSERT_TRUE(parse(nest_selection_sets(MAX_NESTING_DEPTH), arena).IsOk());
+  expect_nesting_too_deep(nest_selection_sets(MAX_NESTING_DEPTH + 1));
+}
+
+TEST(ParserTest, Parse_RejectsDeepSelectionSets) {
+  expect_nesting_too_deep(nest_selection_sets(200000));
+}
+
+TEST(ParserTest, Parse_RejectsDeepListValues) {
+  constexpr size_t DEPTH = 200000;
+
+  expect_nesting_too_deep("{ a(b: " + std::string(DEPTH, '[') +
+                          std::string(DEPTH, ']') + ") }");
+}
+
+TEST(ParserTest, Parse_RejectsDeepObjectValues) {
+  std::string source = "{ a(b: ";
+
+  for (size_t i = 0; i < 200000; i++) {
+    source += "{c:";
+  }
+
+  expect_nesting_too_deep(source);
+}
+
+TEST(ParserTest, Parse_RejectsDeepListTypes) {
+  constexpr size_t DEPTH = 200000;
+
+  expect_nesting_too_deep("query ($v: " + std::string(DEPTH, '[') + "Int" +
+                          std::string(DEPTH, ']') + ") { a }");
+}
+
+TEST(ParserTest, Parse_AllocatesOnlyFromTheArenaUpstream) {
+  // The request-scoped resource cannot fall back to the heap, so parsing
+  // throws if anything bypasses it.
+  std::array<std::byte, 64 * 1024> memory{};
+  std::pmr::monotonic_buffer_resource resource(
+      memory.data(), memory.size(), std::pmr::null_memory_resource());
+  Arena arena = Arena(Arena::DEFAULT_BLOCK_SIZE, &resource);
+
+  Result<const Document*, ParseError> r =
+      parse("query Q($id: ID!) { user(id: $id) { ...F } }\n"
+            "fragment F on User { name friends(first: 10) { name } }",
+            arena);
+
+  ASSERT_TRUE(r.IsOk());
+  ASSERT_EQ(2, r.Unwrap()->definitions_.size());
+}
@@ -0,0 +1,86 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/tokenization/character_class.h"
+
+#include <graphqlpp/language/tokenization/tokenizer.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::tokenization;
+
+static_assert(classify(U'a') == LETTER_CLASS);
+static_assert(classify(U'E') == EXPONENT_CLASS);
+static_assert(classify(U'\U0000FEFF') == OTHER_CLASS);
+static_assert(NUMBER_TRANSITIONS[NUMBER_ZERO][DIGIT_CLASS] ==
+              LEADING_ZERO_ERROR);
+
+class ClassifyTestFixture
+    : public testing::TestWithParam<std::tuple<char32_t, CharacterClass>> {};
+
+TEST_P(ClassifyTestFixture, Classify_ReturnsLexicalClass) {
+  const auto [character, expected_class] = GetParam();
+
+  ASSERT_EQ(expected_class, classify(character));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ClassifyTest, ClassifyTestFixture,
+    testing::Values(std::make_tuple(U'\t', WHITESPACE_CLASS),
+                    std::make_tuple(U'\r', LINE_TERMINATOR_CLASS),
+                    std::make_tuple(U'#', COMMENT_CLASS),
+                    std::make_tuple(U',', COMMA_CLASS),
+                    std::make_tuple(U'|', PUNCTUATOR_CLASS),
+                    std::make_tuple(U'.', DOT_CLASS),
+                    std::make_tuple(U'"', QUOTE_CLASS),
+                    std::make_tuple(U'-', MINUS_CLASS),
+                    std::make_tuple(U'+', PLUS_CLASS),
+                    std::make_tuple(U'0', ZERO_CLASS),
+                    std::make_tuple(U'9', DIGIT_CLASS),
+                    std::make_tuple(U'e', EXPONENT_CLASS),
+                    std::make_tuple(U'_', LETTER_CLASS),
+                    std::make_tuple(U'?', OTHER_CLASS),
+                    std::make_tuple(U'\U000000E9', OTHER_CLASS)));
+
+class NumberAutomatonTestFixture
+    : public testing::TestWithParam<std::tuple<std::string, TokenType>> {};
+
+TEST_P(NumberAutomatonTestFixture, Tokenize_ScansWholeNumber) {
+  const auto [source, expected_type] = GetParam();
+
+  Result<std::vector<Token>, TokenizeError> r = tokenize(source);
+
+  ASSERT_TRUE(r.IsOk());
+
+  std::vector<Token> tokens = r.Unwrap();
+
+  ASSERT_EQ(1, tokens.size());
+  ASSERT_EQ(expected_type, tokens.at(0).type_);
+  ASSERT_EQ(source.size(), tokens.at(0).length_);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    NumberAutomatonTest, NumberAutomatonTestFixture,
+    testing::Values(std::make_tuple("0", INT_VALUE),
+                    std::make_tuple("-0", INT_VALUE),
+                    std::make_tuple("1234567890", INT_VALUE),
+                    std::make_tuple("0.0", FLOAT_VALUE),
+                    std::make_tuple("-0e0", FLOAT_VALUE),
+                    std::make_tuple("10.01E+10", FLOAT_VALUE),
+                    std::make_tuple("9e-09", FLOAT_VALUE)));
+
+TEST(NumberAutomatonTest, Tokenize_EndsNumbersAtPunctuators) {
+  Result<std::vector<Token>, TokenizeError> r = tokenize("[1,-2.5]");
+
+  ASSERT_TRUE(r.IsOk());
+
+  std::vector<Token> tokens = r.Unwrap();
+
+  ASSERT_EQ(5, tokens.size());
+  ASSERT_EQ(INT_VALUE, tokens.at(1).type_);
+  ASSERT_EQ(FLOAT_VALUE, tokens.at(3).type_);
+  ASSERT_EQ(4, tokens.at(3).length_);
+}
@@ -0,0 +1,205 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/tokenization/incremental_tokenizer.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "graphqlpp/language/tokenization/tokenizer.h"
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::tokenization;
+
+/// \brief Replaces a range of a document and applies the same edit to the
+/// tokenizer.
+Result<size_t, TokenizeError> edit(IncrementalTokenizer& tokenizer,
+                                   std::string& source, const size_t offset,
+                                   const size_t deleted_length,
+                                   const std::string& inserted) {
+  source.replace(offset, deleted_length, inserted);
+
+  return tokenizer.apply_edit(
+      source, TextEdit{.offset_ = offset,
+                       .deleted_length_ = deleted_length,
+                       .inserted_length_ = inserted.size()});
+}
+
+/// \brief Checks that the tokenizer agrees with a full tokenization of the
+/// document, both on its tokens and on its error.
+void expect_same_as_tokenize(const IncrementalTokenizer& tokenizer,
+                             Result<size_t, TokenizeError>& r,
+                             const std::string& source) {
+  Result<std::vector<Token>, TokenizeError> expected = tokenize(source);
+
+  ASSERT_EQ(expected.IsOk(), r.IsOk()) << source;
+  ASSERT_EQ(expected.IsOk(), tokenizer.is_valid());
+
+  if (expected.IsOk()) {
+    ASSERT_EQ(expected.Unwrap(), tokenizer.get_tokens()) << source;
+  } else {
+    ASSERT_EQ(expected.UnwrapErr(), r.UnwrapErr()) << source;
+  }
+}
+
+TEST(IncrementalTokenizerTest, Reset_MatchesTokenize) {
+  const std::string source = "query Q($a: Int = 1) { f(b: \"c\") # d\n}";
+  IncrementalTokenizer tokenizer = IncrementalTokenizer();
+
+  Result<size_t, TokenizeError> r = tokenizer.reset(source);
+
+  ASSERT_TRUE(r.IsOk());
+  ASSERT_EQ(tokenizer.size(), r.Unwrap());
+  expect_same_as_tokenize(tokenizer, r, source);
+}
+
+TEST(IncrementalTokenizerTest, ApplyEdit_OnlyLexesTheAffectedTokens) {
+  std::string source = "{ a b c d e f g h i j }";
+  IncrementalTokenizer tokenizer = IncrementalTokenizer();
+  ASSERT_TRUE(tokenizer.reset(source).IsOk());
+
+  Result<size_t, TokenizeError> r = edit(tokenizer, source, 10, 0, "x");
+
+  ASSERT_TRUE(r.IsOk());
+  // "dx" and the whitespace after it, where lexing resynchronizes.
+  ASSERT_EQ(2, r.Unwrap());
+  expect_same_as_tokenize(tokenizer, r, source);
+}
+
+TEST(IncrementalTokenizerTest, ApplyEdit_MergesTokens) {
+  std::string source = "{ ab cd }";
+  IncrementalTokenizer tokenizer = IncrementalTokenizer();
+  ASSERT_TRUE(tokenizer.reset(source).IsOk());
+
+  Result<size_t, TokenizeError> r = edit(tokenizer, source, 4, 1, "");
+
+  expect_same_as_tokenize(tokenizer, r, source);
+  ASSERT_EQ("abcd", tokenizer.get(2).get_value(source));
+}
+
+TEST(IncrementalTokenizerTest, ApplyEdit_OpeningStringRelexesTheRest) {
+  std::string source = "{ a b c }";
+  IncrementalTokenizer tokenizer = IncrementalTokenizer();
+  ASSERT_TRUE(tokenizer.reset(source).IsOk());
+
+  Result<size_t, TokenizeError> r = edit(tokenizer, source, 2, 0, "\"");
+  expect_same_as_tokenize(tokenizer, r, source);
+  ASSERT_FALSE(tokenizer.is_valid());
+
+  r = edit(tokenizer, source, 8, 0, "\"");
+  expect_same_as_tokenize(tokenizer, r, source);
+  ASSERT_EQ(STRING_VALUE, tokenizer.get(2).type_);
+}
+
+TEST(IncrementalTokenizerTest, ApplyEdit_RecoversAfterFailedEdits) {
+  std::string source = "{ a(b: 1) }";
+  IncrementalTokenizer tokenizer = IncrementalTokenizer();
+  ASSERT_TRUE(tokenizer.reset(source).IsOk());
+
+  Result<size_t, TokenizeError> r = edit(tokenizer, source, 7, 0, "0");
+  expect_same_as_tokenize(tokenizer, r, source);
+  ASSERT_EQ(INVALID_NUMBER_LEADING_ZERO, r.UnwrapErr().get_code());
+
+  r = edit(tokenizer, source, 0, 0, "\x01");
+  expect_same_as_tokenize(tokenizer, r, source);
+  ASSERT_EQ(INVALID_CHARACTER, r.UnwrapErr().get_code());
+
+  r = edit(tokenizer, source, 0, 1, "");
+  expect_same_as_tokenize(tokenizer, r, source);
+
+  r = edit(tokenizer, source, 7, 1, "");
+  expect_same_as_tokenize(tokenizer, r, source);
+  ASSERT_TRUE(tokenizer.is_valid());
+}
+
+TEST(IncrementalTokenizerTest, ApplyEdit_ReportsCharactersSplitByTheEdit) {
+  std::string source = "\"caf\xC3\xA9\"";
+  IncrementalTokenizer tokenizer = IncrementalTokenizer();
+  ASSERT_TRUE(tokenizer.reset(source).IsOk());
+
+  Result<size_t, TokenizeError> r = edit(tokenizer, source, 5, 0, "x");
+
+  expect_same_as_tokenize(tokenizer, r, source);
+  ASSERT_EQ(MALFORMED_UTF8, r.UnwrapErr().get_code());
+}
+
+TEST(IncrementalTokenizerTest, ApplyEdit_MismatchedEditStartsOver) {
+  IncrementalTokenizer tokenizer = IncrementalTokenizer();
+  ASSERT_TRUE(tokenizer.reset("{ a }").IsOk());
+
+  const std::string source = "{ b c }";
+  Result<size_t, TokenizeError> r = tokenizer.apply_edit(
+      source,
+      TextEdit{.offset_ = 2, .deleted_length_ = 1, .inserted_length_ = 1});
+
+  expect_same_as_tokenize(tokenizer, r, source);
+}
+
+TEST(IncrementalTokenizerTest, ApplyEdit_RandomEditsMatchTokenize) {
+  const std::vector<std::string> fragments = {
+      " ",     "\n",   "\r",  ",",    "{",      "}",  "(",   ")",
+      ":",     "$",    "!",   "@",    "...",    ".",  "a",   "bc",
+      "_d1",   "0",    "12",  "-3",   "4.5",    "e6", "\"",  "\"\"\"",
+      "\\",    "\\n",  "#",   "# x\n", "\xC3\xA9", "\xC3", "\x01", "\t"};
+  const std::string initial =
+      "query Q($v: [Int!] = [1, -2.5e3]) @d {\n"
+      "  a: f(s: \"x\\\"y\", b: \"\"\"block \\\"\"\" \"\"\") { ...F }\n"
+      "  # comment\r\n  g\n}\nfragment F on T { h(c: \"\xC3\xA9\", d: 0) }\n";
+  std::mt19937 random(20240917);
+  std::string source = initial;
+  std::string valid_source = initial;
+  IncrementalTokenizer tokenizer = IncrementalTokenizer();
+  ASSERT_TRUE(tokenizer.reset(source).IsOk());
+
+  for (size_t i = 0; i < 3000; i++) {
+    if (source.size() > 4 * initial.size()) {
+      source = initial;
+      ASSERT_TRUE(tokenizer.reset(source).IsOk());
+    }
+
+    const size_t offset = random() % (source.size() + 1);
+    const size_t deleted_length =
+        std::min<size_t>(random() % 4, source.size() - offset);
+    std::string inserted;
+
+    for (size_t j = random() % 3; j > 0; j--) {
+      inserted += fragments[random() % fragments.size()];
+    }
+
+    Result<size_t, TokenizeError> r =
+        edit(tokenizer, source, offset, deleted_length, inserted);
+    expect_same_as_tokenize(tokenizer, r, source);
+
+    if (tokenizer.is_valid()) {
+      valid_source = source;
+      continue;
+    }
+
+    // Most failed edits are undone, as an editor user would, by a single
+    // edit spanning every difference with the last valid document.
+    if (random() % 4 != 0) {
+      size_t prefix = 0;
+      size_t suffix = 0;
+
+      while (prefix < std::min(source.size(), valid_source.size()) &&
+             source[prefix] == valid_source[prefix]) {
+        prefix++;
+      }
+
+      while (suffix < std::min(source.size(), valid_source.size()) - prefix &&
+             source[source.size() - suffix - 1] ==
+                 valid_source[valid_source.size() - suffix - 1]) {
+        suffix++;
+      }
+
+      r = edit(tokenizer, source, prefix, source.size() - prefix - suffix,
+               valid_source.substr(
+                   prefix, valid_source.size() - prefix - suffix));
+      expect_same_as_tokenize(tokenizer, r, source);
+      ASSERT_TRUE(tokenizer.is_valid());
+    }
+  }
+}
@@ -0,0 +1,184 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/tokenization/lexer.h"
+
+#include <graphqlpp/language/tokenization/tokenizer.h>
+#include <gtest/gtest.h>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::tokenization;
+
+const std::string LEXER_SOURCE =
+    "\xEF\xBB\xBFquery Q($id: ID! = \"caf\xC3\xA9\") {\r\n"
+    "  # comment \xE2\x82\xAC\r"
+    "  user(id: $id, n: -12.5e3) { ...F @d }\n"
+    "  \"\"\"block\r\n\\\"\"\" \xE2\x82\xAC\"\"\"\r\n"
+    "}";
+
+/// \brief Feeds the source in chunks of the given size and collects every
+/// token together with its value.
+std::vector<std::pair<Token, std::string>> lex_in_chunks(
+    const std::string& source, const size_t chunk_size) {
+  std::vector<std::pair<Token, std::string>> tokens;
+  Lexer lexer = Lexer();
+
+  const auto drain = [&]() {
+    while (true) {
+      Result<std::optional<Token>, TokenizeError> r = lexer.next();
+      EXPECT_TRUE(r.IsOk());
+
+      std::optional<Token> token = r.Unwrap();
+
+      if (!token.has_value()) {
+        return;
+      }
+
+      tokens.emplace_back(token.value(),
+                          std::string(lexer.get_value(token.value())));
+    }
+  };
+
+  for (size_t i = 0; i < source.size(); i += chunk_size) {
+    lexer.feed(std::string_view(source).substr(i, chunk_size));
+    drain();
+  }
+
+  lexer.finish();
+  drain();
+
+  EXPECT_TRUE(lexer.is_done());
+
+  return tokens;
+}
+
+class LexerChunkSizeTestFixture : public testing::TestWithParam<size_t> {};
+
+TEST_P(LexerChunkSizeTestFixture, Next_MatchesTokenize) {
+  Result<std::vector<Token>, TokenizeError> r = tokenize(LEXER_SOURCE);
+
+  ASSERT_TRUE(r.IsOk());
+
+  std::vector<Token> expected_tokens = r.Unwrap();
+  std::vector<std::pair<Token, std::string>> tokens =
+      lex_in_chunks(LEXER_SOURCE, GetParam());
+
+  ASSERT_EQ(expected_tokens.size(), tokens.size());
+
+  for (size_t i = 0; i < tokens.size(); i++) {
+    ASSERT_EQ(expected_tokens.at(i), tokens.at(i).first);
+    ASSERT_EQ(expected_tokens.at(i).get_value(LEXER_SOURCE),
+              tokens.at(i).second);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(ChunkSizeTest, LexerChunkSizeTestFixture,
+                         testing::Values(1, 2, 3, 5, 7, 16, 1024));
+
+TEST(LexerTest, Next_CarriageReturnAndNewLineSplitAcrossChunks) {
+  Lexer lexer = Lexer();
+  lexer.feed("a\r");
+
+  ASSERT_EQ(NAME, lexer.next().Unwrap().value().type_);
+  ASSERT_FALSE(lexer.next().Unwrap().has_value());
+
+  lexer.feed("\nb");
+  lexer.finish();
+
+  Token line_terminator = lexer.next().Unwrap().value();
+
+  ASSERT_EQ(LINE_TERMINATOR, line_terminator.type_);
+  ASSERT_EQ(2, line_terminator.length_);
+
+  Token name = lexer.next().Unwrap().value();
+
+  ASSERT_EQ(3, name.offset_);
+  ASSERT_EQ("b", lexer.get_value(name));
+  ASSERT_FALSE(lexer.next().Unwrap().has_value());
+  ASSERT_TRUE(lexer.is_done());
+}
+
+TEST(LexerTest, Next_RetainsOnlyThePartialToken) {
+  constexpr size_t chunk_size = 64;
+  std::string chunk;
+
+  while (chunk.size() < chunk_size) {
+    chunk += "field ";
+  }
+
+  chunk.resize(chunk_size);
+
+  Lexer lexer = Lexer();
+  size_t token_count = 0;
+
+  for (size_t i = 0; i < 10000; i++) {
+    lexer.feed(chunk);
+
+    while (lexer.next().Unwrap().has_value()) {
+      token_count++;
+    }
+
+    ASSERT_LE(lexer.get_buffered_size(), 2 * chunk_size);
+  }
+
+  ASSERT_GT(token_count, 10000);
+}
+
+TEST(LexerTest, Next_ReportsTruncatedUtf8AtTheEnd) {
+  Lexer lexer = Lexer();
+  lexer.feed("a,\xE2\x82");
+
+  ASSERT_EQ(NAME, lexer.next().Unwrap().value().type_);
+  ASSERT_EQ(COMMA, lexer.next().Unwrap().value().type_);
+  ASSERT_FALSE(lexer.next().Unwrap().has_value());
+
+  lexer.finish();
+
+  Result<std::optional<Token>, TokenizeError> r = lexer.next();
+
+  ASSERT_FALSE(r.IsOk());
+
+  std::vector<Location> locations = r.UnwrapErr().get_locations().value();
+
+  ASSERT_EQ(1, locations.at(0).line_);
+  ASSERT_EQ(3, locations.at(0).column_);
+}
+
+TEST(LexerTest, Next_LocatesErrorsAfterDiscardedChunks) {
+  Lexer lexer = Lexer();
+
+  for (const std::string_view chunk : {"ab\r", "\n\"\xC3\xA9", "\" d", "e ?"}) {
+    lexer.feed(chunk);
+
+    while (true) {
+      Result<std::optional<Token>, TokenizeError> r = lexer.next();
+
+      if (!r.IsOk() || !r.Unwrap().has_value()) {
+        break;
+      }
+    }
+  }
+
+  Result<std::optional<Token>, TokenizeError> r = lexer.next();
+
+  ASSERT_FALSE(r.IsOk());
+
+  std::vector<Location> locations = r.UnwrapErr().get_locations().value();
+
+  ASSERT_EQ(2, locations.at(0).line_);
+  ASSERT_EQ(8, locations.at(0).column_);
+}
+
+TEST(LexerTest, Next_ReportsUnterminatedStringOnFinish) {
+  Lexer lexer = Lexer();
+  lexer.feed("\"abc");
+
+  ASSERT_FALSE(lexer.next().Unwrap().has_value());
+
+  lexer.finish();
+
+  ASSERT_FALSE(lexer.next().IsOk());
+  ASSERT_FALSE(lexer.next().IsOk());
+  ASSERT_FALSE(lexer.is_done());
+}
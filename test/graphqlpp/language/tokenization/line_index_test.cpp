@@ -0,0 +1,54 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/tokenization/line_index.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace graphqlpp::language::tokenization;
+
+class LineIndexTestFixture
+    : public testing::TestWithParam<std::tuple<std::string, size_t, Location>> {
+};
+
+TEST_P(LineIndexTestFixture, GetLocation_MatchesLineTerminators) {
+  const auto [source, offset, expected_location] = GetParam();
+
+  ASSERT_EQ(expected_location, LineIndex(source).get_location(offset));
+  ASSERT_EQ(expected_location, locate(std::string_view(source), offset));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    LineIndexTest, LineIndexTestFixture,
+    testing::Values(
+        std::make_tuple("", 0, Location{.line_ = 1, .column_ = 1}),
+        std::make_tuple("abc", 2, Location{.line_ = 1, .column_ = 3}),
+        std::make_tuple("a\nb", 2, Location{.line_ = 2, .column_ = 1}),
+        std::make_tuple("a\rb", 2, Location{.line_ = 2, .column_ = 1}),
+        std::make_tuple("a\r\nb", 3, Location{.line_ = 2, .column_ = 1}),
+        std::make_tuple("a\r\n\r\n\n\rb", 7,
+                        Location{.line_ = 5, .column_ = 1}),
+        std::make_tuple("a\n", 2, Location{.line_ = 2, .column_ = 1}),
+        std::make_tuple("\xC3\xA9\xE2\x82\xAC\n\xF0\x9F\x98\x80x", 10,
+                        Location{.line_ = 2, .column_ = 2}),
+        std::make_tuple("caf\xC3\xA9 a", 6,
+                        Location{.line_ = 1, .column_ = 6})));
+
+TEST(LineIndexTest, GetLineStart_ReturnsEveryLineStart) {
+  const LineIndex index = LineIndex("a\r\nbc\rd\n");
+
+  ASSERT_EQ(4, index.get_line_count());
+  ASSERT_EQ(0, index.get_line_start(1));
+  ASSERT_EQ(3, index.get_line_start(2));
+  ASSERT_EQ(6, index.get_line_start(3));
+  ASSERT_EQ(8, index.get_line_start(4));
+}
+
+TEST(LineIndexTest, GetLocation_CountsUtf32Characters) {
+  const std::u32string source = U"\uABCD\U0001F600\r\n\uFEFFa";
+  const Utf32LineIndex index = Utf32LineIndex(source);
+
+  ASSERT_EQ((Location{.line_ = 1, .column_ = 3}), index.get_location(2));
+  ASSERT_EQ((Location{.line_ = 2, .column_ = 2}), index.get_location(5));
+}
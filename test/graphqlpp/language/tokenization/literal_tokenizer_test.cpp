@@ -0,0 +1,87 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/tokenization/literal_tokenizer.h"
+
+#include <gtest/gtest.h>
+
+#include <string_view>
+#include <vector>
+
+#include "graphqlpp/language/parsing/parser.h"
+#include "graphqlpp/language/tokenization/tokenizer.h"
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::tokenization;
+
+constexpr auto USERS_QUERY = GRAPHQLPP_GQL(
+    "query Users($first: Int = 10) {\r\n"
+    "  users(first: $first) { id name(format: \"caf\xC3\xA9\\n\") } # done\n"
+    "}");
+
+static_assert(USERS_QUERY.tokens_.size() == 28);
+static_assert(USERS_QUERY.tokens_[0].type_ == NAME &&
+              USERS_QUERY.tokens_[0].length_ == 5);
+static_assert(is_source_character_valid(U'\t') &&
+              !is_source_character_valid(U'\U0001F600'));
+static_assert(is_token_type_ignored(COMMA) && !is_token_type_ignored(NAME));
+static_assert(are_brackets_balanced("{ a(b: [1]) }",
+                                    GRAPHQLPP_GQL("{ a(b: [1]) }").tokens_));
+
+/// \brief Tokenizes a source within a constant expression.
+/// \return The error the tokenizer failed with, or the amount of tokens.
+constexpr Result<size_t, TokenizeError> tokenize_constant(
+    const std::string_view source) {
+  TokenCounter counter;
+
+  return tokenize_source<SIGNIFICANT_TOKENS_POLICY>(Utf8Source(source),
+                                                    counter);
+}
+
+static_assert(tokenize_constant("{ a \"b }").UnwrapErr() ==
+              TokenizeError(UNTERMINATED_STRING, 8,
+                            Location{.line_ = 1, .column_ = 9}));
+static_assert(tokenize_constant("{\r\n  a: 01 }").UnwrapErr() ==
+              TokenizeError(INVALID_NUMBER_LEADING_ZERO, 9,
+                            Location{.line_ = 2, .column_ = 7}));
+static_assert(tokenize_constant("\xC3\xA9\xFF").UnwrapErr() ==
+              TokenizeError(MALFORMED_UTF8, 2,
+                            Location{.line_ = 1, .column_ = 2}));
+
+TEST(LiteralTokenizerTest, TokenizeLiteral_MatchesTokenize) {
+  TokenBuffer expected;
+  Result<size_t, TokenizeError> r = tokenize<SIGNIFICANT_TOKENS_POLICY>(
+      USERS_QUERY.source_, expected);
+
+  ASSERT_TRUE(r.IsOk());
+  ASSERT_EQ(expected.size(), USERS_QUERY.tokens_.size());
+
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ(expected[i].to_token(), USERS_QUERY.tokens_[i]);
+  }
+}
+
+TEST(LiteralTokenizerTest, TokenizeLiteral_ErrorsMatchTokenize) {
+  for (const std::string_view source :
+       {"{ a \"b }", "{\r\n  a: 01 }", "\xC3\xA9\xFF", "{ a }\n# \x01"}) {
+    TokenBuffer tokens;
+    Result<size_t, TokenizeError> expected =
+        tokenize<SIGNIFICANT_TOKENS_POLICY>(source, tokens);
+    Result<size_t, TokenizeError> actual = tokenize_constant(source);
+
+    ASSERT_FALSE(actual.IsOk());
+    ASSERT_EQ(expected.UnwrapErr(), actual.UnwrapErr());
+  }
+}
+
+TEST(LiteralTokenizerTest, AppendTo_ParsesLiteral) {
+  TokenBuffer tokens;
+  language::parsing::Arena arena;
+  USERS_QUERY.tokens_.append_to(tokens);
+
+  Result<const language::parsing::Document*, language::parsing::ParseError>
+      r = language::parsing::parse(USERS_QUERY.source_, tokens, arena);
+
+  ASSERT_TRUE(r.IsOk());
+  ASSERT_EQ(1, r.Unwrap()->definitions_.size());
+}
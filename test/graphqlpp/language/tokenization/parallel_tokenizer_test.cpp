@@ -0,0 +1,90 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/tokenization/parallel_tokenizer.h"
+
+#include <graphqlpp/language/tokenization/tokenizer.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::concurrency;
+using namespace graphqlpp::language::tokenization;
+
+/// \brief Schema of at least the given size, full of the constructs which
+/// contain line terminators or characters starting other constructs.
+std::string create_large_schema(const size_t minimum_size) {
+  std::string schema;
+
+  for (size_t i = 0; schema.size() < minimum_size; i++) {
+    const std::string index = std::to_string(i);
+
+    schema += "\"\"\"\nType " + index + " with a \\\"\"\" quote,\r\n";
+    schema += "a # hash and a \" quote.\n\n\"\"\"\r\n";
+    schema += "type T" + index + " { # comment with \" and \"\"\"\r";
+    schema += "  f(a: String = \"x\\\"\\n# y\"): [Int!]! \"caf\xC3\xA9\"\n";
+    schema += "}\n";
+  }
+
+  return schema;
+}
+
+void expect_same_tokens(const TokenBuffer& expected,
+                        const TokenBuffer& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ(expected[i].to_token(), actual[i].to_token());
+  }
+}
+
+TEST(ParallelTokenizerTest, TokenizeParallel_MatchesTokenize) {
+  const std::string source =
+      create_large_schema(8 * MINIMUM_PARALLEL_CHUNK_SIZE);
+  ThreadPool pool = ThreadPool(4);
+  TokenBuffer expected = TokenBuffer();
+  TokenBuffer actual = TokenBuffer();
+
+  ASSERT_TRUE(tokenize(source, expected).IsOk());
+
+  Result<size_t, TokenizeError> r = tokenize_parallel(source, actual, pool);
+
+  ASSERT_TRUE(r.IsOk());
+  ASSERT_EQ(expected.size(), r.Unwrap());
+  expect_same_tokens(expected, actual);
+}
+
+TEST(ParallelTokenizerTest, TokenizeParallel_ReportsTheSameError) {
+  std::string source = create_large_schema(8 * MINIMUM_PARALLEL_CHUNK_SIZE);
+  source.insert(source.size() / 2, "?");
+  source.insert(source.size() / 3, "\xF0\x9F\x98\x80");
+  ThreadPool pool = ThreadPool(4);
+  TokenBuffer tokens = TokenBuffer();
+
+  Result<size_t, TokenizeError> expected = tokenize(source, tokens);
+  Result<size_t, TokenizeError> actual =
+      tokenize_parallel(source, tokens, pool);
+
+  ASSERT_FALSE(actual.IsOk());
+
+  TokenizeError expected_error = expected.UnwrapErr();
+  TokenizeError actual_error = actual.UnwrapErr();
+
+  ASSERT_EQ(expected_error.get_message(), actual_error.get_message());
+  ASSERT_EQ(expected_error.get_locations().value().at(0).line_,
+            actual_error.get_locations().value().at(0).line_);
+  ASSERT_EQ(expected_error.get_locations().value().at(0).column_,
+            actual_error.get_locations().value().at(0).column_);
+}
+
+TEST(ParallelTokenizerTest, FindSplitOffsets_SplitsOutsideOfBlockStrings) {
+  const std::string source =
+      "\"\"\"\na\n\\\"\"\"\nb\n\"\"\"\nc\n# \"\nd\n\"\\\"\"\ne";
+
+  const std::vector<size_t> offsets = find_split_offsets(source, 100);
+
+  ASSERT_EQ((std::vector<size_t>{0, 17, 19, 23, 25, 30, source.size()}),
+            offsets);
+}
@@ -0,0 +1,162 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/tokenization/source_scan.h"
+
+#include <graphqlpp/language/tokenization/tokenizer.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::tokenization;
+
+constexpr size_t SOURCE_LENGTH = 100;
+
+class SourceScanTestFixture : public testing::TestWithParam<ScanLevel> {
+ protected:
+  void SetUp() override {
+    if (!is_scan_level_supported(GetParam())) {
+      GTEST_SKIP() << "Scan level not supported by this CPU.";
+    }
+  }
+};
+
+TEST_P(SourceScanTestFixture, FindInvalidSourceCharacter_MatchesScalar) {
+  for (size_t position = 0; position < SOURCE_LENGTH; position++) {
+    std::u32string source(SOURCE_LENGTH, U'a');
+    source[position] = U'\U0001FFFF';
+
+    ASSERT_EQ(position, find_invalid_source_character(source, GetParam()));
+
+    source[position] = U'\U00000001';
+
+    ASSERT_EQ(position, find_invalid_source_character(source, GetParam()));
+  }
+
+  const std::u32string valid = U"\t\r\n \U0000FFFF query { a }\t\r\n";
+
+  ASSERT_EQ(valid.size(), find_invalid_source_character(valid, GetParam()));
+}
+
+TEST_P(SourceScanTestFixture, FindNonAsciiOrInvalidByte_MatchesScalar) {
+  for (size_t position = 0; position < SOURCE_LENGTH; position++) {
+    std::string source(SOURCE_LENGTH, 'a');
+    source[position] = '\xC3';
+
+    ASSERT_EQ(position, find_non_ascii_or_invalid_byte(source, GetParam()));
+
+    source[position] = '\x1F';
+
+    ASSERT_EQ(position, find_non_ascii_or_invalid_byte(source, GetParam()));
+
+    source[position] = '\t';
+
+    ASSERT_EQ(SOURCE_LENGTH,
+              find_non_ascii_or_invalid_byte(source, GetParam()));
+  }
+}
+
+TEST_P(SourceScanTestFixture, FindLineTerminator_MatchesScalar) {
+  for (size_t position = 0; position < SOURCE_LENGTH; position++) {
+    std::string utf8_source(SOURCE_LENGTH, 'a');
+    std::u32string utf32_source(SOURCE_LENGTH, U'a');
+    utf8_source[position] = position % 2 == 0 ? '\n' : '\r';
+    utf32_source[position] = position % 2 == 0 ? NEW_LINE : CARRIAGE_RETURN;
+
+    ASSERT_EQ(position, find_line_terminator(utf8_source, GetParam()));
+    ASSERT_EQ(position, find_line_terminator(utf32_source, GetParam()));
+  }
+}
+
+TEST_P(SourceScanTestFixture, FindNonWhitespace_MatchesScalar) {
+  for (size_t position = 0; position < SOURCE_LENGTH; position++) {
+    std::string utf8_source(SOURCE_LENGTH, ' ');
+    std::u32string utf32_source(SOURCE_LENGTH, TAB);
+    utf8_source[position] = 'a';
+    utf32_source[position] = U'a';
+
+    ASSERT_EQ(position, find_non_whitespace(utf8_source, GetParam()));
+    ASSERT_EQ(position, find_non_whitespace(utf32_source, GetParam()));
+  }
+}
+
+TEST_P(SourceScanTestFixture, FindStructuralByte_MatchesScalar) {
+  for (const char structural : {'"', '\\', '#', '\n', '\r'}) {
+    for (size_t position = 0; position < SOURCE_LENGTH; position++) {
+      std::string source(SOURCE_LENGTH, 'a');
+      source[position] = structural;
+
+      ASSERT_EQ(position, find_structural_byte(source, GetParam()));
+    }
+  }
+
+  const std::string plain = "query { a(b: 1, c: $d) @e { ...f } }\t";
+
+  ASSERT_EQ(plain.size(), find_structural_byte(plain, GetParam()));
+}
+
+TEST_P(SourceScanTestFixture, FindJsonEscapeByte_MatchesScalar) {
+  for (const char escaped : {'"', '\\', '\x01', '\x1F'}) {
+    for (size_t position = 0; position < SOURCE_LENGTH; position++) {
+      std::string value(SOURCE_LENGTH, 'a');
+      value[position] = escaped;
+
+      ASSERT_EQ(position, find_json_escape_byte(value, GetParam()));
+    }
+  }
+
+  const std::string plain = "caf\xC3\xA9 \xF0\x9F\x98\x80 ~ \x7F <a/>";
+
+  ASSERT_EQ(plain.size(), find_json_escape_byte(plain, GetParam()));
+}
+
+INSTANTIATE_TEST_SUITE_P(SourceScanTest, SourceScanTestFixture,
+                         testing::Values(SCALAR, SSE4_2, AVX2));
+
+TEST(SourceScanTest, Tokenize_ReportsInvalidCharacterAfterBulkScannedText) {
+  std::string source = "# " + std::string(70, 'c') + "\n" +
+                       std::string(40, ' ') + "\xF0\x9F\x98\x80";
+
+  Result<std::vector<Token>, TokenizeError> r = tokenize(source);
+
+  ASSERT_FALSE(r.IsOk());
+
+  std::vector<Location> locations = r.UnwrapErr().get_locations().value();
+
+  ASSERT_EQ(2, locations.at(0).line_);
+  ASSERT_EQ(41, locations.at(0).column_);
+}
+
+TEST(SourceScanTest, Tokenize_DetectsWhitespaceAndComments) {
+  const std::string source = "\t  # caf\xC3\xA9\r\n  ";
+
+  Result<std::vector<Token>, TokenizeError> r = tokenize(source);
+
+  ASSERT_TRUE(r.IsOk());
+
+  std::vector<Token> tokens = r.Unwrap();
+
+  ASSERT_EQ(4, tokens.size());
+  ASSERT_EQ((Token{.type_ = WHITESPACE,
+                   .ignored_ = true,
+                   .offset_ = 0,
+                   .length_ = 3}),
+            tokens.at(0));
+  ASSERT_EQ((Token{.type_ = COMMENT,
+                   .ignored_ = true,
+                   .offset_ = 3,
+                   .length_ = 7}),
+            tokens.at(1));
+  ASSERT_EQ((Token{.type_ = LINE_TERMINATOR,
+                   .ignored_ = true,
+                   .offset_ = 10,
+                   .length_ = 2}),
+            tokens.at(2));
+  ASSERT_EQ((Token{.type_ = WHITESPACE,
+                   .ignored_ = true,
+                   .offset_ = 12,
+                   .length_ = 2}),
+            tokens.at(3));
+}
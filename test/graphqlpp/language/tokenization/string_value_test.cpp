@@ -0,0 +1,135 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/tokenization/string_value.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "graphqlpp/language/tokenization/source_scan.h"
+#include "graphqlpp/language/tokenization/tokenizer.h"
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::tokenization;
+
+/// \brief Tokenizes a document made of a single string and returns its
+/// value.
+std::string get_value(const std::string& source) {
+  Result<std::vector<Token>, TokenizeError> r = tokenize(source);
+  EXPECT_TRUE(r.IsOk());
+
+  const std::vector<Token> tokens = r.Unwrap();
+  EXPECT_EQ(1, tokens.size());
+
+  std::string storage;
+
+  return std::string(get_string_value(tokens[0].get_value(source),
+                                      tokens[0].escaped_, storage));
+}
+
+class StringValueTestFixture : public testing::TestWithParam<ScanLevel> {
+ protected:
+  void SetUp() override {
+    if (!is_scan_level_supported(GetParam())) {
+      GTEST_SKIP() << "Scan level not supported by this CPU.";
+    }
+  }
+
+  [[nodiscard]] std::string decode(const std::string& raw_value) const {
+    std::string output;
+    decode_string(raw_value, output, GetParam());
+
+    return output;
+  }
+
+  [[nodiscard]] std::string decode_block(const std::string& raw_value) const {
+    std::string output;
+    decode_block_string(raw_value, output, GetParam());
+
+    return output;
+  }
+};
+
+TEST_P(StringValueTestFixture, DecodeString_ReplacesEscapeSequences) {
+  ASSERT_EQ("a\"b\\c/d\be\ff\ng\rh\ti",
+            decode("a\\\"b\\\\c\\/d\\be\\ff\\ng\\rh\\ti"));
+  ASSERT_EQ("# not a comment", decode("# not a comment"));
+}
+
+TEST_P(StringValueTestFixture, DecodeString_DecodesUnicodeEscapes) {
+  ASSERT_EQ("A\xC3\xA9\xE2\x82\xAC", decode("\\u0041\\u00e9\\u20AC"));
+  ASSERT_EQ("\xF0\x9F\x98\x80", decode("\\u{1F600}"));
+  ASSERT_EQ("\xF0\x9F\x98\x80", decode("\\uD83D\\uDE00"));
+  ASSERT_EQ("\xF0\x9F\x98\x80" "a", decode("\\uD83D\\uDE00a"));
+}
+
+TEST_P(StringValueTestFixture, DecodeString_CopiesLongRunsAroundEscapes) {
+  const std::string run(100, 'x');
+
+  ASSERT_EQ(run + "\n" + run + "\"", decode(run + "\\n" + run + "\\\""));
+}
+
+TEST_P(StringValueTestFixture, DecodeBlockString_StripsCommonIndentation) {
+  ASSERT_EQ("Hello,\n  World!\n\nYours,\n  GraphQL.",
+            decode_block("\n    Hello,\n      World!\n\n    Yours,\n"
+                         "      GraphQL.\n  "));
+  ASSERT_EQ("first\nsecond\n third",
+            decode_block("first\r\n  second\r   third"));
+}
+
+TEST_P(StringValueTestFixture, DecodeBlockString_RemovesBlankLines) {
+  ASSERT_EQ("", decode_block(" \n\t\n  "));
+  // Blank lines between others only lose the common indentation.
+  ASSERT_EQ("a\n \nb", decode_block("  \n  a\n   \n  b\n\t\n"));
+}
+
+TEST_P(StringValueTestFixture, DecodeBlockString_UnescapesTripleQuotes) {
+  ASSERT_EQ("say \"\"\" and \\\"\"\"",
+            decode_block("say \\\"\"\" and \\\\\"\"\""));
+}
+
+INSTANTIATE_TEST_SUITE_P(StringValueTest, StringValueTestFixture,
+                         testing::Values(SCALAR, SSE4_2, AVX2));
+
+TEST(StringValueTest, Tokenize_OnlyFlagsStringsWhichNeedDecoding) {
+  const std::string source =
+      "\"plain\" \"esc\\n\" \"\"\"one line\"\"\" \"\"\"two\nlines\"\"\" "
+      "\"\"\"  \"\"\" name";
+  Result<std::vector<Token>, TokenizeError> r = tokenize(source);
+  ASSERT_TRUE(r.IsOk());
+
+  std::vector<bool> escaped;
+
+  for (const Token& token : r.Unwrap()) {
+    if (!token.ignored_) {
+      escaped.push_back(token.escaped_);
+    }
+  }
+
+  ASSERT_EQ((std::vector<bool>{false, true, false, true, true, false}),
+            escaped);
+}
+
+TEST(StringValueTest, GetStringValue_ViewsStringsWithoutEscapes) {
+  const std::string source = "\"pass through\"";
+  Result<std::vector<Token>, TokenizeError> r = tokenize(source);
+  ASSERT_TRUE(r.IsOk());
+
+  const Token token = r.Unwrap()[0];
+  std::string storage;
+  const std::string_view value =
+      get_string_value(token.get_value(source), token.escaped_, storage);
+
+  ASSERT_EQ("pass through", value);
+  ASSERT_EQ(source.data() + 1, value.data());
+  ASSERT_TRUE(storage.empty());
+}
+
+TEST(StringValueTest, GetStringValue_DecodesFlaggedStrings) {
+  ASSERT_EQ("a\tb", get_value("\"a\\tb\""));
+  ASSERT_EQ("", get_value("\"\"\"   \"\"\""));
+  ASSERT_EQ("a\nb", get_value("\"\"\"\n    a\n    b\n\"\"\""));
+  ASSERT_EQ("", get_value("\"\""));
+}
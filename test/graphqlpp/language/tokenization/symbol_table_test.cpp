@@ -0,0 +1,99 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/tokenization/symbol_table.h"
+
+#include <graphqlpp/language/tokenization/tokenizer.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::tokenization;
+
+TEST(SymbolTableTest, Constructor_SeedsKeywords) {
+  SymbolTable table = SymbolTable();
+
+  ASSERT_EQ(KEYWORD_SYMBOL_COUNT, table.size());
+  ASSERT_EQ(QUERY_SYMBOL, table.intern("query"));
+  ASSERT_EQ(ON_SYMBOL, table.find("on").value());
+  ASSERT_EQ("repeatable", table.get_name(REPEATABLE_SYMBOL));
+}
+
+TEST(SymbolTableTest, Constructor_SeedsGivenNames) {
+  const std::string_view names[] = {"User", "id", "User"};
+  SymbolTable table = SymbolTable(names);
+
+  ASSERT_EQ(KEYWORD_SYMBOL_COUNT + 2, table.size());
+  ASSERT_EQ(KEYWORD_SYMBOL_COUNT, table.find("User").value());
+}
+
+TEST(SymbolTableTest, Intern_StoresEachNameOnce) {
+  SymbolTable table = SymbolTable();
+  std::string name = "field";
+
+  const Symbol symbol = table.intern(name);
+  name = "other";
+
+  ASSERT_EQ(symbol, table.intern("field"));
+  ASSERT_NE(symbol, table.intern(name));
+  ASSERT_EQ("field", table.get_name(symbol));
+  ASSERT_FALSE(table.find("missing").has_value());
+}
+
+TEST(SymbolTableTest, InternNames_InternsOnlyNameTokens) {
+  const std::string source = "query { a b: a, on }";
+  TokenBuffer tokens = TokenBuffer();
+  ASSERT_TRUE(tokenize(source, tokens).IsOk());
+  SymbolTable table = SymbolTable();
+
+  const std::vector<Symbol> symbols = intern_names(source, tokens, table);
+
+  std::vector<Symbol> name_symbols;
+
+  for (size_t i = 0; i < tokens.size(); i++) {
+    if (tokens.get_type(i) == NAME) {
+      name_symbols.push_back(symbols[i]);
+    } else {
+      ASSERT_EQ(NO_SYMBOL, symbols[i]);
+    }
+  }
+
+  ASSERT_EQ(5, name_symbols.size());
+  ASSERT_EQ(QUERY_SYMBOL, name_symbols[0]);
+  ASSERT_EQ(name_symbols[1], name_symbols[3]);
+  ASSERT_EQ(ON_SYMBOL, name_symbols[4]);
+  ASSERT_EQ(KEYWORD_SYMBOL_COUNT + 2, table.size());
+}
+
+TEST(SymbolTableTest, Intern_SupportsConcurrentCallers) {
+  constexpr size_t thread_count = 8;
+  constexpr size_t name_count = 1000;
+  SymbolTable table = SymbolTable();
+  std::vector<std::vector<Symbol>> symbols(thread_count);
+  std::vector<std::thread> threads;
+
+  for (size_t t = 0; t < thread_count; t++) {
+    threads.emplace_back([&table, &symbols, t]() {
+      for (size_t i = 0; i < name_count; i++) {
+        symbols[t].push_back(table.intern("name" + std::to_string(i)));
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(KEYWORD_SYMBOL_COUNT + name_count, table.size());
+
+  for (size_t t = 1; t < thread_count; t++) {
+    ASSERT_EQ(symbols[0], symbols[t]);
+  }
+
+  for (size_t i = 0; i < name_count; i++) {
+    ASSERT_EQ("name" + std::to_string(i), table.get_name(symbols[0][i]));
+  }
+}
@@ -0,0 +1,112 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/tokenization/token_buffer.h"
+
+#include <graphqlpp/language/tokenization/tokenizer.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory_resource>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::tokenization;
+
+Token create_token(const size_t i) {
+  return Token{.type_ = i % 2 == 0 ? LINE_TERMINATOR : PUNCTUATOR,
+               .ignored_ = i % 2 == 0,
+               .offset_ = i * 3,
+               .length_ = i + 1};
+}
+
+TEST(TokenBufferTest, PushBack_KeepsTokensAcrossGrowth) {
+  constexpr size_t token_count = 100;
+  TokenBuffer buffer = TokenBuffer();
+
+  for (size_t i = 0; i < token_count; i++) {
+    buffer.push_back(create_token(i));
+  }
+
+  ASSERT_EQ(token_count, buffer.size());
+
+  for (size_t i = 0; i < token_count; i++) {
+    ASSERT_EQ(create_token(i), buffer[i].to_token());
+  }
+}
+
+TEST(TokenBufferTest, Reserve_DoesNotShrink) {
+  TokenBuffer buffer = TokenBuffer(64);
+
+  buffer.reserve(8);
+
+  ASSERT_EQ(64, buffer.capacity());
+  ASSERT_TRUE(buffer.empty());
+}
+
+TEST(TokenBufferTest, Iterator_VisitsEveryTokenInOrder) {
+  TokenBuffer buffer = TokenBuffer();
+
+  for (size_t i = 0; i < 5; i++) {
+    buffer.push_back(create_token(i));
+  }
+
+  size_t i = 0;
+
+  for (const TokenView token : buffer) {
+    ASSERT_EQ(i, token.get_index());
+    ASSERT_EQ(create_token(i).offset_, token.get_offset());
+    i++;
+  }
+
+  ASSERT_EQ(5, i);
+  ASSERT_EQ(5, buffer.end() - buffer.begin());
+}
+
+TEST(TokenBufferTest, Move_TransfersTokens) {
+  TokenBuffer buffer = TokenBuffer();
+  buffer.push_back(create_token(0));
+
+  TokenBuffer moved = std::move(buffer);
+
+  ASSERT_EQ(1, moved.size());
+  ASSERT_EQ(create_token(0), moved[0].to_token());
+}
+
+TEST(TokenBufferTest, Tokenize_FillsBufferLikeVector) {
+  const std::string source = "a\r\nb\rc\n\n";
+
+  TokenBuffer buffer = TokenBuffer();
+  Result<size_t, TokenizeError> buffer_result = tokenize(source, buffer);
+  Result<std::vector<Token>, TokenizeError> vector_result = tokenize(source);
+
+  ASSERT_TRUE(buffer_result.IsOk());
+  ASSERT_TRUE(vector_result.IsOk());
+
+  std::vector<Token> tokens = vector_result.Unwrap();
+
+  ASSERT_EQ(tokens.size(), buffer_result.Unwrap());
+  ASSERT_EQ(tokens.size(), buffer.size());
+
+  for (size_t i = 0; i < tokens.size(); i++) {
+    ASSERT_EQ(tokens.at(i), buffer[i].to_token());
+    ASSERT_EQ(tokens.at(i).get_value(source), buffer[i].get_value(source));
+  }
+}
+
+TEST(TokenBufferTest, MemoryResource_BacksTheStorage) {
+  std::array<std::byte, 16 * 1024> memory{};
+  std::pmr::monotonic_buffer_resource resource(
+      memory.data(), memory.size(), std::pmr::null_memory_resource());
+  TokenBuffer buffer = TokenBuffer(&resource);
+
+  for (size_t i = 0; i < 100; i++) {
+    buffer.push_back(create_token(i));
+  }
+
+  TokenBuffer moved = std::move(buffer);
+
+  ASSERT_EQ(&resource, moved.get_memory_resource());
+  ASSERT_EQ(100, moved.size());
+  ASSERT_EQ(create_token(99), moved[99].to_token());
+}
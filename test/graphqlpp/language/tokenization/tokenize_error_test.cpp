@@ -0,0 +1,173 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/language/tokenization/tokenize_error.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "graphqlpp/language/parsing/arena.h"
+#include "graphqlpp/language/parsing/parser.h"
+#include "graphqlpp/language/tokenization/tokenizer.h"
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::language::tokenization;
+
+TEST(TokenizeErrorTest, Tokenize_ReportsCodeAndOffset) {
+  Result<std::vector<Token>, TokenizeError> r = tokenize("{ a(b: 01) }");
+
+  ASSERT_FALSE(r.IsOk());
+
+  const TokenizeError error = r.UnwrapErr();
+
+  ASSERT_EQ(INVALID_NUMBER_LEADING_ZERO, error.get_code());
+  ASSERT_EQ(8, error.get_offset());
+  ASSERT_EQ((Location{.line_ = 1, .column_ = 9}), error.get_location());
+  ASSERT_EQ("Detected an invalid number, unexpected digit after 0.",
+            error.get_message());
+}
+
+TEST(TokenizeErrorTest, Tokenize_RejectsLoneEscapedSurrogates) {
+  for (const std::string source : {"\"\\uD800\"", "\"\\uDFFF\"",
+                                   "\"\\uD83D\\u0041\""}) {
+    Result<std::vector<Token>, TokenizeError> r = tokenize(source);
+
+    ASSERT_FALSE(r.IsOk()) << source;
+    ASSERT_EQ(INVALID_ESCAPE_SEQUENCE, r.UnwrapErr().get_code()) << source;
+    ASSERT_EQ(1, r.UnwrapErr().get_offset()) << source;
+  }
+}
+
+TEST(TokenizeErrorTest, WriteJson_FollowsTheResponseFormat) {
+  const TokenizeError error =
+      TokenizeError(UNTERMINATED_STRING, 4, Location{.line_ = 2, .column_ = 3});
+  std::string json;
+
+  error.write_json(json);
+
+  ASSERT_EQ(
+      "{\"message\":\"Detected an unterminated string.\","
+      "\"locations\":[{\"line\":2,\"column\":3}],"
+      "\"extensions\":{\"code\":\"UNTERMINATED_STRING\"}}",
+      json);
+}
+
+TEST(TokenizeErrorTest, AppendJsonString_EscapesSpecialCharacters) {
+  std::string json;
+
+  append_json_string("a\"b\\c\nd\x01", json);
+
+  ASSERT_EQ("\"a\\\"b\\\\c\\nd\\u0001\"", json);
+}
+
+TEST(TokenizeErrorTest, ParseError_WritesJsonWithItsOwnCode) {
+  language::parsing::Arena arena = language::parsing::Arena();
+
+  Result<const language::parsing::Document*, language::parsing::ParseError> r =
+      language::parsing::parse("{ a(b: ) }", arena);
+
+  ASSERT_FALSE(r.IsOk());
+
+  std::string json;
+  r.UnwrapErr().write_json(json);
+
+  ASSERT_EQ(
+      "{\"message\":\"Detected an unexpected token, expected a value.\","
+      "\"locations\":[{\"line\":1,\"column\":8}],"
+      "\"extensions\":{\"code\":\"UNEXPECTED_TOKEN\"}}",
+      json);
+}
+
+TEST(TokenizeErrorTest, TokenizeCollectingErrors_ReportsEveryError) {
+  const std::string source =
+      "{ a(b: 01, c: \"\\q\" d: \"e\x01\")\n  ? f(g: 1.) \"h }";
+  TokenBuffer tokens = TokenBuffer();
+
+  Result<size_t, std::vector<TokenizeError>> r =
+      tokenize_collecting_errors(source, tokens);
+
+  ASSERT_FALSE(r.IsOk());
+
+  const std::vector<TokenizeError> errors = r.UnwrapErr();
+  const std::vector<TokenizeErrorCode> expected_codes = {
+      INVALID_NUMBER_LEADING_ZERO, INVALID_ESCAPE_SEQUENCE, INVALID_CHARACTER,
+      UNEXPECTED_CHARACTER,        INVALID_NUMBER_EXPECTED_DIGIT,
+      UNTERMINATED_STRING};
+
+  ASSERT_EQ(expected_codes.size(), errors.size());
+
+  for (size_t i = 0; i < errors.size(); i++) {
+    ASSERT_EQ(expected_codes[i], errors[i].get_code()) << i;
+  }
+
+  ASSERT_EQ((Location{.line_ = 2, .column_ = 3}), errors[3].get_location());
+  ASSERT_EQ(source.size(), errors[5].get_offset());
+}
+
+TEST(TokenizeErrorTest, TokenizeCollectingErrors_ReportsInvalidCharactersOnce) {
+  const std::string source = "a \x01 \"b\x02\" \xFF c";
+  TokenBuffer tokens = TokenBuffer();
+
+  Result<size_t, std::vector<TokenizeError>> r =
+      tokenize_collecting_errors(source, tokens);
+
+  ASSERT_FALSE(r.IsOk());
+
+  const std::vector<TokenizeError> errors = r.UnwrapErr();
+
+  ASSERT_EQ(3, errors.size());
+  ASSERT_EQ((TokenizeError(INVALID_CHARACTER, 2, Location{1, 3})), errors[0]);
+  ASSERT_EQ((TokenizeError(INVALID_CHARACTER, 6, Location{1, 7})), errors[1]);
+  ASSERT_EQ((TokenizeError(MALFORMED_UTF8, 9, Location{1, 10})), errors[2]);
+}
+
+TEST(TokenizeErrorTest, TokenizeCollectingErrors_StopsAtTheCap) {
+  const std::string source = "? ? ? ? ?";
+  TokenBuffer tokens = TokenBuffer();
+
+  Result<size_t, std::vector<TokenizeError>> r =
+      tokenize_collecting_errors(source, tokens, 2);
+
+  ASSERT_FALSE(r.IsOk());
+
+  const std::vector<TokenizeError> errors = r.UnwrapErr();
+
+  ASSERT_EQ(2, errors.size());
+  ASSERT_EQ(2, errors[1].get_offset());
+}
+
+TEST(TokenizeErrorTest, TokenizeCollectingErrors_ReportsAnErrorWithoutCap) {
+  const std::string source = "{ \x01 }";
+  TokenBuffer tokens = TokenBuffer();
+
+  Result<size_t, std::vector<TokenizeError>> r =
+      tokenize_collecting_errors(source, tokens, 0);
+
+  ASSERT_FALSE(r.IsOk());
+
+  const std::vector<TokenizeError> errors = r.UnwrapErr();
+
+  ASSERT_EQ(1, errors.size());
+  ASSERT_EQ((TokenizeError(INVALID_CHARACTER, 2, Location{1, 3})), errors[0]);
+}
+
+TEST(TokenizeErrorTest, TokenizeCollectingErrors_MatchesTokenizeWhenValid) {
+  const std::string source = "query { a(b: \"c\") }";
+  TokenBuffer expected_tokens = TokenBuffer();
+  TokenBuffer actual_tokens = TokenBuffer();
+
+  ASSERT_TRUE(tokenize(source, expected_tokens).IsOk());
+
+  Result<size_t, std::vector<TokenizeError>> r =
+      tokenize_collecting_errors(source, actual_tokens);
+
+  ASSERT_TRUE(r.IsOk());
+  ASSERT_EQ(expected_tokens.size(), r.Unwrap());
+  ASSERT_EQ(expected_tokens.size(), actual_tokens.size());
+
+  for (size_t i = 0; i < expected_tokens.size(); i++) {
+    ASSERT_EQ(expected_tokens[i].to_token(), actual_tokens[i].to_token());
+  }
+}
@@ -3,6 +3,10 @@
 #include <graphqlpp/language/tokenization/tokenizer.h>
 #include <gtest/gtest.h>
 
+#include <array>
+#include <memory_resource>
+
+#include "graphqlpp/language/tokenization/line_index.h"
 #include "graphqlpp/language/tokenization/tokenize_error.h"
 #include "graphqlpp/result.h"
 
@@ -36,8 +40,8 @@ TEST_P(TokenizeDetectIllegalCharactersTestFixture,
 
   ASSERT_FALSE(r.IsOk());
 
-  std::unique_ptr<TokenizeError> e = r.UnwrapErr();
-  std::optional<std::vector<Location>> o = e->get_locations();
+  TokenizeError e = r.UnwrapErr();
+  std::optional<std::vector<Location>> o = e.get_locations();
 
   ASSERT_TRUE(o.has_value());
 
@@ -68,27 +72,36 @@ INSTANTIATE_TEST_SUITE_P(
                         2, 1)));
 
 class TokenizeDetectLineTerminatorsTestFixture
-    : public testing::TestWithParam<
-          std::tuple<std::vector<char32_t>, std::vector<Token>>> {};
+    : public testing::TestWithParam<std::tuple<
+          std::vector<char32_t>, std::vector<Token>, std::vector<Location>>> {
+};
 
 TEST_P(TokenizeDetectLineTerminatorsTestFixture,
        Tokenize_DetectLineTerminators) {
-  const auto [source, expected_tokens] = GetParam();
+  const auto [source, expected_tokens, expected_locations] = GetParam();
 
   Result<std::vector<Token>, TokenizeError> r = tokenize(source);
 
   ASSERT_TRUE(r.IsOk());
 
-  std::unique_ptr<std::vector<Token>> tokens = r.Unwrap();
+  std::vector<Token> tokens = r.Unwrap();
 
-  ASSERT_EQ(expected_tokens.size(), tokens->size());
+  ASSERT_EQ(expected_tokens.size(), tokens.size());
 
   for (size_t i = 0; i < expected_tokens.size(); i++) {
     Token expected_token = expected_tokens.at(i);
-    Token token = tokens->at(i);
+    Token token = tokens.at(i);
 
     ASSERT_EQ(expected_token, token);
   }
+
+  const Utf32LineIndex index =
+      Utf32LineIndex(std::u32string_view(source.data(), source.size()));
+
+  for (size_t i = 0; i < expected_locations.size(); i++) {
+    ASSERT_EQ(expected_locations.at(i),
+              index.get_location(tokens.at(i).offset_));
+  }
 }
 
 INSTANTIATE_TEST_SUITE_P(
@@ -97,21 +110,21 @@ INSTANTIATE_TEST_SUITE_P(
         std::vector<char32_t>{CARRIAGE_RETURN, NEW_LINE, CARRIAGE_RETURN,
                               NEW_LINE, CARRIAGE_RETURN, NEW_LINE},
         std::vector<Token>{
-            Token{.value_ = std::vector<char32_t>{CARRIAGE_RETURN, NEW_LINE},
-                  .type_ = TokenType::LINE_TERMINATOR,
+            Token{.type_ = TokenType::LINE_TERMINATOR,
                   .ignored_ = true,
-                  .line_ = 1,
-                  .column_ = 1},
-            Token{.value_ = std::vector<char32_t>{CARRIAGE_RETURN, NEW_LINE},
-                  .type_ = TokenType::LINE_TERMINATOR,
+                  .offset_ = 0,
+                  .length_ = 2},
+            Token{.type_ = TokenType::LINE_TERMINATOR,
                   .ignored_ = true,
-                  .line_ = 2,
-                  .column_ = 1},
-            Token{.value_ = std::vector<char32_t>{CARRIAGE_RETURN, NEW_LINE},
-                  .type_ = TokenType::LINE_TERMINATOR,
+                  .offset_ = 2,
+                  .length_ = 2},
+            Token{.type_ = TokenType::LINE_TERMINATOR,
                   .ignored_ = true,
-                  .line_ = 3,
-                  .column_ = 1}})));
+                  .offset_ = 4,
+                  .length_ = 2}},
+        std::vector<Location>{Location{.line_ = 1, .column_ = 1},
+                              Location{.line_ = 2, .column_ = 1},
+                              Location{.line_ = 3, .column_ = 1}})));
 
 class IsTokenTypeIgnoredTestFixture
     : public testing::TestWithParam<std::tuple<TokenType, bool>> {};
@@ -147,12 +160,12 @@ TEST_P(TokenizeDetectPunctuatorTestFixture,
 
   ASSERT_TRUE(r.IsOk());
 
-  std::unique_ptr<std::vector<Token>> tokens = r.Unwrap();
+  std::vector<Token> tokens = r.Unwrap();
 
-  ASSERT_EQ(expected_tokens.size(), tokens->size());
+  ASSERT_EQ(expected_tokens.size(), tokens.size());
 
   for (size_t i = 0; i < expected_tokens.size(); i++) {
-    ASSERT_EQ(expected_tokens.at(i), tokens->at(i));
+    ASSERT_EQ(expected_tokens.at(i), tokens.at(i));
   }
 }
 
@@ -160,39 +173,305 @@ INSTANTIATE_TEST_SUITE_P(
     PunctuatorTest, TokenizeDetectPunctuatorTestFixture,
     testing::Values(
         std::make_tuple(std::vector{U'!'},
-                        std::vector{Token{.value_ = std::vector{U'!'},
-                                          .type_ = TokenType::PUNCTUATOR,
+                        std::vector{Token{.type_ = TokenType::PUNCTUATOR,
                                           .ignored_ = false,
-                                          .line_ = 1,
-                                          .column_ = 1}}),
+                                          .offset_ = 0,
+                                          .length_ = 1}}),
         std::make_tuple(std::vector{U'$'},
-                        std::vector{Token{.value_ = std::vector{U'$'},
-                                          .type_ = TokenType::PUNCTUATOR,
+                        std::vector{Token{.type_ = TokenType::PUNCTUATOR,
                                           .ignored_ = false,
-                                          .line_ = 1,
-                                          .column_ = 1}}),
+                                          .offset_ = 0,
+                                          .length_ = 1}}),
         std::make_tuple(std::vector{U'&'},
-                        std::vector{Token{.value_ = std::vector{U'&'},
-                                          .type_ = TokenType::PUNCTUATOR,
+                        std::vector{Token{.type_ = TokenType::PUNCTUATOR,
                                           .ignored_ = false,
-                                          .line_ = 1,
-                                          .column_ = 1}}),
+                                          .offset_ = 0,
+                                          .length_ = 1}}),
         std::make_tuple(std::vector{U'('},
-                        std::vector{Token{.value_ = std::vector{U'('},
-                                          .type_ = TokenType::PUNCTUATOR,
+                        std::vector{Token{.type_ = TokenType::PUNCTUATOR,
                                           .ignored_ = false,
-                                          .line_ = 1,
-                                          .column_ = 1}}),
+                                          .offset_ = 0,
+                                          .length_ = 1}}),
         std::make_tuple(std::vector{U')'},
-                        std::vector{Token{.value_ = std::vector{U')'},
-                                          .type_ = TokenType::PUNCTUATOR,
+                        std::vector{Token{.type_ = TokenType::PUNCTUATOR,
                                           .ignored_ = false,
-                                          .line_ = 1,
-                                          .column_ = 1}}),
+                                          .offset_ = 0,
+                                          .length_ = 1}}),
         std::make_tuple(std::vector{U'.', U'.', U'.'},
-                        std::vector{
-                            Token{.value_ = std::vector{U'.', U'.', U'.'},
-                                  .type_ = TokenType::PUNCTUATOR,
-                                  .ignored_ = false,
-                                  .line_ = 1,
-                                  .column_ = 1}})));
\ No newline at end of file
+                        std::vector{Token{.type_ = TokenType::PUNCTUATOR,
+                                          .ignored_ = false,
+                                          .offset_ = 0,
+                                          .length_ = 3}})));
+
+class TokenizeUtf8DetectIllegalCharactersTestFixture
+    : public testing::TestWithParam<std::tuple<std::string, size_t, size_t>> {
+};
+
+TEST_P(TokenizeUtf8DetectIllegalCharactersTestFixture,
+       TokenizeUtf8_DetectIllegalCharacters) {
+  constexpr size_t expected_locations = 1;
+  const auto [illegal_source, line, column] = GetParam();
+
+  Result<std::vector<Token>, TokenizeError> r =
+      tokenize(std::string_view(illegal_source));
+
+  ASSERT_FALSE(r.IsOk());
+
+  TokenizeError e = r.UnwrapErr();
+  std::optional<std::vector<Location>> o = e.get_locations();
+
+  ASSERT_TRUE(o.has_value());
+
+  std::vector<Location> l = o.value();
+
+  ASSERT_EQ(expected_locations, l.size());
+
+  Location location = l.at(0);
+
+  ASSERT_EQ(line, location.line_);
+  ASSERT_EQ(column, location.column_);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    IllegalCharactersTest, TokenizeUtf8DetectIllegalCharactersTestFixture,
+    testing::Values(
+        // U+FFFF followed by U+1FFFF.
+        std::make_tuple("\xEF\xBF\xBF\xF0\x9F\xBF\xBF", 1, 2),
+        std::make_tuple("\xEA\xAF\x8D\xEA\xB0\xA1\n\xF1\x9F\xBF\xBF", 2, 1),
+        std::make_tuple("\xEA\xAF\x8D\xEA\xB0\xA1\r\xF1\x9F\xBF\xBF", 2, 1),
+        std::make_tuple("\xEA\xAF\x8D\xEA\xB0\xA1\r\n\xF1\x9F\xBF\xBF", 2,
+                        1),
+        // Malformed sequences: lone continuation byte, truncated sequence,
+        // overlong encoding and encoded surrogate.
+        std::make_tuple("ab\x80", 1, 3), std::make_tuple("\n\xE2\x82", 2, 1),
+        std::make_tuple("\xC0\xAF", 1, 1),
+        std::make_tuple("\r\n \xED\xA0\x80", 2, 2)));
+
+TEST(TokenizeUtf8Test, TokenizeUtf8_TokensReferenceTheSource) {
+  const std::string source = "#\xEA\xAF\x8D\r\n\"\xEA\xB0\xA1\"\n";
+
+  Result<std::vector<Token>, TokenizeError> r = tokenize(source);
+
+  ASSERT_TRUE(r.IsOk());
+
+  std::vector<Token> tokens = r.Unwrap();
+
+  ASSERT_EQ(4, tokens.size());
+  ASSERT_EQ((Token{.type_ = TokenType::LINE_TERMINATOR,
+                   .ignored_ = true,
+                   .offset_ = 4,
+                   .length_ = 2}),
+            tokens.at(1));
+  ASSERT_EQ((Token{.type_ = TokenType::STRING_VALUE,
+                   .ignored_ = false,
+                   .offset_ = 6,
+                   .length_ = 5}),
+            tokens.at(2));
+  ASSERT_EQ((Token{.type_ = TokenType::LINE_TERMINATOR,
+                   .ignored_ = true,
+                   .offset_ = 11,
+                   .length_ = 1}),
+            tokens.at(3));
+  ASSERT_EQ("\r\n", tokens.at(1).get_value(source));
+
+  const LineIndex index = LineIndex(source);
+
+  ASSERT_EQ((Location{.line_ = 1, .column_ = 3}),
+            index.get_location(tokens.at(1).offset_));
+  ASSERT_EQ((Location{.line_ = 2, .column_ = 1}),
+            index.get_location(tokens.at(2).offset_));
+  ASSERT_EQ((Location{.line_ = 2, .column_ = 4}),
+            index.get_location(tokens.at(3).offset_));
+  ASSERT_EQ("\"\xEA\xB0\xA1\"", tokens.at(2).get_value(source));
+}
+
+TEST(TokenizeUtf8Test, TokenizeUtf8_MatchesUtf32Tokens) {
+  const std::u8string utf8_source =
+      u8"\uFEFF{ a(b: \"\uABCD\") }\r# \u00E9\n\r\n\"\"\"\r\n\u00E9\"\"\" c";
+  const std::vector<char32_t> utf32_source = {
+      U'\uFEFF', U'{',      U' ',           U'a',      U'(',      U'b',
+      U':',      U' ',      U'"',           U'\uABCD', U'"',      U')',
+      U' ',      U'}',      CARRIAGE_RETURN, U'#',      U' ',      U'\u00E9',
+      NEW_LINE,  CARRIAGE_RETURN, NEW_LINE,  U'"',      U'"',      U'"',
+      CARRIAGE_RETURN, NEW_LINE, U'\u00E9', U'"',      U'"',      U'"',
+      U' ',      U'c'};
+
+  Result<std::vector<Token>, TokenizeError> utf8_result =
+      tokenize(std::u8string_view(utf8_source));
+  Result<std::vector<Token>, TokenizeError> utf32_result =
+      tokenize(utf32_source);
+
+  ASSERT_TRUE(utf8_result.IsOk());
+  ASSERT_TRUE(utf32_result.IsOk());
+
+  std::vector<Token> utf8_tokens = utf8_result.Unwrap();
+  std::vector<Token> utf32_tokens = utf32_result.Unwrap();
+
+  ASSERT_EQ(utf32_tokens.size(), utf8_tokens.size());
+
+  const LineIndex utf8_index = LineIndex(std::string_view(
+      reinterpret_cast<const char*>(utf8_source.data()), utf8_source.size()));
+  const Utf32LineIndex utf32_index = Utf32LineIndex(
+      std::u32string_view(utf32_source.data(), utf32_source.size()));
+
+  for (size_t i = 0; i < utf32_tokens.size(); i++) {
+    ASSERT_EQ(utf32_tokens.at(i).type_, utf8_tokens.at(i).type_);
+    ASSERT_EQ(utf32_index.get_location(utf32_tokens.at(i).offset_),
+              utf8_index.get_location(utf8_tokens.at(i).offset_));
+  }
+}
+
+class TokenizeDetectTokensTestFixture
+    : public testing::TestWithParam<
+          std::tuple<std::string, std::vector<TokenType>>> {};
+
+TEST_P(TokenizeDetectTokensTestFixture, Tokenize_DetectTokens) {
+  const auto [source, expected_types] = GetParam();
+
+  Result<std::vector<Token>, TokenizeError> r = tokenize(source);
+
+  ASSERT_TRUE(r.IsOk());
+
+  std::vector<Token> tokens = r.Unwrap();
+
+  ASSERT_EQ(expected_types.size(), tokens.size());
+
+  for (size_t i = 0; i < expected_types.size(); i++) {
+    ASSERT_EQ(expected_types.at(i), tokens.at(i).type_);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TokensTest, TokenizeDetectTokensTestFixture,
+    testing::Values(
+        std::make_tuple("query", std::vector{NAME}),
+        std::make_tuple("_a1 B_2", std::vector{NAME, WHITESPACE, NAME}),
+        std::make_tuple("0 -0 123 -45",
+                        std::vector{INT_VALUE, WHITESPACE, INT_VALUE,
+                                    WHITESPACE, INT_VALUE, WHITESPACE,
+                                    INT_VALUE}),
+        std::make_tuple("1.5 -0.25e10 3E-2 4e+1",
+                        std::vector{FLOAT_VALUE, WHITESPACE, FLOAT_VALUE,
+                                    WHITESPACE, FLOAT_VALUE, WHITESPACE,
+                                    FLOAT_VALUE}),
+        std::make_tuple("\"\" \"a\\\"b\\u00e9\\u{1F600}\"",
+                        std::vector{STRING_VALUE, WHITESPACE, STRING_VALUE}),
+        std::make_tuple("\"\"\"a\n\\\"\"\"b\"\"\"", std::vector{STRING_VALUE}),
+        std::make_tuple("{a,b}", std::vector{PUNCTUATOR, NAME, COMMA, NAME,
+                                             PUNCTUATOR}),
+        std::make_tuple("\xEF\xBB\xBF...x", std::vector{UNICODE_BOM,
+                                                        PUNCTUATOR, NAME}),
+        std::make_tuple("$v:[Int!]=@d|&", std::vector{PUNCTUATOR, NAME,
+                                                     PUNCTUATOR, PUNCTUATOR,
+                                                     NAME, PUNCTUATOR,
+                                                     PUNCTUATOR, PUNCTUATOR,
+                                                     PUNCTUATOR, NAME,
+                                                     PUNCTUATOR,
+                                                     PUNCTUATOR})));
+
+class TokenizeDetectLexicalErrorsTestFixture
+    : public testing::TestWithParam<std::tuple<std::string, size_t, size_t>> {
+};
+
+TEST_P(TokenizeDetectLexicalErrorsTestFixture, Tokenize_DetectLexicalErrors) {
+  const auto [source, line, column] = GetParam();
+
+  Result<std::vector<Token>, TokenizeError> r = tokenize(source);
+
+  ASSERT_FALSE(r.IsOk());
+
+  std::vector<Location> locations = r.UnwrapErr().get_locations().value();
+
+  ASSERT_EQ(1, locations.size());
+  ASSERT_EQ(line, locations.at(0).line_);
+  ASSERT_EQ(column, locations.at(0).column_);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    LexicalErrorsTest, TokenizeDetectLexicalErrorsTestFixture,
+    testing::Values(std::make_tuple("a ?", 1, 3),
+                    std::make_tuple("..", 1, 1),
+                    std::make_tuple("\n 01", 2, 3),
+                    std::make_tuple("1.", 1, 3),
+                    std::make_tuple("1.2.3", 1, 4),
+                    std::make_tuple("12abc", 1, 3),
+                    std::make_tuple("-x", 1, 2),
+                    std::make_tuple("1e", 1, 3),
+                    std::make_tuple("\"abc", 1, 5),
+                    std::make_tuple("\"ab\ncd\"", 1, 4),
+                    std::make_tuple("\"\\x\"", 1, 2),
+                    std::make_tuple("\"\\u12G4\"", 1, 2),
+                    std::make_tuple("\"\\u{110000}\"", 1, 2),
+                    // Lone surrogates, escaped either way.
+                    std::make_tuple("\"\\uD800\"", 1, 2),
+                    std::make_tuple("\"\\u{D800}\"", 1, 2),
+                    std::make_tuple("\"a\\uDE00\\uD83D\"", 1, 3),
+                    std::make_tuple("\"\\uD83D\\u0041\"", 1, 2),
+                    std::make_tuple("\"\\uD83D\\u{DE00}\"", 1, 2),
+                    std::make_tuple("\"\"\"a\r\nb", 2, 2),
+                    std::make_tuple("\xC3\xA9", 1, 1)));
+
+TEST(TokenizePolicyTest, TokenizeSignificantTokens_SkipsIgnoredTokens) {
+  const std::string source = "\xEF\xBB\xBF{ a, # b\r\n  c(d: 1.5) }";
+
+  TokenBuffer full = TokenBuffer();
+  TokenBuffer significant = TokenBuffer();
+
+  ASSERT_TRUE(tokenize<FULL_FIDELITY_POLICY>(source, full).IsOk());
+  ASSERT_TRUE(
+      tokenize<SIGNIFICANT_TOKENS_POLICY>(source, significant).IsOk());
+
+  std::vector<Token> expected_tokens;
+
+  for (const TokenView token : full) {
+    if (!token.is_ignored()) {
+      expected_tokens.push_back(token.to_token());
+    }
+  }
+
+  ASSERT_EQ(expected_tokens.size(), significant.size());
+
+  for (size_t i = 0; i < expected_tokens.size(); i++) {
+    ASSERT_EQ(expected_tokens.at(i), significant[i].to_token());
+  }
+}
+
+TEST(TokenizePolicyTest, TokenizeTrusted_SkipsCharacterValidation) {
+  const std::string source = "a # \xF0\x9F\x98\x80\nb";
+
+  TokenBuffer validated = TokenBuffer();
+  TokenBuffer trusted = TokenBuffer();
+
+  ASSERT_FALSE(tokenize<SIGNIFICANT_TOKENS_POLICY>(source, validated).IsOk());
+  ASSERT_TRUE(
+      tokenize<TRUSTED_SIGNIFICANT_TOKENS_POLICY>(source, trusted).IsOk());
+  ASSERT_EQ(2, trusted.size());
+}
+
+TEST(TokenizePolicyTest, TokenizeTrusted_ReportsInvalidTokenStart) {
+  TokenBuffer tokens = TokenBuffer();
+  Result<size_t, TokenizeError> r =
+      tokenize<TRUSTED_SIGNIFICANT_TOKENS_POLICY>("a \xC3\xA9", tokens);
+
+  ASSERT_FALSE(r.IsOk());
+
+  std::vector<Location> locations = r.UnwrapErr().get_locations().value();
+
+  ASSERT_EQ((Location{.line_ = 1, .column_ = 3}), locations.at(0));
+}
+
+TEST(TokenizePmrTest, Tokenize_StoresTokensInTheGivenResource) {
+  std::array<std::byte, 4 * 1024> memory{};
+  std::pmr::monotonic_buffer_resource resource(
+      memory.data(), memory.size(), std::pmr::null_memory_resource());
+
+  Result<std::pmr::vector<Token>, TokenizeError> r =
+      tokenize(std::string_view("{ a(b: 1) }"), &resource);
+
+  ASSERT_TRUE(r.IsOk());
+
+  std::pmr::vector<Token> tokens = r.Unwrap();
+
+  ASSERT_EQ(11, tokens.size());
+  ASSERT_EQ(&resource, tokens.get_allocator().resource());
+}
@@ -4,11 +4,14 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <string>
+
 using namespace graphqlpp;
 
 class NoDefaultConstructor {
  public:
-  explicit NoDefaultConstructor(int x) {}
+  explicit NoDefaultConstructor(int) {}
 };
 
 TEST(ResultTest, IsOk_ReturnsTrueForOkValue) {
@@ -50,24 +53,24 @@ TEST(ResultTest, Err_NoDefaultConstructorWorks) {
   ASSERT_FALSE(r.IsOk());
 }
 
-TEST(ResultTest, Unwrap_ReturnsUniquePtrWithOkValue) {
+TEST(ResultTest, Unwrap_ReturnsOkValue) {
   Result<std::string, bool> r = Result<std::string, bool>::Ok("yes");
 
-  const std::unique_ptr<std::string> ok = r.Unwrap();
+  const std::string ok = r.Unwrap();
 
-  ASSERT_EQ("yes", *ok);
+  ASSERT_EQ("yes", ok);
 }
 
 TEST(ResultTest, Unwrap_ThrowsExceptionForErrorValue) {
   Result<std::string, bool> r = Result<std::string, bool>::Err(false);
 
-  ASSERT_THROW({ auto v = r.Unwrap(); }, std::logic_error);
+  ASSERT_THROW({ [[maybe_unused]] auto v = r.Unwrap(); }, std::logic_error);
 }
 
-TEST(ResultTest, UnwrapErr_ReturnsUniquePtrWithErrorValue) {
+TEST(ResultTest, UnwrapErr_ReturnsErrorValue) {
   Result<std::string, bool> r = Result<std::string, bool>::Err(true);
 
-  const std::unique_ptr<bool> error = r.UnwrapErr();
+  const bool error = r.UnwrapErr();
 
   ASSERT_TRUE(error);
 }
@@ -75,5 +78,70 @@ TEST(ResultTest, UnwrapErr_ReturnsUniquePtrWithErrorValue) {
 TEST(ResultTest, UnwrapErr_ThrowsExceptionForOkValue) {
   Result<std::string, bool> r = Result<std::string, bool>::Ok("yes");
 
-  ASSERT_THROW({ auto e = r.UnwrapErr(); }, std::logic_error);
+  ASSERT_THROW({ [[maybe_unused]] auto e = r.UnwrapErr(); }, std::logic_error);
+}
+
+TEST(ResultTest, Ok_MoveOnlyValueWorks) {
+  Result<std::unique_ptr<int>, bool> r =
+      Result<std::unique_ptr<int>, bool>::Ok(std::make_unique<int>(7));
+
+  const std::unique_ptr<int> ok = r.Unwrap();
+
+  ASSERT_EQ(7, *ok);
+}
+
+TEST(ResultTest, Ok_SameOkAndErrorTypesWork) {
+  Result<int, int> ok = Result<int, int>::Ok(1);
+  Result<int, int> error = Result<int, int>::Err(2);
+
+  ASSERT_TRUE(ok.IsOk());
+  ASSERT_FALSE(error.IsOk());
+  ASSERT_EQ(1, ok.Unwrap());
+  ASSERT_EQ(2, error.UnwrapErr());
+}
+
+TEST(ResultTest, ValueOr_ReturnsOkValue) {
+  Result<int, bool> r = Result<int, bool>::Ok(3);
+
+  ASSERT_EQ(3, r.ValueOr(5));
+}
+
+TEST(ResultTest, ValueOr_ReturnsDefaultValueForErrorValue) {
+  Result<int, bool> r = Result<int, bool>::Err(false);
+
+  ASSERT_EQ(5, r.ValueOr(5));
+}
+
+TEST(ResultTest, Map_TransformsOkValue) {
+  Result<int, bool> r = Result<int, bool>::Ok(3);
+
+  Result<std::string, bool> mapped =
+      r.Map([](const int v) { return std::to_string(v * 2); });
+
+  ASSERT_EQ("6", mapped.Unwrap());
+}
+
+TEST(ResultTest, Map_KeepsErrorValue) {
+  Result<int, std::string> r = Result<int, std::string>::Err("no");
+
+  Result<double, std::string> mapped =
+      r.Map([](const int v) { return v * 0.5; });
+
+  ASSERT_EQ("no", mapped.UnwrapErr());
+}
+
+TEST(ResultTest, AndThen_ChainsOperations) {
+  const auto half = [](const int v) {
+    if (v % 2 != 0) {
+      return Result<int, std::string>::Err("odd");
+    }
+
+    return Result<int, std::string>::Ok(v / 2);
+  };
+
+  Result<int, std::string> even = Result<int, std::string>::Ok(8);
+  Result<int, std::string> odd = Result<int, std::string>::Ok(6);
+
+  ASSERT_EQ(2, even.AndThen(half).AndThen(half).Unwrap());
+  ASSERT_EQ("odd", odd.AndThen(half).AndThen(half).UnwrapErr());
 }
\ No newline at end of file
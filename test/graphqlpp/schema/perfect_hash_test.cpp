@@ -0,0 +1,74 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/schema/perfect_hash.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::schema;
+
+TEST(PerfectHashTest, Find_ReturnsTheIndexOfEveryKey) {
+  std::vector<std::string> names;
+
+  for (size_t i = 0; i < 10000; i++) {
+    names.push_back("name" + std::to_string(i));
+  }
+
+  std::vector<PerfectHashKey> keys;
+
+  for (size_t i = 0; i < names.size(); i++) {
+    // Every name appears within two scopes.
+    keys.push_back(PerfectHashKey{.name_ = names[i], .scope_ = 0});
+    keys.push_back(PerfectHashKey{.name_ = names[i], .scope_ = 1});
+  }
+
+  Result<PerfectHash, size_t> r = PerfectHash::build(keys);
+  ASSERT_TRUE(r.IsOk());
+
+  const PerfectHash hash = r.Unwrap();
+
+  for (size_t i = 0; i < keys.size(); i++) {
+    ASSERT_EQ(i, hash.find(keys[i].name_, keys[i].scope_));
+  }
+
+  // The memory usage stays within a few words per key.
+  ASSERT_LT(hash.get_memory_usage(), keys.size() * 2 * sizeof(uint32_t));
+}
+
+TEST(PerfectHashTest, Find_ReturnsACandidateForUnknownKeys) {
+  const std::vector<PerfectHashKey> keys = {
+      PerfectHashKey{.name_ = "a", .scope_ = 0},
+      PerfectHashKey{.name_ = "b", .scope_ = 0}};
+  Result<PerfectHash, size_t> r = PerfectHash::build(keys);
+  ASSERT_TRUE(r.IsOk());
+
+  const PerfectHash hash = r.Unwrap();
+  const uint32_t candidate = hash.find("c", 0);
+
+  ASSERT_TRUE(candidate == PerfectHash::NOT_FOUND || candidate < keys.size());
+  ASSERT_EQ(PerfectHash::NOT_FOUND, PerfectHash().find("a", 0));
+}
+
+TEST(PerfectHashTest, Build_ReportsRepeatedKeys) {
+  const std::vector<PerfectHashKey> keys = {
+      PerfectHashKey{.name_ = "a", .scope_ = 0},
+      PerfectHashKey{.name_ = "b", .scope_ = 0},
+      PerfectHashKey{.name_ = "a", .scope_ = 1},
+      PerfectHashKey{.name_ = "a", .scope_ = 0}};
+  Result<PerfectHash, size_t> r = PerfectHash::build(keys);
+
+  ASSERT_FALSE(r.IsOk());
+  ASSERT_EQ(3, r.UnwrapErr());
+}
+
+TEST(PerfectHashTest, Build_AcceptsNoKeys) {
+  Result<PerfectHash, size_t> r = PerfectHash::build({});
+  ASSERT_TRUE(r.IsOk());
+
+  ASSERT_EQ(PerfectHash::NOT_FOUND, r.Unwrap().find("a", 0));
+}
@@ -0,0 +1,291 @@
+// Copyright (c) Gabriel Amihalachioaie, SimpleG 2024.
+
+#include "graphqlpp/schema/schema_compiler.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "graphqlpp/result.h"
+
+using namespace graphqlpp;
+using namespace graphqlpp::schema;
+
+Schema compile_or_fail(const std::string& source) {
+  Result<Schema, SchemaError> r = compile_schema(source);
+
+  EXPECT_TRUE(r.IsOk());
+
+  return r.IsOk() ? r.Unwrap() : Schema();
+}
+
+SchemaError compile_and_fail(const std::string& source) {
+  Result<Schema, SchemaError> r = compile_schema(source);
+
+  EXPECT_FALSE(r.IsOk());
+
+  return r.UnwrapErr();
+}
+
+/// \brief Names of a list of definitions.
+template <typename Definition>
+std::vector<std::string> get_names(const Schema& schema,
+                                   const std::span<const Definition> list) {
+  std::vector<std::string> names;
+
+  for (const Definition& definition : list) {
+    names.emplace_back(schema.get_string(definition.name_));
+  }
+
+  return names;
+}
+
+TEST(SchemaCompilerTest, Compile_LooksUpTypesFieldsAndArguments) {
+  const Schema schema = compile_or_fail(
+      "\"\"\"Entry point.\"\"\"\n"
+      "type Query {\n"
+      "  \"Finds a user.\" user(id: ID!, fields: [String!] = [\"a\"]): User\n"
+      "  users(first: Int = 10 @deprecated): [User!]!\n"
+      "}\n"
+      "type User @key(fields: {name: \"id\"}) { id: ID! name: String }\n");
+
+  const TypeId query = schema.find_type("Query");
+  const TypeId user = schema.find_type("User");
+  ASSERT_EQ(0, query);
+  ASSERT_EQ(1, user);
+  ASSERT_EQ(INVALID_ID, schema.find_type("Missing"));
+  ASSERT_EQ(query, schema.get_query_type());
+  ASSERT_EQ(INVALID_ID, schema.get_mutation_type());
+
+  ASSERT_EQ((std::vector<std::string>{"user", "users"}),
+            get_names(schema, schema.get_fields(query)));
+  ASSERT_EQ((std::vector<std::string>{"id", "name"}),
+            get_names(schema, schema.get_fields(user)));
+  ASSERT_EQ(INVALID_ID, schema.find_field(user, "user"));
+
+  const FieldId users = schema.find_field(query, "users");
+  ASSERT_NE(INVALID_ID, users);
+
+  const TypeReference type = schema.get_field(users).type_;
+  ASSERT_EQ(user, type.type_);
+  ASSERT_EQ(1, type.list_depth_);
+  ASSERT_EQ(0b11, type.non_null_mask_);
+  ASSERT_TRUE(type.is_non_null());
+
+  const InputValueId first = schema.find_argument(users, "first");
+  ASSERT_NE(INVALID_ID, first);
+  ASSERT_EQ(schema.find_type("Int"), schema.get_input_value(first).type_.type_);
+  ASSERT_EQ("10", schema.get_string(schema.get_input_value(first)
+                                        .default_value_));
+  ASSERT_EQ(INVALID_ID, schema.find_argument(users, "id"));
+
+  const FieldId user_field = schema.find_field(query, "user");
+  const InputValueId fields = schema.find_argument(user_field, "fields");
+  ASSERT_EQ("[\"a\"]", schema.get_string(schema.get_input_value(fields)
+                                             .default_value_));
+  ASSERT_EQ((std::vector<std::string>{"id", "fields"}),
+            get_names(schema, schema.get_arguments(user_field)));
+}
+
+TEST(SchemaCompilerTest, Compile_LaysOutInterfacesAndUnions) {
+  const Schema schema = compile_or_fail(
+      "interface Node { id: ID! }\n"
+      "interface Named { name: String }\n"
+      "type B implements Node & Named { id: ID! name: String }\n"
+      "type A implements Node { id: ID! }\n"
+      "type C { id: ID! }\n"
+      "union Result = | C | A\n");
+
+  const TypeId node = schema.find_type("Node");
+  const TypeId named = schema.find_type("Named");
+  const TypeId a = schema.find_type("A");
+  const TypeId b = schema.find_type("B");
+  const TypeId c = schema.find_type("C");
+  const TypeId result = schema.find_type("Result");
+
+  ASSERT_EQ((std::vector<TypeId>{node, named}),
+            std::vector<TypeId>(schema.get_interfaces(b).begin(),
+                                schema.get_interfaces(b).end()));
+  ASSERT_EQ((std::vector<TypeId>{b, a}),
+            std::vector<TypeId>(schema.get_possible_types(node).begin(),
+                                schema.get_possible_types(node).end()));
+  ASSERT_EQ((std::vector<TypeId>{a, c}),
+            std::vector<TypeId>(schema.get_possible_types(result).begin(),
+                                schema.get_possible_types(result).end()));
+
+  ASSERT_TRUE(schema.is_possible_type(node, a));
+  ASSERT_TRUE(schema.is_possible_type(named, b));
+  ASSERT_FALSE(schema.is_possible_type(named, a));
+  ASSERT_TRUE(schema.is_possible_type(result, c));
+  ASSERT_FALSE(schema.is_possible_type(result, b));
+  ASSERT_TRUE(schema.is_possible_type(a, a));
+}
+
+TEST(SchemaCompilerTest, Compile_MergesExtensions) {
+  const Schema schema = compile_or_fail(
+      "extend type Query { b: Int }\n"
+      "type Query { a: Int }\n"
+      "enum Color { RED }\n"
+      "extend enum Color { GREEN @deprecated }\n"
+      "input Filter { a: Int }\n"
+      "extend input Filter { b: Color = GREEN }\n"
+      "extend schema @tag\n");
+
+  const TypeId query = schema.find_type("Query");
+  const TypeId color = schema.find_type("Color");
+  const TypeId filter = schema.find_type("Filter");
+
+  ASSERT_EQ((std::vector<std::string>{"b", "a"}),
+            get_names(schema, schema.get_fields(query)));
+  ASSERT_EQ((std::vector<std::string>{"RED", "GREEN"}),
+            get_names(schema, schema.get_enum_values(color)));
+  ASSERT_NE(INVALID_ID, schema.find_enum_value(color, "GREEN"));
+  ASSERT_EQ(INVALID_ID, schema.find_enum_value(color, "BLUE"));
+  ASSERT_NE(INVALID_ID, schema.find_input_field(filter, "b"));
+  ASSERT_EQ(INVALID_ID, schema.find_input_field(query, "a"));
+  // An extended schema definition only has the roots it names.
+  ASSERT_EQ(INVALID_ID, schema.get_query_type());
+}
+
+TEST(SchemaCompilerTest, Compile_AddsBuiltInDefinitionsUnlessDefined) {
+  const Schema schema = compile_or_fail(
+      "schema { mutation: M }\n"
+      "type M { a(b: Int): String }\n"
+      "scalar String @specifiedBy(url: \"https://example.com\")\n"
+      "directive @include(if: Boolean!, when: String) repeatable "
+      "on | FIELD\n");
+
+  ASSERT_EQ(schema.find_type("M"), schema.get_mutation_type());
+  ASSERT_EQ(INVALID_ID, schema.get_query_type());
+  ASSERT_EQ(1, schema.find_type("String"));
+  ASSERT_EQ(6, schema.get_types().size());
+
+  const DirectiveId include = schema.find_directive("include");
+  ASSERT_EQ(0, include);
+  ASSERT_TRUE(schema.get_directive(include).repeatable_);
+  ASSERT_TRUE(schema.get_directive(include).is_allowed_at(
+      DirectiveLocation::FIELD));
+  ASSERT_FALSE(schema.get_directive(include).is_allowed_at(
+      DirectiveLocation::FRAGMENT_SPREAD));
+  ASSERT_NE(INVALID_ID, schema.find_directive_argument(include, "when"));
+
+  const DirectiveId deprecated = schema.find_directive("deprecated");
+  ASSERT_NE(INVALID_ID, deprecated);
+  ASSERT_EQ(4, schema.get_directives().size());
+
+  const InputValueId reason =
+      schema.find_directive_argument(deprecated, "reason");
+  ASSERT_EQ("\"No longer supported\"",
+            schema.get_string(schema.get_input_value(reason).default_value_));
+  ASSERT_EQ(INVALID_ID, schema.find_directive_argument(deprecated, "when"));
+}
+
+TEST(SchemaCompilerTest, Compile_ReportsDuplicates) {
+  SchemaError error =
+      compile_and_fail("type A { a: Int }\nscalar B\ntype A { b: Int }");
+  ASSERT_EQ(DUPLICATE_TYPE, error.get_code());
+  ASSERT_EQ("A", error.get_name());
+  ASSERT_EQ(3, error.get_location().line_);
+
+  error = compile_and_fail("type A { a: Int }\nextend type A { a: String }");
+  ASSERT_EQ(DUPLICATE_MEMBER, error.get_code());
+  ASSERT_EQ(2, error.get_location().line_);
+
+  error = compile_and_fail("type A { a(b: Int, b: Int): Int }");
+  ASSERT_EQ(DUPLICATE_MEMBER, error.get_code());
+  ASSERT_EQ(19, error.get_offset());
+
+  ASSERT_EQ(DUPLICATE_MEMBER,
+            compile_and_fail("type A { a: Int } union U = A | A").get_code());
+  ASSERT_EQ(DUPLICATE_DIRECTIVE,
+            compile_and_fail("directive @a on FIELD directive @a on FIELD")
+                .get_code());
+}
+
+TEST(SchemaCompilerTest, Compile_ReportsInvalidReferences) {
+  SchemaError error = compile_and_fail("type A { a: [B] }");
+  ASSERT_EQ(UNDEFINED_TYPE, error.get_code());
+  ASSERT_EQ("B", error.get_name());
+  ASSERT_EQ(13, error.get_offset());
+
+  ASSERT_EQ(INVALID_TYPE_REFERENCE,
+            compile_and_fail("type A { a(b: A): Int }").get_code());
+  ASSERT_EQ(INVALID_TYPE_REFERENCE,
+            compile_and_fail("input I { a: Int } type A { a: I }").get_code());
+  ASSERT_EQ(INVALID_INTERFACE,
+            compile_and_fail("type B { a: Int } type A implements B "
+                             "{ a: Int }")
+                .get_code());
+  ASSERT_EQ(INVALID_UNION_MEMBER,
+            compile_and_fail("union U = Int").get_code());
+  ASSERT_EQ(INVALID_EXTENSION,
+            compile_and_fail("type A { a: Int } extend input A { b: Int }")
+                .get_code());
+  ASSERT_EQ(UNDEFINED_TYPE,
+            compile_and_fail("extend type A { a: Int }").get_code());
+  ASSERT_EQ(INVALID_TYPE_REFERENCE,
+            compile_and_fail("schema { query: Int }").get_code());
+  ASSERT_EQ(TYPE_NESTING_TOO_DEEP,
+            compile_and_fail("type A { a: " + std::string(16, '[') + "Int" +
+                             std::string(16, ']') + " }")
+                .get_code());
+}
+
+TEST(SchemaCompilerTest, Compile_ReportsSyntaxErrors) {
+  SchemaError error = compile_and_fail("type A { a Int }");
+  ASSERT_EQ(SCHEMA_PARSE_FAILED, error.get_code());
+  ASSERT_EQ(language::parsing::UNEXPECTED_TOKEN,
+            error.get_parse_error()->get_code());
+  ASSERT_EQ(11, error.get_offset());
+  ASSERT_EQ("Detected an unexpected token, expected ':'.", error.get_message());
+
+  ASSERT_EQ(SCHEMA_PARSE_FAILED, compile_and_fail("").get_code());
+  ASSERT_EQ(SCHEMA_PARSE_FAILED,
+            compile_and_fail("query { a }").get_code());
+  ASSERT_EQ(SCHEMA_PARSE_FAILED,
+            compile_and_fail("enum E { true }").get_code());
+  ASSERT_EQ(SCHEMA_PARSE_FAILED,
+            compile_and_fail("type A { a(b: Int = [1}): Int }").get_code());
+  ASSERT_EQ(SCHEMA_PARSE_FAILED,
+            compile_and_fail("directive @a on FIELDS").get_code());
+  ASSERT_EQ(SCHEMA_PARSE_FAILED,
+            compile_and_fail("\"description\" extend type A").get_code());
+  ASSERT_EQ(SCHEMA_PARSE_FAILED, compile_and_fail("type A { a: \"").get_code());
+}
+
+TEST(SchemaCompilerTest, WriteJson_ReportsTheCodeAndLocation) {
+  std::string json;
+  compile_and_fail("type A {\n  a: B\n}").write_json(json);
+
+  ASSERT_EQ(
+      "{\"message\":\"Detected a reference to undefined type 'B'.\","
+      "\"locations\":[{\"line\":2,\"column\":6}],"
+      "\"extensions\":{\"code\":\"UNDEFINED_TYPE\"}}",
+      json);
+}
+
+TEST(SchemaCompilerTest, Compile_FindsEveryMemberOfALargeSchema) {
+  std::string source = "type Query { root: T0 }\n";
+
+  for (size_t i = 0; i < 2000; i++) {
+    const std::string index = std::to_string(i);
+    source += "type T" + index + " { f" + index + "(a: Int): Int next: T" +
+              std::to_string((i + 1) % 2000) + " }\n";
+  }
+
+  const Schema schema = compile_or_fail(source);
+
+  for (size_t i = 0; i < 2000; i++) {
+    const std::string index = std::to_string(i);
+    const TypeId type = schema.find_type("T" + index);
+    ASSERT_EQ(i + 1, type);
+
+    const FieldId field = schema.find_field(type, "f" + index);
+    ASSERT_NE(INVALID_ID, field);
+    ASSERT_NE(INVALID_ID, schema.find_argument(field, "a"));
+    ASSERT_EQ(INVALID_ID, schema.find_field(type, "f" + std::to_string(
+                                                          (i + 1) % 2000)));
+    ASSERT_NE(INVALID_ID, schema.find_field(type, "next"));
+  }
+}